@@ -40,12 +40,17 @@ list (APPEND MAIN_SOURCE_FILES
 	opm/core/grid/cpgpreprocess/preprocess.c
 	opm/core/grid/cpgpreprocess/uniquepoints.c
 	opm/core/io/eclipse/EclipseGridInspector.cpp
+	opm/core/io/eclipse/EclipseBinaryFile.cpp
+	opm/core/io/eclipse/EclipseNativeWriter.cpp
 	opm/core/io/eclipse/EclipseWriter.cpp
 	opm/core/io/eclipse/EclipseReader.cpp
 	opm/core/io/eclipse/EclipseWriteRFTHandler.cpp
 	opm/core/io/eclipse/writeECLData.cpp
+	opm/core/io/AsyncOutputWriter.cpp
+	opm/core/io/CheckpointFile.cpp
 	opm/core/io/OutputWriter.cpp
 	opm/core/io/vag/vag.cpp
+	opm/core/io/vtk/VtuWriter.cpp
 	opm/core/io/vtk/writeVtkData.cpp
 	opm/core/linalg/LinearSolverFactory.cpp
 	opm/core/linalg/LinearSolverInterface.cpp
@@ -83,7 +88,9 @@ list (APPEND MAIN_SOURCE_FILES
 	opm/core/pressure/tpfa/trans_tpfa.c
 	opm/core/pressure/legacy_well.c
 	opm/core/props/BlackoilPropertiesBasic.cpp
+	opm/core/props/BlackoilPropertiesInterface.cpp
 	opm/core/props/BlackoilPropertiesFromDeck.cpp
+	opm/core/props/CachedBlackoilProperties.cpp
 	opm/core/props/IncompPropertiesBasic.cpp
 	opm/core/props/IncompPropertiesFromDeck.cpp
 	opm/core/props/IncompPropertiesSinglePhase.cpp
@@ -125,8 +132,11 @@ list (APPEND MAIN_SOURCE_FILES
 	opm/core/transport/reorder/reordersequence.cpp
 	opm/core/transport/reorder/tarjan.c
 	opm/core/utility/compressedToCartesian.cpp
+	opm/core/utility/CompressedCartesianIndex.cpp
 	opm/core/utility/Event.cpp
 	opm/core/utility/MonotCubicInterpolator.cpp
+	opm/core/utility/MonotCubicTable.cpp
+	opm/core/utility/Profiler.cpp
 	opm/core/utility/StopWatch.cpp
 	opm/core/utility/VelocityInterpolation.cpp
 	opm/core/utility/WachspressCoord.cpp
@@ -147,6 +157,7 @@ list (APPEND MAIN_SOURCE_FILES
 	opm/core/wells/InjectionSpecification.cpp
 	opm/core/wells/ProductionSpecification.cpp
 	opm/core/wells/WellCollection.cpp
+	opm/core/wells/WellPerforationTable.cpp
 	opm/core/wells/WellsGroup.cpp
 	opm/core/wells/WellsManager.cpp
 	opm/core/wells/wells.c
@@ -159,30 +170,44 @@ list (APPEND TEST_SOURCE_FILES
   tests/test_writenumwells.cpp
 	tests/test_readWriteWellStateData.cpp
 	tests/test_EclipseWriter.cpp
+	tests/test_eclipsenativewriter.cpp
 	tests/test_EclipseWriteRFTHandler.cpp
+	tests/test_compressedcartesianindex.cpp
 	tests/test_compressedpropertyaccess.cpp
 	tests/test_dgbasis.cpp
 	tests/test_cartgrid.cpp
   tests/test_ug.cpp
 	tests/test_cubic.cpp
 	tests/test_event.cpp
+	tests/test_indexedheap.cpp
 	tests/test_flowdiagnostics.cpp
 	tests/test_nonuniformtablelinear.cpp
 	tests/test_parallelistlinformation.cpp
 	tests/test_sparsevector.cpp
 	tests/test_sparsetable.cpp
+	tests/test_spu_implicit.cpp
        #tests/test_thresholdpressure.cpp
        tests/test_velocityinterpolation.cpp
 	tests/test_quadratures.cpp
+	tests/test_tofdiscgalreorder.cpp
 	tests/test_uniformtablelinear.cpp
+	tests/test_builduniformlineartable.cpp
+	tests/test_thermalviscositytable.cpp
 	tests/test_wells.cpp
 	tests/test_wachspresscoord.cpp
 	tests/test_column_extract.cpp
 	tests/test_geom2d.cpp
 	tests/test_linearsolver.cpp
+	tests/test_umfpackcache.cpp
 	tests/test_parallel_linearsolver.cpp
 	tests/test_param.cpp
+	tests/test_propertykernels.cpp
 	tests/test_blackoilfluid.cpp
+	tests/test_blackoilproperties_threads.cpp
+	tests/test_blackoilcellproperties.cpp
+	tests/test_pvtregiongrouping.cpp
+	tests/test_pvtlive.cpp
+	tests/test_cachedblackoilproperties.cpp
 	tests/test_satfunc.cpp
 	tests/test_shadow.cpp
 	tests/test_equil.cpp
@@ -194,6 +219,14 @@ list (APPEND TEST_SOURCE_FILES
 	tests/test_wellcontrols.cpp
 	tests/test_wellsgroup.cpp
 	tests/test_wellcollection.cpp
+	tests/test_wellperforationtable.cpp
+	tests/test_wellstate.cpp
+	tests/test_vtuwriter.cpp
+	tests/test_eclipsebinaryfile.cpp
+	tests/test_checkpoint.cpp
+	tests/test_simulatorresume.cpp
+	tests/test_profiler.cpp
+	tests/test_asyncoutputwriter.cpp
 	tests/test_timer.cpp
 	tests/test_minpvprocessor.cpp
 	tests/test_gridutilities.cpp
@@ -236,6 +269,8 @@ list (APPEND TEST_DATA_FILES
 # originally generated with the command:
 # find tutorials examples -name '*.c*' -printf '\t%p\n' | sort
 list (APPEND EXAMPLE_SOURCE_FILES
+	examples/benchmark_property_kernels.cpp
+	examples/benchmark_pvt_live.cpp
 	examples/compute_eikonal_from_files.cpp
 	examples/compute_initial_state.cpp
 	examples/compute_tof.cpp
@@ -290,13 +325,18 @@ list (APPEND PUBLIC_HEADER_FILES
 	opm/core/io/eclipse/CornerpointChopper.hpp
 	opm/core/io/eclipse/EclipseIOUtil.hpp
 	opm/core/io/eclipse/EclipseGridInspector.hpp
+	opm/core/io/eclipse/EclipseBinaryFile.hpp
+	opm/core/io/eclipse/EclipseNativeWriter.hpp
 	opm/core/io/eclipse/EclipseUnits.hpp
 	opm/core/io/eclipse/EclipseWriter.hpp
 	opm/core/io/eclipse/EclipseReader.hpp
 	opm/core/io/eclipse/EclipseWriteRFTHandler.hpp
 	opm/core/io/eclipse/writeECLData.hpp
+	opm/core/io/AsyncOutputWriter.hpp
+	opm/core/io/CheckpointFile.hpp
 	opm/core/io/OutputWriter.hpp
 	opm/core/io/vag/vag.hpp
+	opm/core/io/vtk/VtuWriter.hpp
 	opm/core/io/vtk/writeVtkData.hpp
 	opm/core/linalg/LinearSolverFactory.hpp
 	opm/core/linalg/LinearSolverInterface.hpp
@@ -340,6 +380,7 @@ list (APPEND PUBLIC_HEADER_FILES
 	opm/core/props/BlackoilPhases.hpp
 	opm/core/props/BlackoilPropertiesBasic.hpp
 	opm/core/props/BlackoilPropertiesFromDeck.hpp
+	opm/core/props/CachedBlackoilProperties.hpp
 	opm/core/props/BlackoilPropertiesInterface.hpp
 	opm/core/props/IncompPropertiesBasic.hpp
 	opm/core/props/IncompPropertiesFromDeck.hpp
@@ -360,6 +401,7 @@ list (APPEND PUBLIC_HEADER_FILES
 	opm/core/props/pvt/ThermalWaterPvtWrapper.hpp
 	opm/core/props/pvt/ThermalOilPvtWrapper.hpp
 	opm/core/props/pvt/ThermalGasPvtWrapper.hpp
+	opm/core/props/pvt/ThermalViscosityTable.hpp
 	opm/core/props/rock/RockBasic.hpp
 	opm/core/props/rock/RockCompressibility.hpp
 	opm/core/props/rock/RockFromDeck.hpp
@@ -397,6 +439,7 @@ list (APPEND PUBLIC_HEADER_FILES
 	opm/core/flowdiagnostics/TofDiscGalReorder.hpp
 	opm/core/transport/TransportSolverTwophaseInterface.hpp
 	opm/core/transport/implicit/CSRMatrixBlockAssembler.hpp
+	opm/core/transport/implicit/CSRMatrixGenericSolver.hpp
 	opm/core/transport/implicit/CSRMatrixUmfpackSolver.hpp
 	opm/core/transport/implicit/ImplicitAssembly.hpp
 	opm/core/transport/implicit/ImplicitTransport.hpp
@@ -415,6 +458,7 @@ list (APPEND PUBLIC_HEADER_FILES
 	opm/core/transport/reorder/reordersequence.h
 	opm/core/transport/reorder/tarjan.h
 	opm/core/utility/Average.hpp
+	opm/core/utility/CompressedCartesianIndex.hpp
 	opm/core/utility/CompressedPropertyAccess.hpp
 	opm/core/utility/compressedToCartesian.hpp
 	opm/core/utility/DataMap.hpp
@@ -423,10 +467,13 @@ list (APPEND PUBLIC_HEADER_FILES
 	opm/core/utility/Event_impl.hpp
 	opm/core/utility/Exceptions.hpp
 	opm/core/utility/Factory.hpp
+	opm/core/utility/IndexedHeap.hpp
 	opm/core/utility/MonotCubicInterpolator.hpp
+	opm/core/utility/MonotCubicTable.hpp
 	opm/core/utility/memcmp_double.h
 	opm/core/utility/NonuniformTableLinear.hpp
 	opm/core/utility/NullStream.hpp
+	opm/core/utility/Profiler.hpp
 	opm/core/utility/RegionMapping.hpp
 	opm/core/utility/RootFinders.hpp
 	opm/core/utility/SparseTable.hpp
@@ -436,6 +483,7 @@ list (APPEND PUBLIC_HEADER_FILES
 	opm/core/utility/Units.hpp
 	opm/core/utility/VelocityInterpolation.hpp
 	opm/core/utility/WachspressCoord.hpp
+	opm/core/utility/buildUniformLinearTable.hpp
 	opm/core/utility/buildUniformMonotoneTable.hpp
 	opm/core/utility/have_boost_redef.hpp
 	opm/core/utility/linearInterpolation.hpp
@@ -457,6 +505,7 @@ list (APPEND PUBLIC_HEADER_FILES
 	opm/core/wells/InjectionSpecification.hpp
 	opm/core/wells/ProductionSpecification.hpp
 	opm/core/wells/WellCollection.hpp
+	opm/core/wells/WellPerforationTable.hpp
 	opm/core/wells/WellsGroup.hpp
 	opm/core/wells/WellsManager.hpp
 	opm/core/wells/WellsManager_impl.hpp
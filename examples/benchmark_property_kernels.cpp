@@ -0,0 +1,175 @@
+/*
+  Copyright 2015 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif // HAVE_CONFIG_H
+
+#include <opm/core/props/BlackoilPropertiesBasic.hpp>
+#include <opm/core/props/pvt/PvtPropertiesBasic.hpp>
+#include <opm/core/utility/miscUtilitiesBlackoil.hpp>
+#include <opm/core/utility/parameters/ParameterGroup.hpp>
+#include <opm/core/utility/StopWatch.hpp>
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Times the property kernels that are specialised for two and three
+// phases against loops with the number of phases only known at
+// runtime, as they were before the specialisation. The two-phase
+// kernels serve both the water-oil and the oil-gas configurations.
+//
+// Parameters:
+//   num_points   number of points per evaluation (default 100000)
+//   repeats      number of evaluations timed (default 100)
+
+namespace
+{
+    // Loops with the number of phases only known at runtime.
+
+    void surfacevolGeneric(const int n, const int np, const double* A,
+                           const double* s, double* z)
+    {
+        std::fill(z, z + n*np, 0.0);
+        for (int i = 0; i < n; ++i) {
+            for (int col = 0; col < np; ++col) {
+                for (int row = 0; row < np; ++row) {
+                    z[i*np + row] += A[i*np*np + row + col*np] * s[i*np + col];
+                }
+            }
+        }
+    }
+
+    void densityGeneric(const int n, const int np, const double* A,
+                        const double* sdens, double* rho)
+    {
+        for (int i = 0; i < n; ++i) {
+            for (int phase = 0; phase < np; ++phase) {
+                rho[np*i + phase] = 0.0;
+                for (int comp = 0; comp < np; ++comp) {
+                    rho[np*i + phase] += A[i*np*np + np*phase + comp]*sdens[comp];
+                }
+            }
+        }
+    }
+
+    // The loop order is that of the specialised kernel, so that only
+    // the effect of the fixed number of phases is timed.
+    void fillGeneric(const int n, const int np, const double* value, double* out)
+    {
+        for (int i = 0; i < n; ++i) {
+            for (int phase = 0; phase < np; ++phase) {
+                out[np*i + phase] = value[phase];
+            }
+        }
+    }
+
+    // Time repeats calls of f, return nanoseconds per point.
+    template <class F>
+    double timePerPoint(F f, const int n, const int repeats)
+    {
+        Opm::time::StopWatch clock;
+        clock.start();
+        for (int r = 0; r < repeats; ++r) {
+            f();
+        }
+        return 1e9*clock.secsSinceStart()/(double(n)*repeats);
+    }
+
+    void report(const std::string& config, const std::string& kernel,
+                const double generic, const double specialised, const bool same)
+    {
+        std::cout << std::setw(12) << config << std::setw(14) << kernel
+                  << std::fixed << std::setprecision(2)
+                  << std::setw(12) << generic << std::setw(14) << specialised
+                  << std::setw(10) << generic/specialised
+                  << (same ? "" : "   RESULTS DIFFER") << '\n';
+    }
+
+    void benchmark(const int np, const int n, const int repeats)
+    {
+        const std::string config = np == 2 ? "two-phase" : "three-phase";
+
+        std::vector<double> A(n*np*np), s(n*np), z1(n*np), z2(n*np);
+        for (int i = 0; i < n; ++i) {
+            for (int k = 0; k < np*np; ++k) {
+                A[i*np*np + k] = 1.0 + 0.01*((i + 7*k) % 13);
+            }
+            for (int p = 0; p < np; ++p) {
+                s[i*np + p] = 1.0/np + 0.01*((i + p) % 5);
+            }
+        }
+
+        // Surface volumes.
+        double tg = timePerPoint([&]() { surfacevolGeneric(n, np, &A[0], &s[0], &z1[0]); }, n, repeats);
+        double ts = timePerPoint([&]() { Opm::computeSurfacevol(n, np, &A[0], &s[0], &z2[0]); }, n, repeats);
+        report(config, "surfacevol", tg, ts, z1 == z2);
+
+        // PVT values.
+        Opm::PvtPropertiesBasic pvt;
+        pvt.init(np, std::vector<double>(np, 800.0), std::vector<double>(np, 1e-3));
+        const std::vector<double> visc(np, 1e-3);
+        tg = timePerPoint([&]() { fillGeneric(n, np, &visc[0], &z1[0]); }, n, repeats);
+        ts = timePerPoint([&]() { pvt.mu(n, 0, 0, 0, &z2[0]); }, n, repeats);
+        report(config, "viscosity", tg, ts, z1 == z2);
+
+        // Densities. BlackoilPropertiesBasic only supports two phases.
+        if (np == 2) {
+            Opm::parameter::ParameterGroup param;
+            param.disableOutput();
+            param.insertParameter("num_phases", "2");
+            param.insertParameter("relperm_func", "Linear");
+            Opm::BlackoilPropertiesBasic props(param, 3, 1);
+            const double* sdens = props.surfaceDensity(0);
+            std::vector<int> cells(n, 0);
+            tg = timePerPoint([&]() { densityGeneric(n, np, &A[0], sdens, &z1[0]); }, n, repeats);
+            ts = timePerPoint([&]() { props.density(n, &A[0], &cells[0], &z2[0]); }, n, repeats);
+            report(config, "density", tg, ts, z1 == z2);
+        }
+    }
+
+} // anon namespace
+
+
+
+// ----------------- Main program -----------------
+int
+main(int argc, char** argv)
+try
+{
+    Opm::parameter::ParameterGroup param(argc, argv);
+    const int n = param.getDefault("num_points", 100000);
+    const int repeats = param.getDefault("repeats", 100);
+
+    std::cout << std::setw(12) << "phases" << std::setw(14) << "kernel"
+              << std::setw(12) << "generic" << std::setw(14) << "specialised"
+              << std::setw(10) << "speedup" << '\n'
+              << std::setw(12) << "" << std::setw(14) << ""
+              << std::setw(12) << "[ns/point]" << std::setw(14) << "[ns/point]" << '\n';
+    benchmark(2, n, repeats);
+    benchmark(3, n, repeats);
+}
+catch (const std::exception& e) {
+    std::cerr << "Program threw an exception: " << e.what() << "\n";
+    throw;
+}
@@ -0,0 +1,230 @@
+/*
+  Copyright 2015 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif // HAVE_CONFIG_H
+
+#include <opm/core/props/BlackoilPhases.hpp>
+#include <opm/core/props/pvt/PvtLiveGas.hpp>
+#include <opm/core/props/pvt/PvtLiveOil.hpp>
+#include <opm/core/utility/parameters/ParameterGroup.hpp>
+#include <opm/core/utility/StopWatch.hpp>
+#include <opm/core/utility/Units.hpp>
+
+#include <opm/parser/eclipse/Parser/Parser.hpp>
+#include <opm/parser/eclipse/Parser/ParseMode.hpp>
+#include <opm/parser/eclipse/Deck/Deck.hpp>
+#include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
+
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Times the live oil and gas PVT evaluations in the two ways they are
+// called: for many cells at once, as by the pressure solvers, and for
+// one cell at a time, as by the reorder transport solvers and the
+// equilibration. Both patterns evaluate the same points.
+//
+// Parameters:
+//   num_points   number of points evaluated (default 100000)
+//   repeats      number of evaluations timed (default 20)
+
+namespace
+{
+    const std::string deckString =
+        "RUNSPEC\n"
+        "METRIC\n"
+        "OIL\n"
+        "GAS\n"
+        "DISGAS\n"
+        "VAPOIL\n"
+        "DIMENS\n"
+        "  1 1 1 /\n"
+        "TABDIMS\n"
+        "  1 1 20 20 1 20 /\n"
+        "GRID\n"
+        "DXV\n"
+        "  1.0 /\n"
+        "DYV\n"
+        "  1.0 /\n"
+        "DZV\n"
+        "  1.0 /\n"
+        "TOPS\n"
+        "  0.0 /\n"
+        "PROPS\n"
+        "PVTO\n"
+        "   20   40.  1.10  1.50\n"
+        "       100.  1.09  1.55\n"
+        "       200.  1.075 1.62 /\n"
+        "   50  100.  1.20  1.30 /\n"
+        "   80  150.  1.30  1.10\n"
+        "       250.  1.28  1.16\n"
+        "       350.  1.265 1.21 /\n"
+        "  110  200.  1.40  0.95\n"
+        "       400.  1.37  1.02 /\n"
+        "/\n"
+        "PVTG\n"
+        "   50.  0.0002  0.025  0.015\n"
+        "        0.0     0.0252 0.0148 /\n"
+        "  100.  0.0004  0.012  0.018\n"
+        "        0.0     0.0122 0.0175 /\n"
+        "  200.  0.0007  0.006  0.024\n"
+        "        0.0003  0.0061 0.0235\n"
+        "        0.0     0.0062 0.023 /\n"
+        "  300.  0.0010  0.004  0.030\n"
+        "        0.0     0.0042 0.028 /\n"
+        "/\n";
+
+    // Points spread over the tables, both saturated and
+    // undersaturated.
+    struct Points
+    {
+        explicit Points(const int n)
+            : p(n), T(n, 300.0), r(n), cond(n), z(3*n)
+        {
+            for (int i = 0; i < n; ++i) {
+                p[i] = (40.0 + 350.0*((i*37) % 101)/100.0)*Opm::unit::barsa;
+                r[i] = 0.5 + 110.0*((i*53) % 97)/96.0;
+                if (i % 3 == 0) {
+                    cond[i].setFreeGas();
+                    cond[i].setFreeOil();
+                }
+                z[3*i] = 0.0;
+                z[3*i + 1] = 1.0;
+                z[3*i + 2] = r[i];
+            }
+        }
+
+        std::vector<double> p, T, r;
+        std::vector<Opm::PhasePresence> cond;
+        std::vector<double> z;
+    };
+
+    // Time repeats calls of f, return nanoseconds per point.
+    template <class F>
+    double timePerPoint(F f, const int n, const int repeats)
+    {
+        Opm::time::StopWatch clock;
+        clock.start();
+        for (int r = 0; r < repeats; ++r) {
+            f();
+        }
+        return 1e9*clock.secsSinceStart()/(double(n)*repeats);
+    }
+
+    void report(const std::string& phase, const std::string& quantity,
+                const double batch, const double single)
+    {
+        std::cout << std::setw(6) << phase << std::setw(12) << quantity
+                  << std::fixed << std::setprecision(2)
+                  << std::setw(12) << batch << std::setw(12) << single << '\n';
+    }
+
+    // Times b() and mu() with derivatives and phase presence, and B()
+    // and dBdp() of the surface volumes. For gas, the ratio is scaled
+    // to the vaporised oil-gas ratios of the table.
+    void benchmark(const Opm::PvtInterface& pvt, const bool gas,
+                   const Points& pts, const int repeats)
+    {
+        const std::string phase = gas ? "gas" : "oil";
+        const int n = pts.p.size();
+        std::vector<double> r(pts.r), z(pts.z);
+        if (gas) {
+            for (int i = 0; i < n; ++i) {
+                r[i] *= 1e-5;
+                z[3*i + 1] = r[i];
+                z[3*i + 2] = 1.0;
+            }
+        }
+        std::vector<double> v(n), dvdp(n), dvdr(n);
+        const double* p = &pts.p[0];
+        const double* T = &pts.T[0];
+        const Opm::PhasePresence* cond = &pts.cond[0];
+
+        double tb = timePerPoint([&]() {
+                pvt.b(n, 0, p, T, &r[0], cond, &v[0], &dvdp[0], &dvdr[0]);
+            }, n, repeats);
+        double ts = timePerPoint([&]() {
+                for (int i = 0; i < n; ++i) {
+                    pvt.b(1, 0, p + i, T + i, &r[i], cond + i, &v[i], &dvdp[i], &dvdr[i]);
+                }
+            }, n, repeats);
+        report(phase, "b", tb, ts);
+
+        tb = timePerPoint([&]() {
+                pvt.mu(n, 0, p, T, &r[0], cond, &v[0], &dvdp[0], &dvdr[0]);
+            }, n, repeats);
+        ts = timePerPoint([&]() {
+                for (int i = 0; i < n; ++i) {
+                    pvt.mu(1, 0, p + i, T + i, &r[i], cond + i, &v[i], &dvdp[i], &dvdr[i]);
+                }
+            }, n, repeats);
+        report(phase, "mu", tb, ts);
+
+        tb = timePerPoint([&]() {
+                pvt.dBdp(n, 0, p, T, &z[0], &v[0], &dvdp[0]);
+            }, n, repeats);
+        ts = timePerPoint([&]() {
+                for (int i = 0; i < n; ++i) {
+                    pvt.dBdp(1, 0, p + i, T + i, &z[3*i], &v[i], &dvdp[i]);
+                }
+            }, n, repeats);
+        report(phase, "B, dBdp", tb, ts);
+    }
+
+} // anon namespace
+
+
+
+// ----------------- Main program -----------------
+int
+main(int argc, char** argv)
+try
+{
+    Opm::parameter::ParameterGroup param(argc, argv);
+    const int n = param.getDefault("num_points", 100000);
+    const int repeats = param.getDefault("repeats", 20);
+
+    Opm::ParseMode parseMode;
+    Opm::ParserPtr parser(new Opm::Parser());
+    Opm::DeckConstPtr deck = parser->parseString(deckString, parseMode);
+    Opm::EclipseStateConstPtr eclipseState(new Opm::EclipseState(deck, parseMode));
+    const auto tables = eclipseState->getTableManager();
+
+    const int phase_pos[] = { 0, 1, 2 };
+    Opm::PvtLiveOil oil(tables->getPvtoTables());
+    oil.setPhaseConfiguration(3, phase_pos);
+    Opm::PvtLiveGas gas(tables->getPvtgTables());
+    gas.setPhaseConfiguration(3, phase_pos);
+
+    const Points pts(n);
+    std::cout << std::setw(6) << "phase" << std::setw(12) << "quantity"
+              << std::setw(12) << "batch" << std::setw(12) << "single" << '\n'
+              << std::setw(6) << "" << std::setw(12) << ""
+              << std::setw(12) << "[ns/point]" << std::setw(12) << "[ns/point]" << '\n';
+    benchmark(oil, false, pts, repeats);
+    benchmark(gas, true, pts, repeats);
+}
+catch (const std::exception& e) {
+    std::cerr << "Program threw an exception: " << e.what() << "\n";
+    throw;
+}
@@ -110,7 +110,7 @@ try
     Opm::time::StopWatch timer;
     timer.start();
     std::vector<double> solution;
-    AnisotropicEikonal2d ae(grid);
+    AnisotropicEikonal ae(grid);
     ae.solve(metric.data(), startcells, solution);
     timer.stop();
     double tt = timer.secsSinceStart();
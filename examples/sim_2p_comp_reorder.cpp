@@ -27,6 +27,7 @@
 #include <opm/core/grid/GridManager.hpp>
 #include <opm/core/wells.h>
 #include <opm/core/wells/WellsManager.hpp>
+#include <opm/core/utility/CompressedCartesianIndex.hpp>
 #include <opm/core/utility/ErrorMacros.hpp>
 #include <opm/core/simulator/initState.hpp>
 #include <opm/core/simulator/SimulatorReport.hpp>
@@ -36,6 +37,7 @@
 
 #include <opm/core/props/BlackoilPropertiesBasic.hpp>
 #include <opm/core/props/BlackoilPropertiesFromDeck.hpp>
+#include <opm/core/props/CachedBlackoilProperties.hpp>
 #include <opm/core/props/rock/RockCompressibility.hpp>
 
 #include <opm/core/linalg/LinearSolverFactory.hpp>
@@ -87,6 +89,7 @@ try
     bool use_deck = param.has("deck_filename");
     EclipseStateConstPtr eclipseState;
     std::unique_ptr<GridManager> grid;
+    std::shared_ptr<const CompressedCartesianIndex> cartesian_index;
     std::unique_ptr<BlackoilPropertiesInterface> props;
     std::unique_ptr<RockCompressibility> rock_comp;
 
@@ -105,12 +108,21 @@ try
 
         // Grid init
         grid.reset(new GridManager(deck));
+        // Cartesian index of the grid, shared by the wells of all report steps.
+        {
+            const UnstructuredGrid& g = *grid->c_grid();
+            cartesian_index = std::make_shared<CompressedCartesianIndex>(
+                g.number_of_cells, g.global_cell,
+                g.cartdims[0]*g.cartdims[1]*g.cartdims[2]);
+        }
         // Rock and fluid init
         props.reset(new BlackoilPropertiesFromDeck(deck, eclipseState, *grid->c_grid(), param));
         // check_well_controls = param.getDefault("check_well_controls", false);
         // max_well_control_iterations = param.getDefault("max_well_control_iterations", 10);
         // Rock compressibility.
-        rock_comp.reset(new RockCompressibility(deck, eclipseState));
+        rock_comp.reset(new RockCompressibility(deck, eclipseState,
+                                                param.getDefault("rock_tab_tolerance", 0.0),
+                                                param.getDefault("rock_tab_max_size", 1025)));
         // Gravity.
         gravity[2] = deck->hasKeyword("NOGRAV") ? 0.0 : unit::gravity;
         // Init state variables (saturation and pressure).
@@ -140,6 +152,14 @@ try
         initBlackoilSurfvol(*grid->c_grid(), *props, state);
     }
 
+    // Optionally reuse property evaluations in cells whose state is unchanged.
+    CachedBlackoilProperties* cached_props = 0;
+    if (param.getDefault("use_property_cache", false)) {
+        std::shared_ptr<const BlackoilPropertiesInterface> uncached(props.release());
+        cached_props = new CachedBlackoilProperties(uncached, param.getDefault("property_cache_tolerance", 0.0));
+        props.reset(cached_props);
+    }
+
     bool use_gravity = (gravity[0] != 0.0 || gravity[1] != 0.0 || gravity[2] != 0.0);
     const double *grav = use_gravity ? &gravity[0] : 0;
 
@@ -230,6 +250,7 @@ try
         Opm::TimeMapPtr timeMap(new Opm::TimeMap(deck));
         simtimer.init(timeMap);
         const double total_time = simtimer.totalTime();
+        WellsManager wells;
         for (size_t reportStepIdx = 0; reportStepIdx < timeMap->numTimesteps(); ++reportStepIdx) {
             simtimer.setCurrentStepNum(step);
             simtimer.setTotalTime(total_time);
@@ -239,13 +260,13 @@ try
                       << "\n                  (number of steps: "
                       << simtimer.numSteps() - step << ")\n\n" << std::flush;
 
-            // Create new wells, well_state
-            WellsManager wells(eclipseState , reportStepIdx , *grid->c_grid(), props->permeability());
-            // @@@ HACK: we should really make a new well state and
-            // properly transfer old well state to it every report step,
-            // since number of wells may change etc.
-            if (reportStepIdx == 0) {
-                well_state.init(wells.c_wells(), state);
+            // Update wells, well_state
+            wells.update(eclipseState , reportStepIdx , *grid->c_grid(), props->permeability(),
+                         cartesian_index);
+            // Carry the well state over to the wells of this report step.
+            {
+                const WellState prev_well_state = well_state;
+                well_state.init(wells.c_wells(), wells.wellIds(), state, prev_well_state);
             }
 
             // Create and run simulator.
@@ -273,6 +294,16 @@ try
 
     std::cout << "\n\n================    End of simulation     ===============\n\n";
     rep.report(std::cout);
+    if (cached_props) {
+        const char* names[] = { "viscosity", "matrix", "relperm", "capPress" };
+        std::cout << "Property cache hit rates:\n";
+        for (int q = 0; q < CachedBlackoilProperties::NumQuantities; ++q) {
+            const CachedBlackoilProperties::Statistics& stats
+                = cached_props->statistics(CachedBlackoilProperties::Quantity(q));
+            std::cout << "    " << names[q] << ": " << 100.0*stats.hitRate() << " % of "
+                      << stats.hits + stats.misses << " points\n";
+        }
+    }
 
     if (output) {
         std::string filename = output_dir + "/walltime.param";
@@ -28,6 +28,7 @@
 #include <opm/core/grid/GridManager.hpp>
 #include <opm/core/wells.h>
 #include <opm/core/wells/WellsManager.hpp>
+#include <opm/core/utility/CompressedCartesianIndex.hpp>
 #include <opm/core/utility/ErrorMacros.hpp>
 #include <opm/core/simulator/initState.hpp>
 #include <opm/core/simulator/SimulatorReport.hpp>
@@ -102,6 +103,7 @@ try
 
     Opm::DeckConstPtr deck;
     std::unique_ptr<GridManager> grid;
+    std::shared_ptr<const CompressedCartesianIndex> cartesian_index;
     std::unique_ptr<IncompPropertiesInterface> props;
     std::unique_ptr<RockCompressibility> rock_comp;
     TwophaseState state;
@@ -117,6 +119,13 @@ try
         eclipseState.reset( new EclipseState(deck, parseMode));
         // Grid init
         grid.reset(new GridManager(deck));
+        // Cartesian index of the grid, shared by the wells of all report steps.
+        {
+            const UnstructuredGrid& g = *grid->c_grid();
+            cartesian_index = std::make_shared<CompressedCartesianIndex>(
+                g.number_of_cells, g.global_cell,
+                g.cartdims[0]*g.cartdims[1]*g.cartdims[2]);
+        }
         // Rock and fluid init
         props.reset(new IncompPropertiesFromDeck(deck, eclipseState, *grid->c_grid()));
         // check_well_controls = param.getDefault("check_well_controls", false);
@@ -249,6 +258,7 @@ try
         // Use timer for last epoch to obtain total time.
         simtimer.init(timeMap);
         const double total_time = simtimer.totalTime();
+        WellsManager wells;
         for (size_t reportStepIdx = 0; reportStepIdx < timeMap->numTimesteps(); ++reportStepIdx) {
             // Update the timer.
             simtimer.setCurrentStepNum(step);
@@ -259,13 +269,13 @@ try
                       << "\n                  (number of time steps: "
                       << simtimer.numSteps() - step << ")\n\n" << std::flush;
 
-            // Create new wells, well_state
-            WellsManager wells(eclipseState , reportStepIdx , *grid->c_grid(), props->permeability());
-            // @@@ HACK: we should really make a new well state and
-            // properly transfer old well state to it every report step,
-            // since number of wells may change etc.
-            if (reportStepIdx == 0) {
-                well_state.init(wells.c_wells(), state);
+            // Update wells, well_state
+            wells.update(eclipseState , reportStepIdx , *grid->c_grid(), props->permeability(),
+                         cartesian_index);
+            // Carry the well state over to the wells of this report step.
+            {
+                const WellState prev_well_state = well_state;
+                well_state.init(wells.c_wells(), wells.wellIds(), state, prev_well_state);
             }
 
             // Create and run simulator.
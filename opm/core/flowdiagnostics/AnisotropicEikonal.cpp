@@ -22,7 +22,8 @@
 #include <opm/core/grid.h>
 #include <opm/core/utility/RootFinders.hpp>
 
-#if BOOST_HEAP_AVAILABLE
+#include <algorithm>
+#include <cmath>
 
 namespace Opm
 {
@@ -30,26 +31,72 @@ namespace Opm
     namespace
     {
         /// Euclidean (isotropic) distance.
-        double distanceIso(const double v1[2],
-                           const double v2[2])
+        double distanceIso(const double* v1,
+                           const double* v2,
+                           const int dim)
         {
-            const double d[2] = { v2[0] - v1[0], v2[1] - v1[1] };
-            const double dist = std::sqrt(d[0]*d[0] + d[1]*d[1]);
-            return dist;
+            double dist2 = 0.0;
+            for (int dd = 0; dd < dim; ++dd) {
+                const double d = v2[dd] - v1[dd];
+                dist2 += d*d;
+            }
+            return std::sqrt(dist2);
         }
 
         /// Anisotropic distance with respect to a metric g.
         /// If d = v2 - v1, the distance is sqrt(d^T g d).
-        double distanceAniso(const double v1[2],
-                             const double v2[2],
-                             const double g[4])
+        double distanceAniso(const double* v1,
+                             const double* v2,
+                             const double* g,
+                             const int dim)
+        {
+            double d[3];
+            for (int dd = 0; dd < dim; ++dd) {
+                d[dd] = v2[dd] - v1[dd];
+            }
+            double dist2 = 0.0;
+            for (int ii = 0; ii < dim; ++ii) {
+                for (int jj = 0; jj < dim; ++jj) {
+                    dist2 += g[dim*ii + jj] * d[ii] * d[jj];
+                }
+            }
+            return std::sqrt(dist2);
+        }
+
+        /// Eigenvalues of a symmetric 3x3 matrix, using the
+        /// trigonometric method (O.K. Smith, 1961).
+        void symmetricEigenvalues3d(const double* m,
+                                    double* eig)
         {
-            const double d[2] = { v2[0] - v1[0], v2[1] - v1[1] };
-            const double dist = std::sqrt(+ g[0] * d[0] * d[0]
-                                          + g[1] * d[0] * d[1]
-                                          + g[2] * d[1] * d[0]
-                                          + g[3] * d[1] * d[1]);
-            return dist;
+            const double p1 = m[1]*m[1] + m[2]*m[2] + m[5]*m[5];
+            const double q = (m[0] + m[4] + m[8])/3.0;
+            if (p1 == 0.0) {
+                // Diagonal matrix.
+                eig[0] = m[0];
+                eig[1] = m[4];
+                eig[2] = m[8];
+                return;
+            }
+            const double p2 = (m[0] - q)*(m[0] - q) + (m[4] - q)*(m[4] - q)
+                + (m[8] - q)*(m[8] - q) + 2.0*p1;
+            const double p = std::sqrt(p2/6.0);
+            // B = (M - qI)/p, r = det(B)/2.
+            double b[9];
+            for (int ii = 0; ii < 9; ++ii) {
+                b[ii] = m[ii]/p;
+            }
+            b[0] -= q/p;
+            b[4] -= q/p;
+            b[8] -= q/p;
+            const double detb = b[0]*(b[4]*b[8] - b[5]*b[7])
+                - b[1]*(b[3]*b[8] - b[5]*b[6])
+                + b[2]*(b[3]*b[7] - b[4]*b[6]);
+            const double r = std::max(-1.0, std::min(1.0, detb/2.0));
+            const double pi = 3.14159265358979323846;
+            const double phi = std::acos(r)/3.0;
+            eig[0] = q + 2.0*p*std::cos(phi);
+            eig[2] = q + 2.0*p*std::cos(phi + 2.0*pi/3.0);
+            eig[1] = 3.0*q - eig[0] - eig[2];
         }
     } // anonymous namespace
 
@@ -59,16 +106,21 @@ namespace Opm
 
 
     /// Construct solver.
-    /// \param[in] grid      A 2d grid.
-    AnisotropicEikonal2d::AnisotropicEikonal2d(const UnstructuredGrid& grid)
+    /// \param[in] grid      A 2d or 3d grid.
+    AnisotropicEikonal::AnisotropicEikonal(const UnstructuredGrid& grid)
         : grid_(grid),
+          dim_(grid.dimensions),
           safety_factor_(1.2)
     {
-        if (grid.dimensions != 2) {
-            OPM_THROW(std::logic_error, "Grid for AnisotropicEikonal2d must be 2d.");
+        if (dim_ != 2 && dim_ != 3) {
+            OPM_THROW(std::logic_error, "Grid for AnisotropicEikonal must be 2d or 3d.");
         }
         cell_neighbours_ = cellNeighboursAcrossVertices(grid);
-        orderCounterClockwise(grid, cell_neighbours_);
+        if (dim_ == 2) {
+            orderCounterClockwise(grid, cell_neighbours_);
+        }
+        // In 3d the neighbours are sorted by cell index, which
+        // isNeighbour() relies on.
         computeGridRadius();
     }
 
@@ -76,9 +128,9 @@ namespace Opm
     /// \param[in]  metric            Array of metric tensors, M, for each cell.
     /// \param[in]  startcells        Array of cells where u = 0 at the centroid.
     /// \param[out] solution          Array of solution to the eikonal equation.
-    void AnisotropicEikonal2d::solve(const double* metric,
-                                     const std::vector<int>& startcells,
-                                     std::vector<double>& solution)
+    void AnisotropicEikonal::solve(const double* metric,
+                                   const std::vector<int>& startcells,
+                                   std::vector<double>& solution)
     {
         // Compute anisotropy ratios to be used by isClose().
         computeAnisoRatio(metric);
@@ -108,11 +160,7 @@ namespace Opm
         solution.resize(num_cells, inf);
         is_accepted_.clear();
         is_accepted_.resize(num_cells, false);
-        accepted_front_.clear();
-        considered_.clear();
-        considered_handles_.clear();
-        is_considered_.clear();
-        is_considered_.resize(num_cells, false);
+        considered_.reset(num_cells);
 
         // 2. Move the startcells to Accepted. U_i = q(x_i)
         const int num_startcells = startcells.size();
@@ -120,7 +168,6 @@ namespace Opm
             is_accepted_[startcells[ii]] = true;
             solution[startcells[ii]] = 0.0;
         }
-        accepted_front_.insert(startcells.begin(), startcells.end());
 
         // 3. Move cells adjacent to startcells to Considered, evaluate
         //    U_i = min_{(x_j,x_k) \in NF(x_i)} G_{j,k}
@@ -129,65 +176,50 @@ namespace Opm
             const int num_nb = cell_neighbours_[scell].size();
             for (int nb = 0; nb < num_nb; ++nb) {
                 const int nb_cell = cell_neighbours_[scell][nb];
-                if (!is_accepted_[nb_cell] && !is_considered_[nb_cell]) {
+                if (!is_accepted_[nb_cell] && !considered_.contains(nb_cell)) {
                     const double value = computeValue(nb_cell, metric, solution.data());
-                    pushConsidered(std::make_pair(value, nb_cell));
+                    considered_.push(value, nb_cell);
                 }
             }
         }
 
         while (!considered_.empty()) {
             // 4. Find the Considered cell with the smallest value: r.
-            const ValueAndCell r = topConsidered();
+            const ValueAndCell r = considered_.top();
             // std::cout << "Accepting cell " << r.second << std::endl;
 
-            // 5. Move cell r to Accepted. Update AcceptedFront.
+            // 5. Move cell r to Accepted. (The AcceptedFront is implicit,
+            //    see the comment for is_accepted_.)
             const int rcell = r.second;
             is_accepted_[rcell] = true;
             solution[rcell] = r.first;
-            popConsidered();
-            accepted_front_.insert(rcell);
-            for (auto it = accepted_front_.begin(); it != accepted_front_.end();) {
-                // Note that loop increment happens in the body of this loop.
-                const int cell = *it;
-                bool on_front = false;
-                for (auto it2 = cell_neighbours_[cell].begin(); it2 != cell_neighbours_[cell].end(); ++it2) {
-                    if (!is_accepted_[*it2]) {
-                        on_front = true;
-                        break;
-                    }
-                }
-                if (!on_front) {
-                    accepted_front_.erase(it++);
-                } else {
-                    ++it;
-                }
-            }
+            considered_.pop();
 
             // 6. Recompute the value for all Considered cells within
             //    distance h * F_2/F1 from x_r. Use min of previous and new.
+            //    Updates are collected first, since modifying the heap
+            //    invalidates its iterators.
+            updates_.clear();
             for (auto it = considered_.begin(); it != considered_.end(); ++it) {
                 const int ccell = it->second;
                 if (isClose(rcell, ccell)) {
                     const double value = computeValueUpdate(ccell, metric, solution.data(), rcell);
                     if (value < it->first) {
-                        // Update value for considered cell.
-                        // Note that as solution values decrease, their
-                        // goodness w.r.t. the heap comparator increase,
-                        // therefore we may safely call the increase()
-                        // modificator below.
-                        considered_.increase(considered_handles_[ccell], std::make_pair(value, ccell));
+                        updates_.push_back(std::make_pair(value, ccell));
                     }
                 }
             }
+            for (auto it = updates_.begin(); it != updates_.end(); ++it) {
+                considered_.decrease(it->second, it->first);
+            }
 
             // 7. Move cells adjacent to r from Far to Considered.
             for (auto it = cell_neighbours_[rcell].begin(); it != cell_neighbours_[rcell].end(); ++it) {
                 const int nb_cell = *it;
-                if (!is_accepted_[nb_cell] && !is_considered_[nb_cell]) {
+                if (!is_accepted_[nb_cell] && !considered_.contains(nb_cell)) {
                     assert(solution[nb_cell] == inf);
                     const double value = computeValue(nb_cell, metric, solution.data());
-                    pushConsidered(std::make_pair(value, nb_cell));
+                    considered_.push(value, nb_cell);
                 }
             }
 
@@ -200,39 +232,65 @@ namespace Opm
 
 
 
-    bool AnisotropicEikonal2d::isClose(const int c1,
-                                       const int c2) const
+    bool AnisotropicEikonal::isClose(const int c1,
+                                     const int c2) const
     {
-        const double* v[] = { grid_.cell_centroids + 2*c1,
-                              grid_.cell_centroids + 2*c2 };
-        return distanceIso(v[0], v[1]) < safety_factor_ * aniso_ratio_[c1] * grid_radius_[c1];
+        const double* v[] = { grid_.cell_centroids + dim_*c1,
+                              grid_.cell_centroids + dim_*c2 };
+        return distanceIso(v[0], v[1], dim_) < safety_factor_ * aniso_ratio_[c1] * grid_radius_[c1];
     }
 
 
 
 
 
-    double AnisotropicEikonal2d::computeValue(const int cell,
-                                              const double* metric,
-                                              const double* solution) const
+    bool AnisotropicEikonal::isNeighbour(const int c1,
+                                         const int c2) const
+    {
+        // Only used in 3d, where neighbours are sorted.
+        const auto& nb = cell_neighbours_[c1];
+        return std::binary_search(nb.begin(), nb.end(), c2);
+    }
+
+
+
+
+
+    double AnisotropicEikonal::computeValue(const int cell,
+                                            const double* metric,
+                                            const double* solution) const
     {
         // std::cout << "++++ computeValue(), cell = " << cell << std::endl;
         const auto& nbs = cell_neighbours_[cell];
         const int num_nbs = nbs.size();
         const double inf = 1e100;
         double val = inf;
-        for (int ii = 0; ii < num_nbs; ++ii) {
-            const int n[2] = { nbs[ii], nbs[(ii+1) % num_nbs] };
-            if (accepted_front_.count(n[0]) && accepted_front_.count(n[1])) {
-                const double cand_val = computeFromTri(cell, n[0], n[1], metric, solution);
-                val = std::min(val, cand_val);
+        if (dim_ == 2) {
+            for (int ii = 0; ii < num_nbs; ++ii) {
+                const int n[2] = { nbs[ii], nbs[(ii+1) % num_nbs] };
+                if (is_accepted_[n[0]] && is_accepted_[n[1]]) {
+                    const double cand_val = computeFromTri(cell, n[0], n[1], metric, solution);
+                    val = std::min(val, cand_val);
+                }
+            }
+        } else {
+            for (int ii = 0; ii < num_nbs; ++ii) {
+                if (!is_accepted_[nbs[ii]]) {
+                    continue;
+                }
+                for (int jj = ii + 1; jj < num_nbs; ++jj) {
+                    if (is_accepted_[nbs[jj]] && isNeighbour(nbs[ii], nbs[jj])) {
+                        const double cand_val = computeFromTri(cell, nbs[ii], nbs[jj], metric, solution);
+                        val = std::min(val, cand_val);
+                    }
+                }
             }
         }
         if (val == inf) {
             // Failed to find two accepted front nodes adjacent to this,
             // so we go for a single-neighbour update.
             for (int ii = 0; ii < num_nbs; ++ii) {
-                if (accepted_front_.count(nbs[ii])) {
+                if (is_accepted_[nbs[ii]]) {
                     const double cand_val = computeFromLine(cell, nbs[ii], metric, solution);
                     val = std::min(val, cand_val);
                 }
@@ -247,29 +305,39 @@ namespace Opm
 
 
 
-    double AnisotropicEikonal2d::computeValueUpdate(const int cell,
-                                                    const double* metric,
-                                                    const double* solution,
-                                                    const int new_cell) const
+    double AnisotropicEikonal::computeValueUpdate(const int cell,
+                                                  const double* metric,
+                                                  const double* solution,
+                                                  const int new_cell) const
     {
         // std::cout << "++++ computeValueUpdate(), cell = " << cell << std::endl;
         const auto& nbs = cell_neighbours_[cell];
         const int num_nbs = nbs.size();
         const double inf = 1e100;
         double val = inf;
-        for (int ii = 0; ii < num_nbs; ++ii) {
-            const int n[2] = { nbs[ii], nbs[(ii+1) % num_nbs] };
-            if ((n[0] == new_cell || n[1] == new_cell)
-                && accepted_front_.count(n[0]) && accepted_front_.count(n[1])) {
-                const double cand_val = computeFromTri(cell, n[0], n[1], metric, solution);
-                val = std::min(val, cand_val);
+        if (dim_ == 2) {
+            for (int ii = 0; ii < num_nbs; ++ii) {
+                const int n[2] = { nbs[ii], nbs[(ii+1) % num_nbs] };
+                if ((n[0] == new_cell || n[1] == new_cell)
+                    && is_accepted_[n[0]] && is_accepted_[n[1]]) {
+                    const double cand_val = computeFromTri(cell, n[0], n[1], metric, solution);
+                    val = std::min(val, cand_val);
+                }
+            }
+        } else if (std::binary_search(nbs.begin(), nbs.end(), new_cell)) {
+            for (int ii = 0; ii < num_nbs; ++ii) {
+                const int other = nbs[ii];
+                if (other != new_cell && is_accepted_[other] && isNeighbour(new_cell, other)) {
+                    const double cand_val = computeFromTri(cell, new_cell, other, metric, solution);
+                    val = std::min(val, cand_val);
+                }
             }
         }
         if (val == inf) {
             // Failed to find two accepted front nodes adjacent to this,
             // so we go for a single-neighbour update.
             for (int ii = 0; ii < num_nbs; ++ii) {
-                if (nbs[ii] == new_cell && accepted_front_.count(nbs[ii])) {
+                if (nbs[ii] == new_cell && is_accepted_[nbs[ii]]) {
                     const double cand_val = computeFromLine(cell, nbs[ii], metric, solution);
                     val = std::min(val, cand_val);
                 }
@@ -283,18 +351,19 @@ namespace Opm
 
 
 
-    double AnisotropicEikonal2d::computeFromLine(const int cell,
-                                                 const int from,
-                                                 const double* metric,
-                                                 const double* solution) const
+    double AnisotropicEikonal::computeFromLine(const int cell,
+                                               const int from,
+                                               const double* metric,
+                                               const double* solution) const
     {
         assert(!is_accepted_[cell]);
         assert(is_accepted_[from]);
         // Applying the first fundamental form to compute geodesic distance.
         // Using the metric of 'cell', not 'from'.
-        const double dist = distanceAniso(grid_.cell_centroids + 2 * cell,
-                                          grid_.cell_centroids + 2 * from,
-                                          metric + 4 * cell);
+        const double dist = distanceAniso(grid_.cell_centroids + dim_ * cell,
+                                          grid_.cell_centroids + dim_ * from,
+                                          metric + dim_ * dim_ * cell,
+                                          dim_);
         return solution[from] + dist;
     }
 
@@ -310,13 +379,24 @@ namespace Opm
         double u1;
         double u2;
         const double* g;
+        int dim;
         double operator()(const double theta) const
         {
-            const double xt[2] = { (1-theta)*x1[0] + theta*x2[0], (1-theta)*x1[1] + theta*x2[1] };
-            const double a[2] = { x[0] - xt[0], x[1] - xt[1] };
-            const double b[2] = { x1[0] - x2[0], x1[1] - x2[1] };
-            const double dQdtheta = 2*(a[0]*b[0]*g[0] + a[0]*b[1]*g[1] + a[1]*b[0]*g[2] + a[1]*b[1]*g[3]);
-            const double val =  u2 - u1 + dQdtheta/(2*distanceAniso(x, xt, g));
+            double xt[3];
+            double a[3];
+            double b[3];
+            for (int dd = 0; dd < dim; ++dd) {
+                xt[dd] = (1-theta)*x1[dd] + theta*x2[dd];
+                a[dd] = x[dd] - xt[dd];
+                b[dd] = x1[dd] - x2[dd];
+            }
+            double dQdtheta = 0.0;
+            for (int ii = 0; ii < dim; ++ii) {
+                for (int jj = 0; jj < dim; ++jj) {
+                    dQdtheta += 2*a[ii]*b[jj]*g[dim*ii + jj];
+                }
+            }
+            const double val =  u2 - u1 + dQdtheta/(2*distanceAniso(x, xt, g, dim));
             // std::cout << theta << "   " << val << std::endl;
             return val;
         }
@@ -326,30 +406,33 @@ namespace Opm
 
 
 
-    double AnisotropicEikonal2d::computeFromTri(const int cell,
-                                                const int n0,
-                                                const int n1,
-                                                const double* metric,
-                                                const double* solution) const
+    double AnisotropicEikonal::computeFromTri(const int cell,
+                                              const int n0,
+                                              const int n1,
+                                              const double* metric,
+                                              const double* solution) const
     {
         // std::cout << "====  cell = " << cell << "   n0 = " << n0 << "   n1 = " << n1 << std::endl;
         assert(!is_accepted_[cell]);
         assert(is_accepted_[n0]);
         assert(is_accepted_[n1]);
         DistanceDerivative dd;
-        dd.x1 = grid_.cell_centroids + 2 * n0;
-        dd.x2 = grid_.cell_centroids + 2 * n1;
-        dd.x = grid_.cell_centroids + 2 * cell;
+        dd.x1 = grid_.cell_centroids + dim_ * n0;
+        dd.x2 = grid_.cell_centroids + dim_ * n1;
+        dd.x = grid_.cell_centroids + dim_ * cell;
         dd.u1 = solution[n0];
         dd.u2 = solution[n1];
-        dd.g = metric + 4 * cell;
+        dd.g = metric + dim_ * dim_ * cell;
+        dd.dim = dim_;
         int iter = 0;
         const double theta = RegulaFalsi<ContinueOnError>::solve(dd, 0.0, 1.0, 15, 1e-8, iter);
-        const double xt[2] = { (1-theta)*dd.x1[0] + theta*dd.x2[0],
-                               (1-theta)*dd.x1[1] + theta*dd.x2[1] };
-        const double d1 = distanceAniso(dd.x1, dd.x, dd.g) + solution[n0];
-        const double d2 = distanceAniso(dd.x2, dd.x, dd.g) + solution[n1];
-        const double dt = distanceAniso(xt, dd.x, dd.g) + (1-theta)*solution[n0] + theta*solution[n1];
+        double xt[3];
+        for (int d = 0; d < dim_; ++d) {
+            xt[d] = (1-theta)*dd.x1[d] + theta*dd.x2[d];
+        }
+        const double d1 = distanceAniso(dd.x1, dd.x, dd.g, dim_) + solution[n0];
+        const double d2 = distanceAniso(dd.x2, dd.x, dd.g, dim_) + solution[n1];
+        const double dt = distanceAniso(xt, dd.x, dd.g, dim_) + (1-theta)*solution[n0] + theta*solution[n1];
         return std::min(d1, std::min(d2, dt));
     }
 
@@ -357,47 +440,17 @@ namespace Opm
 
 
 
-    const AnisotropicEikonal2d::ValueAndCell& AnisotropicEikonal2d::topConsidered() const
-    {
-        return considered_.top();
-    }
-
-
-
-
-
-    void AnisotropicEikonal2d::pushConsidered(const ValueAndCell& vc)
-    {
-        HeapHandle h = considered_.push(vc);
-        considered_handles_[vc.second] = h;
-        is_considered_[vc.second] = true;
-    }
-
-
-
-
-
-    void AnisotropicEikonal2d::popConsidered()
-    {
-        is_considered_[considered_.top().second] = false;
-        considered_handles_.erase(considered_.top().second);
-        considered_.pop();
-    }
-
-
-
-
-    void AnisotropicEikonal2d::computeGridRadius()
+    void AnisotropicEikonal::computeGridRadius()
     {
         const int num_cells = cell_neighbours_.size();
         grid_radius_.resize(num_cells);
         for (int cell = 0; cell < num_cells; ++cell) {
             double radius = 0.0;
-            const double* v1 = grid_.cell_centroids + 2*cell;
+            const double* v1 = grid_.cell_centroids + dim_*cell;
             const auto& nb = cell_neighbours_[cell];
             for (auto it = nb.begin(); it != nb.end(); ++it) {
-                const double* v2 = grid_.cell_centroids + 2*(*it);
-                radius = std::max(radius, distanceIso(v1, v2));
+                const double* v2 = grid_.cell_centroids + dim_*(*it);
+                radius = std::max(radius, distanceIso(v1, v2, dim_));
             }
             grid_radius_[cell] = radius;
         }
@@ -406,19 +459,27 @@ namespace Opm
 
 
 
-    void AnisotropicEikonal2d::computeAnisoRatio(const double* metric)
+    void AnisotropicEikonal::computeAnisoRatio(const double* metric)
     {
         const int num_cells = cell_neighbours_.size();
         aniso_ratio_.resize(num_cells);
         for (int cell = 0; cell < num_cells; ++cell) {
-            const double* m = metric + 4*cell;
-            // Find the two eigenvalues from trace and determinant.
-            const double t = m[0] + m[3];
-            const double d = m[0]*m[3] - m[1]*m[2];
-            const double sd = std::sqrt(t*t/4.0 - d);
-            const double eig[2] = { t/2.0 - sd, t/2.0 + sd };
-            // Anisotropy ratio is the max ratio of the eigenvalues.
-            aniso_ratio_[cell] = std::max(eig[0]/eig[1], eig[1]/eig[0]);
+            const double* m = metric + dim_*dim_*cell;
+            if (dim_ == 2) {
+                // Find the two eigenvalues from trace and determinant.
+                const double t = m[0] + m[3];
+                const double d = m[0]*m[3] - m[1]*m[2];
+                const double sd = std::sqrt(t*t/4.0 - d);
+                const double eig[2] = { t/2.0 - sd, t/2.0 + sd };
+                // Anisotropy ratio is the max ratio of the eigenvalues.
+                aniso_ratio_[cell] = std::max(eig[0]/eig[1], eig[1]/eig[0]);
+            } else {
+                double eig[3];
+                symmetricEigenvalues3d(m, eig);
+                const double emin = std::min(eig[0], std::min(eig[1], eig[2]));
+                const double emax = std::max(eig[0], std::max(eig[1], eig[2]));
+                aniso_ratio_[cell] = emax/emin;
+            }
         }
     }
 
@@ -427,35 +488,3 @@ namespace Opm
 
 
 } // namespace Opm
-
-
-#else // BOOST_HEAP_AVAILABLE is false
-
-namespace {
-    const char* AnisotropicEikonal2derrmsg =
-        "\n********************************************************************************\n"
-        "This library has not been compiled with support for the AnisotropicEikonal2d\n"
-        "class, due to too old version of the boost libraries (Boost.Heap from boost\n"
-        "version 1.49 or newer is required.\n"
-        "To use this class you must recompile opm-core on a system with sufficiently new\n"
-        "version of the boost libraries."
-        "\n********************************************************************************\n";
-}
-
-namespace Opm
-{
-
-    AnisotropicEikonal2d::AnisotropicEikonal2d(const UnstructuredGrid&)
-    {
-        OPM_THROW(std::logic_error, AnisotropicEikonal2derrmsg);
-    }
-
-    void AnisotropicEikonal2d::solve(const double*,
-                                     const std::vector<int>&,
-                                     std::vector<double>&)
-    {
-        OPM_THROW(std::logic_error, AnisotropicEikonal2derrmsg);
-    }
-}
-
-#endif // BOOST_HEAP_AVAILABLE
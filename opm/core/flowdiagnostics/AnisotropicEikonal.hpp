@@ -21,21 +21,8 @@
 #define OPM_ANISOTROPICEIKONAL_HEADER_INCLUDED
 
 #include <opm/core/utility/SparseTable.hpp>
+#include <opm/core/utility/IndexedHeap.hpp>
 #include <vector>
-#include <set>
-#include <map>
-
-#include <opm/core/utility/platform_dependent/disable_warnings.h>
-
-#include <boost/version.hpp>
-
-#define BOOST_HEAP_AVAILABLE ((BOOST_VERSION / 100 % 1000) >= 49)
-
-#if BOOST_HEAP_AVAILABLE
-#include <boost/heap/fibonacci_heap.hpp>
-#endif
-
-#include <opm/core/utility/platform_dependent/reenable_warnings.h>
 
 
 struct UnstructuredGrid;
@@ -47,29 +34,36 @@ namespace Opm
     /// where M(x) is a symmetric positive definite matrix.
     /// The boundary conditions are assumed to be
     ///    \f[ u(x) = 0 \qquad x \in \partial\Omega \f].
-    class AnisotropicEikonal2d
+    /// In 2d, updates are computed from pairs of consecutive
+    /// (counterclockwise) neighbours, in 3d from pairs of neighbours
+    /// that are also neighbours of each other.
+    class AnisotropicEikonal
     {
     public:
         /// Construct solver.
-        /// \param[in] grid      A 2d grid.
-        explicit AnisotropicEikonal2d(const UnstructuredGrid& grid);
+        /// \param[in] grid      A 2d or 3d grid.
+        explicit AnisotropicEikonal(const UnstructuredGrid& grid);
 
         /// Solve the eikonal equation.
         /// \param[in]  metric            Array of metric tensors, M, for each cell.
+        ///                               There are dim*dim values per cell.
         /// \param[in]  startcells        Array of cells where u = 0 at the centroid.
         /// \param[out] solution          Array of solution to the eikonal equation.
         void solve(const double* metric,
                    const std::vector<int>& startcells,
                    std::vector<double>& solution);
     private:
-#if BOOST_HEAP_AVAILABLE
         // Grid and topology.
         const UnstructuredGrid& grid_;
+        const int dim_;
         SparseTable<int> cell_neighbours_;
 
         // Keep track of accepted cells.
+        // Note that we do not need to maintain the accepted front
+        // explicitly: only neighbours of non-accepted cells are ever
+        // tested for membership, and such an accepted cell is always
+        // on the front.
         std::vector<char> is_accepted_;
-        std::set<int> accepted_front_;
 
         // Quantities relating to anisotropy.
         std::vector<double> grid_radius_;
@@ -77,29 +71,25 @@ namespace Opm
         const double safety_factor_;
 
         // Keep track of considered cells.
-        typedef std::pair<double, int> ValueAndCell;
-        typedef boost::heap::compare<std::greater<ValueAndCell>> Comparator;
-        typedef boost::heap::fibonacci_heap<ValueAndCell, Comparator> Heap;
+        typedef IndexedHeap<4> Heap;
+        typedef Heap::Entry ValueAndCell;
         Heap considered_;
-        typedef Heap::handle_type HeapHandle;
-        std::map<int, HeapHandle> considered_handles_;
-        std::vector<char> is_considered_;
+        std::vector<ValueAndCell> updates_;
 
         bool isClose(const int c1, const int c2) const;
+        bool isNeighbour(const int c1, const int c2) const;
         double computeValue(const int cell, const double* metric, const double* solution) const;
         double computeValueUpdate(const int cell, const double* metric, const double* solution, const int new_cell) const;
         double computeFromLine(const int cell, const int from, const double* metric, const double* solution) const;
         double computeFromTri(const int cell, const int n0, const int n1, const double* metric, const double* solution) const;
 
-        const ValueAndCell& topConsidered() const;
-        void pushConsidered(const ValueAndCell& vc);
-        void popConsidered();
-
         void computeGridRadius();
         void computeAnisoRatio(const double* metric);
-#endif // BOOST_HEAP_AVAILABLE
     };
 
+    /// The solver was originally 2d only, this name is kept for compatibility.
+    typedef AnisotropicEikonal AnisotropicEikonal2d;
+
 } // namespace Opm
 
 
@@ -22,11 +22,130 @@
 
 #include <opm/core/utility/ErrorMacros.hpp>
 #include <algorithm>
+#include <cmath>
+#include <limits>
 #include <numeric>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 namespace Opm
 {
 
+    namespace
+    {
+        /// Sort a vector, using several threads if OpenMP is enabled.
+        /// Chunks are sorted in parallel and then merged pairwise, so
+        /// the result is identical to that of std::sort() whenever
+        /// the elements are totally ordered.
+        template <class T>
+        void parallelSort(std::vector<T>& v)
+        {
+#ifdef _OPENMP
+            const int n = v.size();
+            const int num_chunks = omp_get_max_threads();
+            if (num_chunks > 1 && n > 10000) {
+                std::vector<int> bounds(num_chunks + 1);
+                for (int chunk = 0; chunk <= num_chunks; ++chunk) {
+                    bounds[chunk] = static_cast<long long>(n) * chunk / num_chunks;
+                }
+#pragma omp parallel for schedule(static)
+                for (int chunk = 0; chunk < num_chunks; ++chunk) {
+                    std::sort(v.begin() + bounds[chunk], v.begin() + bounds[chunk + 1]);
+                }
+                for (int width = 1; width < num_chunks; width *= 2) {
+#pragma omp parallel for schedule(static)
+                    for (int chunk = 0; chunk < num_chunks; chunk += 2*width) {
+                        if (chunk + width < num_chunks) {
+                            const int last = std::min(chunk + 2*width, num_chunks);
+                            std::inplace_merge(v.begin() + bounds[chunk],
+                                               v.begin() + bounds[chunk + width],
+                                               v.begin() + bounds[last]);
+                        }
+                    }
+                }
+                return;
+            }
+#endif
+            std::sort(v.begin(), v.end());
+        }
+
+
+
+        /// Maps total travel times to bins. The bins are logarithmically
+        /// spaced between the smallest and largest finite times if these
+        /// are positive, otherwise uniformly spaced. Non-finite times,
+        /// such as infinite time-of-flight in cells the flow does not
+        /// reach, do not affect the bins, and must not be passed to bin().
+        class TravelTimeBins
+        {
+        public:
+            TravelTimeBins(const std::vector<double>& ftof,
+                           const std::vector<double>& rtof,
+                           const int num_bins)
+                : num_bins_(num_bins), log_scale_(false), tmin_(0.0), scale_(0.0)
+            {
+                if (num_bins < 1) {
+                    OPM_THROW(std::runtime_error, "Number of travel time bins must be positive.");
+                }
+                const int n = ftof.size();
+                double tmin = std::numeric_limits<double>::max();
+                double tmax = -std::numeric_limits<double>::max();
+                for (int ii = 0; ii < n; ++ii) {
+                    const double t = ftof[ii] + rtof[ii];
+                    if (std::isfinite(t)) {
+                        tmin = std::min(tmin, t);
+                        tmax = std::max(tmax, t);
+                    }
+                }
+                if (tmax > tmin) {
+                    log_scale_ = (tmin > 0.0);
+                    tmin_ = log_scale_ ? std::log(tmin) : tmin;
+                    const double tmax_scaled = log_scale_ ? std::log(tmax) : tmax;
+                    scale_ = num_bins / (tmax_scaled - tmin_);
+                }
+            }
+
+            int bin(const double t) const
+            {
+                const double ts = log_scale_ ? std::log(t) : t;
+                const int b = static_cast<int>((ts - tmin_) * scale_);
+                return std::max(0, std::min(b, num_bins_ - 1));
+            }
+
+        private:
+            int num_bins_;
+            bool log_scale_;
+            double tmin_;
+            double scale_;
+        };
+
+
+
+        /// Turn binned pore volumes and fluxes into normalized F and Phi curves.
+        std::pair<std::vector<double>, std::vector<double>>
+        binsToFandPhi(const double* bin_pv,
+                      const double* bin_flux,
+                      const int num_bins)
+        {
+            std::vector<double> F(num_bins + 1, 0.0);
+            std::vector<double> Phi(num_bins + 1, 0.0);
+            for (int b = 0; b < num_bins; ++b) {
+                F[b+1] = F[b] + bin_flux[b];
+                Phi[b+1] = Phi[b] + bin_pv[b];
+            }
+            const double ft = F.back();
+            const double vt = Phi.back();
+            for (int b = 1; b < num_bins + 1; ++b) {
+                F[b] /= ft;
+                Phi[b] /= vt;
+            }
+            return std::make_pair(F, Phi);
+        }
+    } // anonymous namespace
+
+
 
     /// \brief Compute flow-capacity/storage-capacity based on time-of-flight.
     ///
@@ -52,11 +171,12 @@ namespace Opm
         const int n = pv.size();
         typedef std::pair<double, double> D2;
         std::vector<D2> time_and_pv(n);
+#pragma omp parallel for schedule(static)
         for (int ii = 0; ii < n; ++ii) {
             time_and_pv[ii].first = ftof[ii] + rtof[ii]; // Total travel time.
             time_and_pv[ii].second = pv[ii];
         }
-        std::sort(time_and_pv.begin(), time_and_pv.end());
+        parallelSort(time_and_pv);
 
         // Compute Phi.
         std::vector<double> Phi(n + 1);
@@ -89,6 +209,73 @@ namespace Opm
 
 
 
+    /// \brief Compute an approximate F-Phi curve with a fixed number of points.
+    ///
+    /// Instead of sorting all cells by total travel time, the cells are
+    /// accumulated into num_bins bins of total travel time (logarithmically
+    /// spaced when all times are positive), in a single pass over the input.
+    /// Since the bins are ordered by time, the returned curve is exact at the
+    /// bin boundaries, and the only approximation is that the curve is linear
+    /// between them. The output can be passed to computeLorenz() and
+    /// computeSweep() like the output of computeFandPhi().
+    /// Cells with non-finite travel time are left out. If there are no
+    /// cells with finite travel time, both curves are zero.
+    ///
+    /// \param[in]  pv        pore volumes of each cell
+    /// \param[in]  ftof      forward (time from injector) time-of-flight values for each cell
+    /// \param[in]  rtof      reverse (time to producer) time-of-flight values for each cell
+    /// \param[in]  num_bins  number of travel time bins, the curves will have num_bins + 1 points
+    /// \return               a pair of vectors, the first containing F (flow capacity) the second
+    ///                       containing Phi (storage capacity).
+    std::pair<std::vector<double>, std::vector<double>> computeFandPhiBinned(const std::vector<double>& pv,
+                                                                             const std::vector<double>& ftof,
+                                                                             const std::vector<double>& rtof,
+                                                                             const int num_bins)
+    {
+        if (pv.size() != ftof.size() || pv.size() != rtof.size()) {
+            OPM_THROW(std::runtime_error, "computeFandPhiBinned(): Input vectors must have same size.");
+        }
+        const TravelTimeBins bins(ftof, rtof, num_bins);
+        const int n = pv.size();
+
+        // Accumulate pore volume and flux per bin, using
+        // thread-local bins that are summed at the end.
+        std::vector<double> bin_pv(num_bins, 0.0);
+        std::vector<double> bin_flux(num_bins, 0.0);
+#pragma omp parallel
+        {
+            std::vector<double> local_pv(num_bins, 0.0);
+            std::vector<double> local_flux(num_bins, 0.0);
+#pragma omp for schedule(static)
+            for (int ii = 0; ii < n; ++ii) {
+                const double t = ftof[ii] + rtof[ii];
+                if (!std::isfinite(t)) {
+                    continue;
+                }
+                const int b = bins.bin(t);
+                local_pv[b] += pv[ii];
+                local_flux[b] += pv[ii] / t;
+            }
+#pragma omp critical
+            {
+                for (int b = 0; b < num_bins; ++b) {
+                    bin_pv[b] += local_pv[b];
+                    bin_flux[b] += local_flux[b];
+                }
+            }
+        }
+
+        if (std::accumulate(bin_pv.begin(), bin_pv.end(), 0.0) == 0.0) {
+            const std::vector<double> zero(num_bins + 1, 0.0);
+            return std::make_pair(zero, zero);
+        }
+        return binsToFandPhi(bin_pv.data(), bin_flux.data(), num_bins);
+    }
+
+
+
+
+
     /// \brief Compute the Lorenz coefficient based on the F-Phi curve.
     ///
     /// The Lorenz coefficient is a measure of heterogeneity. It is equal
@@ -223,4 +410,105 @@ namespace Opm
 
 
 
+
+
+    /// \brief Compute approximate F-Phi curves for all injector-producer pairs.
+    ///
+    /// Each cell contributes to the curve of an injector-producer pair with its
+    /// pore volume weighted by the product of the pair's tracer values, as in
+    /// computeWellPairs(). The curves are computed in one pass over the cells,
+    /// using the travel time bins described for computeFandPhiBinned().
+    ///
+    /// \param[in]  wells       wells structure, containing NI injector wells and NP producer wells.
+    /// \param[in]  porevol     pore volume of each grid cell
+    /// \param[in]  ftof        forward (time from injector) time-of-flight values for each cell
+    /// \param[in]  rtof        reverse (time to producer) time-of-flight values for each cell
+    /// \param[in]  ftracer     array of forward (injector) tracer values, NI per cell
+    /// \param[in]  btracer     array of backward (producer) tracer values, NP per cell
+    /// \param[in]  num_bins    number of travel time bins, each curve will have num_bins + 1 points
+    /// \return                 a vector with one (F, Phi) pair for each injector-producer pair,
+    ///                         in the same order as returned by computeWellPairs(). Pairs
+    ///                         with no associated pore volume get empty curves.
+    std::vector<std::pair<std::vector<double>, std::vector<double>>>
+    computeWellPairFandPhi(const Wells& wells,
+                           const std::vector<double>& porevol,
+                           const std::vector<double>& ftof,
+                           const std::vector<double>& rtof,
+                           const std::vector<double>& ftracer,
+                           const std::vector<double>& btracer,
+                           const int num_bins)
+    {
+        // Count injectors and producers.
+        int num_inj = 0;
+        const int nw = wells.number_of_wells;
+        for (int w = 0; w < nw; ++w) {
+            if (wells.type[w] == INJECTOR) {
+                ++num_inj;
+            }
+        }
+        const int num_prod = nw - num_inj;
+
+        // Check sizes of input arrays.
+        const int nc = porevol.size();
+        if (ftof.size() != porevol.size() || rtof.size() != porevol.size()) {
+            OPM_THROW(std::runtime_error, "computeWellPairFandPhi(): wrong size of input array ftof or rtof.");
+        }
+        if (nc * num_inj != int(ftracer.size())) {
+            OPM_THROW(std::runtime_error, "computeWellPairFandPhi(): wrong size of input array ftracer.");
+        }
+        if (nc * num_prod != int(btracer.size())) {
+            OPM_THROW(std::runtime_error, "computeWellPairFandPhi(): wrong size of input array btracer.");
+        }
+        const TravelTimeBins bins(ftof, rtof, num_bins);
+
+        // Accumulate pore volume and flux per pair and bin.
+        const int num_pairs = num_inj * num_prod;
+        std::vector<double> bin_pv(num_pairs * num_bins, 0.0);
+        std::vector<double> bin_flux(num_pairs * num_bins, 0.0);
+#pragma omp parallel
+        {
+            std::vector<double> local_pv(num_pairs * num_bins, 0.0);
+            std::vector<double> local_flux(num_pairs * num_bins, 0.0);
+#pragma omp for schedule(static)
+            for (int c = 0; c < nc; ++c) {
+                const double t = ftof[c] + rtof[c];
+                if (!std::isfinite(t)) {
+                    continue;
+                }
+                const int b = bins.bin(t);
+                for (int inj_ix = 0; inj_ix < num_inj; ++inj_ix) {
+                    const double fpv = porevol[c] * ftracer[num_inj * c + inj_ix];
+                    if (fpv == 0.0) {
+                        continue;
+                    }
+                    for (int prod_ix = 0; prod_ix < num_prod; ++prod_ix) {
+                        const double assoc_pv = fpv * btracer[num_prod * c + prod_ix];
+                        const int pos = (inj_ix * num_prod + prod_ix) * num_bins + b;
+                        local_pv[pos] += assoc_pv;
+                        local_flux[pos] += assoc_pv / t;
+                    }
+                }
+            }
+#pragma omp critical
+            {
+                for (int pos = 0; pos < num_pairs * num_bins; ++pos) {
+                    bin_pv[pos] += local_pv[pos];
+                    bin_flux[pos] += local_flux[pos];
+                }
+            }
+        }
+
+        // Create curves, in the order used by computeWellPairs().
+        std::vector<std::pair<std::vector<double>, std::vector<double>>> result(num_pairs);
+        for (int pair = 0; pair < num_pairs; ++pair) {
+            const double* ppv = &bin_pv[pair * num_bins];
+            if (std::accumulate(ppv, ppv + num_bins, 0.0) > 0.0) {
+                result[pair] = binsToFandPhi(ppv, &bin_flux[pair * num_bins], num_bins);
+            }
+        }
+        return result;
+    }
+
+
+
 } // namespace Opm
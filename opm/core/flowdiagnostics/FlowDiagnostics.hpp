@@ -48,6 +48,31 @@ namespace Opm
                    const std::vector<double>& rtof);
 
 
+    /// \brief Compute an approximate F-Phi curve with a fixed number of points.
+    ///
+    /// Instead of sorting all cells by total travel time, the cells are
+    /// accumulated into num_bins bins of total travel time (logarithmically
+    /// spaced when all times are positive), in a single pass over the input.
+    /// Since the bins are ordered by time, the returned curve is exact at the
+    /// bin boundaries, and the only approximation is that the curve is linear
+    /// between them. The output can be passed to computeLorenz() and
+    /// computeSweep() like the output of computeFandPhi().
+    /// Cells with non-finite travel time are left out. If there are no
+    /// cells with finite travel time, both curves are zero.
+    ///
+    /// \param[in]  pv        pore volumes of each cell
+    /// \param[in]  ftof      forward (time from injector) time-of-flight values for each cell
+    /// \param[in]  rtof      reverse (time to producer) time-of-flight values for each cell
+    /// \param[in]  num_bins  number of travel time bins, the curves will have num_bins + 1 points
+    /// \return               a pair of vectors, the first containing F (flow capacity) the second
+    ///                       containing Phi (storage capacity).
+    std::pair<std::vector<double>, std::vector<double>>
+    computeFandPhiBinned(const std::vector<double>& pv,
+                         const std::vector<double>& ftof,
+                         const std::vector<double>& rtof,
+                         const int num_bins);
+
+
     /// \brief Compute the Lorenz coefficient based on the F-Phi curve.
     ///
     /// The Lorenz coefficient is a measure of heterogeneity. It is equal
@@ -98,6 +123,33 @@ namespace Opm
                      const std::vector<double>& ftracer,
                      const std::vector<double>& btracer);
 
+
+    /// \brief Compute approximate F-Phi curves for all injector-producer pairs.
+    ///
+    /// Each cell contributes to the curve of an injector-producer pair with its
+    /// pore volume weighted by the product of the pair's tracer values, as in
+    /// computeWellPairs(). The curves are computed in one pass over the cells,
+    /// using the travel time bins described for computeFandPhiBinned().
+    ///
+    /// \param[in]  wells       wells structure, containing NI injector wells and NP producer wells.
+    /// \param[in]  porevol     pore volume of each grid cell
+    /// \param[in]  ftof        forward (time from injector) time-of-flight values for each cell
+    /// \param[in]  rtof        reverse (time to producer) time-of-flight values for each cell
+    /// \param[in]  ftracer     array of forward (injector) tracer values, NI per cell
+    /// \param[in]  btracer     array of backward (producer) tracer values, NP per cell
+    /// \param[in]  num_bins    number of travel time bins, each curve will have num_bins + 1 points
+    /// \return                 a vector with one (F, Phi) pair for each injector-producer pair,
+    ///                         in the same order as returned by computeWellPairs(). Pairs
+    ///                         with no associated pore volume get empty curves.
+    std::vector<std::pair<std::vector<double>, std::vector<double>>>
+    computeWellPairFandPhi(const Wells& wells,
+                           const std::vector<double>& porevol,
+                           const std::vector<double>& ftof,
+                           const std::vector<double>& rtof,
+                           const std::vector<double>& ftracer,
+                           const std::vector<double>& btracer,
+                           const int num_bins);
+
 } // namespace Opm
 
 #endif // OPM_FLOWDIAGNOSTICS_HEADER_INCLUDED
@@ -49,7 +49,8 @@ namespace Opm
           limiter_usage_(DuringComputations),
           coord_(grid.dimensions),
           velocity_(grid.dimensions),
-          gauss_seidel_tol_(1e-3)
+          gauss_seidel_tol_(1e-3),
+          use_quad_cache_(false)
     {
         const int dg_degree = param.getDefault("dg_degree", 0);
         const bool use_tensorial_basis = param.getDefault("use_tensorial_basis", false);
@@ -96,6 +97,32 @@ namespace Opm
         } else {
             velocity_interpolation_.reset(new VelocityInterpolationConstant(grid_));
         }
+
+        use_quad_cache_ = param.getDefault("use_quadrature_cache", use_quad_cache_);
+        const CachedCell not_cached = { 0, -1, 0, 0 };
+        qc_cell_.resize(use_quad_cache_ ? grid_.number_of_cells : 1, not_cached);
+        const int num_hfaces = grid_.cell_facepos[grid_.number_of_cells];
+        qc_hface_start_.resize(num_hfaces, 0);
+        qc_hface_num_.resize(num_hfaces, 0);
+    }
+
+
+
+
+    /// Memory used by the quadrature cache, in bytes.
+    std::size_t TofDiscGalReorder::quadratureCacheMemoryUsage() const
+    {
+        if (!use_quad_cache_) {
+            return 0;
+        }
+        std::size_t bytes = qc_cell_.capacity()*sizeof(CachedCell);
+        bytes += (qc_hface_start_.capacity() + qc_hface_num_.capacity())*sizeof(int);
+        bytes += (qc_rhs_weight_.capacity() + qc_rhs_basis_.capacity()
+                  + qc_jac_weight_.capacity() + qc_jac_coord_.capacity()
+                  + qc_jac_basis_.capacity() + qc_jac_grad_basis_.capacity()
+                  + qc_face_weight_.capacity() + qc_face_basis_.capacity()
+                  + qc_face_basis_nb_.capacity())*sizeof(double);
+        return bytes;
     }
 
 
@@ -331,23 +358,119 @@ namespace Opm
 
 
 
+    // Computes quadrature points, weights and basis function values
+    // for the cell and its faces, and appends them to the qc_* arrays.
+    // If the quadrature cache is not used, the arrays are emptied first,
+    // so they only contain data for this cell, and basis functions of
+    // neighbouring cells are only evaluated on inflow faces.
+    void TofDiscGalReorder::cacheQuadrature(const int cell)
+    {
+        const int num_basis = basis_func_->numBasisFunc();
+        const int dim = grid_.dimensions;
+        const int degree = basis_func_->degree();
+
+        if (!use_quad_cache_) {
+            qc_rhs_weight_.clear();
+            qc_rhs_basis_.clear();
+            qc_jac_weight_.clear();
+            qc_jac_coord_.clear();
+            qc_jac_basis_.clear();
+            qc_jac_grad_basis_.clear();
+            qc_face_weight_.clear();
+            qc_face_basis_.clear();
+            qc_face_basis_nb_.clear();
+        }
+
+        CachedCell& cc = qc_cell_[use_quad_cache_ ? cell : 0];
+
+        // Cell quadrature for the residual, degree of precision D.
+        {
+            CellQuadrature quad(grid_, cell, degree);
+            cc.rhs_start = qc_rhs_weight_.size();
+            cc.num_rhs = quad.numQuadPts();
+            qc_rhs_basis_.resize(num_basis*(cc.rhs_start + cc.num_rhs));
+            for (int quad_pt = 0; quad_pt < cc.num_rhs; ++quad_pt) {
+                quad.quadPtCoord(quad_pt, &coord_[0]);
+                qc_rhs_weight_.push_back(quad.quadPtWeight(quad_pt));
+                basis_func_->eval(cell, &coord_[0], &qc_rhs_basis_[num_basis*(cc.rhs_start + quad_pt)]);
+            }
+        }
+
+        // Cell quadrature for the jacobian, degree of precision 2*D.
+        // See the comment in cellContribs() for the choice of degree.
+        {
+            CellQuadrature quad(grid_, cell, 2*degree);
+            cc.jac_start = qc_jac_weight_.size();
+            cc.num_jac = quad.numQuadPts();
+            const int end = cc.jac_start + cc.num_jac;
+            qc_jac_coord_.resize(dim*end);
+            qc_jac_basis_.resize(num_basis*end);
+            qc_jac_grad_basis_.resize(num_basis*dim*end);
+            for (int quad_pt = 0; quad_pt < cc.num_jac; ++quad_pt) {
+                const int pt = cc.jac_start + quad_pt;
+                quad.quadPtCoord(quad_pt, &qc_jac_coord_[dim*pt]);
+                qc_jac_weight_.push_back(quad.quadPtWeight(quad_pt));
+                basis_func_->eval(cell, &qc_jac_coord_[dim*pt], &qc_jac_basis_[num_basis*pt]);
+                basis_func_->evalGrad(cell, &qc_jac_coord_[dim*pt], &qc_jac_grad_basis_[num_basis*dim*pt]);
+            }
+        }
+
+        // Face quadratures, degree of precision 2*D.
+        for (int hface = grid_.cell_facepos[cell]; hface < grid_.cell_facepos[cell+1]; ++hface) {
+            const int face = grid_.cell_faces[hface];
+            const int other_cell = (cell == grid_.face_cells[2*face])
+                ? grid_.face_cells[2*face+1] : grid_.face_cells[2*face];
+            bool need_other = (other_cell >= 0);
+            if (need_other && !use_quad_cache_) {
+                const double flux = (cell == grid_.face_cells[2*face])
+                    ? darcyflux_[face] : -darcyflux_[face];
+                need_other = (flux < 0.0);
+            }
+            FaceQuadrature quad(grid_, face, 2*degree);
+            const int start = qc_face_weight_.size();
+            const int num_pts = quad.numQuadPts();
+            qc_hface_start_[hface] = start;
+            qc_hface_num_[hface] = num_pts;
+            qc_face_basis_.resize(num_basis*(start + num_pts));
+            qc_face_basis_nb_.resize(num_basis*(start + num_pts), 0.0);
+            for (int quad_pt = 0; quad_pt < num_pts; ++quad_pt) {
+                const int pt = start + quad_pt;
+                quad.quadPtCoord(quad_pt, &coord_[0]);
+                qc_face_weight_.push_back(quad.quadPtWeight(quad_pt));
+                basis_func_->eval(cell, &coord_[0], &qc_face_basis_[num_basis*pt]);
+                if (need_other) {
+                    basis_func_->eval(other_cell, &coord_[0], &qc_face_basis_nb_[num_basis*pt]);
+                }
+            }
+        }
+    }
+
+
+
+
     void TofDiscGalReorder::cellContribs(const int cell)
     {
         const int num_basis = basis_func_->numBasisFunc();
         const int dim = grid_.dimensions;
 
+        // Quadrature data for this cell and its faces, used
+        // here and in faceContribs().
+        const int cc_index = use_quad_cache_ ? cell : 0;
+        if (!use_quad_cache_ || qc_cell_[cc_index].num_rhs < 0) {
+            cacheQuadrature(cell);
+        }
+        const CachedCell& cc = qc_cell_[cc_index];
+
         // Compute cell residual contribution.
         {
-            const int deg_needed = basis_func_->degree();
-            CellQuadrature quad(grid_, cell, deg_needed);
-            for (int quad_pt = 0; quad_pt < quad.numQuadPts(); ++quad_pt) {
+            const double pv_density = porevolume_[cell] / grid_.cell_volumes[cell];
+            for (int pt = cc.rhs_start; pt < cc.rhs_start + cc.num_rhs; ++pt) {
                 // Integral of: b_i \phi
-                quad.quadPtCoord(quad_pt, &coord_[0]);
-                basis_func_->eval(cell, &coord_[0], &basis_[0]);
-                const double w = quad.quadPtWeight(quad_pt);
+                const double* basis = &qc_rhs_basis_[num_basis*pt];
+                const double w = qc_rhs_weight_[pt];
                 for (int j = 0; j < num_basis; ++j) {
                     // Only adding to the tof rhs.
-                    rhs_[j] += w * basis_[j] * porevolume_[cell] / grid_.cell_volumes[cell];
+                    rhs_[j] += w * basis[j] * pv_density;
                 }
             }
         }
@@ -363,20 +486,17 @@ namespace Opm
             // has significantly lower error with degree of precision 2.
             // For now, we err on the side of caution, and use 2*degree, even
             // though this is wasteful for the pure linear basis functions.
-            // const int deg_needed = 2*basis_func_->degree() - 1;
-            const int deg_needed = 2*basis_func_->degree();
-            CellQuadrature quad(grid_, cell, deg_needed);
-            for (int quad_pt = 0; quad_pt < quad.numQuadPts(); ++quad_pt) {
+            // (The degree is chosen in cacheQuadrature().)
+            for (int pt = cc.jac_start; pt < cc.jac_start + cc.num_jac; ++pt) {
                 // b_i (v \cdot \grad b_j)
-                quad.quadPtCoord(quad_pt, &coord_[0]);
-                basis_func_->eval(cell, &coord_[0], &basis_[0]);
-                basis_func_->evalGrad(cell, &coord_[0], &grad_basis_[0]);
-                velocity_interpolation_->interpolate(cell, &coord_[0], &velocity_[0]);
-                const double w = quad.quadPtWeight(quad_pt);
+                const double* basis = &qc_jac_basis_[num_basis*pt];
+                const double* grad_basis = &qc_jac_grad_basis_[num_basis*dim*pt];
+                velocity_interpolation_->interpolate(cell, &qc_jac_coord_[dim*pt], &velocity_[0]);
+                const double w = qc_jac_weight_[pt];
                 for (int j = 0; j < num_basis; ++j) {
                     for (int i = 0; i < num_basis; ++i) {
                         for (int dd = 0; dd < dim; ++dd) {
-                            jac_[j*num_basis + i] -= w * basis_[j] * grad_basis_[dim*i + dd] * velocity_[dd];
+                            jac_[j*num_basis + i] -= w * basis[j] * grad_basis[dim*i + dd] * velocity_[dd];
                         }
                     }
                 }
@@ -394,14 +514,12 @@ namespace Opm
             const double flux_density = flux / grid_.cell_volumes[cell];
             // Do quadrature over the cell to compute
             // \int_{K} b_i flux b_j dx
-            CellQuadrature quad(grid_, cell, 2*basis_func_->degree());
-            for (int quad_pt = 0; quad_pt < quad.numQuadPts(); ++quad_pt) {
-                quad.quadPtCoord(quad_pt, &coord_[0]);
-                basis_func_->eval(cell, &coord_[0], &basis_[0]);
-                const double w = quad.quadPtWeight(quad_pt);
+            for (int pt = cc.jac_start; pt < cc.jac_start + cc.num_jac; ++pt) {
+                const double* basis = &qc_jac_basis_[num_basis*pt];
+                const double w = qc_jac_weight_[pt];
                 for (int j = 0; j < num_basis; ++j) {
                     for (int i = 0; i < num_basis; ++i) {
-                        jac_[j*num_basis + i] += w * basis_[i] * flux_density * basis_[j];
+                        jac_[j*num_basis + i] += w * basis[i] * flux_density * basis[j];
                     }
                 }
             }
@@ -445,26 +563,24 @@ namespace Opm
             // velocity is constant (this assumption may have to go
             // for higher order than DG1).
             const double normal_velocity = flux / grid_.face_areas[face];
-            const int deg_needed = 2*basis_func_->degree();
-            FaceQuadrature quad(grid_, face, deg_needed);
-            for (int quad_pt = 0; quad_pt < quad.numQuadPts(); ++quad_pt) {
-                quad.quadPtCoord(quad_pt, &coord_[0]);
-                basis_func_->eval(cell, &coord_[0], &basis_[0]);
-                basis_func_->eval(upstream_cell, &coord_[0], &basis_nb_[0]);
-                const double w = quad.quadPtWeight(quad_pt);
+            const int start = qc_hface_start_[hface];
+            for (int pt = start; pt < start + qc_hface_num_[hface]; ++pt) {
+                const double* basis = &qc_face_basis_[num_basis*pt];
+                const double* basis_nb = &qc_face_basis_nb_[num_basis*pt];
+                const double w = qc_face_weight_[pt];
                 // Modify tof rhs
-                const double tof_upstream = std::inner_product(basis_nb_.begin(), basis_nb_.end(),
+                const double tof_upstream = std::inner_product(basis_nb, basis_nb + num_basis,
                                                                tof_coeff_ + num_basis*upstream_cell, 0.0);
                 for (int j = 0; j < num_basis; ++j) {
-                    rhs_[j] -= w * tof_upstream * normal_velocity * basis_[j];
+                    rhs_[j] -= w * tof_upstream * normal_velocity * basis[j];
                 }
                 // Modify tracer rhs
                 if (num_tracers_ && tracerhead_by_cell_[cell] == NoTracerHead) {
                     for (int tr = 0; tr < num_tracers_; ++tr) {
                         const double* up_tr_co = tracer_coeff_ + num_tracers_*num_basis*upstream_cell + num_basis*tr;
-                        const double tracer_up = std::inner_product(basis_nb_.begin(), basis_nb_.end(), up_tr_co, 0.0);
+                        const double tracer_up = std::inner_product(basis_nb, basis_nb + num_basis, up_tr_co, 0.0);
                         for (int j = 0; j < num_basis; ++j) {
-                            rhs_[num_basis*(tr + 1) + j] -= w * tracer_up * normal_velocity * basis_[j];
+                            rhs_[num_basis*(tr + 1) + j] -= w * tracer_up * normal_velocity * basis[j];
                         }
                     }
                 }
@@ -487,15 +603,14 @@ namespace Opm
             // Do quadrature over the face to compute
             // \int_{\partial K} b_i (v(x) \cdot n) b_j ds
             const double normal_velocity = flux / grid_.face_areas[face];
-            FaceQuadrature quad(grid_, face, 2*basis_func_->degree());
-            for (int quad_pt = 0; quad_pt < quad.numQuadPts(); ++quad_pt) {
+            const int start = qc_hface_start_[hface];
+            for (int pt = start; pt < start + qc_hface_num_[hface]; ++pt) {
                 // u^ext flux B   (B = {b_j})
-                quad.quadPtCoord(quad_pt, &coord_[0]);
-                basis_func_->eval(cell, &coord_[0], &basis_[0]);
-                const double w = quad.quadPtWeight(quad_pt);
+                const double* basis = &qc_face_basis_[num_basis*pt];
+                const double w = qc_face_weight_[pt];
                 for (int j = 0; j < num_basis; ++j) {
                     for (int i = 0; i < num_basis; ++i) {
-                        jac_[j*num_basis + i] += w * basis_[i] * normal_velocity * basis_[j];
+                        jac_[j*num_basis + i] += w * basis[i] * normal_velocity * basis[j];
                     }
                 }
             }
@@ -22,6 +22,7 @@
 
 #include <opm/core/transport/reorder/ReorderSolverInterface.hpp>
 #include <memory>
+#include <cstddef>
 #include <vector>
 #include <map>
 #include <ostream>
@@ -71,6 +72,10 @@ namespace Opm
         ///                                             computing (unlimited) solution.
         ///             - AsSimultaneousPostProcess  -- Apply to each cell independently, using un-
         ///                                             limited solution in neighbouring cells.
+        ///   - \c use_quadrature_cache (false)            -- Store quadrature weights and basis function
+        ///                                                   values for each cell and face the first time
+        ///                                                   they are needed, and reuse them in later
+        ///                                                   visits and later calls to solveTof().
         TofDiscGalReorder(const UnstructuredGrid& grid,
                           const parameter::ParameterGroup& param);
 
@@ -117,6 +122,10 @@ namespace Opm
                             std::vector<double>& tof_coeff,
                             std::vector<double>& tracer_coeff);
 
+        /// Memory used by the quadrature cache, in bytes.
+        /// Returns zero unless the use_quadrature_cache parameter was true.
+        std::size_t quadratureCacheMemoryUsage() const;
+
     private:
         virtual void solveSingleCell(const int cell);
         virtual void solveMultiCell(const int num_cells, const int* cells);
@@ -124,6 +133,7 @@ namespace Opm
         void cellContribs(const int cell);
         void faceContribs(const int cell);
         void solveLinearSystem(const int cell);
+        void cacheQuadrature(const int cell);
 
     private:
         // Disable copying and assignment.
@@ -167,6 +177,30 @@ namespace Opm
         int num_multicell_;
         int max_size_multicell_;
         int max_iter_multicell_;
+        // Quadrature cache, used if use_quad_cache_ is true.
+        // A cell's data are appended to the point arrays the first
+        // time the cell is visited, so the storage follows the order
+        // in which the reordering solver visits cells.
+        bool use_quad_cache_;
+        struct CachedCell
+        {
+            int rhs_start;  // first point of degree D cell quadrature
+            int num_rhs;    // number of such points, -1 if not cached
+            int jac_start;  // first point of degree 2*D cell quadrature
+            int num_jac;    // number of such points
+        };
+        std::vector<CachedCell> qc_cell_;       // per cell (a single entry if not caching)
+        std::vector<int> qc_hface_start_;       // per half-face, first face point
+        std::vector<int> qc_hface_num_;         // per half-face, number of face points
+        std::vector<double> qc_rhs_weight_;
+        std::vector<double> qc_rhs_basis_;      // num_basis per point
+        std::vector<double> qc_jac_weight_;
+        std::vector<double> qc_jac_coord_;      // dim per point
+        std::vector<double> qc_jac_basis_;      // num_basis per point
+        std::vector<double> qc_jac_grad_basis_; // num_basis*dim per point
+        std::vector<double> qc_face_weight_;
+        std::vector<double> qc_face_basis_;     // num_basis per point, this cell
+        std::vector<double> qc_face_basis_nb_;  // num_basis per point, other cell (zero on boundary)
 
         // Private methods
 
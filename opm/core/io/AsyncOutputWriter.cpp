@@ -0,0 +1,155 @@
+/*
+  Copyright 2015 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "config.h"
+#include "AsyncOutputWriter.hpp"
+
+#include <opm/core/io/OutputWriter.hpp>
+#include <opm/core/simulator/SimulatorState.hpp>
+#include <opm/core/simulator/SimulatorTimer.hpp>
+#include <opm/core/simulator/WellState.hpp>
+#include <opm/core/utility/ErrorMacros.hpp>
+
+#include <iostream>
+#include <stdexcept>
+
+using namespace Opm;
+
+struct AsyncOutputWriter::Buffer {
+    SimulatorTimer timer;
+    SimulatorState reservoirState;
+    WellState wellState;
+};
+
+AsyncOutputWriter::AsyncOutputWriter (OutputWriter& writer, int num_buffers)
+    : writer_ (writer)
+    , busy_ (false)
+    , stop_ (false) {
+    for (int i = 0; i < num_buffers; ++i) {
+        buffers_.emplace_back (new Buffer);
+        free_.push_back (buffers_.back ().get ());
+    }
+    thread_ = std::thread (&AsyncOutputWriter::run, this);
+}
+
+AsyncOutputWriter::~AsyncOutputWriter () {
+    try {
+        finish ();
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Output writer failed: " << e.what () << std::endl;
+    }
+    catch (...) {
+        std::cerr << "Output writer failed." << std::endl;
+    }
+}
+
+void
+AsyncOutputWriter::writeTimeStep (const SimulatorTimer& timer,
+                                  const SimulatorState& reservoirState,
+                                  const WellState& wellState) {
+    Buffer* buffer;
+    {
+        std::unique_lock <std::mutex> lock (mutex_);
+        if (stop_) {
+            OPM_THROW (std::logic_error, "AsyncOutputWriter::writeTimeStep() called after finish()");
+        }
+        changed_.wait (lock, [this] { return !free_.empty () || error_; });
+        rethrow (lock);
+        buffer = free_.back ();
+        free_.pop_back ();
+    }
+    // the buffer is ours alone until queued
+    buffer->timer = timer;
+    buffer->reservoirState = reservoirState;
+    buffer->wellState = wellState;
+    {
+        std::unique_lock <std::mutex> lock (mutex_);
+        queue_.push_back (buffer);
+    }
+    changed_.notify_all ();
+}
+
+void
+AsyncOutputWriter::flush () {
+    std::unique_lock <std::mutex> lock (mutex_);
+    changed_.wait (lock, [this] { return (queue_.empty () && !busy_) || error_; });
+    rethrow (lock);
+}
+
+void
+AsyncOutputWriter::finish () {
+    stop ();
+    std::unique_lock <std::mutex> lock (mutex_);
+    rethrow (lock);
+}
+
+void
+AsyncOutputWriter::stop () {
+    if (thread_.joinable ()) {
+        {
+            std::unique_lock <std::mutex> lock (mutex_);
+            stop_ = true;
+        }
+        changed_.notify_all ();
+        thread_.join ();
+    }
+}
+
+/// Throw (and forget) the error of the writer thread, if any.
+void
+AsyncOutputWriter::rethrow (std::unique_lock <std::mutex>& lock) {
+    if (error_) {
+        std::exception_ptr error = error_;
+        error_ = nullptr;
+        lock.unlock ();
+        std::rethrow_exception (error);
+    }
+}
+
+void
+AsyncOutputWriter::run () {
+    std::unique_lock <std::mutex> lock (mutex_);
+    for (;;) {
+        changed_.wait (lock, [this] { return !queue_.empty () || stop_; });
+        if (queue_.empty ()) {
+            return; // stopped, and all written
+        }
+        Buffer* buffer = queue_.front ();
+        queue_.pop_front ();
+        busy_ = true;
+        const bool skip = static_cast <bool> (error_);
+        lock.unlock ();
+        if (!skip) {
+            try {
+                writer_.writeTimeStep (buffer->timer, buffer->reservoirState,
+                                       buffer->wellState, false);
+            }
+            catch (...) {
+                lock.lock ();
+                error_ = std::current_exception ();
+                lock.unlock ();
+            }
+        }
+        lock.lock ();
+        busy_ = false;
+        free_.push_back (buffer);
+        changed_.notify_all ();
+    }
+}
@@ -0,0 +1,96 @@
+/*
+  Copyright 2015 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_ASYNC_OUTPUT_WRITER_HPP
+#define OPM_ASYNC_OUTPUT_WRITER_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Opm {
+
+class OutputWriter;
+class SimulatorState;
+class SimulatorTimer;
+class WellState;
+
+/**
+ * Calls the writeTimeStep() of an OutputWriter on a background thread.
+ *
+ * Copies of the timer and states are made into a fixed pool of
+ * buffers, whose capacity is reused from one call to the next; the
+ * number of buffers bounds the number of pending writes, and
+ * writeTimeStep() waits for a free buffer if there is none.
+ *
+ * An exception thrown by the writer is kept and rethrown by the next
+ * call to writeTimeStep(), flush() or finish(); output queued after
+ * the failure is discarded.
+ */
+class AsyncOutputWriter {
+public:
+    /// Start the background thread. The writer must outlive us.
+    AsyncOutputWriter (OutputWriter& writer, int num_buffers);
+
+    /// Write what is still queued and stop the thread. An error not
+    /// yet reported can only be printed to std::cerr here; call
+    /// finish() first to have it thrown.
+    ~AsyncOutputWriter ();
+
+    /// Copy the arguments into a free buffer and queue them.
+    void writeTimeStep (const SimulatorTimer& timer,
+                        const SimulatorState& reservoirState,
+                        const WellState& wellState);
+
+    /// Wait until everything queued has been written.
+    void flush ();
+
+    /// Write everything queued and stop the thread. No more output
+    /// can be queued afterwards.
+    void finish ();
+
+private:
+    struct Buffer;
+
+    AsyncOutputWriter (const AsyncOutputWriter&);
+    AsyncOutputWriter& operator= (const AsyncOutputWriter&);
+
+    void stop ();
+    void rethrow (std::unique_lock <std::mutex>& lock);
+    void run ();
+
+    OutputWriter& writer_;
+    std::vector <std::unique_ptr <Buffer> > buffers_;
+    std::vector <Buffer*> free_;
+    std::deque <Buffer*> queue_;
+    bool busy_;
+    bool stop_;
+    std::exception_ptr error_;
+    std::mutex mutex_;
+    std::condition_variable changed_;
+    std::thread thread_;
+};
+
+} // namespace Opm
+
+#endif /* OPM_ASYNC_OUTPUT_WRITER_HPP */
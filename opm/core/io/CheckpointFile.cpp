@@ -0,0 +1,407 @@
+/*
+  Copyright 2015 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "config.h"
+#include <opm/core/io/CheckpointFile.hpp>
+#include <opm/core/simulator/SimulatorState.hpp>
+#include <opm/core/simulator/SimulatorTimer.hpp>
+#include <opm/core/simulator/WellState.hpp>
+#include <opm/core/utility/ErrorMacros.hpp>
+
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace Opm
+{
+
+    namespace
+    {
+        // File layout, all integers in native byte order:
+        //   header:  magic[8], version (u32), byte order mark (u32),
+        //            number of arrays (u64), reserved (u64)
+        //   entries: name[40], type (u32), reserved (u32), count (u64),
+        //            offset (u64), one per array
+        //   data:    the arrays, each at a 64 byte aligned offset.
+        const char magic[8] = { 'O', 'P', 'M', 'C', 'K', 'P', 'T', '\0' };
+        const std::uint32_t version = 1;
+        const std::uint32_t byte_order_mark = 0x01020304;
+        const std::size_t header_size = 32;
+        const std::size_t entry_size = 64;
+        const std::size_t max_name_size = 39;
+        const std::size_t alignment = 64;
+
+        const std::uint32_t type_int = 1;
+        const std::uint32_t type_double = 2;
+
+        static_assert(sizeof(int) == 4, "Checkpoint files assume 32 bit ints.");
+
+        std::size_t elementSize(const std::uint32_t type)
+        {
+            return type == type_int ? sizeof(int) : sizeof(double);
+        }
+
+        std::uint64_t aligned(const std::uint64_t offset)
+        {
+            return (offset + alignment - 1) / alignment * alignment;
+        }
+
+        template <typename T>
+        void put(std::vector<char>& buf, const std::size_t pos, const T value)
+        {
+            std::memcpy(&buf[pos], &value, sizeof(T));
+        }
+
+        template <typename T>
+        T get(const std::vector<char>& buf, const std::size_t pos)
+        {
+            T value;
+            std::memcpy(&value, &buf[pos], sizeof(T));
+            return value;
+        }
+
+        // Read an array that must have the given number of elements.
+        template <typename T>
+        void readMatching(CheckpointReader& reader, const std::string& name,
+                          const std::size_t expected, std::vector<T>& data)
+        {
+            const std::size_t count = reader.size(name);
+            if (count != expected) {
+                OPM_THROW(std::runtime_error, "Checkpoint array " << name << " has " << count
+                          << " elements, but the state has " << expected);
+            }
+            reader.read(name, data);
+        }
+    } // anonymous namespace
+
+
+
+    void CheckpointWriter::add(const std::string& name, const std::vector<int>& data)
+    {
+        addArray(name, type_int, data.size(), reinterpret_cast<const char*>(data.data()));
+    }
+
+
+
+    void CheckpointWriter::add(const std::string& name, const std::vector<double>& data)
+    {
+        addArray(name, type_double, data.size(), reinterpret_cast<const char*>(data.data()));
+    }
+
+
+
+    void CheckpointWriter::addArray(const std::string& name, const std::uint32_t type,
+                                    const std::uint64_t count, const char* data)
+    {
+        if (name.empty() || name.size() > max_name_size) {
+            OPM_THROW(std::runtime_error, "Invalid checkpoint array name '" << name << "'");
+        }
+        for (std::size_t i = 0; i < arrays_.size(); ++i) {
+            if (arrays_[i].name == name) {
+                OPM_THROW(std::runtime_error, "Checkpoint array " << name << " added twice");
+            }
+        }
+        Array a = { name, type, count, data };
+        arrays_.push_back(a);
+    }
+
+
+
+    void CheckpointWriter::write(const std::string& filename) const
+    {
+        const std::size_t n = arrays_.size();
+        std::vector<char> head(header_size + n*entry_size, '\0');
+        std::memcpy(&head[0], magic, sizeof(magic));
+        put(head, 8, version);
+        put(head, 12, byte_order_mark);
+        put(head, 16, std::uint64_t(n));
+        std::uint64_t offset = aligned(head.size());
+        for (std::size_t i = 0; i < n; ++i) {
+            const std::size_t pos = header_size + i*entry_size;
+            std::memcpy(&head[pos], arrays_[i].name.data(), arrays_[i].name.size());
+            put(head, pos + 40, arrays_[i].type);
+            put(head, pos + 48, arrays_[i].count);
+            put(head, pos + 56, offset);
+            offset = aligned(offset + arrays_[i].count*elementSize(arrays_[i].type));
+        }
+
+        const std::string tmpname = filename + ".tmp";
+        {
+            std::ofstream os(tmpname.c_str(), std::ios::binary | std::ios::trunc);
+            if (!os) {
+                OPM_THROW(std::runtime_error, "Failed to open " << tmpname);
+            }
+            const char zeros[alignment] = { 0 };
+            os.write(head.data(), head.size());
+            std::uint64_t pos = head.size();
+            for (std::size_t i = 0; i < n; ++i) {
+                os.write(zeros, aligned(pos) - pos);
+                const std::uint64_t num_bytes = arrays_[i].count*elementSize(arrays_[i].type);
+                os.write(arrays_[i].data, num_bytes);
+                pos = aligned(pos) + num_bytes;
+            }
+            os.flush();
+            if (!os) {
+                OPM_THROW(std::runtime_error, "Failed to write " << tmpname);
+            }
+        }
+        boost::filesystem::rename(tmpname, filename);
+    }
+
+
+
+    CheckpointReader::CheckpointReader(const std::string& filename)
+        : filename_(filename),
+          file_(filename.c_str(), std::ios::binary)
+    {
+        if (!file_) {
+            OPM_THROW(std::runtime_error, "Failed to open " << filename);
+        }
+        file_.seekg(0, std::ios::end);
+        const std::uint64_t file_size = file_.tellg();
+        file_.seekg(0);
+
+        std::vector<char> head(header_size);
+        file_.read(head.data(), header_size);
+        if (!file_ || std::memcmp(head.data(), magic, sizeof(magic)) != 0) {
+            OPM_THROW(std::runtime_error, filename << " is not a checkpoint file");
+        }
+        if (get<std::uint32_t>(head, 8) != version) {
+            OPM_THROW(std::runtime_error, filename << " has unsupported checkpoint version "
+                      << get<std::uint32_t>(head, 8));
+        }
+        if (get<std::uint32_t>(head, 12) != byte_order_mark) {
+            OPM_THROW(std::runtime_error, filename << " was written with a different byte order");
+        }
+        const std::uint64_t n = get<std::uint64_t>(head, 16);
+        if (n > (file_size - header_size) / entry_size) {
+            OPM_THROW(std::runtime_error, filename << " is truncated");
+        }
+
+        std::vector<char> toc(n*entry_size);
+        file_.read(toc.data(), toc.size());
+        entries_.resize(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            const std::size_t pos = i*entry_size;
+            Entry& e = entries_[i];
+            e.name.assign(&toc[pos], std::find(&toc[pos], &toc[pos] + max_name_size, '\0'));
+            e.type = get<std::uint32_t>(toc, pos + 40);
+            e.count = get<std::uint64_t>(toc, pos + 48);
+            e.offset = get<std::uint64_t>(toc, pos + 56);
+            if ((e.type != type_int && e.type != type_double)
+                || e.offset > file_size
+                || e.count > (file_size - e.offset) / elementSize(e.type)) {
+                OPM_THROW(std::runtime_error, "Invalid or truncated array " << e.name << " in " << filename);
+            }
+        }
+    }
+
+
+
+    bool CheckpointReader::has(const std::string& name) const
+    {
+        for (std::size_t i = 0; i < entries_.size(); ++i) {
+            if (entries_[i].name == name) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+
+
+    std::size_t CheckpointReader::size(const std::string& name) const
+    {
+        return find(name).count;
+    }
+
+
+
+    void CheckpointReader::read(const std::string& name, std::vector<int>& data)
+    {
+        readVector(name, type_int, data);
+    }
+
+
+
+    void CheckpointReader::read(const std::string& name, std::vector<double>& data)
+    {
+        readVector(name, type_double, data);
+    }
+
+
+
+    const CheckpointReader::Entry& CheckpointReader::find(const std::string& name) const
+    {
+        for (std::size_t i = 0; i < entries_.size(); ++i) {
+            if (entries_[i].name == name) {
+                return entries_[i];
+            }
+        }
+        OPM_THROW(std::runtime_error, "No array " << name << " in " << filename_);
+    }
+
+
+
+    template <typename T>
+    void CheckpointReader::readVector(const std::string& name, const std::uint32_t type,
+                                      std::vector<T>& data)
+    {
+        const Entry& e = find(name);
+        if (e.type != type) {
+            OPM_THROW(std::runtime_error, "Array " << name << " in " << filename_
+                      << " has a different element type");
+        }
+        data.resize(e.count);
+        file_.clear();
+        file_.seekg(e.offset);
+        file_.read(reinterpret_cast<char*>(data.data()), e.count*sizeof(T));
+        if (!file_) {
+            OPM_THROW(std::runtime_error, "Failed to read array " << name << " from " << filename_);
+        }
+    }
+
+
+
+    void writeCheckpoint(const std::string& filename,
+                         const SimulatorTimer& timer,
+                         const SimulatorState& state,
+                         const WellState& well_state,
+                         const std::vector<double>& timestep_history)
+    {
+        CheckpointWriter writer;
+
+        std::vector<int> dimensions(3);
+        dimensions[0] = state.numCells();
+        dimensions[1] = state.numFaces();
+        dimensions[2] = state.numPhases();
+        writer.add("state/dimensions", dimensions);
+        for (std::size_t i = 0; i < state.cellData().size(); ++i) {
+            writer.add("cell/" + state.cellDataNames()[i], state.cellData()[i]);
+        }
+        for (std::size_t i = 0; i < state.faceData().size(); ++i) {
+            writer.add("face/" + state.faceDataNames()[i], state.faceData()[i]);
+        }
+
+        writer.add("well/bhp", well_state.bhp());
+        writer.add("well/thp", well_state.thp());
+        writer.add("well/temperature", well_state.temperature());
+        writer.add("well/rates", well_state.wellRates());
+        writer.add("well/perfrates", well_state.perfRates());
+        writer.add("well/perfpress", well_state.perfPress());
+        writer.add("well/ids", well_state.wellIds());
+
+        std::vector<int> step(2);
+        step[0] = timer.currentStepNum();
+        step[1] = timer.numSteps();
+        std::vector<double> time(2);
+        time[0] = timer.simulationTimeElapsed();
+        time[1] = timer.totalTime();
+        writer.add("timer/step", step);
+        writer.add("timer/time", time);
+
+        if (!timestep_history.empty()) {
+            writer.add("timestep/history", timestep_history);
+        }
+
+        writer.write(filename);
+    }
+
+
+
+    void readCheckpoint(const std::string& filename,
+                        SimulatorTimer& timer,
+                        SimulatorState& state,
+                        WellState& well_state,
+                        std::vector<double>* timestep_history)
+    {
+        CheckpointReader reader(filename);
+
+        std::vector<int> dimensions;
+        reader.read("state/dimensions", dimensions);
+        if (dimensions.size() != 3
+            || dimensions[0] != state.numCells()
+            || dimensions[1] != state.numFaces()
+            || dimensions[2] != state.numPhases()) {
+            OPM_THROW(std::runtime_error, "Checkpoint " << filename
+                      << " does not match the grid or phases of the state");
+        }
+        // Everything is read and checked before any of the states or
+        // the timer is changed, so that they are left as they were if
+        // the checkpoint does not match.
+        std::vector<std::vector<double> > cell_data(state.cellData().size());
+        for (std::size_t i = 0; i < cell_data.size(); ++i) {
+            readMatching(reader, "cell/" + state.cellDataNames()[i],
+                         state.cellData()[i].size(), cell_data[i]);
+        }
+        std::vector<std::vector<double> > face_data(state.faceData().size());
+        for (std::size_t i = 0; i < face_data.size(); ++i) {
+            readMatching(reader, "face/" + state.faceDataNames()[i],
+                         state.faceData()[i].size(), face_data[i]);
+        }
+
+        std::vector<double> bhp, thp, temperature, rates, perfrates, perfpress;
+        readMatching(reader, "well/bhp", well_state.bhp().size(), bhp);
+        readMatching(reader, "well/thp", well_state.thp().size(), thp);
+        readMatching(reader, "well/temperature", well_state.temperature().size(), temperature);
+        readMatching(reader, "well/rates", well_state.wellRates().size(), rates);
+        readMatching(reader, "well/perfrates", well_state.perfRates().size(), perfrates);
+        readMatching(reader, "well/perfpress", well_state.perfPress().size(), perfpress);
+        if (!well_state.wellIds().empty()) {
+            std::vector<int> ids;
+            reader.read("well/ids", ids);
+            if (ids != well_state.wellIds()) {
+                OPM_THROW(std::runtime_error, "Checkpoint " << filename
+                          << " was written for other wells");
+            }
+        }
+
+        std::vector<int> step;
+        reader.read("timer/step", step);
+        if (step.size() != 2 || step[1] != timer.numSteps() || step[0] < 0 || step[0] > step[1]) {
+            OPM_THROW(std::runtime_error, "Checkpoint " << filename
+                      << " was written for a different schedule");
+        }
+
+        std::vector<double> history;
+        if (timestep_history && reader.has("timestep/history")) {
+            reader.read("timestep/history", history);
+        }
+
+        for (std::size_t i = 0; i < cell_data.size(); ++i) {
+            state.cellData()[i].swap(cell_data[i]);
+        }
+        for (std::size_t i = 0; i < face_data.size(); ++i) {
+            state.faceData()[i].swap(face_data[i]);
+        }
+        well_state.bhp().swap(bhp);
+        well_state.thp().swap(thp);
+        well_state.temperature().swap(temperature);
+        well_state.wellRates().swap(rates);
+        well_state.perfRates().swap(perfrates);
+        well_state.perfPress().swap(perfpress);
+        timer.setCurrentStepNum(step[0]);
+        if (timestep_history) {
+            timestep_history->swap(history);
+        }
+    }
+
+} // namespace Opm
@@ -0,0 +1,145 @@
+/*
+  Copyright 2015 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_CHECKPOINTFILE_HEADER_INCLUDED
+#define OPM_CHECKPOINTFILE_HEADER_INCLUDED
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace Opm
+{
+
+    class SimulatorState;
+    class SimulatorTimer;
+    class WellState;
+
+    /// Writes named arrays of ints and doubles to a checkpoint file.
+    ///
+    /// The file is laid out for restoring without any parsing: a fixed
+    /// size header and table of contents, followed by the raw arrays
+    /// in native byte order, each starting at a 64 byte aligned offset
+    /// so that the file may also be memory mapped. The arrays are not
+    /// copied; they must stay alive until write() is called.
+    class CheckpointWriter
+    {
+    public:
+        /// Add an array. Names are at most 39 characters and unique.
+        void add(const std::string& name, const std::vector<int>& data);
+        void add(const std::string& name, const std::vector<double>& data);
+
+        /// Write all arrays added so far. The file is first written
+        /// under a temporary name and then renamed, so that an
+        /// existing checkpoint is never left half overwritten.
+        void write(const std::string& filename) const;
+
+    private:
+        struct Array
+        {
+            std::string name;
+            std::uint32_t type;
+            std::uint64_t count;
+            const char* data;
+        };
+        void addArray(const std::string& name, std::uint32_t type,
+                      std::uint64_t count, const char* data);
+        std::vector<Array> arrays_;
+    };
+
+
+
+    /// Reads arrays from a file written by CheckpointWriter. Only the
+    /// header and table of contents are read on construction; each
+    /// array is read directly into its destination by read().
+    class CheckpointReader
+    {
+    public:
+        explicit CheckpointReader(const std::string& filename);
+
+        /// True if the file holds an array of this name.
+        bool has(const std::string& name) const;
+
+        /// Number of elements of an array.
+        std::size_t size(const std::string& name) const;
+
+        /// Read an array, resizing data to fit. Throws if the array
+        /// does not exist or has a different element type.
+        void read(const std::string& name, std::vector<int>& data);
+        void read(const std::string& name, std::vector<double>& data);
+
+    private:
+        struct Entry
+        {
+            std::string name;
+            std::uint32_t type;
+            std::uint64_t count;
+            std::uint64_t offset;
+        };
+        const Entry& find(const std::string& name) const;
+        template <typename T>
+        void readVector(const std::string& name, std::uint32_t type, std::vector<T>& data);
+
+        std::string filename_;
+        std::ifstream file_;
+        std::vector<Entry> entries_;
+    };
+
+
+
+    /// Write a checkpoint of a simulation: all cell and face data of
+    /// the reservoir state, the well state, the position of the timer
+    /// and, optionally, the history of the adaptive time stepping.
+    /// \param[in] filename          checkpoint file, overwritten
+    /// \param[in] timer             timer, at the step to resume from
+    /// \param[in] state             reservoir state, any subclass
+    /// \param[in] well_state        well state
+    /// \param[in] timestep_history  as given by AdaptiveTimeStepping::history(),
+    ///                              not stored if empty
+    void writeCheckpoint(const std::string& filename,
+                         const SimulatorTimer& timer,
+                         const SimulatorState& state,
+                         const WellState& well_state,
+                         const std::vector<double>& timestep_history = std::vector<double>());
+
+    /// Restore a checkpoint written by writeCheckpoint().
+    ///
+    /// The states must already be initialised for the same grid,
+    /// phases and wells as when the checkpoint was written; their
+    /// values are then overwritten. The timer is set to the step of
+    /// the checkpoint and must be set up with the same schedule.
+    /// If the checkpoint does not match, an exception is thrown and
+    /// the states, the timer and the history are left unchanged.
+    /// \param[in]  filename          checkpoint file
+    /// \param[out] timer             timer
+    /// \param[out] state             reservoir state
+    /// \param[out] well_state        well state
+    /// \param[out] timestep_history  if non-null, set to the history of the
+    ///                               adaptive time stepping, empty if none
+    ///                               was stored
+    void readCheckpoint(const std::string& filename,
+                        SimulatorTimer& timer,
+                        SimulatorState& state,
+                        WellState& well_state,
+                        std::vector<double>* timestep_history = 0);
+
+} // namespace Opm
+
+#endif // OPM_CHECKPOINTFILE_HEADER_INCLUDED
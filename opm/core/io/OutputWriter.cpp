@@ -1,7 +1,9 @@
 #include "OutputWriter.hpp"
 
 #include <opm/core/grid.h>
+#include <opm/core/io/eclipse/EclipseNativeWriter.hpp>
 #include <opm/core/io/eclipse/EclipseWriter.hpp>
+#include <opm/core/utility/CompressedCartesianIndex.hpp>
 #include <opm/core/utility/parameters/Parameter.hpp>
 #include <opm/core/utility/parameters/ParameterGroup.hpp>
 
@@ -50,12 +52,14 @@ template <typename Format> unique_ptr <OutputWriter>
 create (const ParameterGroup& params,
         std::shared_ptr <const EclipseState> eclipseState,
         const Opm::PhaseUsage &phaseUsage,
-        std::shared_ptr <const UnstructuredGrid> grid) {
+        std::shared_ptr <const UnstructuredGrid> grid,
+        std::shared_ptr <const CompressedCartesianIndex> cartesianIndex) {
     return unique_ptr <OutputWriter> (new Format (params,
                                                   eclipseState,
                                                   phaseUsage,
                                                   grid->number_of_cells,
-                                                  grid->global_cell));
+                                                  grid->global_cell,
+                                                  cartesianIndex));
 }
 
 /// Map between keyword in configuration and the corresponding
@@ -68,9 +72,11 @@ typedef map <const char*, unique_ptr <OutputWriter> (*)(
         const ParameterGroup&,
         std::shared_ptr <const EclipseState> eclipseState,
         const Opm::PhaseUsage &phaseUsage,
-        std::shared_ptr <const UnstructuredGrid>)> map_t;
+        std::shared_ptr <const UnstructuredGrid>,
+        std::shared_ptr <const CompressedCartesianIndex>)> map_t;
 map_t FORMATS = {
     { "output_ecl", &create <EclipseWriter> },
+    { "output_ecl_native", &create <EclipseNativeWriter> },
 };
 
 } // anonymous namespace
@@ -79,7 +85,8 @@ unique_ptr <OutputWriter>
 OutputWriter::create (const ParameterGroup& params,
                       std::shared_ptr <const EclipseState> eclipseState,
                       const Opm::PhaseUsage &phaseUsage,
-                      std::shared_ptr <const UnstructuredGrid> grid) {
+                      std::shared_ptr <const UnstructuredGrid> grid,
+                      std::shared_ptr <const CompressedCartesianIndex> cartesianIndex) {
     // allocate a list which will be filled with writers. this list
     // is initially empty (no output).
     MultiWriter::ptr_t list (new MultiWriter::writers_t ());
@@ -94,7 +101,13 @@ OutputWriter::create (const ParameterGroup& params,
         // invoke the constructor for the type if we found the keyword
         // and put the pointer to this writer onto the list
         if (params.getDefault <bool> (name, false)) {
-            list->push_front (it->second (params, eclipseState, phaseUsage, grid));
+            // all the formats share one mapping of the grid cells
+            if (!cartesianIndex) {
+                const int* dims = grid->cartdims;
+                cartesianIndex = std::make_shared <CompressedCartesianIndex> (
+                        grid->number_of_cells, grid->global_cell, dims[0]*dims[1]*dims[2]);
+            }
+            list->push_front (it->second (params, eclipseState, phaseUsage, grid, cartesianIndex));
         }
     }
 
@@ -28,6 +28,7 @@ struct UnstructuredGrid;
 namespace Opm {
 
 // forward declaration
+class CompressedCartesianIndex;
 class EclipseState;
 namespace parameter { class ParameterGroup; }
 class SimulatorState;
@@ -102,6 +103,9 @@ public:
      *
      * @param eclipseState The internalized input deck.
      *
+     * @param cartesianIndex Compressed to Cartesian mapping of the grid,
+     *               shared by all the writers. Built from the grid if null.
+     *
      * @return       Pointer to a multiplexer to all applicable output formats.
      *
      * @see Opm::share_obj
@@ -110,7 +114,9 @@ public:
     create (const parameter::ParameterGroup& params,
             std::shared_ptr <const EclipseState> eclipseState,
             const Opm::PhaseUsage &phaseUsage,
-            std::shared_ptr <const UnstructuredGrid> grid);
+            std::shared_ptr <const UnstructuredGrid> grid,
+            std::shared_ptr <const CompressedCartesianIndex> cartesianIndex
+                = std::shared_ptr <const CompressedCartesianIndex> ());
 };
 
 } // namespace Opm
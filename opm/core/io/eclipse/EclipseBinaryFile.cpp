@@ -0,0 +1,397 @@
+/*
+  Copyright 2015 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "config.h"
+#include <opm/core/io/eclipse/EclipseBinaryFile.hpp>
+#include <opm/core/utility/ErrorMacros.hpp>
+#include <opm/core/utility/Units.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace Opm
+{
+
+    namespace
+    {
+        // Elements per data record, as written by Eclipse.
+        const int numeric_block_size = 1000;
+        const int char_block_size = 105;
+
+        // Size of the output buffer before it is written to the file.
+        const std::size_t buffer_flush_size = 1 << 20;
+
+        // Value of a true "LOGI" element.
+        const int logical_true = -1;
+
+        int elementSize(const std::string& type)
+        {
+            if (type == "INTE" || type == "REAL" || type == "LOGI") {
+                return 4;
+            } else if (type == "DOUB" || type == "CHAR") {
+                return 8;
+            } else if (type == "MESS") {
+                return 0;
+            }
+            OPM_THROW(std::runtime_error, "Unknown Eclipse keyword type '" << type << "'");
+        }
+
+        std::uint64_t getBytes(const char* p, const int num_bytes)
+        {
+            std::uint64_t value = 0;
+            for (int b = 0; b < num_bytes; ++b) {
+                value = (value << 8) | static_cast<unsigned char>(p[b]);
+            }
+            return value;
+        }
+
+        std::string trimmed(const char* p, const int n)
+        {
+            std::string s(p, n);
+            s.erase(s.find_last_not_of(' ') + 1);
+            return s;
+        }
+    } // anonymous namespace
+
+
+
+    EclipseBinaryWriter::EclipseBinaryWriter(const std::string& filename,
+                                             const bool append)
+        : filename_(filename),
+          file_(filename.c_str(), std::ios::binary | (append ? std::ios::app : std::ios::trunc))
+    {
+        if (!file_) {
+            OPM_THROW(std::runtime_error, "Failed to open " << filename);
+        }
+        buffer_.reserve(buffer_flush_size + 8*numeric_block_size + 8);
+    }
+
+
+
+    EclipseBinaryWriter::~EclipseBinaryWriter()
+    {
+        try {
+            flush();
+        } catch (...) {
+            // Errors can not be reported from a destructor; call
+            // flush() to see them.
+        }
+    }
+
+
+
+    template <class Put>
+    void EclipseBinaryWriter::writeBlocks(const int count, const int block_size,
+                                          const int element_size, const Put& put)
+    {
+        for (int begin = 0; begin < count; begin += block_size) {
+            const int end = std::min(count, begin + block_size);
+            const int num_bytes = (end - begin)*element_size;
+            beginRecord(num_bytes);
+            for (int i = begin; i < end; ++i) {
+                put(i);
+            }
+            endRecord(num_bytes);
+        }
+    }
+
+
+
+    void EclipseBinaryWriter::write(const std::string& name, const std::vector<int>& data)
+    {
+        writeHeader(name, int(data.size()), "INTE");
+        writeBlocks(int(data.size()), numeric_block_size, 4, [this, &data](const int i) {
+                putBytes(static_cast<std::uint32_t>(data[i]), 4);
+            });
+    }
+
+
+
+    void EclipseBinaryWriter::write(const std::string& name, const std::vector<float>& data)
+    {
+        writeHeader(name, int(data.size()), "REAL");
+        writeBlocks(int(data.size()), numeric_block_size, 4, [this, &data](const int i) {
+                std::uint32_t bits;
+                std::memcpy(&bits, &data[i], 4);
+                putBytes(bits, 4);
+            });
+    }
+
+
+
+    void EclipseBinaryWriter::write(const std::string& name, const std::vector<double>& data)
+    {
+        writeHeader(name, int(data.size()), "DOUB");
+        writeBlocks(int(data.size()), numeric_block_size, 8, [this, &data](const int i) {
+                std::uint64_t bits;
+                std::memcpy(&bits, &data[i], 8);
+                putBytes(bits, 8);
+            });
+    }
+
+
+
+    void EclipseBinaryWriter::write(const std::string& name, const std::vector<std::string>& data)
+    {
+        for (std::size_t i = 0; i < data.size(); ++i) {
+            if (data[i].size() > 8) {
+                OPM_THROW(std::runtime_error, "Element '" << data[i] << "' of keyword " << name
+                          << " is longer than eight characters");
+            }
+        }
+        writeHeader(name, int(data.size()), "CHAR");
+        writeBlocks(int(data.size()), char_block_size, 8, [this, &data](const int i) {
+                buffer_.insert(buffer_.end(), data[i].begin(), data[i].end());
+                buffer_.insert(buffer_.end(), 8 - data[i].size(), ' ');
+            });
+    }
+
+
+
+    void EclipseBinaryWriter::writeLogical(const std::string& name, const std::vector<bool>& data)
+    {
+        writeHeader(name, int(data.size()), "LOGI");
+        writeBlocks(int(data.size()), numeric_block_size, 4, [this, &data](const int i) {
+                putBytes(static_cast<std::uint32_t>(data[i] ? logical_true : 0), 4);
+            });
+    }
+
+
+
+    void EclipseBinaryWriter::writeMessage(const std::string& name)
+    {
+        writeHeader(name, 0, "MESS");
+    }
+
+
+
+    void EclipseBinaryWriter::writeCellData(const std::string& name,
+                                            const std::vector<double>& field,
+                                            const std::vector<int>& cells,
+                                            const int stride,
+                                            const int component,
+                                            const double to_si_factor,
+                                            const double to_si_offset)
+    {
+        writeHeader(name, int(cells.size()), "REAL");
+        const double* values = field.data() + component;
+        writeBlocks(int(cells.size()), numeric_block_size, 4,
+                    [this, &cells, values, stride, to_si_factor, to_si_offset](const int i) {
+                const float value = static_cast<float>(
+                    unit::convert::to(values[std::size_t(stride)*cells[i]] - to_si_offset, to_si_factor));
+                std::uint32_t bits;
+                std::memcpy(&bits, &value, 4);
+                putBytes(bits, 4);
+            });
+    }
+
+
+
+    void EclipseBinaryWriter::flush()
+    {
+        file_.write(buffer_.data(), buffer_.size());
+        file_.flush();
+        buffer_.clear();
+        if (!file_) {
+            OPM_THROW(std::runtime_error, "Failed to write " << filename_);
+        }
+    }
+
+
+
+    void EclipseBinaryWriter::writeHeader(const std::string& name, const int count,
+                                          const char* type)
+    {
+        if (name.size() > 8) {
+            OPM_THROW(std::runtime_error, "Eclipse keyword name '" << name << "' is longer than eight characters");
+        }
+        beginRecord(16);
+        buffer_.insert(buffer_.end(), name.begin(), name.end());
+        buffer_.insert(buffer_.end(), 8 - name.size(), ' ');
+        putBytes(static_cast<std::uint32_t>(count), 4);
+        buffer_.insert(buffer_.end(), type, type + 4);
+        endRecord(16);
+    }
+
+
+
+    void EclipseBinaryWriter::beginRecord(const int num_bytes)
+    {
+        putBytes(static_cast<std::uint32_t>(num_bytes), 4);
+    }
+
+
+
+    void EclipseBinaryWriter::endRecord(const int num_bytes)
+    {
+        putBytes(static_cast<std::uint32_t>(num_bytes), 4);
+        if (buffer_.size() >= buffer_flush_size) {
+            flush();
+        }
+    }
+
+
+
+    void EclipseBinaryWriter::putBytes(const std::uint64_t value, const int num_bytes)
+    {
+        for (int b = num_bytes - 1; b >= 0; --b) {
+            buffer_.push_back(static_cast<char>((value >> (8*b)) & 0xff));
+        }
+    }
+
+
+
+    EclipseBinaryReader::EclipseBinaryReader(const std::string& filename)
+        : filename_(filename),
+          file_(filename.c_str(), std::ios::binary),
+          count_(0)
+    {
+        if (!file_) {
+            OPM_THROW(std::runtime_error, "Failed to open " << filename);
+        }
+    }
+
+
+
+    bool EclipseBinaryReader::next()
+    {
+        name_.clear();
+        type_.clear();
+        count_ = 0;
+        data_.clear();
+        if (file_.peek() == std::ifstream::traits_type::eof()) {
+            return false;
+        }
+
+        std::vector<char> header;
+        if (readRecord(header) != 16) {
+            OPM_THROW(std::runtime_error, "Invalid keyword header in " << filename_);
+        }
+        name_ = trimmed(header.data(), 8);
+        count_ = static_cast<int>(static_cast<std::uint32_t>(getBytes(header.data() + 8, 4)));
+        type_.assign(header.data() + 12, 4);
+        const int element_size = elementSize(type_);
+        if (count_ < 0) {
+            OPM_THROW(std::runtime_error, "Invalid element count of keyword " << name_ << " in " << filename_);
+        }
+
+        const std::size_t num_bytes = std::size_t(count_)*element_size;
+        std::vector<char> record;
+        while (data_.size() < num_bytes) {
+            if (readRecord(record) == 0) {
+                break;
+            }
+            data_.insert(data_.end(), record.begin(), record.end());
+        }
+        if (data_.size() != num_bytes) {
+            OPM_THROW(std::runtime_error, "Data of keyword " << name_ << " in " << filename_
+                      << " does not match its element count");
+        }
+        return true;
+    }
+
+
+
+    std::vector<int> EclipseBinaryReader::getInt() const
+    {
+        checkType("INTE");
+        std::vector<int> v(count_);
+        for (int i = 0; i < count_; ++i) {
+            v[i] = static_cast<int>(static_cast<std::uint32_t>(getBytes(&data_[4*i], 4)));
+        }
+        return v;
+    }
+
+
+
+    std::vector<double> EclipseBinaryReader::getDouble() const
+    {
+        std::vector<double> v(count_);
+        if (type_ == "REAL") {
+            for (int i = 0; i < count_; ++i) {
+                const std::uint32_t bits = static_cast<std::uint32_t>(getBytes(&data_[4*i], 4));
+                float value;
+                std::memcpy(&value, &bits, 4);
+                v[i] = value;
+            }
+        } else {
+            checkType("DOUB");
+            for (int i = 0; i < count_; ++i) {
+                const std::uint64_t bits = getBytes(&data_[8*i], 8);
+                std::memcpy(&v[i], &bits, 8);
+            }
+        }
+        return v;
+    }
+
+
+
+    std::vector<std::string> EclipseBinaryReader::getChar() const
+    {
+        checkType("CHAR");
+        std::vector<std::string> v(count_);
+        for (int i = 0; i < count_; ++i) {
+            v[i] = trimmed(&data_[8*i], 8);
+        }
+        return v;
+    }
+
+
+
+    std::vector<bool> EclipseBinaryReader::getLogical() const
+    {
+        checkType("LOGI");
+        std::vector<bool> v(count_);
+        for (int i = 0; i < count_; ++i) {
+            v[i] = getBytes(&data_[4*i], 4) != 0;
+        }
+        return v;
+    }
+
+
+
+    int EclipseBinaryReader::readRecord(std::vector<char>& data)
+    {
+        char marker[4];
+        file_.read(marker, 4);
+        const std::uint32_t head = static_cast<std::uint32_t>(getBytes(marker, 4));
+        if (!file_ || head > (1u << 30)) {
+            OPM_THROW(std::runtime_error, "Invalid record marker in " << filename_);
+        }
+        data.resize(head);
+        file_.read(data.data(), head);
+        file_.read(marker, 4);
+        if (!file_ || getBytes(marker, 4) != head) {
+            OPM_THROW(std::runtime_error, "Truncated or corrupt record in " << filename_);
+        }
+        return int(head);
+    }
+
+
+
+    void EclipseBinaryReader::checkType(const char* type) const
+    {
+        if (type_ != type) {
+            OPM_THROW(std::runtime_error, "Keyword " << name_ << " has type " << type_
+                      << ", not " << type);
+        }
+    }
+
+} // namespace Opm
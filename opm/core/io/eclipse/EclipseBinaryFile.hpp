@@ -0,0 +1,165 @@
+/*
+  Copyright 2015 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_ECLIPSEBINARYFILE_HEADER_INCLUDED
+#define OPM_ECLIPSEBINARYFILE_HEADER_INCLUDED
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace Opm
+{
+
+    /// Writer for unformatted Eclipse files (EGRID, UNRST, SMSPEC,
+    /// UNSMRY, ...), without ERT.
+    ///
+    /// A file is a sequence of keywords. Each keyword is a Fortran
+    /// record holding its name, element count and type ("INTE", "REAL",
+    /// "DOUB", "LOGI", "CHAR" or "MESS"), followed by the data split
+    /// into records of at most 1000 elements (105 for "CHAR"). Records
+    /// are framed by their byte count, and all numbers are big-endian.
+    ///
+    /// Output is collected in a buffer that is written to the file
+    /// when it grows large, on flush() and on destruction.
+    class EclipseBinaryWriter
+    {
+    public:
+        /// Open file, truncating it unless append is true.
+        explicit EclipseBinaryWriter(const std::string& filename,
+                                     const bool append = false);
+
+        /// Flushes the buffer.
+        ~EclipseBinaryWriter();
+
+        /// Write keyword of type "INTE".
+        void write(const std::string& name, const std::vector<int>& data);
+
+        /// Write keyword of type "REAL".
+        void write(const std::string& name, const std::vector<float>& data);
+
+        /// Write keyword of type "DOUB".
+        void write(const std::string& name, const std::vector<double>& data);
+
+        /// Write keyword of type "CHAR". Strings are padded to eight
+        /// characters, longer strings are an error.
+        void write(const std::string& name, const std::vector<std::string>& data);
+
+        /// Write keyword of type "LOGI".
+        void writeLogical(const std::string& name, const std::vector<bool>& data);
+
+        /// Write keyword of type "MESS", which has no data.
+        void writeMessage(const std::string& name);
+
+        /// Write keyword of type "REAL" with one value per cell, gathered
+        /// from a field and converted from SI units on the fly.
+        /// Element i of the keyword is
+        ///     unit::convert::to(field[stride*cells[i] + component] - to_si_offset,
+        ///                       to_si_factor).
+        /// \param[in] field         cell values, stride values per cell.
+        /// \param[in] cells         cells to write, in output order.
+        /// \param[in] stride        number of values per cell in field.
+        /// \param[in] component     which of those values to write.
+        /// \param[in] to_si_factor  factor from the output unit to SI.
+        /// \param[in] to_si_offset  offset of the output unit from SI.
+        void writeCellData(const std::string& name,
+                           const std::vector<double>& field,
+                           const std::vector<int>& cells,
+                           const int stride = 1,
+                           const int component = 0,
+                           const double to_si_factor = 1.0,
+                           const double to_si_offset = 0.0);
+
+        /// Write buffered output to the file.
+        void flush();
+
+    private:
+        void writeHeader(const std::string& name, int count, const char* type);
+        void beginRecord(int num_bytes);
+        void endRecord(int num_bytes);
+        void putBytes(std::uint64_t value, int num_bytes);
+        template <class Put>
+        void writeBlocks(int count, int block_size, int element_size, const Put& put);
+
+        std::string filename_;
+        std::ofstream file_;
+        std::vector<char> buffer_;
+    };
+
+
+
+    /// Reader for unformatted Eclipse files, as written by
+    /// EclipseBinaryWriter. Keywords are read one at a time:
+    ///
+    /// \code
+    ///     EclipseBinaryReader reader(filename);
+    ///     while (reader.next()) {
+    ///         if (reader.name() == "PRESSURE") {
+    ///             std::vector<double> p = reader.getDouble();
+    ///         }
+    ///     }
+    /// \endcode
+    ///
+    /// Malformed input makes next() throw.
+    class EclipseBinaryReader
+    {
+    public:
+        /// Open file.
+        explicit EclipseBinaryReader(const std::string& filename);
+
+        /// Read the next keyword. Returns false at the end of the file.
+        bool next();
+
+        /// Name of the current keyword, without trailing blanks.
+        const std::string& name() const { return name_; }
+
+        /// Type of the current keyword, e.g. "INTE".
+        const std::string& type() const { return type_; }
+
+        /// Number of elements of the current keyword.
+        int size() const { return count_; }
+
+        /// Data of the current "INTE" keyword.
+        std::vector<int> getInt() const;
+
+        /// Data of the current "REAL" or "DOUB" keyword.
+        std::vector<double> getDouble() const;
+
+        /// Data of the current "CHAR" keyword, without trailing blanks.
+        std::vector<std::string> getChar() const;
+
+        /// Data of the current "LOGI" keyword.
+        std::vector<bool> getLogical() const;
+
+    private:
+        int readRecord(std::vector<char>& data);
+        void checkType(const char* type) const;
+
+        std::string filename_;
+        std::ifstream file_;
+        std::string name_;
+        std::string type_;
+        int count_;
+        std::vector<char> data_;
+    };
+
+} // namespace Opm
+
+#endif // OPM_ECLIPSEBINARYFILE_HEADER_INCLUDED
@@ -0,0 +1,431 @@
+/*
+  Copyright 2015 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "config.h"
+#include <opm/core/io/eclipse/EclipseNativeWriter.hpp>
+#include <opm/core/io/eclipse/EclipseBinaryFile.hpp>
+#include <opm/core/simulator/SimulatorState.hpp>
+#include <opm/core/simulator/SimulatorTimerInterface.hpp>
+#include <opm/core/simulator/WellState.hpp>
+#include <opm/core/utility/CompressedCartesianIndex.hpp>
+#include <opm/core/utility/ErrorMacros.hpp>
+#include <opm/core/utility/Profiler.hpp>
+#include <opm/core/utility/parameters/ParameterGroup.hpp>
+#include <opm/core/utility/Units.hpp>
+
+#include <opm/parser/eclipse/EclipseState/Schedule/Schedule.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/Well.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/EclipseGrid.hpp>
+
+#include <boost/algorithm/string/case_conv.hpp> // to_upper_copy
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <iostream>
+#include <map>
+
+namespace Opm
+{
+
+    namespace
+    {
+        // Sizes of the restart headers, as written by Eclipse 100.
+        const int intehead_size = 411;
+        const int logihead_size = 121;
+        const int doubhead_size = 229;
+
+        // Items of INTEHEAD.
+        const int intehead_unit = 2;
+        const int intehead_nx = 8;
+        const int intehead_ny = 9;
+        const int intehead_nz = 10;
+        const int intehead_nactive = 11;
+        const int intehead_phase = 14;
+        const int intehead_nwells = 16;
+        const int intehead_day = 64;
+        const int intehead_month = 65;
+        const int intehead_year = 66;
+        const int intehead_iprog = 94;
+
+        // Simulator identification; Eclipse 100.
+        const int iprog_e100 = 100;
+
+        // Name used for the WGNAMES entry of variables without a well.
+        const char* const dummy_well = ":+:+:+:+";
+
+        int eclipseUnitType(const UnitSystem::UnitType unit)
+        {
+            switch (unit) {
+            case UnitSystem::UNIT_TYPE_METRIC: return 1;
+            case UnitSystem::UNIT_TYPE_FIELD:  return 2;
+            case UnitSystem::UNIT_TYPE_LAB:    return 3;
+            }
+            OPM_THROW(std::logic_error, "Unhandled unit system " << unit);
+        }
+
+        // Phase bit mask of INTEHEAD: oil 1, water 2, gas 4.
+        int eclipsePhaseMask(const PhaseUsage& pu)
+        {
+            return (pu.phase_used[BlackoilPhases::Liquid] ? 1 : 0)
+                | (pu.phase_used[BlackoilPhases::Aqua] ? 2 : 0)
+                | (pu.phase_used[BlackoilPhases::Vapour] ? 4 : 0);
+        }
+
+        std::vector<int> dayMonthYear(const boost::posix_time::ptime& time)
+        {
+            const boost::gregorian::date date = time.date();
+            std::vector<int> dmy(3);
+            dmy[0] = date.day();
+            dmy[1] = date.month();
+            dmy[2] = date.year();
+            return dmy;
+        }
+    } // anonymous namespace
+
+
+
+    EclipseNativeWriter::EclipseNativeWriter(const parameter::ParameterGroup& params,
+                                             Opm::EclipseStateConstPtr eclipseState,
+                                             const Opm::PhaseUsage& phaseUsage,
+                                             int numCells,
+                                             const int* compressedToCartesianCellIdx,
+                                             std::shared_ptr<const CompressedCartesianIndex> cartesianIndex)
+        : eclipseState_(eclipseState),
+          phaseUsage_(phaseUsage),
+          ministepIdx_(0),
+          reportStepIdx_(-1)
+    {
+        const auto eclGrid = eclipseState->getEclipseGrid();
+        cartesianSize_[0] = eclGrid->getNX();
+        cartesianSize_[1] = eclGrid->getNY();
+        cartesianSize_[2] = eclGrid->getNZ();
+
+        if (!cartesianIndex) {
+            cartesianIndex = std::make_shared<CompressedCartesianIndex>(numCells, compressedToCartesianCellIdx,
+                                                                        eclGrid->getCartesianSize());
+        }
+        else if (cartesianIndex->numCells() != numCells) {
+            OPM_THROW(std::runtime_error, "The Cartesian index has " << cartesianIndex->numCells()
+                      << " cells, the grid " << numCells << ".");
+        }
+        eclipseOrder_ = cartesianIndex->cellsInCartesianOrder();
+        actnum_.assign(eclGrid->getCartesianSize(), 0);
+        for (int cell = 0; cell < numCells; ++cell) {
+            actnum_[cartesianIndex->cartesianIndex(cell)] = 1;
+        }
+
+        const auto unitSystem = eclipseState->getDeckUnitSystem();
+        deckToSiPressure_ = unitSystem->parse("Pressure")->getSIScaling();
+        deckToSiTemperatureFactor_ = unitSystem->parse("Temperature")->getSIScaling();
+        deckToSiTemperatureOffset_ = unitSystem->parse("Temperature")->getSIOffset();
+
+        // Base name and output directory as for EclipseWriter.
+        using boost::filesystem::path;
+        path deckPath(params.get<std::string>("deck_filename"));
+        if (boost::to_upper_copy(path(deckPath.extension()).string()) == ".DATA") {
+            baseName_ = path(deckPath.stem()).string();
+        }
+        else {
+            baseName_ = path(deckPath.filename()).string();
+        }
+        baseName_ = boost::to_upper_copy(baseName_);
+        enableOutput_ = params.getDefault<bool>("output", true);
+        outputDir_ = params.getDefault<std::string>("output_dir", ".");
+        if (enableOutput_) {
+            if (!boost::filesystem::exists(outputDir_)) {
+                std::cout << "Trying to create directory \"" << outputDir_ << "\" for the simulation output\n";
+                boost::filesystem::create_directories(outputDir_);
+            }
+            if (!boost::filesystem::is_directory(outputDir_)) {
+                OPM_THROW(std::runtime_error, "The path specified as output directory '" << outputDir_
+                          << "' is not a directory");
+            }
+        }
+
+        setupSummary();
+    }
+
+
+
+    EclipseNativeWriter::~EclipseNativeWriter()
+    {
+    }
+
+
+
+    void EclipseNativeWriter::writeInit(const SimulatorTimerInterface& timer)
+    {
+        if (!enableOutput_) {
+            return;
+        }
+        ministepIdx_ = 0;
+        reportStepIdx_ = -1;
+
+        if (eclipseState_->getIOConfigConst()->getWriteEGRIDFile()) {
+            writeEgrid();
+        }
+        writeSmspec(timer);
+        // Start empty unified files; the steps are appended.
+        EclipseBinaryWriter(fileName("UNSMRY")).flush();
+        EclipseBinaryWriter(fileName("UNRST")).flush();
+    }
+
+
+
+    void EclipseNativeWriter::writeTimeStep(const SimulatorTimerInterface& timer,
+                                            const SimulatorState& reservoirState,
+                                            const WellState& wellState,
+                                            bool isSubstep)
+    {
+        if (!enableOutput_) {
+            return;
+        }
+        OPM_PROFILE_REGION("write_ecl");
+        if (!isSubstep && eclipseState_->getIOConfigConst()->getWriteRestartFile(timer.reportStepNum())) {
+            writeRestartStep(timer, reservoirState);
+        }
+        writeSummaryStep(timer, wellState);
+    }
+
+
+
+    std::string EclipseNativeWriter::fileName(const std::string& extension) const
+    {
+        return (boost::filesystem::path(outputDir_) / (baseName_ + "." + extension)).string();
+    }
+
+
+
+    void EclipseNativeWriter::setupSummary()
+    {
+        using namespace Opm::unit;
+        const UnitSystem::UnitType unitType = eclipseState_->getDeckUnitSystem()->getType();
+        if (unitType != UnitSystem::UNIT_TYPE_METRIC && unitType != UnitSystem::UNIT_TYPE_FIELD) {
+            OPM_THROW(std::logic_error, "Deck uses unexpected unit system");
+        }
+        const bool metric = unitType == UnitSystem::UNIT_TYPE_METRIC;
+
+        SummaryVariable elapsed = { "TIME", dummy_well, "DAYS", -1, 1.0, day };
+        summaryVariables_.push_back(elapsed);
+
+        const char phaseLetter[BlackoilPhases::MaxNumPhases] = { 'W', 'O', 'G' };
+        const auto& wells = eclipseState_->getSchedule()->getWells();
+        for (std::size_t w = 0; w < wells.size(); ++w) {
+            const std::string& name = wells[w]->name();
+            SummaryVariable bhp = { "WBHP", name, metric ? "BARSA" : "PSIA", -1, 1.0,
+                                    metric ? barsa : psia };
+            summaryVariables_.push_back(bhp);
+            for (int phase = 0; phase < BlackoilPhases::MaxNumPhases; ++phase) {
+                if (!phaseUsage_.phase_used[phase]) {
+                    continue;
+                }
+                const bool gas = phase == BlackoilPhases::Vapour;
+                SummaryVariable rate = { "", name, "", phase, 0.0, 0.0 };
+                rate.unit = metric ? "SM3/DAY" : (gas ? "MSCF/DAY" : "STB/DAY");
+                rate.to_si_factor = metric ? cubic(meter)/day : (gas ? 1000*cubic(feet)/day : stb/day);
+                rate.keyword = std::string("W") + phaseLetter[phase] + "PR";
+                rate.sign = -1.0;
+                summaryVariables_.push_back(rate);
+                rate.keyword = std::string("W") + phaseLetter[phase] + "IR";
+                rate.sign = 1.0;
+                summaryVariables_.push_back(rate);
+            }
+        }
+    }
+
+
+
+    void EclipseNativeWriter::writeEgrid() const
+    {
+        const auto eclGrid = eclipseState_->getEclipseGrid();
+        const bool metric = eclipseState_->getDeckUnitSystem()->getType() == UnitSystem::UNIT_TYPE_METRIC;
+        const double length = metric ? unit::meter : unit::feet;
+
+        std::vector<double> coord;
+        std::vector<double> zcorn;
+        eclGrid->exportCOORD(coord);
+        eclGrid->exportZCORN(zcorn);
+        std::vector<float> values;
+
+        EclipseBinaryWriter egrid(fileName("EGRID"));
+        std::vector<int> filehead(100, 0);
+        filehead[0] = 3;    // file format version
+        filehead[1] = 2007; // release year
+        egrid.write("FILEHEAD", filehead);
+        std::vector<std::string> gridunit(2);
+        gridunit[0] = metric ? "METRES" : "FEET";
+        egrid.write("GRIDUNIT", gridunit);
+        std::vector<int> gridhead(100, 0);
+        gridhead[0] = 1;    // corner point grid
+        gridhead[1] = cartesianSize_[0];
+        gridhead[2] = cartesianSize_[1];
+        gridhead[3] = cartesianSize_[2];
+        gridhead[24] = 1;   // number of reservoirs
+        egrid.write("GRIDHEAD", gridhead);
+        values.resize(coord.size());
+        for (std::size_t i = 0; i < coord.size(); ++i) {
+            values[i] = static_cast<float>(unit::convert::to(coord[i], length));
+        }
+        egrid.write("COORD", values);
+        values.resize(zcorn.size());
+        for (std::size_t i = 0; i < zcorn.size(); ++i) {
+            values[i] = static_cast<float>(unit::convert::to(zcorn[i], length));
+        }
+        egrid.write("ZCORN", values);
+        egrid.write("ACTNUM", actnum_);
+        egrid.write("ENDGRID", std::vector<int>());
+        egrid.flush();
+    }
+
+
+
+    void EclipseNativeWriter::writeSmspec(const SimulatorTimerInterface& timer) const
+    {
+        const int numVariables = int(summaryVariables_.size());
+        std::vector<std::string> keywords(numVariables);
+        std::vector<std::string> wells(numVariables);
+        std::vector<std::string> units(numVariables);
+        for (int v = 0; v < numVariables; ++v) {
+            keywords[v] = summaryVariables_[v].keyword;
+            wells[v] = summaryVariables_[v].well;
+            units[v] = summaryVariables_[v].unit;
+        }
+
+        EclipseBinaryWriter smspec(fileName("SMSPEC"));
+        std::vector<int> intehead(2);
+        intehead[0] = eclipseUnitType(eclipseState_->getDeckUnitSystem()->getType());
+        intehead[1] = iprog_e100;
+        smspec.write("INTEHEAD", intehead);
+        smspec.write("RESTART", std::vector<std::string>(9));
+        std::vector<int> dimens(6, 0);
+        dimens[0] = numVariables;
+        dimens[1] = cartesianSize_[0];
+        dimens[2] = cartesianSize_[1];
+        dimens[3] = cartesianSize_[2];
+        dimens[5] = -1;     // not a restarted run
+        smspec.write("DIMENS", dimens);
+        smspec.write("KEYWORDS", keywords);
+        smspec.write("WGNAMES", wells);
+        smspec.write("NUMS", std::vector<int>(numVariables, 0));
+        smspec.write("UNITS", units);
+        smspec.write("STARTDAT", dayMonthYear(timer.startDateTime()));
+        smspec.flush();
+    }
+
+
+
+    void EclipseNativeWriter::writeSummaryStep(const SimulatorTimerInterface& timer,
+                                               const WellState& wellState)
+    {
+        // The well state holds the wells that are open in the current
+        // report step, in schedule order.
+        const int reportStep = timer.reportStepNum();
+        const auto& timeStepWells = eclipseState_->getSchedule()->getWells(reportStep);
+        std::map<std::string, int> wellNameToIdx;
+        int openWellIdx = 0;
+        for (std::size_t w = 0; w < timeStepWells.size(); ++w) {
+            if (timeStepWells[w]->getStatus(reportStep) != WellCommon::SHUT) {
+                wellNameToIdx[timeStepWells[w]->name()] = openWellIdx++;
+            }
+        }
+
+        const int np = phaseUsage_.num_phases;
+        std::vector<float> params(summaryVariables_.size());
+        for (std::size_t v = 0; v < summaryVariables_.size(); ++v) {
+            const SummaryVariable& var = summaryVariables_[v];
+            double value = 0.0;
+            if (var.keyword == "TIME") {
+                value = timer.simulationTimeElapsed();
+            } else {
+                const auto it = wellNameToIdx.find(var.well);
+                if (it != wellNameToIdx.end()) {
+                    const int w = it->second;
+                    if (var.phase < 0) {
+                        if (w < int(wellState.bhp().size())) {
+                            value = wellState.bhp()[w];
+                        }
+                    } else {
+                        const std::size_t idx = std::size_t(w)*np + phaseUsage_.phase_pos[var.phase];
+                        if (idx < wellState.wellRates().size()) {
+                            value = std::max(0.0, var.sign*wellState.wellRates()[idx]);
+                        }
+                    }
+                }
+            }
+            params[v] = static_cast<float>(unit::convert::to(value, var.to_si_factor));
+        }
+
+        EclipseBinaryWriter unsmry(fileName("UNSMRY"), true);
+        if (reportStep != reportStepIdx_) {
+            unsmry.write("SEQHDR", std::vector<int>(1, 0));
+            reportStepIdx_ = reportStep;
+        }
+        unsmry.write("MINISTEP", std::vector<int>(1, ministepIdx_++));
+        unsmry.write("PARAMS", params);
+        unsmry.flush();
+    }
+
+
+
+    void EclipseNativeWriter::writeRestartStep(const SimulatorTimerInterface& timer,
+                                               const SimulatorState& reservoirState) const
+    {
+        const int reportStep = timer.reportStepNum();
+        const std::vector<int> date = dayMonthYear(timer.currentDateTime());
+
+        EclipseBinaryWriter unrst(fileName("UNRST"), true);
+        unrst.write("SEQNUM", std::vector<int>(1, reportStep));
+        std::vector<int> intehead(intehead_size, 0);
+        intehead[intehead_unit] = eclipseUnitType(eclipseState_->getDeckUnitSystem()->getType());
+        intehead[intehead_nx] = cartesianSize_[0];
+        intehead[intehead_ny] = cartesianSize_[1];
+        intehead[intehead_nz] = cartesianSize_[2];
+        intehead[intehead_nactive] = int(eclipseOrder_.size());
+        intehead[intehead_phase] = eclipsePhaseMask(phaseUsage_);
+        intehead[intehead_nwells] = int(eclipseState_->getSchedule()->numWells(reportStep));
+        intehead[intehead_day] = date[0];
+        intehead[intehead_month] = date[1];
+        intehead[intehead_year] = date[2];
+        intehead[intehead_iprog] = iprog_e100;
+        unrst.write("INTEHEAD", intehead);
+        unrst.writeLogical("LOGIHEAD", std::vector<bool>(logihead_size, false));
+        std::vector<double> doubhead(doubhead_size, 0.0);
+        doubhead[0] = unit::convert::to(timer.simulationTimeElapsed(), unit::day);
+        unrst.write("DOUBHEAD", doubhead);
+
+        unrst.writeMessage("STARTSOL");
+        unrst.writeCellData("PRESSURE", reservoirState.pressure(), eclipseOrder_,
+                            1, 0, deckToSiPressure_);
+        unrst.writeCellData("TEMP", reservoirState.temperature(), eclipseOrder_,
+                            1, 0, deckToSiTemperatureFactor_, deckToSiTemperatureOffset_);
+        const int np = phaseUsage_.num_phases;
+        if (phaseUsage_.phase_used[BlackoilPhases::Aqua]) {
+            unrst.writeCellData("SWAT", reservoirState.saturation(), eclipseOrder_,
+                                np, phaseUsage_.phase_pos[BlackoilPhases::Aqua]);
+        }
+        if (phaseUsage_.phase_used[BlackoilPhases::Vapour]) {
+            unrst.writeCellData("SGAS", reservoirState.saturation(), eclipseOrder_,
+                                np, phaseUsage_.phase_pos[BlackoilPhases::Vapour]);
+        }
+        unrst.writeMessage("ENDSOL");
+        unrst.flush();
+    }
+
+} // namespace Opm
@@ -0,0 +1,121 @@
+/*
+  Copyright 2015 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_ECLIPSENATIVEWRITER_HEADER_INCLUDED
+#define OPM_ECLIPSENATIVEWRITER_HEADER_INCLUDED
+
+#include <opm/core/io/OutputWriter.hpp>
+#include <opm/core/props/BlackoilPhases.hpp>
+
+#include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
+
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Opm
+{
+
+    namespace parameter { class ParameterGroup; }
+    class CompressedCartesianIndex;
+
+    /// Writes the grid (EGRID), restart (UNRST) and summary (SMSPEC,
+    /// UNSMRY) files of a blackoil simulation in the unformatted,
+    /// unified Eclipse format, using EclipseBinaryWriter instead of ERT.
+    ///
+    /// Cell data is gathered to the active cells in Cartesian order and
+    /// converted to the deck units as it is written, without temporary
+    /// copies of the state. The summary holds TIME and, for every well
+    /// of the schedule, WBHP and the production and injection rates of
+    /// the active phases (W{O,W,G}{P,I}R).
+    ///
+    /// Enabled by the parameter output_ecl_native. The parameters
+    /// deck_filename, output and output_dir have the same meaning as
+    /// for EclipseWriter. The FMTOUT and UNIFOUT settings of the deck
+    /// are ignored.
+    class EclipseNativeWriter : public OutputWriter
+    {
+    public:
+        /// If cartesianIndex is null, it is built from
+        /// compressedToCartesianCellIdx. Otherwise it must be the
+        /// index of the same grid.
+        EclipseNativeWriter(const parameter::ParameterGroup& params,
+                            Opm::EclipseStateConstPtr eclipseState,
+                            const Opm::PhaseUsage& phaseUsage,
+                            int numCells,
+                            const int* compressedToCartesianCellIdx,
+                            std::shared_ptr<const CompressedCartesianIndex> cartesianIndex
+                                = std::shared_ptr<const CompressedCartesianIndex>());
+
+        virtual ~EclipseNativeWriter();
+
+        /// Write the EGRID and SMSPEC files, and start new UNRST and
+        /// UNSMRY files.
+        virtual void writeInit(const SimulatorTimerInterface& timer);
+
+        /// Append a summary step and, unless this is a substep and if
+        /// requested by the deck, a restart step.
+        virtual void writeTimeStep(const SimulatorTimerInterface& timer,
+                                   const SimulatorState& reservoirState,
+                                   const WellState& wellState,
+                                   bool isSubstep);
+
+    private:
+        struct SummaryVariable
+        {
+            std::string keyword;
+            std::string well;
+            std::string unit;
+            // Phase of a rate, -1 for the bottom hole pressure.
+            int phase;
+            // +1 for injection, -1 for production rates.
+            double sign;
+            double to_si_factor;
+        };
+
+        std::string fileName(const std::string& extension) const;
+        void setupSummary();
+        void writeEgrid() const;
+        void writeSmspec(const SimulatorTimerInterface& timer) const;
+        void writeSummaryStep(const SimulatorTimerInterface& timer,
+                              const WellState& wellState);
+        void writeRestartStep(const SimulatorTimerInterface& timer,
+                              const SimulatorState& reservoirState) const;
+
+        Opm::EclipseStateConstPtr eclipseState_;
+        PhaseUsage phaseUsage_;
+        std::array<int, 3> cartesianSize_;
+        // Active cells in the order of the Eclipse output.
+        std::vector<int> eclipseOrder_;
+        std::vector<int> actnum_;
+        double deckToSiPressure_;
+        double deckToSiTemperatureFactor_;
+        double deckToSiTemperatureOffset_;
+        bool enableOutput_;
+        std::string outputDir_;
+        std::string baseName_;
+        std::vector<SummaryVariable> summaryVariables_;
+        int ministepIdx_;
+        int reportStepIdx_;
+    };
+
+} // namespace Opm
+
+#endif // OPM_ECLIPSENATIVEWRITER_HEADER_INCLUDED
@@ -42,8 +42,14 @@
 namespace Opm {
 namespace EclipseWriterDetails {
 
-    EclipseWriteRFTHandler::EclipseWriteRFTHandler(const int * compressedToCartesianCellIdx, size_t numCells, size_t cartesianSize) {
-        initGlobalToActiveIndex(compressedToCartesianCellIdx, numCells, cartesianSize);
+    EclipseWriteRFTHandler::EclipseWriteRFTHandler(const int * compressedToCartesianCellIdx, size_t numCells, size_t cartesianSize)
+        : cartesianIndex_(std::make_shared<CompressedCartesianIndex>(numCells, compressedToCartesianCellIdx, cartesianSize))
+    {
+    }
+
+    EclipseWriteRFTHandler::EclipseWriteRFTHandler(std::shared_ptr<const CompressedCartesianIndex> cartesianIndex)
+        : cartesianIndex_(cartesianIndex)
+    {
     }
 
     void EclipseWriteRFTHandler::writeTimeStep(const std::string& filename,
@@ -114,7 +120,7 @@ namespace EclipseWriterDetails {
             size_t k = (size_t)completion->getK();
 
             size_t global_index = eclipseGrid->getGlobalIndex(i,j,k);
-            int active_index = globalToActiveIndex_[global_index];
+            int active_index = cartesianIndex_->compressedIndex(global_index);
 
             if (active_index > -1) {
                 double depth = eclipseGrid->getCellDepth(i,j,k);
@@ -131,15 +137,5 @@ namespace EclipseWriterDetails {
     }
 
 
-    void EclipseWriteRFTHandler::initGlobalToActiveIndex(const int * compressedToCartesianCellIdx, size_t numCells, size_t cartesianSize) {
-        globalToActiveIndex_.resize(cartesianSize, -1);
-        for (size_t active_index = 0; active_index < numCells; ++active_index) {
-            //If compressedToCartesianCellIdx is NULL, assume no compressed to cartesian mapping, set global equal to active index
-            int global_index = (NULL != compressedToCartesianCellIdx) ? compressedToCartesianCellIdx[active_index] : active_index;
-            globalToActiveIndex_[global_index] = active_index;
-        }
-    }
-
-
 }//namespace EclipseWriterDetails
 }//namespace Opm
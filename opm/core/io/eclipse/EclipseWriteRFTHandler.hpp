@@ -23,12 +23,15 @@
 #include <opm/core/simulator/SimulatorTimer.hpp>
 #include <opm/core/simulator/BlackoilState.hpp>
 #include <opm/core/simulator/SimulatorState.hpp>
+#include <opm/core/utility/CompressedCartesianIndex.hpp>
 
 #include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
 
 #include <ert/ecl/ecl_rft_node.h>
 #include <ert/ecl/ecl_util.h>
 
+#include <memory>
+
 
 namespace Opm {
 namespace EclipseWriterDetails {
@@ -39,6 +42,10 @@ namespace EclipseWriterDetails {
     public:
     EclipseWriteRFTHandler(const int * compressedToCartesianCellIdx, size_t numCells, size_t cartesianSize);
 
+    /// Construct with the active cell mapping of the grid shared with
+    /// other users.
+    explicit EclipseWriteRFTHandler(std::shared_ptr<const CompressedCartesianIndex> cartesianIndex);
+
 
     void writeTimeStep(const std::string& filename,
                        const ert_ecl_unit_enum ecl_unit,
@@ -60,9 +67,7 @@ namespace EclipseWriterDetails {
                                          const std::vector<double>& swat,
                                          const std::vector<double>& sgas);
 
-    void initGlobalToActiveIndex(const int * compressedToCartesianCellIdx, size_t numCells, size_t cartesianSize);
-
-    std::vector<int> globalToActiveIndex_;
+    std::shared_ptr<const CompressedCartesianIndex> cartesianIndex_;
 
     };
 
@@ -34,6 +34,7 @@
 #include <opm/core/utility/ErrorMacros.hpp>
 #include <opm/core/utility/parameters/Parameter.hpp>
 #include <opm/core/utility/parameters/ParameterGroup.hpp>
+#include <opm/core/utility/Profiler.hpp>
 #include <opm/core/utility/Units.hpp>
 #include <opm/core/wells.h> // WellType
 
@@ -1228,7 +1229,7 @@ void EclipseWriter::writeTimeStep(const SimulatorTimerInterface& timer,
     if (!enableOutput_) {
         return;
     }
-
+    OPM_PROFILE_REGION("write_ecl");
 
     std::vector<double> pressure = reservoirState.pressure();
     EclipseWriterDetails::convertFromSiTo(pressure, deckToSiPressure_);
@@ -1342,10 +1343,7 @@ void EclipseWriter::writeTimeStep(const SimulatorTimerInterface& timer,
 
 
     //Write RFT data for current timestep to RFT file
-    std::shared_ptr<EclipseWriterDetails::EclipseWriteRFTHandler> eclipseWriteRFTHandler = std::make_shared<EclipseWriterDetails::EclipseWriteRFTHandler>(
-                                                                                                                      compressedToCartesianCellIdx_,
-                                                                                                                      numCells_,
-                                                                                                                      eclipseState_->getEclipseGrid()->getCartesianSize());
+    std::shared_ptr<EclipseWriterDetails::EclipseWriteRFTHandler> eclipseWriteRFTHandler = std::make_shared<EclipseWriterDetails::EclipseWriteRFTHandler>(cartesianIndex_);
 
 
     char * rft_filename = ecl_util_alloc_filename(outputDir_.c_str(),
@@ -1398,11 +1396,12 @@ EclipseWriter::EclipseWriter(const parameter::ParameterGroup& params,
                              Opm::EclipseStateConstPtr eclipseState,
                              const Opm::PhaseUsage &phaseUsage,
                              int numCells,
-                             const int* compressedToCartesianCellIdx)
+                             const int* compressedToCartesianCellIdx,
+                             std::shared_ptr<const CompressedCartesianIndex> cartesianIndex)
     : eclipseState_(eclipseState)
     , numCells_(numCells)
     , compressedToCartesianCellIdx_(compressedToCartesianCellIdx)
-    , gridToEclipseIdx_(numCells, int(-1) )
+    , cartesianIndex_(cartesianIndex)
     , phaseUsage_(phaseUsage)
 {
     const auto eclGrid = eclipseState->getEclipseGrid();
@@ -1410,26 +1409,19 @@ EclipseWriter::EclipseWriter(const parameter::ParameterGroup& params,
     cartesianSize_[1] = eclGrid->getNY();
     cartesianSize_[2] = eclGrid->getNZ();
 
-    if( compressedToCartesianCellIdx ) {
-        // if compressedToCartesianCellIdx available then
-        // compute mapping to eclipse order
-        std::map< int , int > indexMap;
-        for (int cellIdx = 0; cellIdx < numCells; ++cellIdx) {
-            int cartesianCellIdx = compressedToCartesianCellIdx[cellIdx];
-            indexMap[ cartesianCellIdx ] = cellIdx;
-        }
-
-        int idx = 0;
-        for( auto it = indexMap.begin(), end = indexMap.end(); it != end; ++it ) {
-            gridToEclipseIdx_[ idx++ ] = (*it).second;
-        }
+    // the mapping to eclipse order is the active cells sorted by
+    // Cartesian index, or the identity if no compressedToCartesianCellIdx
+    // was given
+    if (!cartesianIndex_) {
+        cartesianIndex_ = std::make_shared<CompressedCartesianIndex>(numCells,
+                                                                     compressedToCartesianCellIdx,
+                                                                     eclGrid->getCartesianSize());
     }
-    else {
-        // if not compressedToCartesianCellIdx was given use identity
-        for (int cellIdx = 0; cellIdx < numCells; ++cellIdx) {
-            gridToEclipseIdx_[ cellIdx ] = cellIdx;
-        }
+    else if (cartesianIndex_->numCells() != numCells) {
+        OPM_THROW(std::runtime_error, "The Cartesian index has " << cartesianIndex_->numCells()
+                  << " cells, the grid " << numCells << ".");
     }
+    gridToEclipseIdx_ = cartesianIndex_->cellsInCartesianOrder();
 
 
     // factor from the pressure values given in the deck to Pascals
@@ -26,6 +26,7 @@
 #include <opm/core/props/BlackoilPhases.hpp>
 #include <opm/core/wells.h> // WellType
 #include <opm/core/simulator/SimulatorTimerInterface.hpp>
+#include <opm/core/utility/CompressedCartesianIndex.hpp>
 
 #include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
 
@@ -63,12 +64,18 @@ public:
     /*!
      * \brief Sets the common attributes required to write eclipse
      *        binary files using ERT.
+     *
+     * If cartesianIndex is null, it is built from
+     * compressedToCartesianCellIdx. Otherwise it must be the index of
+     * the same grid, and is shared with the caller.
      */
     EclipseWriter(const parameter::ParameterGroup& params,
                   Opm::EclipseStateConstPtr eclipseState,
                   const Opm::PhaseUsage &phaseUsage,
                   int numCells,
-                  const int* compressedToCartesianCellIdx);
+                  const int* compressedToCartesianCellIdx,
+                  std::shared_ptr<const CompressedCartesianIndex> cartesianIndex
+                      = std::shared_ptr<const CompressedCartesianIndex>());
 
     /**
      * We need a destructor in the compilation unit to avoid the
@@ -110,6 +117,7 @@ private:
     int numCells_;
     std::array<int, 3> cartesianSize_;
     const int* compressedToCartesianCellIdx_;
+    std::shared_ptr<const CompressedCartesianIndex> cartesianIndex_;
     std::vector< int > gridToEclipseIdx_;
     double deckToSiPressure_;
     double deckToSiTemperatureFactor_;
@@ -0,0 +1,423 @@
+/*
+  Copyright 2015 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "config.h"
+#include <opm/core/io/vtk/VtuWriter.hpp>
+#include <opm/core/grid.h>
+#include <opm/core/utility/ErrorMacros.hpp>
+#include <opm/core/utility/Profiler.hpp>
+
+#if HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <fstream>
+#include <limits>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+namespace Opm
+{
+
+    namespace
+    {
+        // Size of the blocks compressed separately, the default block
+        // size of vtkZLibDataCompressor.
+        const std::uint64_t zlib_block_size = 32768;
+
+        // Polyhedron.
+        const unsigned char vtk_polyhedron = 42;
+
+        bool isLittleEndian()
+        {
+            const std::uint16_t one = 1;
+            return *reinterpret_cast<const unsigned char*>(&one) == 1;
+        }
+
+        template <typename T>
+        std::pair<const char*, std::uint64_t> bytesOf(const std::vector<T>& v)
+        {
+            return std::make_pair(reinterpret_cast<const char*>(v.data()),
+                                  std::uint64_t(v.size()*sizeof(T)));
+        }
+
+        void dataArrayTag(const char* type, const std::string& name,
+                          const int num_comps, const std::uint64_t offset,
+                          std::ostream& os)
+        {
+            os << "        <DataArray type=\"" << type << "\" Name=\"" << name
+               << "\" NumberOfComponents=\"" << num_comps
+               << "\" format=\"appended\" offset=\"" << offset << "\"/>\n";
+        }
+
+        const char* scalarsName(const DataMap& data)
+        {
+            if (data.find("saturation") != data.end()) {
+                return "saturation";
+            } else if (data.find("pressure") != data.end()) {
+                return "pressure";
+            }
+            return 0;
+        }
+
+        /// Call func(p) for p = 0, ..., n - 1, each in its own thread
+        /// except for p = 0, which is run by the calling thread. The
+        /// first exception thrown, if any, is rethrown when all calls
+        /// have finished.
+        template <class Func>
+        void forEachPiece(const int n, const Func& func)
+        {
+            std::vector<std::exception_ptr> errors(n);
+            std::vector<std::thread> threads;
+            threads.reserve(n - 1);
+            for (int p = 1; p < n; ++p) {
+                threads.emplace_back([&func, &errors, p]() {
+                        try {
+                            func(p);
+                        } catch (...) {
+                            errors[p] = std::current_exception();
+                        }
+                    });
+            }
+            try {
+                func(0);
+            } catch (...) {
+                errors[0] = std::current_exception();
+            }
+            for (std::size_t t = 0; t < threads.size(); ++t) {
+                threads[t].join();
+            }
+            for (int p = 0; p < n; ++p) {
+                if (errors[p]) {
+                    std::rethrow_exception(errors[p]);
+                }
+            }
+        }
+    } // anonymous namespace
+
+
+
+    VtuWriter::Encoding VtuWriter::encodingFromString(const std::string& name)
+    {
+        if (name == "binary" || name == "raw") {
+            return Raw;
+        } else if (name == "zlib") {
+            return Zlib;
+        }
+        OPM_THROW(std::runtime_error, "Unknown vtk encoding: " << name);
+    }
+
+
+
+    VtuWriter::VtuWriter(const UnstructuredGrid& grid,
+                         const Encoding encoding,
+                         const int num_pieces)
+        : grid_(grid),
+          encoding_(encoding)
+    {
+        if (grid.dimensions != 3) {
+            OPM_THROW(std::runtime_error, "Vtk output for 3d grids only");
+        }
+        if (num_pieces < 1) {
+            OPM_THROW(std::runtime_error, "VtuWriter: number of pieces must be positive, got " << num_pieces);
+        }
+#if !HAVE_ZLIB
+        if (encoding == Zlib) {
+            OPM_THROW(std::runtime_error, "VtuWriter: zlib encoding requested, but opm-core was built without zlib.");
+        }
+#endif
+        // Avoid empty pieces.
+        const int num_cells = grid.number_of_cells;
+        const int n = std::max(1, std::min(num_pieces, num_cells));
+        pieces_.resize(n);
+        for (int p = 0; p < n; ++p) {
+            pieces_[p].begin_cell = int((std::int64_t(num_cells)*p)/n);
+            pieces_[p].end_cell = int((std::int64_t(num_cells)*(p + 1))/n);
+        }
+        forEachPiece(n, [this](const int p) { encodeGeometry(pieces_[p]); });
+    }
+
+
+
+    int VtuWriter::numPieces() const
+    {
+        return int(pieces_.size());
+    }
+
+
+
+    void VtuWriter::write(const DataMap& data, const std::string& basename) const
+    {
+        OPM_PROFILE_REGION("write_vtu");
+        for (DataMap::const_iterator dit = data.begin(); dit != data.end(); ++dit) {
+            const std::size_t size = dit->second->size();
+            if (grid_.number_of_cells == 0 || size == 0 || size % grid_.number_of_cells != 0) {
+                OPM_THROW(std::runtime_error, "VtuWriter: field " << dit->first << " of size " << size
+                          << " does not match grid with " << grid_.number_of_cells << " cells");
+            }
+        }
+        if (pieces_.size() == 1) {
+            writePiece(pieces_[0], data, basename + ".vtu");
+            return;
+        }
+        forEachPiece(numPieces(), [this, &data, &basename](const int p) {
+                std::ostringstream filename;
+                filename << basename << '-' << p << ".vtu";
+                writePiece(pieces_[p], data, filename.str());
+            });
+        writeParallelFile(data, basename);
+    }
+
+
+
+    void VtuWriter::encodeGeometry(Piece& piece) const
+    {
+        const UnstructuredGrid& g = grid_;
+
+        // Number the points used by the piece, in global order.
+        std::vector<int> local_point(g.number_of_nodes, -1);
+        for (int c = piece.begin_cell; c < piece.end_cell; ++c) {
+            for (int hf = g.cell_facepos[c]; hf < g.cell_facepos[c + 1]; ++hf) {
+                const int f = g.cell_faces[hf];
+                for (int fn = g.face_nodepos[f]; fn < g.face_nodepos[f + 1]; ++fn) {
+                    local_point[g.face_nodes[fn]] = 0;
+                }
+            }
+        }
+        std::vector<double> points;
+        int num_points = 0;
+        for (int node = 0; node < g.number_of_nodes; ++node) {
+            if (local_point[node] == 0) {
+                local_point[node] = num_points++;
+                points.insert(points.end(), g.node_coordinates + 3*node, g.node_coordinates + 3*node + 3);
+            } else {
+                local_point[node] = -1;
+            }
+        }
+        piece.num_points = num_points;
+
+        std::vector<int> connectivity;
+        std::vector<int> offsets;
+        std::vector<int> faces;
+        std::vector<int> faceoffsets;
+        for (int c = piece.begin_cell; c < piece.end_cell; ++c) {
+            std::set<int> cell_pts;
+            faces.push_back(g.cell_facepos[c + 1] - g.cell_facepos[c]);
+            for (int hf = g.cell_facepos[c]; hf < g.cell_facepos[c + 1]; ++hf) {
+                const int f = g.cell_faces[hf];
+                faces.push_back(g.face_nodepos[f + 1] - g.face_nodepos[f]);
+                for (int fn = g.face_nodepos[f]; fn < g.face_nodepos[f + 1]; ++fn) {
+                    const int pt = local_point[g.face_nodes[fn]];
+                    faces.push_back(pt);
+                    cell_pts.insert(pt);
+                }
+            }
+            connectivity.insert(connectivity.end(), cell_pts.begin(), cell_pts.end());
+            offsets.push_back(int(connectivity.size()));
+            faceoffsets.push_back(int(faces.size()));
+        }
+        const std::vector<unsigned char> types(piece.end_cell - piece.begin_cell, vtk_polyhedron);
+
+        // Encode in the order the arrays are listed in the file.
+        piece.geometry.clear();
+        piece.geometry_offsets.clear();
+        auto add = [this, &piece](const std::pair<const char*, std::uint64_t>& bytes) {
+            piece.geometry_offsets.push_back(piece.geometry.size());
+            encode(bytes.first, bytes.second, piece.geometry);
+        };
+        add(bytesOf(points));
+        add(bytesOf(connectivity));
+        add(bytesOf(offsets));
+        add(bytesOf(faces));
+        add(bytesOf(faceoffsets));
+        add(bytesOf(types));
+    }
+
+
+
+    void VtuWriter::writePiece(const Piece& piece, const DataMap& data,
+                               const std::string& filename) const
+    {
+        const int num_cells = piece.end_cell - piece.begin_cell;
+
+        // Encode the cell data, placed after the geometry.
+        std::string appended_data;
+        std::vector<std::uint64_t> data_offsets;
+        std::vector<double> values;
+        for (DataMap::const_iterator dit = data.begin(); dit != data.end(); ++dit) {
+            const std::vector<double>& field = *(dit->second);
+            const int num_comps = int(field.size()/grid_.number_of_cells);
+            values.assign(field.begin() + std::size_t(piece.begin_cell)*num_comps,
+                          field.begin() + std::size_t(piece.end_cell)*num_comps);
+            for (std::size_t i = 0; i < values.size(); ++i) {
+                if (std::fabs(values[i]) < std::numeric_limits<double>::min()) {
+                    // Avoiding denormal numbers to work around
+                    // bug in Paraview.
+                    values[i] = 0.0;
+                }
+            }
+            data_offsets.push_back(piece.geometry.size() + appended_data.size());
+            encode(reinterpret_cast<const char*>(values.data()),
+                   values.size()*sizeof(double), appended_data);
+        }
+
+        std::ostringstream os;
+        os << "<?xml version=\"1.0\"?>\n"
+           << "<VTKFile type=\"UnstructuredGrid\" version=\"1.0\" byte_order=\""
+           << (isLittleEndian() ? "LittleEndian" : "BigEndian") << "\" header_type=\"UInt64\"";
+        if (encoding_ == Zlib) {
+            os << " compressor=\"vtkZLibDataCompressor\"";
+        }
+        os << ">\n"
+           << "  <UnstructuredGrid>\n"
+           << "    <Piece NumberOfPoints=\"" << piece.num_points
+           << "\" NumberOfCells=\"" << num_cells << "\">\n"
+           << "      <Points>\n";
+        dataArrayTag("Float64", "Coordinates", 3, piece.geometry_offsets[0], os);
+        os << "      </Points>\n"
+           << "      <Cells>\n";
+        dataArrayTag("Int32", "connectivity", 1, piece.geometry_offsets[1], os);
+        dataArrayTag("Int32", "offsets", 1, piece.geometry_offsets[2], os);
+        dataArrayTag("Int32", "faces", 1, piece.geometry_offsets[3], os);
+        dataArrayTag("Int32", "faceoffsets", 1, piece.geometry_offsets[4], os);
+        dataArrayTag("UInt8", "types", 1, piece.geometry_offsets[5], os);
+        os << "      </Cells>\n"
+           << "      <CellData";
+        const char* scalars = scalarsName(data);
+        if (scalars) {
+            os << " Scalars=\"" << scalars << "\"";
+        }
+        os << ">\n";
+        int field = 0;
+        for (DataMap::const_iterator dit = data.begin(); dit != data.end(); ++dit, ++field) {
+            const int num_comps = int(dit->second->size()/grid_.number_of_cells);
+            dataArrayTag("Float64", dit->first, num_comps, data_offsets[field], os);
+        }
+        os << "      </CellData>\n"
+           << "    </Piece>\n"
+           << "  </UnstructuredGrid>\n"
+           << "  <AppendedData encoding=\"raw\">\n"
+           << "_";
+        const std::string header = os.str();
+
+        std::ofstream file(filename.c_str(), std::ios::out | std::ios::binary);
+        if (!file) {
+            OPM_THROW(std::runtime_error, "Failed to open " << filename);
+        }
+        file.write(header.data(), header.size());
+        file.write(piece.geometry.data(), piece.geometry.size());
+        file.write(appended_data.data(), appended_data.size());
+        file << "\n  </AppendedData>\n</VTKFile>\n";
+        if (!file) {
+            OPM_THROW(std::runtime_error, "Failed to write " << filename);
+        }
+    }
+
+
+
+    void VtuWriter::writeParallelFile(const DataMap& data,
+                                      const std::string& basename) const
+    {
+        const std::string filename = basename + ".pvtu";
+        std::ofstream os(filename.c_str());
+        if (!os) {
+            OPM_THROW(std::runtime_error, "Failed to open " << filename);
+        }
+        // Pieces are referred to relative to the .pvtu file.
+        const std::string::size_type slash = basename.find_last_of('/');
+        const std::string piece_base = slash == std::string::npos ? basename : basename.substr(slash + 1);
+
+        os << "<?xml version=\"1.0\"?>\n"
+           << "<VTKFile type=\"PUnstructuredGrid\" version=\"1.0\" byte_order=\""
+           << (isLittleEndian() ? "LittleEndian" : "BigEndian") << "\" header_type=\"UInt64\">\n"
+           << "  <PUnstructuredGrid GhostLevel=\"0\">\n"
+           << "    <PPoints>\n"
+           << "      <PDataArray type=\"Float64\" Name=\"Coordinates\" NumberOfComponents=\"3\"/>\n"
+           << "    </PPoints>\n"
+           << "    <PCellData";
+        const char* scalars = scalarsName(data);
+        if (scalars) {
+            os << " Scalars=\"" << scalars << "\"";
+        }
+        os << ">\n";
+        for (DataMap::const_iterator dit = data.begin(); dit != data.end(); ++dit) {
+            const int num_comps = int(dit->second->size()/grid_.number_of_cells);
+            os << "      <PDataArray type=\"Float64\" Name=\"" << dit->first
+               << "\" NumberOfComponents=\"" << num_comps << "\"/>\n";
+        }
+        os << "    </PCellData>\n";
+        for (int p = 0; p < numPieces(); ++p) {
+            os << "    <Piece Source=\"" << piece_base << '-' << p << ".vtu\"/>\n";
+        }
+        os << "  </PUnstructuredGrid>\n"
+           << "</VTKFile>\n";
+        if (!os) {
+            OPM_THROW(std::runtime_error, "Failed to write " << filename);
+        }
+    }
+
+
+
+    void VtuWriter::encode(const char* bytes, const std::uint64_t num_bytes,
+                           std::string& out) const
+    {
+        if (encoding_ == Raw) {
+            out.append(reinterpret_cast<const char*>(&num_bytes), sizeof(num_bytes));
+            out.append(bytes, num_bytes);
+            return;
+        }
+#if HAVE_ZLIB
+        // Header: number of blocks, block size, size of the last block
+        // if partial (zero otherwise), and the compressed block sizes.
+        const std::uint64_t num_blocks = (num_bytes + zlib_block_size - 1)/zlib_block_size;
+        std::vector<std::uint64_t> header(3 + num_blocks);
+        header[0] = num_blocks;
+        header[1] = zlib_block_size;
+        header[2] = num_bytes % zlib_block_size;
+        std::string blocks;
+        std::vector<Bytef> buffer(compressBound(zlib_block_size));
+        for (std::uint64_t b = 0; b < num_blocks; ++b) {
+            const std::uint64_t size = std::min(zlib_block_size, num_bytes - b*zlib_block_size);
+            uLongf compressed_size = buffer.size();
+            const int status = compress2(buffer.data(), &compressed_size,
+                                         reinterpret_cast<const Bytef*>(bytes + b*zlib_block_size),
+                                         size, Z_DEFAULT_COMPRESSION);
+            if (status != Z_OK) {
+                OPM_THROW(std::runtime_error, "VtuWriter: zlib compression failed with status " << status);
+            }
+            header[3 + b] = compressed_size;
+            blocks.append(reinterpret_cast<const char*>(buffer.data()), compressed_size);
+        }
+        out.append(reinterpret_cast<const char*>(header.data()), header.size()*sizeof(std::uint64_t));
+        out.append(blocks);
+#else
+        static_cast<void>(bytes);
+        static_cast<void>(num_bytes);
+        static_cast<void>(out);
+        OPM_THROW(std::runtime_error, "VtuWriter: zlib encoding not available.");
+#endif
+    }
+
+} // namespace Opm
@@ -0,0 +1,108 @@
+/*
+  Copyright 2015 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_VTUWRITER_HEADER_INCLUDED
+#define OPM_VTUWRITER_HEADER_INCLUDED
+
+#include <opm/core/utility/DataMap.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct UnstructuredGrid;
+
+namespace Opm
+{
+
+    /// Vtk output for general grids in the XML format, with the
+    /// arrays stored as binary appended data.
+    ///
+    /// The grid geometry (points and polyhedral cells) is encoded once,
+    /// when the writer is constructed, and copied into every file
+    /// written, so that the cost of each call to write() is dominated
+    /// by the cell data. The grid may be split into a number of pieces
+    /// of contiguous cell ranges. The pieces are then written to
+    /// separate files, each by its own thread, and tied together by a
+    /// parallel (.pvtu) file.
+    class VtuWriter
+    {
+    public:
+        /// Encoding of the appended data.
+        enum Encoding {
+            /// Uncompressed binary.
+            Raw,
+            /// Compressed with zlib. Only available if opm-core was
+            /// built with zlib support (HAVE_ZLIB).
+            Zlib
+        };
+
+        /// Parse an encoding name, "binary" (or "raw") or "zlib".
+        /// Throws for any other name.
+        static Encoding encodingFromString(const std::string& name);
+
+        /// Construct writer for a grid.
+        /// \param[in] grid        3d grid, must outlive the writer.
+        /// \param[in] encoding    encoding of the appended data.
+        /// \param[in] num_pieces  number of pieces to split the grid into.
+        VtuWriter(const UnstructuredGrid& grid,
+                  const Encoding encoding = Raw,
+                  const int num_pieces = 1);
+
+        /// Number of pieces.
+        int numPieces() const;
+
+        /// Write cell data. With a single piece, the output is written to
+        /// basename + ".vtu". Otherwise piece p is written to
+        /// basename + "-p.vtu" and the pieces are listed in
+        /// basename + ".pvtu".
+        /// \param[in] data      cell data; the number of components of a
+        ///                      field is its size divided by the number
+        ///                      of cells.
+        /// \param[in] basename  path of the output, without extension.
+        void write(const DataMap& data, const std::string& basename) const;
+
+    private:
+        struct Piece
+        {
+            int begin_cell;
+            int end_cell;
+            int num_points;
+            // Encoded geometry arrays, in the order they are listed in
+            // the file, and their offsets into the appended data.
+            std::string geometry;
+            std::vector<std::uint64_t> geometry_offsets;
+        };
+
+        void encodeGeometry(Piece& piece) const;
+        void writePiece(const Piece& piece, const DataMap& data,
+                        const std::string& filename) const;
+        void writeParallelFile(const DataMap& data,
+                               const std::string& basename) const;
+        void encode(const char* bytes, std::uint64_t num_bytes,
+                    std::string& out) const;
+
+        const UnstructuredGrid& grid_;
+        Encoding encoding_;
+        std::vector<Piece> pieces_;
+    };
+
+} // namespace Opm
+
+#endif // OPM_VTUWRITER_HEADER_INCLUDED
@@ -25,6 +25,7 @@
 #include <opm/core/linalg/LinearSolverIstl.hpp>
 #include <opm/core/linalg/ParallelIstlInformation.hpp>
 #include <opm/core/utility/ErrorMacros.hpp>
+#include <opm/core/utility/Profiler.hpp>
 
 // Silence compatibility warning from DUNE headers since we don't use
 // the deprecated member anyway (in this compilation unit)
@@ -145,6 +146,7 @@ namespace Opm
                             double* solution,
                             const boost::any& comm) const
     {
+        OPM_PROFILE_REGION("linear_solve");
         // Build Istl structures from input.
         // System matrix
         Mat A(size, size, nonzeros, Mat::row_wise);
@@ -25,6 +25,7 @@
 #define PETSC_CLANGUAGE_CXX 1 //enable CHKERRXX macro.
 #include <petsc.h>
 #include <opm/core/utility/ErrorMacros.hpp>
+#include <opm/core/utility/Profiler.hpp>
 
 namespace Opm
 {
@@ -253,6 +254,7 @@ namespace{
                                double* solution,
                                const boost::any&) const
     {
+        OPM_PROFILE_REGION("linear_solve");
         KSPTypeMap ksp(ksp_type_);
         KSPType ksp_type = ksp.find(ksp_type_);
         PCTypeMap pc(pc_type_);
@@ -21,6 +21,7 @@
 #include <opm/core/linalg/LinearSolverUmfpack.hpp>
 #include <opm/core/linalg/sparse_sys.h>
 #include <opm/core/linalg/call_umfpack.h>
+#include <opm/core/utility/Profiler.hpp>
 
 namespace Opm
 {
@@ -49,6 +50,7 @@ namespace Opm
                                double* solution,
                                const boost::any&) const
     {
+        OPM_PROFILE_REGION("linear_solve");
         CSRMatrix A  = {
             (size_t)size,
             (size_t)nonzeros,
@@ -36,6 +36,7 @@
 #include "config.h"
 #include <assert.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include <umfpack.h>
 
@@ -183,3 +184,218 @@ call_UMFPACK(struct CSRMatrix *A, const double *b, double *x)
     csc_deallocate(csc);
 }
 
+
+/* ====================================================================== *
+ * Cached factorisations
+ * ====================================================================== */
+
+struct UMFPACKCache {
+    size_t            m;        /* Pattern of last matrix (CSR) */
+    size_t            nnz;
+    int              *ia;
+    int              *ja;
+
+    struct CSCMatrix *csc;      /* CSC structure of last matrix */
+    UF_long          *perm;     /* CSR nonzero -> CSC nonzero */
+
+    void             *Symbolic;
+    void             *Numeric;
+
+    double            Control[UMFPACK_CONTROL];
+};
+
+
+/* ---------------------------------------------------------------------- */
+static void
+cache_clear(struct UMFPACKCache *cache)
+/* ---------------------------------------------------------------------- */
+{
+    if (cache->Numeric != NULL) {
+        umfpack_dl_free_numeric(&cache->Numeric);
+    }
+    if (cache->Symbolic != NULL) {
+        umfpack_dl_free_symbolic(&cache->Symbolic);
+    }
+
+    csc_deallocate(cache->csc);
+    free(cache->perm);
+    free(cache->ja);
+    free(cache->ia);
+
+    cache->m        = 0;
+    cache->nnz      = 0;
+    cache->ia       = NULL;
+    cache->ja       = NULL;
+    cache->csc      = NULL;
+    cache->perm     = NULL;
+    cache->Symbolic = NULL;
+    cache->Numeric  = NULL;
+}
+
+
+/* ---------------------------------------------------------------------- */
+struct UMFPACKCache *
+call_UMFPACK_create_cache(void)
+/* ---------------------------------------------------------------------- */
+{
+    struct UMFPACKCache *new;
+
+    new = malloc(1 * sizeof *new);
+
+    if (new != NULL) {
+        new->m        = 0;
+        new->nnz      = 0;
+        new->ia       = NULL;
+        new->ja       = NULL;
+        new->csc      = NULL;
+        new->perm     = NULL;
+        new->Symbolic = NULL;
+        new->Numeric  = NULL;
+
+        umfpack_dl_defaults(new->Control);
+    }
+
+    return new;
+}
+
+
+/* ---------------------------------------------------------------------- */
+void
+call_UMFPACK_destroy_cache(struct UMFPACKCache *cache)
+/* ---------------------------------------------------------------------- */
+{
+    if (cache != NULL) {
+        cache_clear(cache);
+    }
+
+    free(cache);
+}
+
+
+/* ---------------------------------------------------------------------- */
+static int
+same_pattern(const struct CSRMatrix *A, const struct UMFPACKCache *cache)
+/* ---------------------------------------------------------------------- */
+{
+    return (cache->csc != NULL)                                         &&
+           (A->m        == cache->m)                                    &&
+           ((size_t) A->ia[A->m] == cache->nnz)                          &&
+           (memcmp(A->ia, cache->ia, (A->m + 1)  * sizeof *A->ia) == 0) &&
+           (memcmp(A->ja, cache->ja,  cache->nnz * sizeof *A->ja) == 0);
+}
+
+
+/* ---------------------------------------------------------------------- */
+static int
+cache_setup_pattern(const struct CSRMatrix *A, struct UMFPACKCache *cache)
+/* ---------------------------------------------------------------------- */
+{
+    UF_long i, nz, *count;
+    size_t  nnz;
+    int     ok;
+
+    cache_clear(cache);
+
+    nnz = A->ia[A->m];
+
+    cache->ia   = malloc((A->m + 1) * sizeof *cache->ia);
+    cache->ja   = malloc( nnz       * sizeof *cache->ja);
+    cache->perm = malloc( nnz       * sizeof *cache->perm);
+    cache->csc  = csc_allocate(A->m, nnz);
+
+    ok = (cache->ia   != NULL) && (cache->ja  != NULL) &&
+         (cache->perm != NULL) && (cache->csc != NULL);
+
+    if (ok) {
+        cache->m   = A->m;
+        cache->nnz = nnz;
+        memcpy(cache->ia, A->ia, (A->m + 1) * sizeof *A->ia);
+        memcpy(cache->ja, A->ja,  nnz       * sizeof *A->ja);
+
+        /* Compute CSC structure as in csr_to_csc(), but record
+         * where each CSR nonzero ends up instead of copying
+         * values. */
+        count = cache->csc->p;
+        for (i = 0; i <= cache->csc->n; i++) { count[i] = 0; }
+
+        for (nz = 0; nz < cache->csc->nnz; nz++) {
+            count[ A->ja[nz] + 1 ] += 1;
+        }
+
+        for (i = 1; i <= cache->csc->n; i++) {
+            count[0] += count[i];
+            count[i]  = count[0] - count[i];
+        }
+
+        for (i = nz = 0; i < cache->csc->n; i++) {
+            for (; nz < A->ia[i + 1]; nz++) {
+                cache->perm  [nz]                      = count[ A->ja[nz] + 1 ];
+                cache->csc->i[ count[ A->ja[nz] + 1 ] ] = i;
+
+                count        [ A->ja[nz] + 1 ]        += 1;
+            }
+        }
+
+        count[0] = 0;
+
+        for (nz = 0; nz < cache->csc->nnz; nz++) {
+            cache->csc->x[ cache->perm[nz] ] = A->sa[nz];
+        }
+
+        ok = umfpack_dl_symbolic(cache->csc->n, cache->csc->n,
+                                 cache->csc->p, cache->csc->i,
+                                 cache->csc->x, &cache->Symbolic,
+                                 cache->Control, NULL) == UMFPACK_OK;
+    }
+
+    if (! ok) {
+        cache_clear(cache);
+    }
+
+    return ok;
+}
+
+
+/* ---------------------------------------------------------------------- */
+int
+call_UMFPACK_cached(struct CSRMatrix *A, const double *b, double *x,
+                    int refactor, struct UMFPACKCache *cache)
+/* ---------------------------------------------------------------------- */
+{
+    UF_long nz;
+    int     ok, new_pattern;
+
+    assert (cache != NULL);
+
+    new_pattern = ! same_pattern(A, cache);
+
+    ok = 1;
+    if (new_pattern) {
+        ok = cache_setup_pattern(A, cache);
+    }
+
+    if (ok && (new_pattern || refactor || (cache->Numeric == NULL))) {
+        if (! new_pattern) {
+            for (nz = 0; nz < cache->csc->nnz; nz++) {
+                cache->csc->x[ cache->perm[nz] ] = A->sa[nz];
+            }
+        }
+
+        if (cache->Numeric != NULL) {
+            umfpack_dl_free_numeric(&cache->Numeric);
+        }
+
+        ok = umfpack_dl_numeric(cache->csc->p, cache->csc->i,
+                                cache->csc->x, cache->Symbolic,
+                                &cache->Numeric, cache->Control,
+                                NULL) == UMFPACK_OK;
+    }
+
+    if (ok) {
+        ok = umfpack_dl_solve(UMFPACK_A, cache->csc->p, cache->csc->i,
+                              cache->csc->x, x, b, cache->Numeric,
+                              cache->Control, NULL) == UMFPACK_OK;
+    }
+
+    return ok;
+}
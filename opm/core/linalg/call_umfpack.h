@@ -40,9 +40,45 @@ extern "C" {
 #endif
 
 struct CSRMatrix;
+struct UMFPACKCache;
 
 void call_UMFPACK(struct CSRMatrix *A, const double *b, double *x);
 
+/**
+ * Create an object that keeps UMFPACK's symbolic and numeric
+ * factorisations between calls to call_UMFPACK_cached().
+ *
+ * @return New, empty cache.  Dispose of resources using
+ * call_UMFPACK_destroy_cache().  NULL in case of allocation failure.
+ */
+struct UMFPACKCache *
+call_UMFPACK_create_cache(void);
+
+void
+call_UMFPACK_destroy_cache(struct UMFPACKCache *cache);
+
+/**
+ * Solve A x = b, reusing the symbolic factorisation stored in the
+ * cache if the sparsity pattern of A is unchanged since the previous
+ * call.
+ *
+ * @param[in]     A         Matrix.
+ * @param[in]     b         Right-hand side.
+ * @param[out]    x         Solution.
+ * @param[in]     refactor  If zero, and the pattern is unchanged, the
+ *                          numeric factorisation from the previous call
+ *                          is used as is, i.e. the system solved is the
+ *                          one with the matrix values of that call (as
+ *                          in simplified Newton iterations).  Otherwise
+ *                          the numeric factorisation is recomputed.
+ * @param[in,out] cache     Factorisation cache.
+ *
+ * @return One (true) if successful, zero (false) otherwise.
+ */
+int
+call_UMFPACK_cached(struct CSRMatrix *A, const double *b, double *x,
+                    int refactor, struct UMFPACKCache *cache);
+
 #ifdef __cplusplus
 }
 #endif
@@ -28,6 +28,7 @@
 #include <opm/core/linalg/sparse_sys.h>
 #include <opm/core/utility/ErrorMacros.hpp>
 #include <opm/core/utility/miscUtilities.hpp>
+#include <opm/core/utility/Profiler.hpp>
 #include <opm/core/wells.h>
 #include <opm/core/simulator/BlackoilState.hpp>
 #include <opm/core/simulator/WellState.hpp>
@@ -273,8 +274,8 @@ namespace Opm
         //
         // std::vector<double> cell_A_;
         // std::vector<double> cell_dA_;
-        // std::vector<double> cell_viscosity_;
         // std::vector<double> cell_phasemob_;
+        // std::vector<double> cell_rho_;
         // std::vector<double> cell_voldisc_;
         // std::vector<double> face_A_;
         // std::vector<double> face_phasemob_;
@@ -301,8 +302,8 @@ namespace Opm
         //
         // std::vector<double> cell_A_;
         // std::vector<double> cell_dA_;
-        // std::vector<double> cell_viscosity_;
         // std::vector<double> cell_phasemob_;
+        // std::vector<double> cell_rho_;
         // std::vector<double> cell_voldisc_;
         // std::vector<double> porevol_;   // Only modified if rock_comp_props_ is non-null.
         // std::vector<double> rock_comp_; // Empty unless rock_comp_props_ is non-null.
@@ -312,17 +313,25 @@ namespace Opm
         const double* cell_T = &state.temperature()[0];
         const double* cell_z = &state.surfacevol()[0];
         const double* cell_s = &state.saturation()[0];
+        typedef BlackoilCellProperties CP;
+        props_.computeCellProperties(nc, cell_p, cell_T, cell_z, cell_s, &allcells_[0],
+                                     CP::Mobilities | CP::Densities | CP::MatrixDerivatives,
+                                     cell_props_);
+        // The assembly expects the values of each cell to be contiguous.
         cell_A_.resize(nc*np*np);
         cell_dA_.resize(nc*np*np);
-        props_.matrix(nc, cell_p, cell_T, cell_z, &allcells_[0], &cell_A_[0], &cell_dA_[0]);
-        cell_viscosity_.resize(nc*np);
-        props_.viscosity(nc, cell_p, cell_T, cell_z, &allcells_[0], &cell_viscosity_[0], 0);
         cell_phasemob_.resize(nc*np);
-        props_.relperm(nc, cell_s, &allcells_[0], &cell_phasemob_[0], 0);
-        std::transform(cell_phasemob_.begin(), cell_phasemob_.end(),
-                       cell_viscosity_.begin(),
-                       cell_phasemob_.begin(),
-                       std::divides<double>());
+        cell_rho_.resize(nc*np);
+        for (int cell = 0; cell < nc; ++cell) {
+            for (int k = 0; k < np*np; ++k) {
+                cell_A_[np*np*cell + k] = cell_props_.A[k*nc + cell];
+                cell_dA_[np*np*cell + k] = cell_props_.dAdp[k*nc + cell];
+            }
+            for (int phase = 0; phase < np; ++phase) {
+                cell_phasemob_[np*cell + phase] = cell_props_.mob[cell_props_.index(phase, cell)];
+                cell_rho_[np*cell + phase] = cell_props_.rho[cell_props_.index(phase, cell)];
+            }
+        }
         // Volume discrepancy: we have that
         //     z = Au, voldiscr = sum(u) - 1,
         // but I am not sure it is actually needed.
@@ -381,9 +390,8 @@ namespace Opm
                     // Gravity contribution, gravcontrib = rho*(face_z - cell_z) [per phase].
                     if (grav != 0.0) {
                         const double depth_diff = face_depth - grid_.cell_centroids[c[j]*dim + dim - 1];
-                        props_.density(1, &cell_A_[np*np*c[j]], &c[j], &gravcontrib[j][0]);
                         for (int p = 0; p < np; ++p) {
-                            gravcontrib[j][p] *= depth_diff*grav;
+                            gravcontrib[j][p] = cell_rho_[np*c[j] + p]*(depth_diff*grav);
                         }
                     } else {
                         std::fill(gravcontrib[j].begin(), gravcontrib[j].end(), 0.0);
@@ -508,6 +516,7 @@ namespace Opm
                                     const BlackoilState& state,
                                     const WellState& well_state)
     {
+        OPM_PROFILE_REGION("assemble");
         const double* cell_press = &state.pressure()[0];
         const double* well_bhp = well_state.bhp().empty() ? NULL : &well_state.bhp()[0];
         const double* z = &state.surfacevol()[0];
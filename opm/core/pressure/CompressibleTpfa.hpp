@@ -21,6 +21,8 @@
 #define OPM_COMPRESSIBLETPFA_HEADER_INCLUDED
 
 
+#include <opm/core/props/BlackoilPropertiesInterface.hpp>
+
 #include <vector>
 
 struct UnstructuredGrid;
@@ -32,7 +34,6 @@ namespace Opm
 {
 
     class BlackoilState;
-    class BlackoilPropertiesInterface;
     class RockCompressibility;
     class LinearSolverInterface;
     class WellState;
@@ -138,10 +139,11 @@ namespace Opm
         std::vector<double> initial_porevol_;
 
         // ------ Data that will be modified for every solver iteration. ------
+        BlackoilCellProperties cell_props_;
         std::vector<double> cell_A_;
         std::vector<double> cell_dA_;
-        std::vector<double> cell_viscosity_;
         std::vector<double> cell_phasemob_;
+        std::vector<double> cell_rho_;
         std::vector<double> cell_voldisc_;
         std::vector<double> face_A_;
         std::vector<double> face_phasemob_;
@@ -32,6 +32,7 @@
 #include <opm/core/simulator/WellState.hpp>
 #include <opm/core/utility/ErrorMacros.hpp>
 #include <opm/core/utility/miscUtilities.hpp>
+#include <opm/core/utility/Profiler.hpp>
 #include <opm/core/wells.h>
 #include <iostream>
 #include <iomanip>
@@ -177,9 +178,12 @@ namespace Opm
 
         // Assemble.
         UnstructuredGrid* gg = const_cast<UnstructuredGrid*>(&grid_);
-        int ok = ifs_tpfa_assemble(gg, &forces_, &trans_[0], &gpress_omegaweighted_[0], h_);
-        if (!ok) {
-            OPM_THROW(std::runtime_error, "Failed assembling pressure system.");
+        {
+            OPM_PROFILE_REGION("assemble");
+            int ok = ifs_tpfa_assemble(gg, &forces_, &trans_[0], &gpress_omegaweighted_[0], h_);
+            if (!ok) {
+                OPM_THROW(std::runtime_error, "Failed assembling pressure system.");
+            }
         }
 
         // Solve.
@@ -292,6 +296,9 @@ namespace Opm
         }
         const int num_dofs = grid_.number_of_cells + (wells_ ? wells_->number_of_wells : 0);
         pressures_.resize(num_dofs);
+        if (wells_) {
+            well_perforations_ = WellPerforationTable(*wells_, grid_);
+        }
         UnstructuredGrid* gg = const_cast<UnstructuredGrid*>(&grid_);
         tpfa_htrans_compute(gg, props_.permeability(), &htrans_[0]);
         if (gravity_) {
@@ -336,7 +343,7 @@ namespace Opm
 
         // wdp_
         if (wells_) {
-            Opm::computeWDP(*wells_, grid_, state.saturation(), props_.density(),
+            Opm::computeWDP(well_perforations_, state.saturation(), props_.density(),
                             gravity_ ? gravity_[2] : 0.0, true, wdp_);
         }
         // totmob_, omega_, gpress_omegaweighted_
@@ -399,6 +406,7 @@ namespace Opm
                               const TwophaseState& state,
                               const WellState& /*well_state*/)
     {
+        OPM_PROFILE_REGION("assemble");
         const double* pressures = wells_ ? &pressures_[0] : &state.pressure()[0];
 
         bool ok = ifs_tpfa_assemble_comprock_increment(const_cast<UnstructuredGrid*>(&grid_),
@@ -22,6 +22,7 @@
 
 
 #include <opm/core/pressure/tpfa/ifs_tpfa.h>
+#include <opm/core/wells/WellPerforationTable.hpp>
 #include <vector>
 
 struct UnstructuredGrid;
@@ -162,6 +163,7 @@ namespace Opm
 	std::vector<double> htrans_;
 	std::vector<double> gpress_;
         std::vector<int> allcells_;
+        WellPerforationTable well_perforations_;
 
         // ------ Data that will be modified for every solve. ------
 	std::vector<double> trans_ ;
@@ -21,11 +21,52 @@
 #include <opm/core/props/BlackoilPropertiesBasic.hpp>
 #include <opm/core/utility/Units.hpp>
 #include <opm/core/utility/ErrorMacros.hpp>
+#include <algorithm>
 #include <iostream>
 
 namespace Opm
 {
 
+    namespace
+    {
+        // Kernels of matrix() and density(). NP is the number of phases if
+        // known at compile time, zero if given by np at runtime.
+
+        template <int NP>
+        void diagonalMatrixKernel(const int n, const int np_runtime,
+                                  const double* B, double* A)
+        {
+            const int np = NP > 0 ? NP : np_runtime;
+            for (int i = 0; i < n; ++i) {
+                double* m = A + i*np*np;
+                for (int k = 0; k < np*np; ++k) {
+                    m[k] = 0.0;
+                }
+                // Diagonal entries only.
+                for (int phase = 0; phase < np; ++phase) {
+                    m[phase + phase*np] = 1.0/B[phase];
+                }
+            }
+        }
+
+        template <int NP>
+        void densityKernel(const int n, const int np_runtime,
+                           const double* A, const double* sdens, double* rho)
+        {
+            const int np = NP > 0 ? NP : np_runtime;
+            for (int i = 0; i < n; ++i) {
+                const double* Ai = A + i*np*np;
+                for (int phase = 0; phase < np; ++phase) {
+                    double r = 0.0;
+                    for (int comp = 0; comp < np; ++comp) {
+                        r += Ai[np*phase + comp]*sdens[comp];
+                    }
+                    rho[np*i + phase] = r;
+                }
+            }
+        }
+    } // anonymous namespace
+
     BlackoilPropertiesBasic::BlackoilPropertiesBasic(const parameter::ParameterGroup& param,
                                                      const int dim,
                                                      const int num_cells)
@@ -136,23 +177,15 @@ namespace Opm
         double B[2]; // Must be enough since component classes do not handle more than 2.
         pvt_.B(1, p, T, 0, B);
         // Compute A matrix
-// #pragma omp parallel for
-        for (int i = 0; i < n; ++i) {
-            double* m = A + i*np*np;
-            std::fill(m, m + np*np, 0.0);
-            // Diagonal entries only.
-            for (int phase = 0; phase < np; ++phase) {
-                m[phase + phase*np] = 1.0/B[phase];
-            }
+        if (np == 2) {
+            diagonalMatrixKernel<2>(n, np, B, A);
+        } else {
+            diagonalMatrixKernel<0>(n, np, B, A);
         }
 
         // Derivative of A matrix.
         if (dAdp) {
-// #pragma omp parallel for
-            for (int i = 0; i < n; ++i) {
-                double* m = dAdp + i*np*np;
-                std::fill(m, m + np*np, 0.0);
-            }
+            std::fill(dAdp, dAdp + n*np*np, 0.0);
         }
     }
 
@@ -170,14 +203,10 @@ namespace Opm
     {
         const int np = numPhases();
         const double* sdens = pvt_.surfaceDensities();
-// #pragma omp parallel for
-        for (int i = 0; i < n; ++i) {
-            for (int phase = 0; phase < np; ++phase) {
-                rho[np*i + phase] = 0.0;
-                for (int comp = 0; comp < np; ++comp) {
-                    rho[np*i + phase] += A[i*np*np + np*phase + comp]*sdens[comp];
-                }
-            }
+        if (np == 2) {
+            densityKernel<2>(n, np, A, sdens, rho);
+        } else {
+            densityKernel<0>(n, np, A, sdens, rho);
         }
     }
 
@@ -22,12 +22,129 @@
 #include <opm/material/fluidmatrixinteractions/EclMaterialLawManager.hpp>
 #include <opm/core/utility/parameters/ParameterGroup.hpp>
 #include <opm/core/utility/compressedToCartesian.hpp>
+#include <opm/core/utility/Profiler.hpp>
+#include <algorithm>
+#include <iostream>
 #include <vector>
 #include <numeric>
 
 namespace Opm
 {
 
+    namespace
+    {
+        // Work arrays are kept per thread, so that evaluation is
+        // reentrant and may be done concurrently from several threads.
+        struct Workspace
+        {
+            std::vector<double> B;
+            std::vector<double> dB;
+            std::vector<double> R;
+            std::vector<double> dR;
+            std::vector<double> mu;
+            std::vector<double> kr;
+            std::vector<double> dkrds;
+            std::vector<int> pvtTableIdx;
+        };
+
+        Workspace& workspace()
+        {
+            static thread_local Workspace ws;
+            return ws;
+        }
+
+        // Evaluate B and R (and their pressure derivatives if
+        // derivatives is true) into the workspace, by region if
+        // regions is non-null.
+        void evalBR(const BlackoilPvtProperties& pvt,
+                    const int n,
+                    const RegionMapping<>* regions,
+                    const int* pvtTableIdx,
+                    const double* p,
+                    const double* T,
+                    const double* z,
+                    const bool derivatives,
+                    Workspace& ws)
+        {
+            const int np = pvt.numPhases();
+            ws.B.resize(n*np);
+            ws.R.resize(n*np);
+            if (derivatives) {
+                ws.dB.resize(n*np);
+                ws.dR.resize(n*np);
+                if (regions) {
+                    pvt.dBdp(n, *regions, p, T, z, &ws.B[0], &ws.dB[0]);
+                    pvt.dRdp(n, *regions, p, z, &ws.R[0], &ws.dR[0]);
+                } else {
+                    pvt.dBdp(n, pvtTableIdx, p, T, z, &ws.B[0], &ws.dB[0]);
+                    pvt.dRdp(n, pvtTableIdx, p, z, &ws.R[0], &ws.dR[0]);
+                }
+            } else {
+                if (regions) {
+                    pvt.B(n, *regions, p, T, z, &ws.B[0]);
+                    pvt.R(n, *regions, p, z, &ws.R[0]);
+                } else {
+                    pvt.B(n, pvtTableIdx, p, T, z, &ws.B[0]);
+                    pvt.R(n, pvtTableIdx, p, z, &ws.R[0]);
+                }
+            }
+        }
+
+        // The A matrix of one point, in Fortran order, from its B
+        // and R values. o and g are the oil and gas phase positions.
+        inline void pointMatrix(const int np, const bool oil_and_gas,
+                                const int o, const int g,
+                                const double* B, const double* R,
+                                double* m)
+        {
+            std::fill(m, m + np*np, 0.0);
+            // Diagonal entries.
+            for (int phase = 0; phase < np; ++phase) {
+                m[phase + phase*np] = 1.0/B[phase];
+            }
+            // Off-diagonal entries.
+            if (oil_and_gas) {
+                m[o + g*np] = R[g]/B[g];
+                m[g + o*np] = R[o]/B[o];
+            }
+        }
+
+        // Derivative of A matrix.
+        // A     = R*inv(B) whence
+        //
+        // dA/dp = (dR/dp*inv(B) + R*d(inv(B))/dp)
+        //       = (dR/dp*inv(B) - R*inv(B)*(dB/dp)*inv(B))
+        //       = (dR/dp - A*(dB/dp)) * inv(B)
+        //
+        // The B matrix is diagonal and that fact is exploited in the
+        // following implementation, which expects m to hold A on entry.
+        inline void pointMatrixDerivative(const int np, const bool oil_and_gas,
+                                          const int o, const int g,
+                                          const double* B, const double* dB,
+                                          const double* dR, double* m)
+        {
+            // (2): dA/dp <- -dA/dp*(dB/dp) == -A*(dB/dp)
+            for (int col = 0; col < np; ++col) {
+                for (int row = 0; row < np; ++row) {
+                    m[col*np + row] *= - dB[ col ]; // Note sign.
+                }
+            }
+
+            if (oil_and_gas) {
+                // (2b): dA/dp += dR/dp (== dR/dp - A*(dB/dp))
+                m[o*np + g] += dR[ o ];
+                m[g*np + o] += dR[ g ];
+            }
+
+            // (3): dA/dp *= inv(B) (== final result)
+            for (int col = 0; col < np; ++col) {
+                for (int row = 0; row < np; ++row) {
+                    m[col*np + row] /= B[ col ];
+                }
+            }
+        }
+    } // anonymous namespace
+
     BlackoilPropertiesFromDeck::BlackoilPropertiesFromDeck(Opm::DeckConstPtr deck,
                                                            Opm::EclipseStateConstPtr eclState,
                                                            const UnstructuredGrid& grid,
@@ -157,13 +274,21 @@ namespace Opm
         // retrieve the cell specific PVT table index from the deck
         // and using the grid...
         extractPvtTableIndex(cellPvtRegionIdx_, deck, number_of_cells, global_cell);
+        if (deck->hasKeyword("PVTNUM") && param.getDefault("pvt_region_grouping", false)) {
+            cellPvtRegionMapping_.reset(new RegionMapping<>(cellPvtRegionIdx_));
+        }
 
         if(init_rock){
             rock_.init(eclState, number_of_cells, global_cell, cart_dims);
         }
 
         const int pvt_samples = param.getDefault("pvt_tab_size", -1);
-        pvt_.init(deck, eclState, pvt_samples);
+        const double pvt_tolerance = param.getDefault("pvt_tab_tolerance", 0.0);
+        const int pvt_max_samples = param.getDefault("pvt_tab_max_size", 1025);
+        pvt_.init(deck, eclState, pvt_samples, pvt_tolerance, pvt_max_samples);
+        OPM_MESSAGE_IF(pvt_samples <= 0 && pvt_tolerance > 0.0,
+                       "PVT tables resampled onto uniform grids, max relative error: "
+                       << pvt_.maxResamplingError());
 
         // Unfortunate lack of pointer smartness here...
         std::string threephase_model = param.getDefault<std::string>("threephase_model", "gwseg");
@@ -244,16 +369,17 @@ namespace Opm
                                                double* mu,
                                                double* dmudp) const
     {
+        OPM_PROFILE_REGION_STATS("props_viscosity");
         if (dmudp) {
             OPM_THROW(std::runtime_error, "BlackoilPropertiesFromDeck::viscosity()  --  derivatives of viscosity not yet implemented.");
         } else {
-            const int *cellPvtTableIdx = cellPvtRegionIndex();
-            assert(cellPvtTableIdx != 0);
-            std::vector<int> pvtTableIdx(n);
-            for (int i = 0; i < n; ++ i)
-                pvtTableIdx[i] = cellPvtTableIdx[cells[i]];
-
-            pvt_.mu(n, &pvtTableIdx[0], p, T, z, mu);
+            Workspace& ws = workspace();
+            const auto regions = pvtRegionMapping(n, cells, ws.pvtTableIdx);
+            if (regions) {
+                pvt_.mu(n, *regions, p, T, z, mu);
+            } else {
+                pvt_.mu(n, ws.pvtTableIdx.data(), p, T, z, mu);
+            }
         }
     }
 
@@ -276,24 +402,13 @@ namespace Opm
                                             double* A,
                                             double* dAdp) const
     {
+        OPM_PROFILE_REGION_STATS("props_matrix");
         const int np = numPhases();
+        Workspace& ws = workspace();
 
-        const int *cellPvtTableIdx = cellPvtRegionIndex();
-        std::vector<int> pvtTableIdx(n);
-        for (int i = 0; i < n; ++ i)
-            pvtTableIdx[i] = cellPvtTableIdx[cells[i]];
+        const auto regions = pvtRegionMapping(n, cells, ws.pvtTableIdx);
+        evalBR(pvt_, n, regions, ws.pvtTableIdx.data(), p, T, z, dAdp != 0, ws);
 
-        B_.resize(n*np);
-        R_.resize(n*np);
-        if (dAdp) {
-            dB_.resize(n*np);
-            dR_.resize(n*np);
-            pvt_.dBdp(n, &pvtTableIdx[0], p, T, z, &B_[0], &dB_[0]);
-            pvt_.dRdp(n, &pvtTableIdx[0], p, z, &R_[0], &dR_[0]);
-        } else {
-            pvt_.B(n, &pvtTableIdx[0], p, T, z, &B_[0]);
-            pvt_.R(n, &pvtTableIdx[0], p, z, &R_[0]);
-        }
         const int* phase_pos = pvt_.phasePosition();
         bool oil_and_gas = pvt_.phaseUsed()[BlackoilPhases::Liquid] &&
             pvt_.phaseUsed()[BlackoilPhases::Vapour];
@@ -303,59 +418,19 @@ namespace Opm
         // Compute A matrix
 // #pragma omp parallel for
         for (int i = 0; i < n; ++i) {
-            double* m = A + i*np*np;
-            std::fill(m, m + np*np, 0.0);
-            // Diagonal entries.
-            for (int phase = 0; phase < np; ++phase) {
-                m[phase + phase*np] = 1.0/B_[i*np + phase];
-            }
-            // Off-diagonal entries.
-            if (oil_and_gas) {
-                m[o + g*np] = R_[i*np + g]/B_[i*np + g];
-                m[g + o*np] = R_[i*np + o]/B_[i*np + o];
-            }
+            pointMatrix(np, oil_and_gas, o, g, &ws.B[i*np], &ws.R[i*np], A + i*np*np);
         }
 
-        // Derivative of A matrix.
-        // A     = R*inv(B) whence
-        //
-        // dA/dp = (dR/dp*inv(B) + R*d(inv(B))/dp)
-        //       = (dR/dp*inv(B) - R*inv(B)*(dB/dp)*inv(B))
-        //       = (dR/dp - A*(dB/dp)) * inv(B)
-        //
-        // The B matrix is diagonal and that fact is exploited in the
-        // following implementation.
+        // Derivative of A matrix, see pointMatrixDerivative().
         if (dAdp) {
 // #pragma omp parallel for
             // (1): dA/dp <- A
             std::copy(A, A + n*np*np, dAdp);
 
             for (int i = 0; i < n; ++i) {
-                double*       m  = dAdp + i*np*np;
-
-                // (2): dA/dp <- -dA/dp*(dB/dp) == -A*(dB/dp)
-                const double* dB = & dB_[i * np];
-                for (int col = 0; col < np; ++col) {
-                    for (int row = 0; row < np; ++row) {
-                        m[col*np + row] *= - dB[ col ]; // Note sign.
-                    }
-                }
-
-                if (oil_and_gas) {
-                    // (2b): dA/dp += dR/dp (== dR/dp - A*(dB/dp))
-                    const double* dR = & dR_[i * np];
-
-                    m[o*np + g] += dR[ o ];
-                    m[g*np + o] += dR[ g ];
-                }
-
-                // (3): dA/dp *= inv(B) (== final result)
-                const double* B = & B_[i * np];
-                for (int col = 0; col < np; ++col) {
-                    for (int row = 0; row < np; ++row) {
-                        m[col*np + row] /= B[ col ];
-                    }
-                }
+                pointMatrixDerivative(np, oil_and_gas, o, g,
+                                      &ws.B[i*np], &ws.dB[i*np], &ws.dR[i*np],
+                                      dAdp + i*np*np);
             }
         }
     }
@@ -373,18 +448,174 @@ namespace Opm
                                              double* rho) const
     {
         const int np = numPhases();
-// #pragma omp parallel for
-        for (int i = 0; i < n; ++i) {
-            int cellIdx = cells?cells[i]:i;
-            int pvtRegionIdx = getTableIndex_(cellPvtRegionIndex(), cellIdx);
-            const double* sdens = pvt_.surfaceDensities(pvtRegionIdx);
+        auto pointDensity = [&](const int i, const double* sdens) {
             for (int phase = 0; phase < np; ++phase) {
                 rho[np*i + phase] = 0.0;
                 for (int comp = 0; comp < np; ++comp) {
                     rho[np*i + phase] += A[i*np*np + np*phase + comp]*sdens[comp];
                 }
             }
+        };
+
+        Workspace& ws = workspace();
+        const auto regions = pvtRegionMapping(n, cells, ws.pvtTableIdx);
+        const int* pvtTableIdx = ws.pvtTableIdx.data();
+        if (regions) {
+            for (const int region : regions->activeRegions()) {
+                const double* sdens = pvt_.surfaceDensities(region);
+                for (const auto i : regions->cells(region)) {
+                    pointDensity(i, sdens);
+                }
+            }
+        } else {
+// #pragma omp parallel for
+            for (int i = 0; i < n; ++i) {
+                pointDensity(i, pvt_.surfaceDensities(pvtTableIdx[i]));
+            }
+        }
+    }
+
+    /// Compute several fluid properties in one pass. The PVT and
+    /// saturation function evaluations are each done once for all
+    /// points, and a single loop over the points then forms the
+    /// requested quantities, with the same arithmetic as viscosity(),
+    /// relperm(), matrix() and density(), so that the results are
+    /// identical to those of separate calls.
+    void BlackoilPropertiesFromDeck::computeCellProperties(const int n,
+                                                           const double* p,
+                                                           const double* T,
+                                                           const double* z,
+                                                           const double* s,
+                                                           const int* cells,
+                                                           const int quantities,
+                                                           BlackoilCellProperties& props) const
+    {
+        OPM_PROFILE_REGION_STATS("props_cell_properties");
+        typedef BlackoilCellProperties CP;
+        const bool mobilities         = quantities & CP::Mobilities;
+        const bool densities          = quantities & CP::Densities;
+        const bool matrices           = (quantities & CP::Matrices) || densities;
+        const bool mob_derivatives    = mobilities && (quantities & CP::MobilityDerivatives);
+        const bool matrix_derivatives = matrices && (quantities & CP::MatrixDerivatives);
+        if (mobilities && s == 0) {
+            OPM_THROW(std::runtime_error, "computeCellProperties(): saturations are required for mobilities.");
+        }
+
+        const int np = numPhases();
+        props.num_points = n;
+        props.num_phases = np;
+        props.mob   .resize(mobilities ? n*np : 0);
+        props.totmob.resize(mobilities ? n : 0);
+        props.dmobds.resize(mob_derivatives ? n*np*np : 0);
+        props.A     .resize(matrices ? n*np*np : 0);
+        props.B     .resize(matrices ? n*np : 0);
+        props.dAdp  .resize(matrix_derivatives ? n*np*np : 0);
+        props.rho   .resize(densities ? n*np : 0);
+
+        Workspace& ws = workspace();
+        const auto regions = pvtRegionMapping(n, cells, ws.pvtTableIdx);
+        const int* pvtTableIdx = ws.pvtTableIdx.data();
+
+        if (mobilities) {
+            ws.mu.resize(n*np);
+            ws.kr.resize(n*np);
+            ws.dkrds.resize(mob_derivatives ? n*np*np : 0);
+            if (regions) {
+                pvt_.mu(n, *regions, p, T, z, ws.mu.data());
+            } else {
+                pvt_.mu(n, pvtTableIdx, p, T, z, ws.mu.data());
+            }
+            satprops_->relperm(n, s, cells, ws.kr.data(),
+                               mob_derivatives ? ws.dkrds.data() : 0);
+        }
+        if (matrices) {
+            evalBR(pvt_, n, regions, pvtTableIdx, p, T, z, matrix_derivatives, ws);
+        }
+
+        const int* phase_pos = pvt_.phasePosition();
+        const bool oil_and_gas = pvt_.phaseUsed()[BlackoilPhases::Liquid] &&
+            pvt_.phaseUsed()[BlackoilPhases::Vapour];
+        const int o = phase_pos[BlackoilPhases::Liquid];
+        const int g = phase_pos[BlackoilPhases::Vapour];
+        const int maxnp2 = BlackoilPhases::MaxNumPhases*BlackoilPhases::MaxNumPhases;
+
+        for (int i = 0; i < n; ++i) {
+            if (mobilities) {
+                const double* mu = &ws.mu[np*i];
+                const double* kr = &ws.kr[np*i];
+                double totmob = 0.0;
+                for (int phase = 0; phase < np; ++phase) {
+                    const double mob = kr[phase] / mu[phase];
+                    props.mob[props.index(phase, i)] = mob;
+                    totmob += mob;
+                }
+                props.totmob[i] = totmob;
+                if (mob_derivatives) {
+                    const double* dkrds = &ws.dkrds[np*np*i];
+                    for (int col = 0; col < np; ++col) {
+                        for (int row = 0; row < np; ++row) {
+                            props.dmobds[props.index(row, col, i)]
+                                = dkrds[np*col + row] / mu[row];
+                        }
+                    }
+                }
+            }
+
+            if (matrices) {
+                double a[maxnp2];
+                pointMatrix(np, oil_and_gas, o, g, &ws.B[np*i], &ws.R[np*i], a);
+                for (int k = 0; k < np*np; ++k) {
+                    props.A[k*n + i] = a[k];
+                }
+                for (int phase = 0; phase < np; ++phase) {
+                    props.B[props.index(phase, i)] = 1.0 / a[np*phase + phase];
+                }
+                if (matrix_derivatives) {
+                    double da[maxnp2];
+                    std::copy(a, a + np*np, da);
+                    pointMatrixDerivative(np, oil_and_gas, o, g,
+                                          &ws.B[np*i], &ws.dB[np*i], &ws.dR[np*i], da);
+                    for (int k = 0; k < np*np; ++k) {
+                        props.dAdp[k*n + i] = da[k];
+                    }
+                }
+                if (densities) {
+                    const double* sdens = pvt_.surfaceDensities(pvtTableIdx[i]);
+                    for (int phase = 0; phase < np; ++phase) {
+                        double rho = 0.0;
+                        for (int comp = 0; comp < np; ++comp) {
+                            rho += a[np*phase + comp]*sdens[comp];
+                        }
+                        props.rho[props.index(phase, i)] = rho;
+                    }
+                }
+            }
+        }
+    }
+
+    const RegionMapping<>*
+    BlackoilPropertiesFromDeck::pvtRegionMapping(const int n,
+                                                 const int* cells,
+                                                 std::vector<int>& pvtTableIdx) const
+    {
+        const int* cellPvtTableIdx = cellPvtRegionIndex();
+        assert(cellPvtTableIdx != 0);
+        pvtTableIdx.resize(n);
+        bool all_cells = (n == int(cellPvtRegionIdx_.size()));
+        for (int i = 0; i < n; ++i) {
+            const int cellIdx = cells ? cells[i] : i;
+            pvtTableIdx[i] = cellPvtTableIdx[cellIdx];
+            all_cells = all_cells && (cellIdx == i);
+        }
+
+        // Building a mapping for a subset of the cells on every call
+        // costs more than grouping saves, so subsets are evaluated in
+        // point order.
+        if (!all_cells || !cellPvtRegionMapping_
+            || cellPvtRegionMapping_->activeRegions().size() < 2) {
+            return 0;
         }
+        return cellPvtRegionMapping_.get();
     }
 
     /// Densities of stock components at surface conditions.
@@ -410,6 +641,7 @@ namespace Opm
                                              double* kr,
                                              double* dkrds) const
     {
+        OPM_PROFILE_REGION_STATS("props_relperm");
         satprops_->relperm(n, s, cells, kr, dkrds);
     }
 
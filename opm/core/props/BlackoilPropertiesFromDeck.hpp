@@ -26,6 +26,7 @@
 #include <opm/core/props/pvt/BlackoilPvtProperties.hpp>
 #include <opm/core/props/satfunc/SaturationPropsFromDeck.hpp>
 #include <opm/core/utility/parameters/ParameterGroup.hpp>
+#include <opm/core/utility/RegionMapping.hpp>
 
 #include <opm/parser/eclipse/Deck/Deck.hpp>
 
@@ -38,6 +39,11 @@ namespace Opm
 
     /// Concrete class implementing the blackoil property interface,
     /// reading all data and properties from eclipse deck input.
+    ///
+    /// Once constructed, all const member functions are reentrant:
+    /// they may be called concurrently from several threads, as long
+    /// as no thread calls a non-const member function (such as
+    /// swatInitScaling()) at the same time.
     class BlackoilPropertiesFromDeck : public BlackoilPropertiesInterface
     {
     public:
@@ -63,6 +69,11 @@ namespace Opm
         ///                        threephase_model("simple")  three-phase relperm model (accepts "simple" and "stone2").
         ///                      For both size parameters, a 0 or negative value indicates that no spline fitting is to
         ///                      be done, and the input fluid data used directly for linear interpolation.
+        ///                        pvt_tab_tolerance (0.0)     if positive, dead-oil pvt tables are resampled onto
+        ///                                                    uniform grids with this maximum relative error,
+        ///                        pvt_tab_max_size (1025)     using at most this number of points.
+        ///                        pvt_region_grouping (false) evaluate pvt properties region by region (PVTNUM)
+        ///                                                    when called for all cells.
         BlackoilPropertiesFromDeck(Opm::DeckConstPtr deck,
                                    Opm::EclipseStateConstPtr eclState,
                                    const UnstructuredGrid& grid,
@@ -180,6 +191,21 @@ namespace Opm
         /// \return Array of P density values.
         virtual const double* surfaceDensity(int cellIdx = 0) const;
 
+        /// Compute several fluid properties in one pass, see
+        /// BlackoilPropertiesInterface::computeCellProperties(). The
+        /// table lookups are done once for all points, followed by a
+        /// single loop forming the requested quantities. The results
+        /// are identical to those of separate calls to viscosity(),
+        /// relperm(), matrix() and density().
+        virtual void computeCellProperties(const int n,
+                                           const double* p,
+                                           const double* T,
+                                           const double* z,
+                                           const double* s,
+                                           const int* cells,
+                                           const int quantities,
+                                           BlackoilCellProperties& props) const;
+
         /// \param[in]  n      Number of data points.
         /// \param[in]  s      Array of nP saturation values.
         /// \param[in]  cells  Array of n cell indices to be associated with the s values.
@@ -241,6 +267,16 @@ namespace Opm
             return pvtTableIdx[cellIdx];
         }
 
+        // Fill pvtTableIdx with the PVT region of each point, and
+        // return the grouping of all cells by PVT region if the points
+        // are all cells in order. Returns null if grouping is disabled
+        // (parameter pvt_region_grouping), all cells are in the same
+        // region, or the points are some other set of cells.
+        const RegionMapping<>*
+        pvtRegionMapping(const int n,
+                         const int* cells,
+                         std::vector<int>& pvtTableIdx) const;
+
         void init(Opm::DeckConstPtr deck,
                   Opm::EclipseStateConstPtr eclState,
                   std::shared_ptr<MaterialLawManager> materialLawManager,
@@ -260,13 +296,10 @@ namespace Opm
 
         RockFromDeck rock_;
         std::vector<int> cellPvtRegionIdx_;
+        std::shared_ptr<const RegionMapping<> > cellPvtRegionMapping_;
         BlackoilPvtProperties pvt_;
         std::shared_ptr<MaterialLawManager> materialLawManager_;
         std::shared_ptr<SaturationPropsInterface> satprops_;
-        mutable std::vector<double> B_;
-        mutable std::vector<double> dB_;
-        mutable std::vector<double> R_;
-        mutable std::vector<double> dR_;
     };
 
 
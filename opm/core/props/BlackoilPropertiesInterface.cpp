@@ -0,0 +1,127 @@
+/*
+  Copyright 2015 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "config.h"
+#include <opm/core/props/BlackoilPropertiesInterface.hpp>
+#include <opm/core/utility/ErrorMacros.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace Opm
+{
+
+    void BlackoilPropertiesInterface::computeCellProperties(const int n,
+                                                            const double* p,
+                                                            const double* T,
+                                                            const double* z,
+                                                            const double* s,
+                                                            const int* cells,
+                                                            const int quantities,
+                                                            BlackoilCellProperties& props) const
+    {
+        typedef BlackoilCellProperties CP;
+        const bool mobilities         = quantities & CP::Mobilities;
+        const bool densities          = quantities & CP::Densities;
+        const bool matrices           = (quantities & CP::Matrices) || densities;
+        const bool mob_derivatives    = mobilities && (quantities & CP::MobilityDerivatives);
+        const bool matrix_derivatives = matrices && (quantities & CP::MatrixDerivatives);
+        if (mobilities && s == 0) {
+            OPM_THROW(std::runtime_error, "computeCellProperties(): saturations are required for mobilities.");
+        }
+
+        const int np = numPhases();
+        props.num_points = n;
+        props.num_phases = np;
+        props.mob   .resize(mobilities ? n*np : 0);
+        props.totmob.resize(mobilities ? n : 0);
+        props.dmobds.resize(mob_derivatives ? n*np*np : 0);
+        props.A     .resize(matrices ? n*np*np : 0);
+        props.B     .resize(matrices ? n*np : 0);
+        props.dAdp  .resize(matrix_derivatives ? n*np*np : 0);
+        props.rho   .resize(densities ? n*np : 0);
+
+        // Block size chosen so that all block arrays fit comfortably in
+        // the L1 cache for three phases.
+        const int block_size = 64;
+        std::vector<double> mu(block_size*np);
+        std::vector<double> kr(block_size*np);
+        std::vector<double> dkrds(mob_derivatives ? block_size*np*np : 0);
+        std::vector<double> A(block_size*np*np);
+        std::vector<double> dAdp(matrix_derivatives ? block_size*np*np : 0);
+        std::vector<double> rho(block_size*np);
+
+        for (int start = 0; start < n; start += block_size) {
+            const int bs = std::min(block_size, n - start);
+            const double* bp = p + start;
+            const double* bT = T ? T + start : 0;
+            const double* bz = z ? z + np*start : 0;
+            const int* bcells = cells + start;
+
+            if (mobilities) {
+                viscosity(bs, bp, bT, bz, bcells, &mu[0], 0);
+                relperm(bs, s + np*start, bcells, &kr[0], mob_derivatives ? &dkrds[0] : 0);
+                for (int i = 0; i < bs; ++i) {
+                    double totmob = 0.0;
+                    for (int phase = 0; phase < np; ++phase) {
+                        const double mob = kr[np*i + phase] / mu[np*i + phase];
+                        props.mob[props.index(phase, start + i)] = mob;
+                        totmob += mob;
+                    }
+                    props.totmob[start + i] = totmob;
+                    if (mob_derivatives) {
+                        for (int col = 0; col < np; ++col) {
+                            for (int row = 0; row < np; ++row) {
+                                props.dmobds[props.index(row, col, start + i)]
+                                    = dkrds[np*np*i + np*col + row] / mu[np*i + row];
+                            }
+                        }
+                    }
+                }
+            }
+
+            if (matrices) {
+                matrix(bs, bp, bT, bz, bcells, &A[0], matrix_derivatives ? &dAdp[0] : 0);
+                for (int i = 0; i < bs; ++i) {
+                    for (int k = 0; k < np*np; ++k) {
+                        props.A[k*n + start + i] = A[np*np*i + k];
+                    }
+                    for (int phase = 0; phase < np; ++phase) {
+                        props.B[props.index(phase, start + i)] = 1.0 / A[np*np*i + np*phase + phase];
+                    }
+                    if (matrix_derivatives) {
+                        for (int k = 0; k < np*np; ++k) {
+                            props.dAdp[k*n + start + i] = dAdp[np*np*i + k];
+                        }
+                    }
+                }
+            }
+
+            if (densities) {
+                density(bs, &A[0], bcells, &rho[0]);
+                for (int i = 0; i < bs; ++i) {
+                    for (int phase = 0; phase < np; ++phase) {
+                        props.rho[props.index(phase, start + i)] = rho[np*i + phase];
+                    }
+                }
+            }
+        }
+    }
+
+} // namespace Opm
@@ -20,11 +20,58 @@
 #ifndef OPM_BLACKOILPROPERTIESINTERFACE_HEADER_INCLUDED
 #define OPM_BLACKOILPROPERTIESINTERFACE_HEADER_INCLUDED
 
+#include <vector>
+
 namespace Opm
 {
 
     struct PhaseUsage;
 
+    /// Fluid properties of a set of points, as computed by
+    /// BlackoilPropertiesInterface::computeCellProperties().
+    /// The data are stored as a structure of arrays: for n points
+    /// and P phases, the value of a phase quantity for phase p in
+    /// point i is at index p*n + i, and the (row, col) entry of a
+    /// P x P matrix quantity is at index (row + col*P)*n + i.
+    /// Quantities that were not requested are left empty.
+    struct BlackoilCellProperties
+    {
+        /// Quantities that may be requested, combine with bitwise or.
+        enum Quantity {
+            Mobilities          = 1,  ///< mob, totmob (and dmobds with MobilityDerivatives)
+            Matrices            = 2,  ///< A, B (and dAdp with MatrixDerivatives)
+            Densities           = 4,  ///< rho, implies that A and B are computed
+            MatrixDerivatives   = 8,  ///< dAdp, if A is computed
+            MobilityDerivatives = 16, ///< dmobds, if mob is computed
+            Derivatives         = MatrixDerivatives | MobilityDerivatives
+        };
+
+        int num_points;
+        int num_phases;
+
+        std::vector<double> mob;     ///< Phase mobilities kr/mu.
+        std::vector<double> dmobds;  ///< Matrix of d(mob_row)/d(s_col).
+        std::vector<double> totmob;  ///< Total mobility, n values.
+        std::vector<double> A;       ///< Matrix A = RB^{-1}, see matrix().
+        std::vector<double> dAdp;    ///< Pressure derivative of A.
+        std::vector<double> B;       ///< Formation volume factors.
+        std::vector<double> rho;     ///< Phase densities at reservoir conditions.
+
+        BlackoilCellProperties() : num_points(0), num_phases(0) {}
+
+        /// Index of a phase quantity.
+        int index(const int phase, const int i) const
+        {
+            return phase*num_points + i;
+        }
+
+        /// Index of a matrix quantity.
+        int index(const int row, const int col, const int i) const
+        {
+            return (row + col*num_phases)*num_points + i;
+        }
+    };
+
     /// Abstract base class for blackoil fluid and reservoir properties.
     /// Supports variable number of spatial dimensions, called D.
     /// Supports variable number of phases, but assumes that
@@ -174,6 +221,32 @@ namespace Opm
                                       const double pcow, 
                                       double & swat) = 0;
 
+
+        /// Compute several fluid properties in one pass over the
+        /// input arrays. The points are processed in small blocks,
+        /// calling viscosity(), relperm(), matrix() and density() for
+        /// each block, so that the inputs and intermediate results
+        /// stay in cache. BlackoilPropertiesFromDeck overrides this
+        /// with a single loop over the points.
+        /// \param[in]  n           Number of data points.
+        /// \param[in]  p           Array of n pressure values.
+        /// \param[in]  T           Array of n temperature values.
+        /// \param[in]  z           Array of nP surface volume values.
+        /// \param[in]  s           Array of nP saturation values, may be null
+        ///                         if mobilities are not requested.
+        /// \param[in]  cells       Array of n cell indices.
+        /// \param[in]  quantities  Requested quantities, a combination of
+        ///                         BlackoilCellProperties::Quantity values.
+        /// \param[out] props       Computed properties, resized as needed.
+        virtual void computeCellProperties(const int n,
+                                           const double* p,
+                                           const double* T,
+                                           const double* z,
+                                           const double* s,
+                                           const int* cells,
+                                           const int quantities,
+                                           BlackoilCellProperties& props) const;
+
     };
 
 
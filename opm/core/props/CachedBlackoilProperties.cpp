@@ -0,0 +1,372 @@
+/*
+  Copyright 2015 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "config.h"
+#include <opm/core/props/CachedBlackoilProperties.hpp>
+#include <opm/core/props/BlackoilPhases.hpp>
+#include <opm/core/utility/ErrorMacros.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace Opm
+{
+
+    namespace
+    {
+        bool unchanged(const double x, const double y, const double tolerance)
+        {
+            return std::abs(x - y) <= tolerance*std::max(std::abs(x), std::abs(y));
+        }
+
+        // Copy the width values of the points in index from src to dst.
+        void gather(const double* src, const int width,
+                    const std::vector<int>& index, std::vector<double>& dst)
+        {
+            dst.resize(index.size()*width);
+            for (std::size_t k = 0; k < index.size(); ++k) {
+                std::copy(src + width*index[k], src + width*(index[k] + 1), &dst[width*k]);
+            }
+        }
+    } // anonymous namespace
+
+
+
+    CachedBlackoilProperties::CachedBlackoilProperties(std::shared_ptr<const BlackoilPropertiesInterface> props,
+                                                       const double tolerance)
+        : props_(props),
+          tolerance_(tolerance),
+          cache_(NumQuantities)
+    {
+        if (!props_) {
+            OPM_THROW(std::runtime_error, "CachedBlackoilProperties: no properties to wrap.");
+        }
+        const int np = props_->numPhases();
+        cache_[Viscosity].num_inputs = 2 + np;
+        cache_[Viscosity].num_values = np;
+        cache_[Viscosity].num_derivatives = np;
+        cache_[Matrix].num_inputs = 2 + np;
+        cache_[Matrix].num_values = np*np;
+        cache_[Matrix].num_derivatives = np*np;
+        cache_[Relperm].num_inputs = np;
+        cache_[Relperm].num_values = np;
+        cache_[Relperm].num_derivatives = np*np;
+        cache_[CapPress].num_inputs = np;
+        cache_[CapPress].num_values = np;
+        cache_[CapPress].num_derivatives = np*np;
+    }
+
+
+
+    void CachedBlackoilProperties::invalidate()
+    {
+        for (int q = 0; q < NumQuantities; ++q) {
+            std::fill(cache_[q].state.begin(), cache_[q].state.end(), char(Empty));
+        }
+    }
+
+
+
+    const CachedBlackoilProperties::Statistics&
+    CachedBlackoilProperties::statistics(const Quantity q) const
+    {
+        return cache_[q].statistics;
+    }
+
+
+
+    void CachedBlackoilProperties::resetStatistics()
+    {
+        for (int q = 0; q < NumQuantities; ++q) {
+            cache_[q].statistics = Statistics();
+        }
+    }
+
+
+
+    // Copy remembered values for the points with unchanged input, and
+    // collect the other points in misses_.index. The input of point i
+    // is the concatenation of the widths[a] values at inputs[a] +
+    // widths[a]*i for a = 0, ..., num_arrays - 1.
+    int CachedBlackoilProperties::lookup(Cache& cache, const int n, const int* cells,
+                                         const double* const* inputs, const int* widths,
+                                         const int num_arrays,
+                                         double* values, double* derivatives) const
+    {
+        const int nc = props_->numCells();
+        if (cache.state.empty()) {
+            cache.input.resize(nc*cache.num_inputs);
+            cache.value.resize(nc*cache.num_values);
+            cache.derivative.resize(nc*cache.num_derivatives);
+            cache.state.resize(nc, Empty);
+        }
+        const char required = derivatives ? HasDerivatives : HasValues;
+
+        misses_.index.clear();
+        for (int i = 0; i < n; ++i) {
+            const int cell = cells[i];
+            bool hit = cell >= 0 && cell < nc && cache.state[cell] >= required;
+            const double* remembered = hit ? &cache.input[cell*cache.num_inputs] : 0;
+            for (int a = 0; hit && a < num_arrays; ++a) {
+                const double* in = inputs[a] + widths[a]*i;
+                for (int k = 0; k < widths[a]; ++k) {
+                    if (!unchanged(in[k], remembered[k], tolerance_)) {
+                        hit = false;
+                        break;
+                    }
+                }
+                remembered += widths[a];
+            }
+            if (hit) {
+                const double* v = &cache.value[cell*cache.num_values];
+                std::copy(v, v + cache.num_values, values + cache.num_values*i);
+                if (derivatives) {
+                    const double* d = &cache.derivative[cell*cache.num_derivatives];
+                    std::copy(d, d + cache.num_derivatives, derivatives + cache.num_derivatives*i);
+                }
+            } else {
+                misses_.index.push_back(i);
+            }
+        }
+        const int num_misses = misses_.index.size();
+        cache.statistics.hits += n - num_misses;
+        cache.statistics.misses += num_misses;
+
+        // Gather the cell indices of the misses, and size the output.
+        misses_.cells.resize(num_misses);
+        for (int k = 0; k < num_misses; ++k) {
+            misses_.cells[k] = cells[misses_.index[k]];
+        }
+        misses_.value.resize(num_misses*cache.num_values);
+        misses_.derivative.resize(derivatives ? num_misses*cache.num_derivatives : 0);
+        return num_misses;
+    }
+
+
+
+    // Scatter the evaluated values of the points in misses_.index to
+    // the output arrays, and remember them with their input.
+    void CachedBlackoilProperties::store(Cache& cache, const int* cells,
+                                         const double* const* inputs, const int* widths,
+                                         const int num_arrays,
+                                         double* values, double* derivatives) const
+    {
+        const int nc = props_->numCells();
+        const int nv = cache.num_values;
+        const int nd = cache.num_derivatives;
+        for (std::size_t k = 0; k < misses_.index.size(); ++k) {
+            const int i = misses_.index[k];
+            const double* v = &misses_.value[nv*k];
+            std::copy(v, v + nv, values + nv*i);
+            const double* d = derivatives ? &misses_.derivative[nd*k] : 0;
+            if (derivatives) {
+                std::copy(d, d + nd, derivatives + nd*i);
+            }
+
+            const int cell = cells[i];
+            if (cell < 0 || cell >= nc) {
+                continue;
+            }
+            double* remembered = &cache.input[cell*cache.num_inputs];
+            for (int a = 0; a < num_arrays; ++a) {
+                std::copy(inputs[a] + widths[a]*i, inputs[a] + widths[a]*(i + 1), remembered);
+                remembered += widths[a];
+            }
+            std::copy(v, v + nv, &cache.value[nv*cell]);
+            if (derivatives) {
+                std::copy(d, d + nd, &cache.derivative[nd*cell]);
+            }
+            cache.state[cell] = derivatives ? HasDerivatives : HasValues;
+        }
+    }
+
+
+
+    // ---- Rock interface ----
+
+    int CachedBlackoilProperties::numDimensions() const
+    {
+        return props_->numDimensions();
+    }
+
+    int CachedBlackoilProperties::numCells() const
+    {
+        return props_->numCells();
+    }
+
+    const int* CachedBlackoilProperties::cellPvtRegionIndex() const
+    {
+        return props_->cellPvtRegionIndex();
+    }
+
+    const double* CachedBlackoilProperties::porosity() const
+    {
+        return props_->porosity();
+    }
+
+    const double* CachedBlackoilProperties::permeability() const
+    {
+        return props_->permeability();
+    }
+
+
+
+    // ---- Fluid interface ----
+
+    int CachedBlackoilProperties::numPhases() const
+    {
+        return props_->numPhases();
+    }
+
+    PhaseUsage CachedBlackoilProperties::phaseUsage() const
+    {
+        return props_->phaseUsage();
+    }
+
+    void CachedBlackoilProperties::viscosity(const int n,
+                                             const double* p,
+                                             const double* T,
+                                             const double* z,
+                                             const int* cells,
+                                             double* mu,
+                                             double* dmudp) const
+    {
+        if (!cells || !T || !z) {
+            props_->viscosity(n, p, T, z, cells, mu, dmudp);
+            return;
+        }
+        const int np = numPhases();
+        const double* inputs[3] = { p, T, z };
+        const int widths[3] = { 1, 1, np };
+        Cache& cache = cache_[Viscosity];
+        const int m = lookup(cache, n, cells, inputs, widths, 3, mu, dmudp);
+        if (m > 0) {
+            gather(p, 1, misses_.index, misses_.p);
+            gather(T, 1, misses_.index, misses_.T);
+            gather(z, np, misses_.index, misses_.z);
+            props_->viscosity(m, &misses_.p[0], &misses_.T[0], &misses_.z[0], &misses_.cells[0],
+                              &misses_.value[0], dmudp ? &misses_.derivative[0] : 0);
+            store(cache, cells, inputs, widths, 3, mu, dmudp);
+        }
+    }
+
+    void CachedBlackoilProperties::matrix(const int n,
+                                          const double* p,
+                                          const double* T,
+                                          const double* z,
+                                          const int* cells,
+                                          double* A,
+                                          double* dAdp) const
+    {
+        if (!cells || !T || !z) {
+            props_->matrix(n, p, T, z, cells, A, dAdp);
+            return;
+        }
+        const int np = numPhases();
+        const double* inputs[3] = { p, T, z };
+        const int widths[3] = { 1, 1, np };
+        Cache& cache = cache_[Matrix];
+        const int m = lookup(cache, n, cells, inputs, widths, 3, A, dAdp);
+        if (m > 0) {
+            gather(p, 1, misses_.index, misses_.p);
+            gather(T, 1, misses_.index, misses_.T);
+            gather(z, np, misses_.index, misses_.z);
+            props_->matrix(m, &misses_.p[0], &misses_.T[0], &misses_.z[0], &misses_.cells[0],
+                           &misses_.value[0], dAdp ? &misses_.derivative[0] : 0);
+            store(cache, cells, inputs, widths, 3, A, dAdp);
+        }
+    }
+
+    void CachedBlackoilProperties::density(const int n,
+                                           const double* A,
+                                           const int* cells,
+                                           double* rho) const
+    {
+        props_->density(n, A, cells, rho);
+    }
+
+    const double* CachedBlackoilProperties::surfaceDensity(int regionIdx) const
+    {
+        return props_->surfaceDensity(regionIdx);
+    }
+
+    void CachedBlackoilProperties::relperm(const int n,
+                                           const double* s,
+                                           const int* cells,
+                                           double* kr,
+                                           double* dkrds) const
+    {
+        if (!cells) {
+            props_->relperm(n, s, cells, kr, dkrds);
+            return;
+        }
+        const int np = numPhases();
+        const double* inputs[1] = { s };
+        const int widths[1] = { np };
+        Cache& cache = cache_[Relperm];
+        const int m = lookup(cache, n, cells, inputs, widths, 1, kr, dkrds);
+        if (m > 0) {
+            gather(s, np, misses_.index, misses_.z);
+            props_->relperm(m, &misses_.z[0], &misses_.cells[0],
+                            &misses_.value[0], dkrds ? &misses_.derivative[0] : 0);
+            store(cache, cells, inputs, widths, 1, kr, dkrds);
+        }
+    }
+
+    void CachedBlackoilProperties::capPress(const int n,
+                                            const double* s,
+                                            const int* cells,
+                                            double* pc,
+                                            double* dpcds) const
+    {
+        if (!cells) {
+            props_->capPress(n, s, cells, pc, dpcds);
+            return;
+        }
+        const int np = numPhases();
+        const double* inputs[1] = { s };
+        const int widths[1] = { np };
+        Cache& cache = cache_[CapPress];
+        const int m = lookup(cache, n, cells, inputs, widths, 1, pc, dpcds);
+        if (m > 0) {
+            gather(s, np, misses_.index, misses_.z);
+            props_->capPress(m, &misses_.z[0], &misses_.cells[0],
+                             &misses_.value[0], dpcds ? &misses_.derivative[0] : 0);
+            store(cache, cells, inputs, widths, 1, pc, dpcds);
+        }
+    }
+
+    void CachedBlackoilProperties::satRange(const int n,
+                                            const int* cells,
+                                            double* smin,
+                                            double* smax) const
+    {
+        props_->satRange(n, cells, smin, smax);
+    }
+
+    void CachedBlackoilProperties::swatInitScaling(const int /*cell*/,
+                                                   const double /*pcow*/,
+                                                   double& /*swat*/)
+    {
+        OPM_THROW(std::runtime_error, "CachedBlackoilProperties::swatInitScaling()  --  not supported, "
+                  "call the wrapped properties object instead.");
+    }
+
+} // namespace Opm
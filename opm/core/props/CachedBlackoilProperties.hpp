@@ -0,0 +1,189 @@
+/*
+  Copyright 2015 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_CACHEDBLACKOILPROPERTIES_HEADER_INCLUDED
+#define OPM_CACHEDBLACKOILPROPERTIES_HEADER_INCLUDED
+
+#include <opm/core/props/BlackoilPropertiesInterface.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace Opm
+{
+
+    /// Wrapper around another BlackoilPropertiesInterface object that
+    /// remembers the last evaluation of viscosity(), matrix(),
+    /// relperm() and capPress() in each cell, and returns the
+    /// remembered values when the same cell is evaluated again with
+    /// unchanged input. Only the points whose input has changed are
+    /// passed on to the wrapped object.
+    ///
+    /// An input value x is considered unchanged from the remembered
+    /// value y if |x - y| <= tolerance*max(|x|, |y|). With the default
+    /// tolerance of zero, only identical input is unchanged, and the
+    /// results are identical to those of the wrapped object.
+    ///
+    /// The cache is keyed on the cell index only, so points that are
+    /// not associated with a grid cell (i.e. with an index outside
+    /// [0, numCells())) and calls without cell indices, temperatures
+    /// or surface volumes are always passed on. Unlike the wrapped
+    /// object, this class is not safe to use from several threads
+    /// concurrently. swatInitScaling() is not supported, since it
+    /// would modify the wrapped object.
+    class CachedBlackoilProperties : public BlackoilPropertiesInterface
+    {
+    public:
+        /// Cached quantities.
+        enum Quantity { Viscosity, Matrix, Relperm, CapPress, NumQuantities };
+
+        /// Number of cache hits and misses, counted per point.
+        struct Statistics
+        {
+            Statistics() : hits(0), misses(0) {}
+            std::size_t hits;
+            std::size_t misses;
+            /// Fraction of points served from the cache.
+            double hitRate() const
+            {
+                return hits + misses > 0 ? double(hits)/double(hits + misses) : 0.0;
+            }
+        };
+
+        /// Construct wrapper.
+        /// \param[in]  props      The properties to evaluate.
+        /// \param[in]  tolerance  Relative tolerance for input changes.
+        explicit CachedBlackoilProperties(std::shared_ptr<const BlackoilPropertiesInterface> props,
+                                          const double tolerance = 0.0);
+
+        /// Forget all remembered evaluations, for example if the
+        /// wrapped object has been modified.
+        void invalidate();
+
+        /// Hit and miss counts of a quantity since construction or the
+        /// last call to resetStatistics().
+        const Statistics& statistics(const Quantity q) const;
+
+        /// Reset all hit and miss counts.
+        void resetStatistics();
+
+        // ---- Rock interface ----
+
+        virtual int numDimensions() const;
+        virtual int numCells() const;
+        virtual const int* cellPvtRegionIndex() const;
+        virtual const double* porosity() const;
+        virtual const double* permeability() const;
+
+        // ---- Fluid interface ----
+
+        virtual int numPhases() const;
+        virtual PhaseUsage phaseUsage() const;
+
+        virtual void viscosity(const int n,
+                               const double* p,
+                               const double* T,
+                               const double* z,
+                               const int* cells,
+                               double* mu,
+                               double* dmudp) const;
+
+        virtual void matrix(const int n,
+                            const double* p,
+                            const double* T,
+                            const double* z,
+                            const int* cells,
+                            double* A,
+                            double* dAdp) const;
+
+        virtual void density(const int n,
+                             const double* A,
+                             const int* cells,
+                             double* rho) const;
+
+        virtual const double* surfaceDensity(int regionIdx = 0) const;
+
+        virtual void relperm(const int n,
+                             const double* s,
+                             const int* cells,
+                             double* kr,
+                             double* dkrds) const;
+
+        virtual void capPress(const int n,
+                              const double* s,
+                              const int* cells,
+                              double* pc,
+                              double* dpcds) const;
+
+        virtual void satRange(const int n,
+                              const int* cells,
+                              double* smin,
+                              double* smax) const;
+
+        virtual void swatInitScaling(const int cell,
+                                     const double pcow,
+                                     double& swat);
+
+    private:
+        // Remembered evaluations of one quantity.
+        struct Cache
+        {
+            Cache() : num_inputs(0), num_values(0), num_derivatives(0) {}
+            int num_inputs;
+            int num_values;
+            int num_derivatives;
+            std::vector<double> input;        // num_inputs per cell
+            std::vector<double> value;        // num_values per cell
+            std::vector<double> derivative;   // num_derivatives per cell
+            std::vector<char> state;          // one of the CacheState values per cell
+            Statistics statistics;
+        };
+
+        enum CacheState { Empty = 0, HasValues = 1, HasDerivatives = 2 };
+
+        // Points of the current call that must be evaluated, and
+        // their gathered input and output.
+        struct Misses
+        {
+            std::vector<int> index;
+            std::vector<int> cells;
+            std::vector<double> p, T, z;
+            std::vector<double> value, derivative;
+        };
+
+        int lookup(Cache& cache, const int n, const int* cells,
+                   const double* const* inputs, const int* widths,
+                   const int num_arrays,
+                   double* values, double* derivatives) const;
+
+        void store(Cache& cache, const int* cells,
+                   const double* const* inputs, const int* widths,
+                   const int num_arrays,
+                   double* values, double* derivatives) const;
+
+        std::shared_ptr<const BlackoilPropertiesInterface> props_;
+        double tolerance_;
+        mutable std::vector<Cache> cache_;
+        mutable Misses misses_;
+    };
+
+} // namespace Opm
+
+#endif // OPM_CACHEDBLACKOILPROPERTIES_HEADER_INCLUDED
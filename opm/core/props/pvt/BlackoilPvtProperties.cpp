@@ -34,18 +34,45 @@
 #include <opm/parser/eclipse/Deck/Deck.hpp>
 #include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
 
+#include <algorithm>
+
 namespace Opm
 {
 
+    namespace
+    {
+        // Work arrays are kept per thread, so that evaluation is
+        // reentrant and may be done concurrently from several threads.
+        struct Workspace
+        {
+            std::vector<double> data1;
+            std::vector<double> data2;
+            std::vector<int> region_idx;
+            std::vector<double> region_p;
+            std::vector<double> region_T;
+            std::vector<double> region_z;
+        };
+
+        Workspace& workspace()
+        {
+            static thread_local Workspace ws;
+            return ws;
+        }
+    } // anonymous namespace
+
     BlackoilPvtProperties::BlackoilPvtProperties()
+        : max_resampling_error_(0.0)
     {
     }
 
     void BlackoilPvtProperties::init(Opm::DeckConstPtr deck,
                                      Opm::EclipseStateConstPtr eclipseState,
-                                     int numSamples)
+                                     int numSamples,
+                                     double resampleTolerance,
+                                     int maxResampleSize)
     {
         phase_usage_ = phaseUsageFromDeck(deck);
+        max_resampling_error_ = 0.0;
 
         // Surface densities. Accounting for different orders in eclipse and our code.
         Opm::DeckKeywordConstPtr densityKeyword = deck->getKeyword("DENSITY");
@@ -95,7 +122,8 @@ namespace Opm
                         props_[phase_usage_.phase_pos[Liquid]] = splinePvt;
                     } else {
                         auto deadPvt = std::shared_ptr<PvtDead>(new PvtDead);
-                        deadPvt->initFromOil(pvdoTables);
+                        deadPvt->initFromOil(pvdoTables, resampleTolerance, maxResampleSize);
+                        max_resampling_error_ = std::max(max_resampling_error_, deadPvt->maxResamplingError());
                         props_[phase_usage_.phase_pos[Liquid]] = deadPvt;
                     }
                 } else if (pvtoTables.size() > 0) {
@@ -122,7 +150,8 @@ namespace Opm
                         props_[phase_usage_.phase_pos[Vapour]] = splinePvt;
                     } else {
                         std::shared_ptr<PvtDead> deadPvt(new PvtDead);
-                        deadPvt->initFromGas(pvdgTables);
+                        deadPvt->initFromGas(pvdgTables, resampleTolerance, maxResampleSize);
+                        max_resampling_error_ = std::max(max_resampling_error_, deadPvt->maxResamplingError());
 
                         props_[phase_usage_.phase_pos[Vapour]] = deadPvt;
                     }
@@ -135,6 +164,11 @@ namespace Opm
         }
     }
 
+    double BlackoilPvtProperties::maxResamplingError() const
+    {
+        return max_resampling_error_;
+    }
+
     const double* BlackoilPvtProperties::surfaceDensities(int regionIdx) const
     {
         return &densities_[regionIdx][0];
@@ -169,12 +203,13 @@ namespace Opm
                                    const double* z,
                                    double* output_mu) const
     {
-        data1_.resize(n);
+        Workspace& ws = workspace();
+        ws.data1.resize(n);
         for (int phase = 0; phase < phase_usage_.num_phases; ++phase) {
-            props_[phase]->mu(n, pvtTableIdx, p, T, z, &data1_[0]);
+            props_[phase]->mu(n, pvtTableIdx, p, T, z, &ws.data1[0]);
 // #pragma omp parallel for
             for (int i = 0; i < n; ++i) {
-                output_mu[phase_usage_.num_phases*i + phase] = data1_[i];
+                output_mu[phase_usage_.num_phases*i + phase] = ws.data1[i];
             }
         }
     }
@@ -186,12 +221,13 @@ namespace Opm
                                   const double* z,
                                   double* output_B) const
     {
-        data1_.resize(n);
+        Workspace& ws = workspace();
+        ws.data1.resize(n);
         for (int phase = 0; phase < phase_usage_.num_phases; ++phase) {
-            props_[phase]->B(n, pvtTableIdx, p, T, z, &data1_[0]);
+            props_[phase]->B(n, pvtTableIdx, p, T, z, &ws.data1[0]);
 // #pragma omp parallel for
             for (int i = 0; i < n; ++i) {
-                output_B[phase_usage_.num_phases*i + phase] = data1_[i];
+                output_B[phase_usage_.num_phases*i + phase] = ws.data1[i];
             }
         }
     }
@@ -204,14 +240,15 @@ namespace Opm
                                      double* output_B,
                                      double* output_dBdp) const
     {
-        data1_.resize(n);
-        data2_.resize(n);
+        Workspace& ws = workspace();
+        ws.data1.resize(n);
+        ws.data2.resize(n);
         for (int phase = 0; phase < phase_usage_.num_phases; ++phase) {
-            props_[phase]->dBdp(n, pvtTableIdx, p, T, z, &data1_[0], &data2_[0]);
+            props_[phase]->dBdp(n, pvtTableIdx, p, T, z, &ws.data1[0], &ws.data2[0]);
 // #pragma omp parallel for
             for (int i = 0; i < n; ++i) {
-                output_B[phase_usage_.num_phases*i + phase] = data1_[i];
-                output_dBdp[phase_usage_.num_phases*i + phase] = data2_[i];
+                output_B[phase_usage_.num_phases*i + phase] = ws.data1[i];
+                output_dBdp[phase_usage_.num_phases*i + phase] = ws.data2[i];
             }
         }
     }
@@ -223,12 +260,13 @@ namespace Opm
                                   const double* z,
                                   double* output_R) const
     {
-        data1_.resize(n);
+        Workspace& ws = workspace();
+        ws.data1.resize(n);
         for (int phase = 0; phase < phase_usage_.num_phases; ++phase) {
-            props_[phase]->R(n, pvtTableIdx, p, z, &data1_[0]);
+            props_[phase]->R(n, pvtTableIdx, p, z, &ws.data1[0]);
 // #pragma omp parallel for
             for (int i = 0; i < n; ++i) {
-                output_R[phase_usage_.num_phases*i + phase] = data1_[i];
+                output_R[phase_usage_.num_phases*i + phase] = ws.data1[i];
             }
         }
     }
@@ -240,15 +278,146 @@ namespace Opm
                                      double* output_R,
                                      double* output_dRdp) const
     {
-        data1_.resize(n);
-        data2_.resize(n);
+        Workspace& ws = workspace();
+        ws.data1.resize(n);
+        ws.data2.resize(n);
         for (int phase = 0; phase < phase_usage_.num_phases; ++phase) {
-            props_[phase]->dRdp(n, pvtTableIdx, p, z, &data1_[0], &data2_[0]);
+            props_[phase]->dRdp(n, pvtTableIdx, p, z, &ws.data1[0], &ws.data2[0]);
 // #pragma omp parallel for
             for (int i = 0; i < n; ++i) {
-                output_R[phase_usage_.num_phases*i + phase] = data1_[i];
-                output_dRdp[phase_usage_.num_phases*i + phase] = data2_[i];
+                output_R[phase_usage_.num_phases*i + phase] = ws.data1[i];
+                output_dRdp[phase_usage_.num_phases*i + phase] = ws.data2[i];
+            }
+        }
+    }
+
+
+    template <class Eval>
+    void BlackoilPvtProperties::evalByRegion(const int n,
+                                             const RegionMapping<>& regions,
+                                             const double* p,
+                                             const double* T,
+                                             const double* z,
+                                             double* output1,
+                                             double* output2,
+                                             Eval eval) const
+    {
+        if (n == 0) {
+            return;
+        }
+        Workspace& ws = workspace();
+        const int np = phase_usage_.num_phases;
+        ws.region_idx.resize(n);
+        ws.region_p.resize(n);
+        ws.region_T.resize(n);
+        ws.region_z.resize(n*np);
+        ws.data1.resize(n);
+        ws.data2.resize(n);
+
+        for (const int region : regions.activeRegions()) {
+            const auto cells = regions.cells(region);
+            const int m = cells.size();
+
+            // Gather inputs.
+            int i = 0;
+            for (const auto cell : cells) {
+                ws.region_p[i] = p[cell];
+                ws.region_T[i] = T ? T[cell] : 0.0;
+                for (int phase = 0; phase < np; ++phase) {
+                    ws.region_z[np*i + phase] = z[np*cell + phase];
+                }
+                ++i;
+            }
+            std::fill(ws.region_idx.begin(), ws.region_idx.begin() + m, region);
+
+            // Evaluate and scatter outputs.
+            for (int phase = 0; phase < np; ++phase) {
+                eval(phase, m, &ws.region_idx[0], &ws.region_p[0], &ws.region_T[0], &ws.region_z[0],
+                     &ws.data1[0], &ws.data2[0]);
+                i = 0;
+                for (const auto cell : cells) {
+                    output1[np*cell + phase] = ws.data1[i];
+                    if (output2) {
+                        output2[np*cell + phase] = ws.data2[i];
+                    }
+                    ++i;
+                }
             }
         }
     }
+
+    void BlackoilPvtProperties::mu(const int n,
+                                   const RegionMapping<>& regions,
+                                   const double* p,
+                                   const double* T,
+                                   const double* z,
+                                   double* output_mu) const
+    {
+        evalByRegion(n, regions, p, T, z, output_mu, 0,
+                     [&](const int phase, const int m, const int* idx,
+                         const double* rp, const double* rT, const double* rz,
+                         double* out1, double* /* out2 */) {
+                         props_[phase]->mu(m, idx, rp, rT, rz, out1);
+                     });
+    }
+
+    void BlackoilPvtProperties::B(const int n,
+                                  const RegionMapping<>& regions,
+                                  const double* p,
+                                  const double* T,
+                                  const double* z,
+                                  double* output_B) const
+    {
+        evalByRegion(n, regions, p, T, z, output_B, 0,
+                     [&](const int phase, const int m, const int* idx,
+                         const double* rp, const double* rT, const double* rz,
+                         double* out1, double* /* out2 */) {
+                         props_[phase]->B(m, idx, rp, rT, rz, out1);
+                     });
+    }
+
+    void BlackoilPvtProperties::dBdp(const int n,
+                                     const RegionMapping<>& regions,
+                                     const double* p,
+                                     const double* T,
+                                     const double* z,
+                                     double* output_B,
+                                     double* output_dBdp) const
+    {
+        evalByRegion(n, regions, p, T, z, output_B, output_dBdp,
+                     [&](const int phase, const int m, const int* idx,
+                         const double* rp, const double* rT, const double* rz,
+                         double* out1, double* out2) {
+                         props_[phase]->dBdp(m, idx, rp, rT, rz, out1, out2);
+                     });
+    }
+
+    void BlackoilPvtProperties::R(const int n,
+                                  const RegionMapping<>& regions,
+                                  const double* p,
+                                  const double* z,
+                                  double* output_R) const
+    {
+        evalByRegion(n, regions, p, 0, z, output_R, 0,
+                     [&](const int phase, const int m, const int* idx,
+                         const double* rp, const double* /* rT */, const double* rz,
+                         double* out1, double* /* out2 */) {
+                         props_[phase]->R(m, idx, rp, rz, out1);
+                     });
+    }
+
+    void BlackoilPvtProperties::dRdp(const int n,
+                                     const RegionMapping<>& regions,
+                                     const double* p,
+                                     const double* z,
+                                     double* output_R,
+                                     double* output_dRdp) const
+    {
+        evalByRegion(n, regions, p, 0, z, output_R, output_dRdp,
+                     [&](const int phase, const int m, const int* idx,
+                         const double* rp, const double* /* rT */, const double* rz,
+                         double* out1, double* out2) {
+                         props_[phase]->dRdp(m, idx, rp, rz, out1, out2);
+                     });
+    }
 } // namespace Opm
@@ -22,6 +22,7 @@
 
 #include <opm/core/props/pvt/PvtInterface.hpp>
 #include <opm/core/props/BlackoilPhases.hpp>
+#include <opm/core/utility/RegionMapping.hpp>
 
 #include <opm/parser/eclipse/Deck/Deck.hpp>
 #include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
@@ -44,6 +45,8 @@ namespace Opm
     /// by PvtInterface is that this collects all phases' properties,
     /// and therefore the output arrays are of size n*num_phases as opposed
     /// to size n in PvtInterface.
+    /// After init(), all const member functions may be called
+    /// concurrently from several threads.
     class BlackoilPvtProperties : public BlackoilPhases
     {
     public:
@@ -53,9 +56,23 @@ namespace Opm
         /// Initialize from deck.
         ///
         /// \param deck     An input deck from the opm-parser module.
+        /// \param samples  If positive, dead oil and dry gas tables
+        ///                 are represented by splines with this
+        ///                 number of samples.
+        /// \param resampleTolerance  If positive (and samples is not),
+        ///                 dead oil and dry gas tables are resampled
+        ///                 onto uniform grids with at most
+        ///                 maxResampleSize points, aiming for this
+        ///                 maximum relative error.
         void init(Opm::DeckConstPtr deck,
                   Opm::EclipseStateConstPtr eclipseState,
-                  int samples);
+                  int samples,
+                  double resampleTolerance = 0.0,
+                  int maxResampleSize = 1025);
+
+        /// Maximum relative error introduced by resampling tables,
+        /// zero if no tables were resampled.
+        double maxResamplingError() const;
 
         /// \return   Object describing the active phases.
         PhaseUsage phaseUsage() const;
@@ -117,20 +134,82 @@ namespace Opm
                   double* output_R,
                   double* output_dRdp) const;
 
+        /// \name Region-grouped evaluation.
+        /// These methods are equivalent to the ones above, but take a
+        /// mapping from the evaluation points 0..n-1 to PVT regions.
+        /// The points are evaluated region by region, so that only
+        /// one region's tables are in use at a time, and the results
+        /// are scattered back to the original order.
+        /// @{
+
+        /// Viscosity as a function of p, T and z.
+        void mu(const int n,
+                const RegionMapping<>& regions,
+                const double* p,
+                const double* T,
+                const double* z,
+                double* output_mu) const;
+
+        /// Formation volume factor as a function of p, T and z.
+        void B(const int n,
+               const RegionMapping<>& regions,
+               const double* p,
+               const double* T,
+               const double* z,
+               double* output_B) const;
+
+        /// Formation volume factor and p-derivative as functions of p, T and z.
+        void dBdp(const int n,
+                  const RegionMapping<>& regions,
+                  const double* p,
+                  const double* T,
+                  const double* z,
+                  double* output_B,
+                  double* output_dBdp) const;
+
+        /// Solution factor as a function of p and z.
+        void R(const int n,
+               const RegionMapping<>& regions,
+               const double* p,
+               const double* z,
+               double* output_R) const;
+
+        /// Solution factor and p-derivative as functions of p and z.
+        void dRdp(const int n,
+                  const RegionMapping<>& regions,
+                  const double* p,
+                  const double* z,
+                  double* output_R,
+                  double* output_dRdp) const;
+
+        /// @}
+
     private:
         // Disabling copying (just to avoid surprises, since we use shared_ptr).
         BlackoilPvtProperties(const BlackoilPvtProperties&);
         BlackoilPvtProperties& operator=(const BlackoilPvtProperties&);
 
+        // Gather the inputs of the points in one region, call
+        // eval(phase, m, tableIdx, p, T, z, out1, out2) for each phase,
+        // and scatter the outputs. out2 is only used if output2 is
+        // non-null.
+        template <class Eval>
+        void evalByRegion(const int n,
+                          const RegionMapping<>& regions,
+                          const double* p,
+                          const double* T,
+                          const double* z,
+                          double* output1,
+                          double* output2,
+                          Eval eval) const;
+
         PhaseUsage phase_usage_;
 
         // The PVT properties. We need to store one object per PVT
         // region per active fluid phase.
         std::vector<std::shared_ptr<PvtInterface> > props_;
         std::vector<std::array<double, MaxNumPhases> > densities_;
-
-        mutable std::vector<double> data1_;
-        mutable std::vector<double> data2_;
+        double max_resampling_error_;
     };
 
 }
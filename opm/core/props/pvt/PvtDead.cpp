@@ -20,6 +20,7 @@
 
 #include "config.h"
 #include <opm/core/props/pvt/PvtDead.hpp>
+#include <opm/core/utility/buildUniformLinearTable.hpp>
 #include <algorithm>
 
 // Extra includes for debug dumping of tables.
@@ -34,7 +35,9 @@ namespace Opm
     // Member functions
     //-------------------------------------------------------------------------
     /// Constructor
-    void PvtDead::initFromOil(const std::vector<Opm::PvdoTable>& pvdoTables)
+    void PvtDead::initFromOil(const std::vector<Opm::PvdoTable>& pvdoTables,
+                              const double resampleTolerance,
+                              const int maxSamples)
     {
         int numRegions = pvdoTables.size();
 
@@ -65,11 +68,17 @@ namespace Opm
             b_[regionIdx] = NonuniformTableLinear<double>(press, inverseB);
             viscosity_[regionIdx] = NonuniformTableLinear<double>(press, visc);
             inverseBmu_[regionIdx] = NonuniformTableLinear<double>(press, inverseBmu);
+
+            if (resampleTolerance > 0.0) {
+                resample(regionIdx, press, inverseB, inverseBmu, resampleTolerance, maxSamples);
+            }
         }
     }
 
 
-    void PvtDead::initFromGas(const std::vector<Opm::PvdgTable>& pvdgTables)
+    void PvtDead::initFromGas(const std::vector<Opm::PvdgTable>& pvdgTables,
+                              const double resampleTolerance,
+                              const int maxSamples)
     {
         int numRegions = pvdgTables.size();
 
@@ -100,6 +109,10 @@ namespace Opm
             b_[regionIdx] = NonuniformTableLinear<double>(press, inverseB);
             viscosity_[regionIdx] = NonuniformTableLinear<double>(press, visc);
             inverseBmu_[regionIdx] = NonuniformTableLinear<double>(press, inverseBmu);
+
+            if (resampleTolerance > 0.0) {
+                resample(regionIdx, press, inverseB, inverseBmu, resampleTolerance, maxSamples);
+            }
         }
     }
 
@@ -109,6 +122,33 @@ namespace Opm
     }
 
 
+    void PvtDead::resample(const int regionIdx,
+                           const std::vector<double>& press,
+                           const std::vector<double>& inverseB,
+                           const std::vector<double>& inverseBmu,
+                           const double tolerance,
+                           const int maxSamples)
+    {
+        const int numRegions = b_.size();
+        uniform_b_.resize(numRegions);
+        uniform_inverseBmu_.resize(numRegions);
+        uniform_ = true;
+
+        double error = buildUniformLinearTable(press, inverseB, tolerance, maxSamples,
+                                               uniform_b_[regionIdx]);
+        max_resampling_error_ = std::max(max_resampling_error_, error);
+        error = buildUniformLinearTable(press, inverseBmu, tolerance, maxSamples,
+                                        uniform_inverseBmu_[regionIdx]);
+        max_resampling_error_ = std::max(max_resampling_error_, error);
+    }
+
+
+    double PvtDead::maxResamplingError() const
+    {
+        return max_resampling_error_;
+    }
+
+
 
     void PvtDead::mu(const int n,
                      const int* pvtTableIdx,
@@ -120,8 +160,8 @@ namespace Opm
 // #pragma omp parallel for
         for (int i = 0; i < n; ++i) {
             int regionIdx = getTableIndex_(pvtTableIdx, i);
-            double tempInvB = b_[regionIdx](p[i]);
-            double tempInvBmu = inverseBmu_[regionIdx](p[i]);
+            double tempInvB = inverseB(regionIdx, p[i]);
+            double tempInvBmu = inverseBmu(regionIdx, p[i]);
             output_mu[i] = tempInvB / tempInvBmu;
         }
     }
@@ -138,11 +178,11 @@ namespace Opm
     // #pragma omp parallel for
             for (int i = 0; i < n; ++i) {
                 int regionIdx = getTableIndex_(pvtTableIdx, i);
-                double tempInvB = b_[regionIdx](p[i]);
-                double tempInvBmu = inverseBmu_[regionIdx](p[i]);
+                double tempInvB = inverseB(regionIdx, p[i]);
+                double tempInvBmu = inverseBmu(regionIdx, p[i]);
                 output_mu[i] = tempInvB / tempInvBmu;
-                output_dmudp[i] = (tempInvBmu * b_[regionIdx].derivative(p[i])
-                                 - tempInvB * inverseBmu_[regionIdx].derivative(p[i])) / (tempInvBmu * tempInvBmu);
+                output_dmudp[i] = (tempInvBmu * inverseBDeriv(regionIdx, p[i])
+                                 - tempInvB * inverseBmuDeriv(regionIdx, p[i])) / (tempInvBmu * tempInvBmu);
             }
             std::fill(output_dmudr, output_dmudr + n, 0.0);
 
@@ -161,11 +201,11 @@ namespace Opm
     // #pragma omp parallel for
             for (int i = 0; i < n; ++i) {
                 int regionIdx = getTableIndex_(pvtTableIdx, i);
-                double tempInvB = b_[regionIdx](p[i]);
-                double tempInvBmu = inverseBmu_[regionIdx](p[i]);
+                double tempInvB = inverseB(regionIdx, p[i]);
+                double tempInvBmu = inverseBmu(regionIdx, p[i]);
                 output_mu[i] = tempInvB / tempInvBmu;
-                output_dmudp[i] = (tempInvBmu * b_[regionIdx].derivative(p[i])
-                                 - tempInvB * inverseBmu_[regionIdx].derivative(p[i]))
+                output_dmudp[i] = (tempInvBmu * inverseBDeriv(regionIdx, p[i])
+                                 - tempInvB * inverseBmuDeriv(regionIdx, p[i]))
                                  / (tempInvBmu * tempInvBmu);
             }
             std::fill(output_dmudr, output_dmudr + n, 0.0);
@@ -183,7 +223,7 @@ namespace Opm
         // B = 1/b
         for (int i = 0; i < n; ++i) {
             int regionIdx = getTableIndex_(pvtTableIdx, i);
-            output_B[i] = 1.0/b_[regionIdx](p[i]);
+            output_B[i] = 1.0/inverseB(regionIdx, p[i]);
         }
     }
 
@@ -200,7 +240,7 @@ namespace Opm
         for (int i = 0; i < n; ++i) {
             int regionIdx = getTableIndex_(pvtTableIdx, i);
             double Bg = output_B[i];
-            output_dBdp[i] = -Bg*Bg*b_[regionIdx].derivative(p[i]);
+            output_dBdp[i] = -Bg*Bg*inverseBDeriv(regionIdx, p[i]);
         }
     }
 
@@ -218,8 +258,8 @@ namespace Opm
             for (int i = 0; i < n; ++i) {
                 int regionIdx = getTableIndex_(pvtTableIdx, i);
 
-                output_b[i] = b_[regionIdx](p[i]);
-                output_dbdp[i] = b_[regionIdx].derivative(p[i]);
+                output_b[i] = inverseB(regionIdx, p[i]);
+                output_dbdp[i] = inverseBDeriv(regionIdx, p[i]);
 
             }
             std::fill(output_dbdr, output_dbdr + n, 0.0);
@@ -241,8 +281,8 @@ namespace Opm
             for (int i = 0; i < n; ++i) {
                 int regionIdx = getTableIndex_(pvtTableIdx, i);
 
-                output_b[i] = b_[regionIdx](p[i]);
-                output_dbdp[i] = b_[regionIdx].derivative(p[i]);
+                output_b[i] = inverseB(regionIdx, p[i]);
+                output_dbdp[i] = inverseBDeriv(regionIdx, p[i]);
 
             }
             std::fill(output_dbdr, output_dbdr + n, 0.0);
@@ -22,6 +22,7 @@
 
 #include <opm/core/props/pvt/PvtInterface.hpp>
 #include <opm/core/utility/NonuniformTableLinear.hpp>
+#include <opm/core/utility/UniformTableLinear.hpp>
 
 #include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
 
@@ -44,12 +45,28 @@ namespace Opm
     class PvtDead : public PvtInterface
     {
     public:
-        PvtDead() {};
-
-        void initFromOil(const std::vector<Opm::PvdoTable>& pvdoTables);
-        void initFromGas(const std::vector<Opm::PvdgTable>& pvdgTables);
+        PvtDead() : uniform_(false), max_resampling_error_(0.0) {};
+
+        /// Initialise from PVDO tables.
+        /// If resampleTolerance is positive, the tables are resampled
+        /// onto uniform pressure grids of at most maxSamples points,
+        /// with maximum relative deviation resampleTolerance if
+        /// possible, and lookups use index arithmetic instead of
+        /// binary search.
+        void initFromOil(const std::vector<Opm::PvdoTable>& pvdoTables,
+                         const double resampleTolerance = 0.0,
+                         const int maxSamples = 1025);
+
+        /// Initialise from PVDG tables. Resampling as for initFromOil().
+        void initFromGas(const std::vector<Opm::PvdgTable>& pvdgTables,
+                         const double resampleTolerance = 0.0,
+                         const int maxSamples = 1025);
         virtual ~PvtDead();
 
+        /// Maximum relative deviation of resampled tables from the
+        /// input tables, zero if tables are not resampled.
+        double maxResamplingError() const;
+
         /// Viscosity as a function of p, T and z.
         virtual void mu(const int n,
                         const int* pvtTableIdx,
@@ -158,11 +175,44 @@ namespace Opm
             return pvtTableIdx[cellIdx];
         }
 
+        void resample(const int regionIdx,
+                      const std::vector<double>& press,
+                      const std::vector<double>& inverseB,
+                      const std::vector<double>& inverseBmu,
+                      const double tolerance,
+                      const int maxSamples);
+
+        double inverseB(const int regionIdx, const double p) const
+        {
+            return uniform_ ? uniform_b_[regionIdx](p) : b_[regionIdx](p);
+        }
+
+        double inverseBDeriv(const int regionIdx, const double p) const
+        {
+            return uniform_ ? uniform_b_[regionIdx].derivative(p) : b_[regionIdx].derivative(p);
+        }
+
+        double inverseBmu(const int regionIdx, const double p) const
+        {
+            return uniform_ ? uniform_inverseBmu_[regionIdx](p) : inverseBmu_[regionIdx](p);
+        }
+
+        double inverseBmuDeriv(const int regionIdx, const double p) const
+        {
+            return uniform_ ? uniform_inverseBmu_[regionIdx].derivative(p) : inverseBmu_[regionIdx].derivative(p);
+        }
+
         // PVT properties of dry gas or dead oil. We need to store one
         // table per PVT region.
         std::vector<NonuniformTableLinear<double> > b_;
         std::vector<NonuniformTableLinear<double> > viscosity_;
         std::vector<NonuniformTableLinear<double> > inverseBmu_;
+
+        // Optional uniformly resampled tables, used if uniform_ is true.
+        bool uniform_;
+        double max_resampling_error_;
+        std::vector<UniformTableLinear<double> > uniform_b_;
+        std::vector<UniformTableLinear<double> > uniform_inverseBmu_;
     };
 }
 
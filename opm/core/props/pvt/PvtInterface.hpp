@@ -157,6 +157,31 @@ namespace Opm
 
 
     protected:
+        /// Smallest number of points for which the subclasses evaluate
+        /// in parallel. Many callers evaluate a single cell at a time,
+        /// for which starting a parallel region costs more than the
+        /// evaluation itself.
+        static const int min_parallel_points = 512;
+
+        /// Call body(i) for i = 0, ..., n - 1, in parallel only if n is
+        /// at least min_parallel_points. Smaller batches do not enter a
+        /// parallel region at all, since an OpenMP if() clause still
+        /// sets up a team of one thread.
+        template <class Body>
+        static void forEachPoint(const int n, const Body& body)
+        {
+            if (n < min_parallel_points) {
+                for (int i = 0; i < n; ++i) {
+                    body(i);
+                }
+                return;
+            }
+#pragma omp parallel for schedule(static)
+            for (int i = 0; i < n; ++i) {
+                body(i);
+            }
+        }
+
         int num_phases_;
         int phase_pos_[MaxNumPhases];
     };
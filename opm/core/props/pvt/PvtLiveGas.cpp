@@ -41,6 +41,9 @@ namespace Opm
 
     using Opm::linearInterpolation;
     using Opm::linearInterpolationDerivative;
+    using Opm::linearInterpolationInInterval;
+    using Opm::linearInterpolationDerivativeInInterval;
+    using Opm::tableIndex;
 
 
     //------------------------------------------------------------------------
@@ -108,13 +111,12 @@ namespace Opm
                         const double* z,
                         double* output_mu) const
     {
-// #pragma omp parallel for
-        for (int i = 0; i < n; ++i) {
+        forEachPoint(n, [&](const int i) {
             double inverseB = miscible_gas(p[i], z + num_phases_*i, getTableIndex_(pvtRegionIdx, i), 1, false);
             double inverseBMu = miscible_gas(p[i], z + num_phases_*i, getTableIndex_(pvtRegionIdx, i), 3, false);
 
             output_mu[i] = inverseB / inverseBMu;
-        }
+        });
     }
 
     /// Viscosity and its p and r derivatives as a function of p, T and r.
@@ -141,32 +143,20 @@ namespace Opm
                                double* output_dmudp,
                                double* output_dmudr) const
     {
-        for (int i = 0; i < n; ++i) {
-            const PhasePresence& cnd = cond[i];
+        forEachPoint(n, [&](const int i) {
             int tableIdx = getTableIndex_(pvtRegionIdx, i);
 
-            double inverseBMu = miscible_gas(p[i], r[i], cnd, tableIdx, 3, 0);
-            double inverseB = miscible_gas(p[i], r[i], cnd, tableIdx, 1, 0);
-
-            output_mu[i] = inverseB / inverseBMu;
-
-            double dinverseBmudp = miscible_gas(p[i], r[i], cnd, tableIdx, 3, 1);
-            double dinverseBdp = miscible_gas(p[i], r[i], cnd, tableIdx, 1, 1);
-
-            output_dmudp[i] = (inverseBMu * dinverseBdp - inverseB * dinverseBmudp)
-                              / (inverseBMu * inverseBMu);
-
-            double dinverseBmudr = miscible_gas(p[i], r[i], cnd, tableIdx, 3, 2);
-            double dinverseBdr = miscible_gas(p[i], r[i], cnd, tableIdx, 1, 2);
-
-            output_dmudr[i] = (inverseBMu * dinverseBdr - inverseB * dinverseBmudr)
-                              / (inverseBMu * inverseBMu);
-
-        }
+            double inverseB[3];
+            double inverseBMu[3];
+            evalInverseB(tableIdx, p[i], r[i], cond[i], inverseB, inverseBMu);
 
+            const double invBMu2 = inverseBMu[0] * inverseBMu[0];
+            output_mu[i] = inverseB[0] / inverseBMu[0];
+            output_dmudp[i] = (inverseBMu[0] * inverseB[1] - inverseB[0] * inverseBMu[1]) / invBMu2;
+            output_dmudr[i] = (inverseBMu[0] * inverseB[2] - inverseB[0] * inverseBMu[2]) / invBMu2;
+        });
     }
 
-
     /// Formation volume factor as a function of p, T and z.
     void PvtLiveGas::B(const int n,
                        const int* pvtRegionIdx,
@@ -175,10 +165,9 @@ namespace Opm
                              const double* z,
                              double* output_B) const
     {
-// #pragma omp parallel for
-        for (int i = 0; i < n; ++i) {
+        forEachPoint(n, [&](const int i) {
             output_B[i] = evalB(p[i], z + num_phases_*i, getTableIndex_(pvtRegionIdx, i));
-        }
+        });
 
     }
 
@@ -192,10 +181,9 @@ namespace Opm
                                 double* output_B,
                                 double* output_dBdp) const
     {
-// #pragma omp parallel for
-        for (int i = 0; i < n; ++i) {
+        forEachPoint(n, [&](const int i) {
             evalBDeriv(p[i], z + num_phases_*i, getTableIndex_(pvtRegionIdx, i), output_B[i], output_dBdp[i]);
-        }
+        });
     }
 
     /// The inverse of the formation volume factor b = 1 / B, and its p and r derivatives as a function of p, T and r.
@@ -224,16 +212,16 @@ namespace Opm
                           double* output_dbdr) const
 
     {
-        // #pragma omp parallel for
-                for (int i = 0; i < n; ++i) {
-                    const PhasePresence& cnd = cond[i];
+        forEachPoint(n, [&](const int i) {
+            int tableIdx = getTableIndex_(pvtRegionIdx, i);
 
-                    int tableIdx = getTableIndex_(pvtRegionIdx, i);
-                    output_b[i] = miscible_gas(p[i], r[i], cnd, tableIdx, 1, 0);
-                    output_dbdp[i] = miscible_gas(p[i], r[i], cnd, tableIdx, 1, 1);
-                    output_dbdr[i] = miscible_gas(p[i], r[i], cnd, tableIdx, 1, 2);
+            double inverseB[3];
+            evalInverseB(tableIdx, p[i], r[i], cond[i], inverseB, 0);
 
-                }
+            output_b[i] = inverseB[0];
+            output_dbdp[i] = inverseB[1];
+            output_dbdr[i] = inverseB[2];
+        });
     }
 
     /// Gas resolution and its derivatives at bublepoint as a function of p.
@@ -270,10 +258,9 @@ namespace Opm
                              const double* z,
                              double* output_R) const
     {
-// #pragma omp parallel for
-        for (int i = 0; i < n; ++i) {
+        forEachPoint(n, [&](const int i) {
             output_R[i] = evalR(p[i], z + num_phases_*i, getTableIndex_(pvtRegionIdx, i));
-        }
+        });
 
     }
 
@@ -286,10 +273,9 @@ namespace Opm
                                 double* output_R,
                                 double* output_dRdp) const
     {
-// #pragma omp parallel for
-        for (int i = 0; i < n; ++i) {
+        forEachPoint(n, [&](const int i) {
             evalRDeriv(p[i], z + num_phases_*i, getTableIndex_(pvtRegionIdx, i), output_R[i], output_dRdp[i]);
-        }
+        });
     }
 
 
@@ -448,116 +434,62 @@ namespace Opm
         }
     }
 
-    double PvtLiveGas::miscible_gas(const double press,
-                                    const double r,
-                                    const PhasePresence& cond,
-                                    const int pvtTableIdx,
-                                    const int item,
-                                    const int deriv) const
+    void PvtLiveGas::evalInverseB(const int pvtTableIdx,
+                                  const double press,
+                                  const double r,
+                                  const PhasePresence& cond,
+                                  double* inverseB,
+                                  double* inverseBMu) const
     {
-        const std::vector<std::vector<double> > &saturatedGasTable =
-            saturated_gas_table_[pvtTableIdx];
-        const std::vector<std::vector<std::vector<double> > > &undersatGasTables =
-            undersat_gas_tables_[pvtTableIdx];
-
-        const bool isSat = cond.hasFreeOil();
-
-        // Derivative w.r.t p
-        if (deriv == 1) {
-            if (isSat) {  // Saturated case
-                return linearInterpolationDerivative(saturatedGasTable[0],
-                                                saturatedGasTable[item],
-                                                press);
-            } else {  // Undersaturated case
-                int is = tableIndex(saturatedGasTable[0], press);
-                if (undersatGasTables[is][0].size() < 2) {
-                    double val = (saturatedGasTable[item][is+1]
-                                  - saturatedGasTable[item][is]) /
-                        (saturatedGasTable[0][is+1] -
-                         saturatedGasTable[0][is]);
-                    return val;
-                }
-                double val1 =
-                    linearInterpolation(undersatGasTables[is][0],
-                                              undersatGasTables[is][item],
-                                              r);
-                double val2 =
-                    linearInterpolation(undersatGasTables[is+1][0],
-                                              undersatGasTables[is+1][item],
-                                              r);
-                double val = (val2 - val1)/
-                    (saturatedGasTable[0][is+1] - saturatedGasTable[0][is]);
-                return val;
+        const std::vector<std::vector<double> >& satTable = saturated_gas_table_[pvtTableIdx];
+        const std::vector<std::vector<std::vector<double> > >& undersatTables = undersat_gas_tables_[pvtTableIdx];
+        const int numItems = inverseBMu ? 2 : 1;
+        double* const out[2] = { inverseB, inverseBMu };
+        const int items[2] = { 1, 3 };
+
+        const int is = tableIndex(satTable[0], press);
+
+        if (cond.hasFreeOil()) {  // Saturated case
+            for (int k = 0; k < numItems; ++k) {
+                const std::vector<double>& yv = satTable[items[k]];
+                out[k][0] = linearInterpolationInInterval(satTable[0], yv, is, press);
+                out[k][1] = linearInterpolationDerivativeInInterval(satTable[0], yv, is);
+                out[k][2] = 0.0;
             }
-        } else if (deriv == 2){
-            if (isSat) {
-                return 0;
-            } else {
-                int is = tableIndex(saturatedGasTable[0], press);
-                double w = (press - saturatedGasTable[0][is]) /
-                    (saturatedGasTable[0][is+1] - saturatedGasTable[0][is]);
-                assert(undersatGasTables[is][0].size() >= 2);
-                assert(undersatGasTables[is+1][0].size() >= 2);
-                double val1 =
-                    linearInterpolationDerivative(undersatGasTables[is][0],
-                                              undersatGasTables[is][item],
-                                              r);
-                double val2 =
-                    linearInterpolationDerivative(undersatGasTables[is+1][0],
-                                              undersatGasTables[is+1][item],
-                                              r);
-
-                double val = val1 + w * (val2 - val1);
-                return val;
+            return;
+        }
 
+        // Undersaturated case: interpolate between table sections
+        const double dp = satTable[0][is+1] - satTable[0][is];
+        const double w = (press - satTable[0][is]) / dp;
+        const std::vector<std::vector<double> >& ut1 = undersatTables[is];
+        const std::vector<std::vector<double> >& ut2 = undersatTables[is+1];
+
+        if (ut1[0].size() < 2) {
+            // No undersaturated data, use saturated values.
+            for (int k = 0; k < numItems; ++k) {
+                const std::vector<double>& yv = satTable[items[k]];
+                out[k][0] = yv[is] + w*(yv[is+1] - yv[is]);
+                out[k][1] = (yv[is+1] - yv[is]) / dp;
+                out[k][2] = 0.0;
             }
-        } else {
-            if (isSat) {  // Saturated case
-                return linearInterpolation(saturatedGasTable[0],
-                                                 saturatedGasTable[item],
-                                                 press);
-            } else {  // Undersaturated case
-                int is = tableIndex(saturatedGasTable[0], press);
-                // Extrapolate from first table section
-                if (is == 0 && press < saturatedGasTable[0][0]) {
-                    return linearInterpolation(undersatGasTables[0][0],
-                                                     undersatGasTables[0][item],
-                                                     r);
-                }
-
-                // Extrapolate from last table section
-                //int ltp = saturatedGasTable[0].size() - 1;
-                //if (is+1 == ltp && press > saturatedGasTable[0][ltp]) {
-                //    return linearInterpolation(undersatGasTables[ltp][0],
-                //                                    undersatGasTables[ltp][item],
-                //                                    r);
-                //}
+            return;
+        }
 
-                // Interpolate between table sections
-                double w = (press - saturatedGasTable[0][is]) /
-                    (saturatedGasTable[0][is+1] -
-                     saturatedGasTable[0][is]);
-                if (undersatGasTables[is][0].size() < 2) {
-                    double val = saturatedGasTable[item][is] +
-                        w*(saturatedGasTable[item][is+1] -
-                           saturatedGasTable[item][is]);
-                    return val;
-                }
-                double val1 =
-                    linearInterpolation(undersatGasTables[is][0],
-                                              undersatGasTables[is][item],
-                                              r);
-                double val2 =
-                    linearInterpolation(undersatGasTables[is+1][0],
-                                              undersatGasTables[is+1][item],
-                                              r);
-                double val = val1 + w*(val2 - val1);
-                return val;
-            }
+        // Extrapolate from first table section
+        const bool belowTable = (is == 0 && press < satTable[0][0]);
+        const int i1 = tableIndex(ut1[0], r);
+        const int i2 = tableIndex(ut2[0], r);
+        for (int k = 0; k < numItems; ++k) {
+            const int item = items[k];
+            const double val1 = linearInterpolationInInterval(ut1[0], ut1[item], i1, r);
+            const double val2 = linearInterpolationInInterval(ut2[0], ut2[item], i2, r);
+            const double dval1 = linearInterpolationDerivativeInInterval(ut1[0], ut1[item], i1);
+            const double dval2 = linearInterpolationDerivativeInInterval(ut2[0], ut2[item], i2);
+            out[k][0] = belowTable ? val1 : val1 + w*(val2 - val1);
+            out[k][1] = (val2 - val1) / dp;
+            out[k][2] = dval1 + w*(dval2 - dval1);
         }
     }
 
-
-
-
 } // namespace Opm
@@ -162,12 +162,17 @@ namespace Opm
                             const int pvtTableIdx,
                             const int item,
                             const bool deriv = false) const;
-        double miscible_gas(const double press,
-                            const double r,
-                            const PhasePresence& cond,
-                            const int pvtTableIdx,
-                            const int item,
-                            const int deriv = 0) const;
+
+        // Evaluate 1/B and, if inverseBMu is non-null, 1/(B*mu) at a
+        // single state, with all table searches done once.  Each output
+        // holds the value and its p and r derivatives.
+        void evalInverseB(const int pvtTableIdx,
+                          const double press,
+                          const double r,
+                          const PhasePresence& cond,
+                          double* inverseB,
+                          double* inverseBMu) const;
+
         // PVT properties of wet gas (with vaporised oil). We need to
         // store one table per PVT region.
         std::vector< std::vector<std::vector<double> > > saturated_gas_table_;
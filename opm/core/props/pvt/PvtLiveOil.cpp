@@ -23,12 +23,15 @@
 #include <opm/core/utility/linearInterpolation.hpp>
 
 #include <algorithm>
+#include <cassert>
 
 namespace Opm
 {
 
     using Opm::linearInterpolation;
     using Opm::linearInterpolationDerivative;
+    using Opm::linearInterpolationInInterval;
+    using Opm::linearInterpolationDerivativeInInterval;
     using Opm::tableIndex;
 
     //------------------------------------------------------------------------
@@ -140,15 +143,15 @@ namespace Opm
                               const double* z,
                               double* output_mu) const
     {
-// #pragma omp parallel for
-        for (int i = 0; i < n; ++i) {
+        forEachPoint(n, [&](const int i) {
             int tableIdx = getTableIndex_(pvtTableIdx, i);
 
-            double inverseB = miscible_oil(p[i], z + num_phases_*i, tableIdx, 1, false);
-            double inverseBMu = miscible_oil(p[i], z + num_phases_*i, tableIdx, 3, false);
+            double inverseB[3];
+            double inverseBMu[3];
+            evalInverseB(tableIdx, p[i], z + num_phases_*i, inverseB, inverseBMu);
 
-            output_mu[i] = inverseB / inverseBMu; 
-        }
+            output_mu[i] = inverseB[0] / inverseBMu[0];
+        });
     }
 
     /// Viscosity and its p and r derivatives as a function of p, T and r.
@@ -161,29 +164,18 @@ namespace Opm
                                double* output_dmudp,
                                double* output_dmudr) const
     {
-        // #pragma omp parallel for
-                for (int i = 0; i < n; ++i) {
-                    int tableIdx = getTableIndex_(pvtTableIdx, i);
-
-                    double inverseBMu = miscible_oil(p[i], r[i], tableIdx, 3, 0);
-                    double inverseB = miscible_oil(p[i], r[i], tableIdx, 1, 0);
-
-                    output_mu[i] = inverseB / inverseBMu;
-
-                    double dinverseBmudp = miscible_oil(p[i], r[i], tableIdx, 3, 1);
-                    double dinverseBdp = miscible_oil(p[i], r[i], tableIdx, 1, 1);
-
-                    output_dmudp[i] = (inverseBMu * dinverseBdp - inverseB * dinverseBmudp)
-                                      / (inverseBMu * inverseBMu);
-
-
-                    double dinverseBmudr = miscible_oil(p[i], r[i], tableIdx, 3, 2);
-                    double dinverseBdr = miscible_oil(p[i], r[i], tableIdx, 1, 2);
+        forEachPoint(n, [&](const int i) {
+            int tableIdx = getTableIndex_(pvtTableIdx, i);
 
-                    output_dmudr[i] = (inverseBMu * dinverseBdr - inverseB * dinverseBmudr)
-                                      / (inverseBMu * inverseBMu);
+            double inverseB[3];
+            double inverseBMu[3];
+            evalInverseB(tableIdx, p[i], r[i], 0, inverseB, inverseBMu);
 
-                }
+            const double invBMu2 = inverseBMu[0] * inverseBMu[0];
+            output_mu[i] = inverseB[0] / inverseBMu[0];
+            output_dmudp[i] = (inverseBMu[0] * inverseB[1] - inverseB[0] * inverseBMu[1]) / invBMu2;
+            output_dmudr[i] = (inverseBMu[0] * inverseB[2] - inverseB[0] * inverseBMu[2]) / invBMu2;
+        });
     }
 
     /// Viscosity and its p and r derivatives as a function of p, T and r.
@@ -197,30 +189,18 @@ namespace Opm
                                double* output_dmudp,
                                double* output_dmudr) const
     {
-        // #pragma omp parallel for
-                for (int i = 0; i < n; ++i) {
-                    int tableIdx = getTableIndex_(pvtTableIdx, i);
-                    const PhasePresence& cnd = cond[i];
-
-                    double inverseBMu = miscible_oil(p[i], r[i], cnd, tableIdx, 3, 0);
-                    double inverseB = miscible_oil(p[i], r[i], cnd, tableIdx, 1, 0);
-
-                    output_mu[i] = inverseB / inverseBMu;
-
-                    double dinverseBmudp = miscible_oil(p[i], r[i], cnd, tableIdx, 3, 1);
-                    double dinverseBdp = miscible_oil(p[i], r[i], cnd, tableIdx, 1, 1);
-
-                    output_dmudp[i] = (inverseBMu * dinverseBdp - inverseB * dinverseBmudp)
-                                      / (inverseBMu * inverseBMu);
-
-
-                    double dinverseBmudr = miscible_oil(p[i], r[i], cnd, tableIdx, 3, 2);
-                    double dinverseBdr = miscible_oil(p[i], r[i], cnd, tableIdx, 1, 2);
+        forEachPoint(n, [&](const int i) {
+            int tableIdx = getTableIndex_(pvtTableIdx, i);
 
-                    output_dmudr[i] = (inverseBMu * dinverseBdr - inverseB * dinverseBmudr)
-                                      / (inverseBMu * inverseBMu);
+            double inverseB[3];
+            double inverseBMu[3];
+            evalInverseB(tableIdx, p[i], r[i], cond + i, inverseB, inverseBMu);
 
-                }
+            const double invBMu2 = inverseBMu[0] * inverseBMu[0];
+            output_mu[i] = inverseB[0] / inverseBMu[0];
+            output_dmudp[i] = (inverseBMu[0] * inverseB[1] - inverseB[0] * inverseBMu[1]) / invBMu2;
+            output_dmudr[i] = (inverseBMu[0] * inverseB[2] - inverseB[0] * inverseBMu[2]) / invBMu2;
+        });
     }
 
 
@@ -232,12 +212,11 @@ namespace Opm
                              const double* z,
                              double* output_B) const
     {
-// #pragma omp parallel for
-        for (int i = 0; i < n; ++i) {
+        forEachPoint(n, [&](const int i) {
             int tableIdx = getTableIndex_(pvtTableIdx, i);
 
             output_B[i] = evalB(tableIdx, p[i], z + num_phases_*i);
-        }
+        });
 
     }
 
@@ -251,12 +230,11 @@ namespace Opm
                                 double* output_B,
                                 double* output_dBdp) const
     {
-// #pragma omp parallel for
-        for (int i = 0; i < n; ++i) {
+        forEachPoint(n, [&](const int i) {
             int tableIdx = getTableIndex_(pvtTableIdx, i);
 
             evalBDeriv(tableIdx, p[i], z + num_phases_*i, output_B[i], output_dBdp[i]);
-        }
+        });
     }
 
     void PvtLiveOil::b(const int n,
@@ -269,15 +247,16 @@ namespace Opm
                           double* output_dbdr) const
 
     {
-        // #pragma omp parallel for
-                for (int i = 0; i < n; ++i) {
-                    int tableIdx = getTableIndex_(pvtTableIdx, i);
+        forEachPoint(n, [&](const int i) {
+            int tableIdx = getTableIndex_(pvtTableIdx, i);
 
-                    output_b[i] = miscible_oil(p[i], r[i], tableIdx, 1, 0);
-                    output_dbdp[i] = miscible_oil(p[i], r[i], tableIdx, 1, 1);
-                    output_dbdr[i] = miscible_oil(p[i], r[i], tableIdx, 1, 2);
+            double inverseB[3];
+            evalInverseB(tableIdx, p[i], r[i], 0, inverseB, 0);
 
-                }
+            output_b[i] = inverseB[0];
+            output_dbdp[i] = inverseB[1];
+            output_dbdr[i] = inverseB[2];
+        });
     }
 
     void PvtLiveOil::b(const int n,
@@ -291,16 +270,16 @@ namespace Opm
                           double* output_dbdr) const
 
     {
-        // #pragma omp parallel for
-                for (int i = 0; i < n; ++i) {
-                    const PhasePresence& cnd = cond[i];
-                    int tableIdx = getTableIndex_(pvtTableIdx, i);
+        forEachPoint(n, [&](const int i) {
+            int tableIdx = getTableIndex_(pvtTableIdx, i);
 
-                    output_b[i] = miscible_oil(p[i], r[i], cnd, tableIdx, 1, 0);
-                    output_dbdp[i] = miscible_oil(p[i], r[i], cnd, tableIdx, 1, 1);
-                    output_dbdr[i] = miscible_oil(p[i], r[i], cnd, tableIdx, 1, 2);
+            double inverseB[3];
+            evalInverseB(tableIdx, p[i], r[i], cond + i, inverseB, 0);
 
-                }
+            output_b[i] = inverseB[0];
+            output_dbdp[i] = inverseB[1];
+            output_dbdr[i] = inverseB[2];
+        });
     }
 
     void PvtLiveOil::rsSat(const int n,
@@ -337,11 +316,10 @@ namespace Opm
                              const double* z,
                              double* output_R) const
     {
-// #pragma omp parallel for
-        for (int i = 0; i < n; ++i) {
+        forEachPoint(n, [&](const int i) {
             int tableIdx = getTableIndex_(pvtTableIdx, i);
             output_R[i] = evalR(tableIdx, p[i], z + num_phases_*i);
-        }
+        });
 
     }
 
@@ -354,11 +332,10 @@ namespace Opm
                                 double* output_R,
                                 double* output_dRdp) const
     {
-// #pragma omp parallel for
-        for (int i = 0; i < n; ++i) {
+        forEachPoint(n, [&](const int i) {
             int tableIdx = getTableIndex_(pvtTableIdx, i);
             evalRDeriv(tableIdx, p[i], z + num_phases_*i, output_R[i], output_dRdp[i]);
-        }
+        });
     }
 
 
@@ -370,7 +347,9 @@ namespace Opm
                                    double press, const double* surfvol) const
     {
         // if (surfvol[phase_pos_[Liquid]] == 0.0) return 1.0; // To handle no-oil case.
-        return 1.0/miscible_oil(press, surfvol, pvtTableIdx, 1, false);
+        double inverseB[3];
+        evalInverseB(pvtTableIdx, press, surfvol, inverseB, 0);
+        return 1.0/inverseB[0];
     }
 
 
@@ -378,8 +357,10 @@ namespace Opm
                                       const double press, const double* surfvol,
                                       double& Bval, double& dBdpval) const
     {
-        Bval = evalB(pvtTableIdx, press, surfvol);
-        dBdpval = -Bval*Bval*miscible_oil(press, surfvol, pvtTableIdx, 1, true);
+        double inverseB[3];
+        evalInverseB(pvtTableIdx, press, surfvol, inverseB, 0);
+        Bval = 1.0/inverseB[0];
+        dBdpval = -Bval*Bval*inverseB[1];
     }
 
     double PvtLiveOil::evalR(size_t pvtTableIdx,
@@ -423,227 +404,87 @@ namespace Opm
     }
 
 
-    // TODO: Check if this function need to be adapted to the 1/(B*mu) interpolation.
-    double PvtLiveOil::miscible_oil(const double press,
-                                    const double* surfvol,
-                                    const int pvtTableIdx,
-                                    const int item,
-                                    const bool deriv) const
+    void PvtLiveOil::evalInverseB(const int pvtTableIdx,
+                                  const double press,
+                                  const double r,
+                                  const PhasePresence* cond,
+                                  double* inverseB,
+                                  double* inverseBMu) const
     {
-        int section;
-        double Rval = linearInterpolation(saturated_oil_table_[pvtTableIdx][0],
-                                          saturated_oil_table_[pvtTableIdx][4],
-                                          press, section);
-        double maxR = (surfvol[phase_pos_[Liquid]] == 0.0) ? 0.0 : surfvol[phase_pos_[Vapour]]/surfvol[phase_pos_[Liquid]];
-        if (deriv) {
-            if (Rval < maxR ) {  // Saturated case
-                return linearInterpolationDerivative(saturated_oil_table_[pvtTableIdx][0],
-                                                     saturated_oil_table_[pvtTableIdx][item],
-                                                     press);
-            } else {  // Undersaturated case
-                int is = tableIndex(saturated_oil_table_[pvtTableIdx][4], maxR);
-                double w = (maxR - saturated_oil_table_[pvtTableIdx][4][is]) /
-                    (saturated_oil_table_[pvtTableIdx][4][is+1] - saturated_oil_table_[pvtTableIdx][4][is]);
-                assert(undersat_oil_tables_[pvtTableIdx][is][0].size() >= 2);
-                assert(undersat_oil_tables_[pvtTableIdx][is+1][0].size() >= 2);
-                double val1 =
-                    linearInterpolationDerivative(undersat_oil_tables_[pvtTableIdx][is][0],
-                                                  undersat_oil_tables_[pvtTableIdx][is][item],
-                                                  press);
-                double val2 =
-                    linearInterpolationDerivative(undersat_oil_tables_[pvtTableIdx][is+1][0],
-                                                  undersat_oil_tables_[pvtTableIdx][is+1][item],
-                                                  press);
-                double val = val1 + w*(val2 - val1);
-                return val;
-            }
+        const std::vector<std::vector<double> >& satTable = saturated_oil_table_[pvtTableIdx];
+
+        bool isSat;
+        int ip = -1;
+        if (cond) {
+            isSat = cond->hasFreeGas();
         } else {
-            if (Rval < maxR ) {  // Saturated case
-                return linearInterpolation(saturated_oil_table_[pvtTableIdx][0],
-                                           saturated_oil_table_[pvtTableIdx][item],
-                                           press);
-            } else {  // Undersaturated case
-                // Interpolate between table sections
-                int is = tableIndex(saturated_oil_table_[pvtTableIdx][4], maxR);
-                double w = (maxR - saturated_oil_table_[pvtTableIdx][4][is]) /
-                    (saturated_oil_table_[pvtTableIdx][4][is+1] - saturated_oil_table_[pvtTableIdx][4][is]);
-                assert(undersat_oil_tables_[pvtTableIdx][is][0].size() >= 2);
-                assert(undersat_oil_tables_[pvtTableIdx][is+1][0].size() >= 2);
-                double val1 =
-                    linearInterpolation(undersat_oil_tables_[pvtTableIdx][is][0],
-                                        undersat_oil_tables_[pvtTableIdx][is][item],
-                                        press);
-                double val2 =
-                    linearInterpolation(undersat_oil_tables_[pvtTableIdx][is+1][0],
-                                        undersat_oil_tables_[pvtTableIdx][is+1][item],
-                                        press);
-                double val = val1 + w*(val2 - val1);
-                return val;
-            }
+            ip = tableIndex(satTable[0], press);
+            isSat = linearInterpolationInInterval(satTable[0], satTable[4], ip, press) <= r;
         }
+        evalInverseB(pvtTableIdx, press, r, isSat, ip, inverseB, inverseBMu);
     }
 
-    double PvtLiveOil::miscible_oil(const double press,
-                                    const double r,
-                                    const int pvtTableIdx,
-                                    const int item,
-                                    const int deriv) const
-    {
-        int section;
-        double Rval = linearInterpolation(saturated_oil_table_[pvtTableIdx][0],
-                                          saturated_oil_table_[pvtTableIdx][4],
-                                          press, section);
-        // derivative with respect to frist component (pressure)
-        if (deriv == 1) {
-            if (Rval <= r ) {  // Saturated case
-                return linearInterpolationDerivative(saturated_oil_table_[pvtTableIdx][0],
-                                                     saturated_oil_table_[pvtTableIdx][item],
-                                                     press);
-            } else {  // Undersaturated case
-                int is = tableIndex(saturated_oil_table_[pvtTableIdx][4], r);
-                double w = (r - saturated_oil_table_[pvtTableIdx][4][is]) /
-                    (saturated_oil_table_[pvtTableIdx][4][is+1] - saturated_oil_table_[pvtTableIdx][4][is]);
-                assert(undersat_oil_tables_[pvtTableIdx][is][0].size() >= 2);
-                assert(undersat_oil_tables_[pvtTableIdx][is+1][0].size() >= 2);
-                double val1 =
-                    linearInterpolationDerivative(undersat_oil_tables_[pvtTableIdx][is][0],
-                                             undersat_oil_tables_[pvtTableIdx][is][item],
-                                             press);
-                double val2 =
-                    linearInterpolationDerivative(undersat_oil_tables_[pvtTableIdx][is+1][0],
-                                             undersat_oil_tables_[pvtTableIdx][is+1][item],
-                                             press);
-                double val = val1 + w*(val2 - val1);
-                return val;
-            }
-            // derivative with respect to second component (r)
-        } else if (deriv == 2)  {
-            if (Rval <= r ) {  // Saturated case
-                return 0;
-            } else {  // Undersaturated case
-                int is = tableIndex(saturated_oil_table_[pvtTableIdx][4], r);
-                assert(undersat_oil_tables_[pvtTableIdx][is][0].size() >= 2);
-                assert(undersat_oil_tables_[pvtTableIdx][is+1][0].size() >= 2);
-                double val1 =
-                    linearInterpolation(undersat_oil_tables_[pvtTableIdx][is][0],
-                                              undersat_oil_tables_[pvtTableIdx][is][item],
-                                              press);
-                double val2 =
-                    linearInterpolation(undersat_oil_tables_[pvtTableIdx][is+1][0],
-                                              undersat_oil_tables_[pvtTableIdx][is+1][item],
-                                              press);
-
-                double val = (val2 - val1)/(saturated_oil_table_[pvtTableIdx][4][is+1]-saturated_oil_table_[pvtTableIdx][4][is]);
-                return val;
-            }
 
+    void PvtLiveOil::evalInverseB(const int pvtTableIdx,
+                                  const double press,
+                                  const double* surfvol,
+                                  double* inverseB,
+                                  double* inverseBMu) const
+    {
+        const std::vector<std::vector<double> >& satTable = saturated_oil_table_[pvtTableIdx];
 
-            }    else {
-            if (Rval <= r ) {  // Saturated case
-                return linearInterpolation(saturated_oil_table_[pvtTableIdx][0],
-                                           saturated_oil_table_[pvtTableIdx][item],
-                                           press);
-            } else {  // Undersaturated case
-                // Interpolate between table sections
-                int is = tableIndex(saturated_oil_table_[pvtTableIdx][4], r);
-                double w = (r - saturated_oil_table_[pvtTableIdx][4][is]) /
-                    (saturated_oil_table_[pvtTableIdx][4][is+1] - saturated_oil_table_[pvtTableIdx][4][is]);
-                assert(undersat_oil_tables_[pvtTableIdx][is][0].size() >= 2);
-                assert(undersat_oil_tables_[pvtTableIdx][is+1][0].size() >= 2);
-                double val1 =
-                    linearInterpolation(undersat_oil_tables_[pvtTableIdx][is][0],
-                                              undersat_oil_tables_[pvtTableIdx][is][item],
-                                              press);
-                double val2 =
-                    linearInterpolation(undersat_oil_tables_[pvtTableIdx][is+1][0],
-                                              undersat_oil_tables_[pvtTableIdx][is+1][item],
-                                              press);
-                double val = val1 + w*(val2 - val1);
-                return val;
-            }
-        }
+        const int ip = tableIndex(satTable[0], press);
+        const double Rval = linearInterpolationInInterval(satTable[0], satTable[4], ip, press);
+        const double maxR = (surfvol[phase_pos_[Liquid]] == 0.0) ? 0.0 : surfvol[phase_pos_[Vapour]]/surfvol[phase_pos_[Liquid]];
+        evalInverseB(pvtTableIdx, press, maxR, Rval < maxR, ip, inverseB, inverseBMu);
     }
 
-    double PvtLiveOil::miscible_oil(const double press,
-                                    const double r,
-                                    const PhasePresence& cond,
-                                    const int pvtTableIdx,
-                                    const int item,
-                                    const int deriv) const
+
+    void PvtLiveOil::evalInverseB(const int pvtTableIdx,
+                                  const double press,
+                                  const double r,
+                                  const bool isSat,
+                                  int satSection,
+                                  double* inverseB,
+                                  double* inverseBMu) const
     {
-        const bool isSat = cond.hasFreeGas();
-
-        // derivative with respect to frist component (pressure)
-        if (deriv == 1) {
-            if (isSat) {  // Saturated case
-                return linearInterpolationDerivative(saturated_oil_table_[pvtTableIdx][0],
-                                                     saturated_oil_table_[pvtTableIdx][item],
-                                                     press);
-            } else {  // Undersaturated case
-                int is = tableIndex(saturated_oil_table_[pvtTableIdx][4], r);
-                double w = (r - saturated_oil_table_[pvtTableIdx][4][is]) /
-                    (saturated_oil_table_[pvtTableIdx][4][is+1] - saturated_oil_table_[pvtTableIdx][4][is]);
-                assert(undersat_oil_tables_[pvtTableIdx][is][0].size() >= 2);
-                assert(undersat_oil_tables_[pvtTableIdx][is+1][0].size() >= 2);
-                double val1 =
-                    linearInterpolationDerivative(undersat_oil_tables_[pvtTableIdx][is][0],
-                                             undersat_oil_tables_[pvtTableIdx][is][item],
-                                             press);
-                double val2 =
-                    linearInterpolationDerivative(undersat_oil_tables_[pvtTableIdx][is+1][0],
-                                             undersat_oil_tables_[pvtTableIdx][is+1][item],
-                                             press);
-                double val = val1 + w*(val2 - val1);
-                return val;
+        const std::vector<std::vector<double> >& satTable = saturated_oil_table_[pvtTableIdx];
+        const int numItems = inverseBMu ? 2 : 1;
+        double* const out[2] = { inverseB, inverseBMu };
+        const int items[2] = { 1, 3 };
+
+        if (isSat) {
+            if (satSection < 0) {
+                satSection = tableIndex(satTable[0], press);
             }
-            // derivative with respect to second component (r)
-        } else if (deriv == 2)  {
-            if (isSat) {  // Saturated case
-                return 0;
-            } else {  // Undersaturated case
-                int is = tableIndex(saturated_oil_table_[pvtTableIdx][4], r);
-                assert(undersat_oil_tables_[pvtTableIdx][is][0].size() >= 2);
-                assert(undersat_oil_tables_[pvtTableIdx][is+1][0].size() >= 2);
-                double val1 =
-                    linearInterpolation(undersat_oil_tables_[pvtTableIdx][is][0],
-                                              undersat_oil_tables_[pvtTableIdx][is][item],
-                                              press);
-                double val2 =
-                    linearInterpolation(undersat_oil_tables_[pvtTableIdx][is+1][0],
-                                              undersat_oil_tables_[pvtTableIdx][is+1][item],
-                                              press);
-
-                double val = (val2 - val1)/(saturated_oil_table_[pvtTableIdx][4][is+1]-saturated_oil_table_[pvtTableIdx][4][is]);
-                return val;
+            for (int k = 0; k < numItems; ++k) {
+                const std::vector<double>& yv = satTable[items[k]];
+                out[k][0] = linearInterpolationInInterval(satTable[0], yv, satSection, press);
+                out[k][1] = linearInterpolationDerivativeInInterval(satTable[0], yv, satSection);
+                out[k][2] = 0.0;
             }
-
-
-            }
-            // no derivative
-            else {
-                if (isSat) {  // Saturated case
-                    return linearInterpolation(saturated_oil_table_[pvtTableIdx][0],
-                                               saturated_oil_table_[pvtTableIdx][item],
-                                               press);
-                } else {  // Undersaturated case
-                    // Interpolate between table sections
-                    int is = tableIndex(saturated_oil_table_[pvtTableIdx][4], r);
-                    double w = (r - saturated_oil_table_[pvtTableIdx][4][is]) /
-                        (saturated_oil_table_[pvtTableIdx][4][is+1] - saturated_oil_table_[pvtTableIdx][4][is]);
-                    assert(undersat_oil_tables_[pvtTableIdx][is][0].size() >= 2);
-                    assert(undersat_oil_tables_[pvtTableIdx][is+1][0].size() >= 2);
-                    double val1 =
-                        linearInterpolation(undersat_oil_tables_[pvtTableIdx][is][0],
-                                                  undersat_oil_tables_[pvtTableIdx][is][item],
-                                                  press);
-                    double val2 =
-                        linearInterpolation(undersat_oil_tables_[pvtTableIdx][is+1][0],
-                                                  undersat_oil_tables_[pvtTableIdx][is+1][item],
-                                                  press);
-                    double val = val1 + w*(val2 - val1);
-                    return val;
-                }
+        } else {
+            // Interpolate between table sections
+            const int is = tableIndex(satTable[4], r);
+            const double dR = satTable[4][is+1] - satTable[4][is];
+            const double w = (r - satTable[4][is]) / dR;
+            const std::vector<std::vector<double> >& ut1 = undersat_oil_tables_[pvtTableIdx][is];
+            const std::vector<std::vector<double> >& ut2 = undersat_oil_tables_[pvtTableIdx][is+1];
+            assert(ut1[0].size() >= 2);
+            assert(ut2[0].size() >= 2);
+            const int i1 = tableIndex(ut1[0], press);
+            const int i2 = tableIndex(ut2[0], press);
+            for (int k = 0; k < numItems; ++k) {
+                const int item = items[k];
+                const double val1 = linearInterpolationInInterval(ut1[0], ut1[item], i1, press);
+                const double val2 = linearInterpolationInInterval(ut2[0], ut2[item], i2, press);
+                const double dval1 = linearInterpolationDerivativeInInterval(ut1[0], ut1[item], i1);
+                const double dval2 = linearInterpolationDerivativeInInterval(ut2[0], ut2[item], i2);
+                out[k][0] = val1 + w*(val2 - val1);
+                out[k][1] = dval1 + w*(dval2 - dval1);
+                out[k][2] = (val2 - val1)/dR;
             }
         }
+    }
 
 } // namespace Opm
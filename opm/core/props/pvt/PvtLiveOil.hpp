@@ -155,25 +155,35 @@ namespace Opm
         double evalR(size_t pvtTableIdx, double press, const double* surfvol) const;
         void evalRDeriv(size_t pvtTableIdx, double press, const double* surfvol, double& R, double& dRdp) const;
 
-        // item:  1=>1/B  2=>mu;
-        double miscible_oil(const double press,
-                            const double* surfvol,
-                            const int pvtTableIdx,
-                            const int item,
-                            const bool deriv = false) const;
-
-        double miscible_oil(const double press,
-                            const double r,
-                            const int pvtTableIdx,
-                            const int item,
-                            const int deriv = 0) const;
-
-        double miscible_oil(const double press,
-                            const double r,
-                            const PhasePresence& cond,
-                            const int pvtTableIdx,
-                            const int item,
-                            const int deriv = 0) const;
+        // Evaluate 1/B and, if inverseBMu is non-null, 1/(B*mu) at a
+        // single state, with all table searches done once.  Each output
+        // holds the value and its p and r derivatives.  The state is
+        // saturated if cond says so, or, if cond is null, if r >= rsSat(p).
+        void evalInverseB(const int pvtTableIdx,
+                          const double press,
+                          const double r,
+                          const PhasePresence* cond,
+                          double* inverseB,
+                          double* inverseBMu) const;
+
+        // As above, with r and saturation state determined from surface
+        // volumes.  The r derivatives are with respect to that ratio.
+        void evalInverseB(const int pvtTableIdx,
+                          const double press,
+                          const double* surfvol,
+                          double* inverseB,
+                          double* inverseBMu) const;
+
+        // Evaluation engine for the above.  satSection is the interval
+        // of the saturated pressure column containing press, or -1 if
+        // not yet known.
+        void evalInverseB(const int pvtTableIdx,
+                          const double press,
+                          const double r,
+                          const bool isSat,
+                          int satSection,
+                          double* inverseB,
+                          double* inverseBMu) const;
 
         // PVT properties of live oil (with dissolved gas). We need to
         // store one table per PVT region.
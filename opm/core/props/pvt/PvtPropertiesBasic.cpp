@@ -24,10 +24,45 @@
 #include <opm/core/utility/Units.hpp>
 #include <opm/core/utility/ErrorMacros.hpp>
 
+#include <algorithm>
+
 
 namespace Opm
 {
 
+    namespace
+    {
+        // Set output[np*i + phase] = value[phase] for all n points. NP is
+        // the number of phases if known at compile time, zero if given by
+        // np at runtime.
+        template <int NP>
+        void fillPhaseValuesKernel(const int n, const int np_runtime,
+                                   const double* value, double* output)
+        {
+            const int np = NP > 0 ? NP : np_runtime;
+            for (int i = 0; i < n; ++i) {
+                for (int phase = 0; phase < np; ++phase) {
+                    output[np*i + phase] = value[phase];
+                }
+            }
+        }
+
+        void fillPhaseValues(const int n, const int np,
+                             const double* value, double* output)
+        {
+            switch (np) {
+            case 2:
+                fillPhaseValuesKernel<2>(n, np, value, output);
+                break;
+            case 3:
+                fillPhaseValuesKernel<3>(n, np, value, output);
+                break;
+            default:
+                fillPhaseValuesKernel<0>(n, np, value, output);
+            }
+        }
+    } // anonymous namespace
+
     PvtPropertiesBasic::PvtPropertiesBasic()
     {
     }
@@ -117,13 +152,7 @@ namespace Opm
                                 const double* /*z*/,
                                 double* output_mu) const
     {
-        const int np = numPhases();
-        for (int phase = 0; phase < np; ++phase) {
-// #pragma omp parallel for
-            for (int i = 0; i < n; ++i) {
-                output_mu[np*i + phase] = viscosity_[phase];
-            }
-        }
+        fillPhaseValues(n, numPhases(), &viscosity_[0], output_mu);
     }
 
     void PvtPropertiesBasic::B(const int n,
@@ -132,13 +161,7 @@ namespace Opm
                                const double* /*z*/,
                                double* output_B) const
     {
-        const int np = numPhases();
-        for (int phase = 0; phase < np; ++phase) {
-// #pragma omp parallel for
-            for (int i = 0; i < n; ++i) {
-                output_B[np*i + phase] = formation_volume_factor_[phase];
-            }
-        }
+        fillPhaseValues(n, numPhases(), &formation_volume_factor_[0], output_B);
     }
 
     void PvtPropertiesBasic::dBdp(const int n,
@@ -149,14 +172,8 @@ namespace Opm
                                   double* output_dBdp) const
     {
         const int np = numPhases();
-        for (int phase = 0; phase < np; ++phase) {
-// #pragma omp parallel for
-            for (int i = 0; i < n; ++i) {
-                output_B[np*i + phase] = formation_volume_factor_[phase];
-                output_dBdp[np*i + phase] = 0.0;
-            }
-        }
-
+        fillPhaseValues(n, np, &formation_volume_factor_[0], output_B);
+        std::fill(output_dBdp, output_dBdp + n*np, 0.0);
     }
 
 
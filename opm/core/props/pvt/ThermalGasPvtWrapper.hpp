@@ -20,10 +20,12 @@
 #define OPM_THERMAL_GAS_PVT_WRAPPER_HPP
 
 #include <opm/core/props/pvt/PvtInterface.hpp>
+#include <opm/core/props/pvt/ThermalViscosityTable.hpp>
 #include <opm/core/utility/ErrorMacros.hpp>
 
 #include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
 
+#include <string>
 #include <vector>
 
 namespace Opm
@@ -54,16 +56,21 @@ namespace Opm
                 OPM_THROW(std::runtime_error, "Gas phase was not initialized using a known way");
 
             // viscosity
+            gasvisctTables_.clear();
             if (deck->hasKeyword("GASVISCT")) {
-                gasvisctTables_ = &tables->getGasvisctTables();
-                assert(int(gasvisctTables_->size()) == numRegions);
-                static_cast<void>(numRegions); //Silence compiler warning
+                const auto& gasvisctTables = tables->getGasvisctTables();
+                assert(int(gasvisctTables.size()) == numRegions);
 
                 gasCompIdx_ = deck->getKeyword("GCOMPIDX")->getRecord(0)->getItem("GAS_COMPONENT_INDEX")->getInt(0) - 1;
-                gasvisctColumnName_ = "Viscosity"+std::to_string(static_cast<long long>(gasCompIdx_));
+                const std::string columnName = "Viscosity"+std::to_string(static_cast<long long>(gasCompIdx_));
+                for (int regionIdx = 0; regionIdx < numRegions; ++regionIdx) {
+                    gasvisctTables_.push_back(ThermalViscosityTable(gasvisctTables[regionIdx].getColumn(0),
+                                                                    gasvisctTables[regionIdx].getColumn(columnName)));
+                }
             }
 
             // density
+            tref_ = 0.0;
             if (deck->hasKeyword("TREF")) {
                 tref_ = deck->getKeyword("TREF")->getRecord(0)->getItem("TEMPERATURE")->getSIDouble(0);
             }
@@ -76,7 +83,7 @@ namespace Opm
                         const double* z,
                         double* output_mu) const
         {
-            if (gasvisctTables_)
+            if (!gasvisctTables_.empty())
                 // TODO: temperature dependence for viscosity depending on z
                 OPM_THROW(std::runtime_error,
                           "temperature dependent viscosity as a function of z "
@@ -95,7 +102,8 @@ namespace Opm
                         double* output_dmudp,
                         double* output_dmudr) const
         {
-            if (gasvisctTables_ != 0) {
+            if (!gasvisctTables_.empty()) {
+                int interval = 0;
                 for (int i = 0; i < n; ++i) {
                     // temperature dependence of the gas phase. this assumes that the gas
                     // component index has been set properly, and it also looses the
@@ -103,7 +111,7 @@ namespace Opm
                     // seems to be what the documentation for the GASVISCT keyword in the
                     // RM says.)
                     int regionIdx = getPvtRegionIndex_(pvtRegionIdx, i);
-                    double muGasvisct = (*gasvisctTables_)[regionIdx].evaluate(gasvisctColumnName_, T[i]);
+                    double muGasvisct = gasvisctTables_[regionIdx].evaluate(T[i], interval);
 
                     output_mu[i] = muGasvisct;
                     output_dmudp[i] = 0.0;
@@ -128,7 +136,8 @@ namespace Opm
                         double* output_dmudp,
                         double* output_dmudr) const
         {
-            if (gasvisctTables_ != 0) {
+            if (!gasvisctTables_.empty()) {
+                int interval = 0;
                 for (int i = 0; i < n; ++i) {
                     // temperature dependence of the gas phase. this assumes that the gas
                     // component index has been set properly, and it also looses the
@@ -136,7 +145,7 @@ namespace Opm
                     // seems to be what the documentation for the GASVISCT keyword in the
                     // RM says.)
                     int regionIdx = getPvtRegionIndex_(pvtRegionIdx, i);
-                    double muGasvisct = (*gasvisctTables_)[regionIdx].evaluate(gasvisctColumnName_, T[i]);
+                    double muGasvisct = gasvisctTables_[regionIdx].evaluate(T[i], interval);
 
                     output_mu[i] = muGasvisct;
                     output_dmudp[i] = 0.0;
@@ -297,8 +306,9 @@ namespace Opm
 
         // The PVT properties needed for temperature dependence of the viscosity. We need
         // to store one value per PVT region.
-        const std::vector<Opm::GasvisctTable>* gasvisctTables_;
-        std::string gasvisctColumnName_;
+        // The GASVISCT tables with the column of the gas component resolved,
+        // empty if the gas viscosity does not depend on temperature.
+        std::vector<ThermalViscosityTable> gasvisctTables_;
         int gasCompIdx_;
 
         // The PVT properties needed for temperature dependence of the density.
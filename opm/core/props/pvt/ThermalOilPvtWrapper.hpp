@@ -21,6 +21,7 @@
 #define OPM_THERMAL_OIL_PVT_WRAPPER_HPP
 
 #include <opm/core/props/pvt/PvtInterface.hpp>
+#include <opm/core/props/pvt/ThermalViscosityTable.hpp>
 #include <opm/core/utility/ErrorMacros.hpp>
 
 #include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
@@ -58,13 +59,19 @@ namespace Opm
                 OPM_THROW(std::runtime_error, "Oil phase was not initialized using a known way");
 
             // viscosity
+            oilvisctTables_.clear();
             if (deck->hasKeyword("VISCREF")) {
-                oilvisctTables_ = &tables->getOilvisctTables();
+                const auto& oilvisctTables = tables->getOilvisctTables();
                 Opm::DeckKeywordConstPtr viscrefKeyword = deck->getKeyword("VISCREF");
 
-                assert(int(oilvisctTables_->size()) == numRegions);
+                assert(int(oilvisctTables.size()) == numRegions);
                 assert(int(viscrefKeyword->size()) == numRegions);
 
+                for (int regionIdx = 0; regionIdx < numRegions; ++regionIdx) {
+                    oilvisctTables_.push_back(ThermalViscosityTable(oilvisctTables[regionIdx].getColumn(0),
+                                                                    oilvisctTables[regionIdx].getColumn("Viscosity")));
+                }
+
                 viscrefPress_.resize(numRegions);
                 viscrefRs_.resize(numRegions);
                 muRef_.resize(numRegions);
@@ -112,7 +119,7 @@ namespace Opm
                         const double* z,
                         double* output_mu) const
         {
-            if (oilvisctTables_)
+            if (!oilvisctTables_.empty())
                 // TODO: temperature dependence for viscosity depending on z
                 OPM_THROW(std::runtime_error,
                           "temperature dependent viscosity as a function of z "
@@ -134,11 +141,12 @@ namespace Opm
             // compute the isothermal viscosity and its derivatives
             isothermalPvt_->mu(n, pvtRegionIdx, p, T, r, output_mu, output_dmudp, output_dmudr);
 
-            if (!oilvisctTables_)
+            if (oilvisctTables_.empty())
                 // isothermal case
                 return;
 
             // temperature dependence
+            int interval = 0;
             for (int i = 0; i < n; ++i) {
                 int regionIdx = getPvtRegionIndex_(pvtRegionIdx, i);
 
@@ -147,7 +155,7 @@ namespace Opm
                 double muRef = muRef_[regionIdx];
 
                 // compute the viscosity deviation due to temperature
-                double muOilvisct = (*oilvisctTables_)[regionIdx].evaluate("Viscosity", T[i]);
+                double muOilvisct = oilvisctTables_[regionIdx].evaluate(T[i], interval);
                 double alpha = muOilvisct/muRef;
 
                 output_mu[i] *= alpha;
@@ -170,11 +178,12 @@ namespace Opm
             // compute the isothermal viscosity and its derivatives
             isothermalPvt_->mu(n, pvtRegionIdx, p, T, r, cond, output_mu, output_dmudp, output_dmudr);
 
-            if (!oilvisctTables_)
+            if (oilvisctTables_.empty())
                 // isothermal case
                 return;
 
             // temperature dependence
+            int interval = 0;
             for (int i = 0; i < n; ++i) {
                 int regionIdx = getPvtRegionIndex_(pvtRegionIdx, i);
 
@@ -183,7 +192,7 @@ namespace Opm
                 double muRef = muRef_[regionIdx];
 
                 // compute the viscosity deviation due to temperature
-                double muOilvisct = (*oilvisctTables_)[regionIdx].evaluate("Viscosity", T[i]);
+                double muOilvisct = oilvisctTables_[regionIdx].evaluate(T[i], interval);
                 double alpha = muOilvisct/muRef;
 
                 output_mu[i] *= alpha;
@@ -367,7 +376,9 @@ namespace Opm
         std::vector<double> viscrefRs_;
         std::vector<double> muRef_;
 
-        const std::vector<Opm::OilvisctTable>* oilvisctTables_;
+        // The OILVISCT tables with their columns resolved, empty if the oil
+        // viscosity does not depend on temperature.
+        std::vector<ThermalViscosityTable> oilvisctTables_;
 
         // The PVT properties needed for temperature dependence of the density. This is
         // specified as one value per EOS in the manual, but we unconditionally use the
@@ -0,0 +1,125 @@
+/*
+  Copyright 2015 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_THERMALVISCOSITYTABLE_HEADER_INCLUDED
+#define OPM_THERMALVISCOSITYTABLE_HEADER_INCLUDED
+
+#include <opm/core/utility/ErrorMacros.hpp>
+
+#include <cassert>
+#include <stdexcept>
+#include <vector>
+
+namespace Opm
+{
+
+    /// Viscosity as a function of temperature, as given by one region
+    /// of the OILVISCT, WATVISCT or GASVISCT keywords.
+    ///
+    /// The table columns are copied once at construction, so that
+    /// evaluation does not need to look up columns by name. Evaluation
+    /// interpolates linearly and is constant outside the table range,
+    /// giving the same values as the evaluate() method of the parser's
+    /// tables. The temperatures must be strictly increasing.
+    class ThermalViscosityTable
+    {
+    public:
+        ThermalViscosityTable()
+        {
+        }
+
+        /// Construct from temperature and viscosity columns.
+        ThermalViscosityTable(const std::vector<double>& temperature,
+                              const std::vector<double>& viscosity)
+            : temperature_(temperature),
+              viscosity_(viscosity)
+        {
+            if (temperature_.empty() || temperature_.size() != viscosity_.size()) {
+                OPM_THROW(std::runtime_error, "ThermalViscosityTable: columns must be nonempty and of equal size.");
+            }
+        }
+
+        /// Viscosity at temperature T.
+        double operator()(const double T) const
+        {
+            int interval = 0;
+            return evaluate(T, interval);
+        }
+
+        /// Viscosity at temperature T.
+        /// \param[in]     T         Temperature.
+        /// \param[in,out] interval  Interval to start searching from. On
+        ///                          return, the interval containing T.
+        ///                          Passing the result of the previous
+        ///                          call makes the lookup for nearby
+        ///                          temperatures constant time.
+        double evaluate(const double T, int& interval) const
+        {
+            const int last = int(temperature_.size()) - 1;
+            if (last == 0 || T <= temperature_[0]) {
+                interval = 0;
+                return viscosity_[0];
+            }
+            if (T >= temperature_[last]) {
+                interval = last - 1;
+                return viscosity_[last];
+            }
+            int i = (interval >= 0 && interval < last) ? interval : 0;
+            if (T < temperature_[i]) {
+                int hi = i;
+                int lo = 0;
+                while (lo + 1 < hi) {
+                    const int mid = (lo + hi)/2;
+                    if (temperature_[mid] <= T) lo = mid; else hi = mid;
+                }
+                i = lo;
+            } else if (T > temperature_[i + 1]) {
+                int lo = i + 1;
+                int hi = last;
+                while (lo + 1 < hi) {
+                    const int mid = (lo + hi)/2;
+                    if (temperature_[mid] <= T) lo = mid; else hi = mid;
+                }
+                i = lo;
+            }
+            assert(temperature_[i] <= T && T <= temperature_[i + 1]);
+            interval = i;
+            const double alpha = (T - temperature_[i])/(temperature_[i + 1] - temperature_[i]);
+            return viscosity_[i]*(1 - alpha) + viscosity_[i + 1]*alpha;
+        }
+
+        /// Viscosities at n temperatures.
+        /// Consecutive temperatures are typically close, so each
+        /// lookup starts from the interval of the previous one.
+        void evaluate(const int n, const double* T, double* mu) const
+        {
+            int interval = 0;
+            for (int i = 0; i < n; ++i) {
+                mu[i] = evaluate(T[i], interval);
+            }
+        }
+
+    private:
+        std::vector<double> temperature_;
+        std::vector<double> viscosity_;
+    };
+
+} // namespace Opm
+
+#endif // OPM_THERMALVISCOSITYTABLE_HEADER_INCLUDED
@@ -21,6 +21,7 @@
 #define OPM_THERMAL_WATER_PVT_WRAPPER_HPP
 
 #include <opm/core/props/pvt/PvtInterface.hpp>
+#include <opm/core/props/pvt/ThermalViscosityTable.hpp>
 #include <opm/core/utility/ErrorMacros.hpp>
 
 #include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
@@ -44,7 +45,7 @@ namespace Opm
                           Opm::EclipseStateConstPtr eclipseState)
         {
             isothermalPvt_ = isothermalPvt;
-            watvisctTables_ = 0;
+            watvisctTables_.clear();
 
             // stuff which we need to get from the PVTW keyword
             Opm::DeckKeywordConstPtr pvtwKeyword = deck->getKeyword("PVTW");
@@ -66,17 +67,26 @@ namespace Opm
             // (basically we expect well-behaved VISCREF and WATVISCT keywords.)
             if (deck->hasKeyword("VISCREF")) {
                 auto tables = eclipseState->getTableManager();
-                watvisctTables_ = &tables->getWatvisctTables();
+                const auto& watvisctTables = tables->getWatvisctTables();
                 Opm::DeckKeywordConstPtr viscrefKeyword = deck->getKeyword("VISCREF");
 
-                assert(int(watvisctTables_->size()) == numRegions);
+                assert(int(watvisctTables.size()) == numRegions);
                 assert(int(viscrefKeyword->size()) == numRegions);
 
                 viscrefPress_.resize(numRegions);
+                muRef_.resize(numRegions);
                 for (int regionIdx = 0; regionIdx < numRegions; ++ regionIdx) {
                     Opm::DeckRecordConstPtr viscrefRecord = viscrefKeyword->getRecord(regionIdx);
 
                     viscrefPress_[regionIdx] = viscrefRecord->getItem("REFERENCE_PRESSURE")->getSIDouble(0);
+
+                    // calculate the viscosity of the isothermal keyword for the reference
+                    // pressure given by the VISCREF keyword.
+                    double x = -pvtwViscosibility_[regionIdx]*(viscrefPress_[regionIdx] - pvtwRefPress_[regionIdx]);
+                    muRef_[regionIdx] = pvtwViscosity_[regionIdx]/(1.0 + x + 0.5*x*x);
+
+                    watvisctTables_.push_back(ThermalViscosityTable(watvisctTables[regionIdx].getColumn(0),
+                                                                    watvisctTables[regionIdx].getColumn("Viscosity")));
                 }
             }
 
@@ -106,7 +116,7 @@ namespace Opm
                         const double* z,
                         double* output_mu) const
         {
-            if (watvisctTables_)
+            if (!watvisctTables_.empty())
                 // TODO: temperature dependence for viscosity depending on z
                 OPM_THROW(std::runtime_error,
                           "temperature dependent viscosity as a function of z "
@@ -128,21 +138,21 @@ namespace Opm
             // compute the isothermal viscosity and its derivatives
             isothermalPvt_->mu(n, pvtRegionIdx, p, T, r, output_mu, output_dmudp, output_dmudr);
 
-            if (!watvisctTables_)
+            if (watvisctTables_.empty())
                 // isothermal case
                 return;
 
             // temperature dependence
+            int interval = 0;
             for (int i = 0; i < n; ++i) {
                 int tableIdx = getTableIndex_(pvtRegionIdx, i);
 
-                // calculate the viscosity of the isothermal keyword for the reference
-                // pressure given by the VISCREF keyword.
-                double x = -pvtwViscosibility_[tableIdx]*(viscrefPress_[tableIdx] - pvtwRefPress_[tableIdx]);
-                double muRef = pvtwViscosity_[tableIdx]/(1.0 + x + 0.5*x*x);
+                // the viscosity of the isothermal keyword for the reference pressure
+                // given by the VISCREF keyword.
+                double muRef = muRef_[tableIdx];
 
                 // compute the viscosity deviation due to temperature
-                double muWatvisct = (*watvisctTables_)[tableIdx].evaluate("Viscosity", T[i]);
+                double muWatvisct = watvisctTables_[tableIdx].evaluate(T[i], interval);
                 double alpha = muWatvisct/muRef;
 
                 output_mu[i] *= alpha;
@@ -165,21 +175,21 @@ namespace Opm
             // compute the isothermal viscosity and its derivatives
             isothermalPvt_->mu(n, pvtRegionIdx, p, T, r, cond, output_mu, output_dmudp, output_dmudr);
 
-            if (!watvisctTables_)
+            if (watvisctTables_.empty())
                 // isothermal case
                 return;
 
             // temperature dependence
+            int interval = 0;
             for (int i = 0; i < n; ++i) {
                 int tableIdx = getTableIndex_(pvtRegionIdx, i);
 
-                // calculate the viscosity of the isothermal keyword for the reference
-                // pressure given by the VISCREF keyword.
-                double x = -pvtwViscosibility_[tableIdx]*(viscrefPress_[tableIdx] - pvtwRefPress_[tableIdx]);
-                double muRef = pvtwViscosity_[tableIdx]/(1.0 + x + 0.5*x*x);
+                // the viscosity of the isothermal keyword for the reference pressure
+                // given by the VISCREF keyword.
+                double muRef = muRef_[tableIdx];
 
                 // compute the viscosity deviation due to temperature
-                double muWatvisct = (*watvisctTables_)[tableIdx].evaluate("Viscosity", T[i]);
+                double muWatvisct = watvisctTables_[tableIdx].evaluate(T[i], interval);
                 double alpha = muWatvisct/muRef;
 
                 output_mu[i] *= alpha;
@@ -371,6 +381,7 @@ namespace Opm
         // The PVT properties needed for temperature dependence. We need to store one
         // value per PVT region.
         std::vector<double> viscrefPress_;
+        std::vector<double> muRef_;
 
         std::vector<double> watdentRefTemp_;
         std::vector<double> watdentCT1_;
@@ -382,7 +393,9 @@ namespace Opm
         std::vector<double> pvtwViscosity_;
         std::vector<double> pvtwViscosibility_;
 
-        const std::vector<Opm::WatvisctTable>* watvisctTables_;
+        // The WATVISCT tables with their columns resolved, empty if the water
+        // viscosity does not depend on temperature.
+        std::vector<ThermalViscosityTable> watvisctTables_;
     };
 
 }
@@ -23,8 +23,10 @@
 #include <opm/core/utility/Units.hpp>
 #include <opm/core/utility/ErrorMacros.hpp>
 #include <opm/core/utility/linearInterpolation.hpp>
+#include <opm/core/utility/buildUniformLinearTable.hpp>
 
 
+#include <algorithm>
 #include <iostream>
 
 namespace Opm
@@ -32,16 +34,22 @@ namespace Opm
 
     RockCompressibility::RockCompressibility(const parameter::ParameterGroup& param)
         : pref_(0.0),
-          rock_comp_(0.0)
+          rock_comp_(0.0),
+          uniform_(false),
+          resampling_error_(0.0)
     {
         pref_ = param.getDefault("rock_compressibility_pref", 100.0)*unit::barsa;
         rock_comp_ = param.getDefault("rock_compressibility", 0.0)/unit::barsa;
     }
 
     RockCompressibility::RockCompressibility(Opm::DeckConstPtr deck,
-                                             Opm::EclipseStateConstPtr eclipseState)
+                                             Opm::EclipseStateConstPtr eclipseState,
+                                             const double resampleTolerance,
+                                             const int maxResampleSize)
         : pref_(0.0),
-          rock_comp_(0.0)
+          rock_comp_(0.0),
+          uniform_(false),
+          resampling_error_(0.0)
     {
         const auto tables = eclipseState->getTableManager();
         const auto& rocktabTables = tables->getRocktabTables();
@@ -52,6 +60,17 @@ namespace Opm
             p_ = rocktabTables[0].getPressureColumn();
             poromult_ = rocktabTables[0].getPoreVolumeMultiplierColumn();
             transmult_ =  rocktabTables[0].getTransmissibilityMultiplierColumn();
+
+            if (resampleTolerance > 0.0) {
+                const double poro_error = buildUniformLinearTable(p_, poromult_, resampleTolerance,
+                                                                  maxResampleSize, uniform_poromult_);
+                const double trans_error = buildUniformLinearTable(p_, transmult_, resampleTolerance,
+                                                                   maxResampleSize, uniform_transmult_);
+                resampling_error_ = std::max(poro_error, trans_error);
+                uniform_ = true;
+                OPM_MESSAGE("ROCKTAB resampled onto a uniform grid, max relative error: "
+                            << resampling_error_);
+            }
         } else if (deck->hasKeyword("ROCK")) {
             Opm::DeckKeywordConstPtr rockKeyword = deck->getKeyword("ROCK");
             if (rockKeyword->size() != 1) {
@@ -80,7 +99,8 @@ namespace Opm
             const double cpnorm = rock_comp_*(pressure - pref_);
             return (1.0 + cpnorm + 0.5*cpnorm*cpnorm);
         } else {
-            return Opm::linearInterpolation(p_, poromult_, pressure);
+            return uniform_ ? uniform_poromult_(pressure)
+                : Opm::linearInterpolation(p_, poromult_, pressure);
         }
     }
 
@@ -91,7 +111,8 @@ namespace Opm
             // we must use its derivative.
             return rock_comp_ + 2 * rock_comp_ * rock_comp_ * (pressure - pref_);
         } else {
-            return Opm::linearInterpolationDerivative(p_, poromult_, pressure);
+            return uniform_ ? uniform_poromult_.derivative(pressure)
+                : Opm::linearInterpolationDerivative(p_, poromult_, pressure);
         }
     }
 
@@ -100,7 +121,8 @@ namespace Opm
         if (p_.empty()) {
             return 1.0;
         } else {
-            return Opm::linearInterpolation(p_, transmult_, pressure);
+            return uniform_ ? uniform_transmult_(pressure)
+                : Opm::linearInterpolation(p_, transmult_, pressure);
         }
     }
 
@@ -109,7 +131,8 @@ namespace Opm
         if (p_.empty()) {
             return 0.0;
         } else {
-            return Opm::linearInterpolationDerivative(p_, transmult_, pressure);
+            return uniform_ ? uniform_transmult_.derivative(pressure)
+                : Opm::linearInterpolationDerivative(p_, transmult_, pressure);
         }
     }
 
@@ -120,12 +143,17 @@ namespace Opm
         } else {
             //const double poromult = Opm::linearInterpolation(p_, poromult_, pressure);
             //const double dporomultdp = Opm::linearInterpolationDerivative(p_, poromult_, pressure);
-            const double poromult = Opm::linearInterpolation(p_, poromult_, pressure);
-            const double dporomultdp = Opm::linearInterpolationDerivative(p_, poromult_, pressure);
+            const double poromult = poroMult(pressure);
+            const double dporomultdp = poroMultDeriv(pressure);
 
             return dporomultdp/poromult;
         }
     }
 
+    double RockCompressibility::resamplingError() const
+    {
+        return resampling_error_;
+    }
+
 } // namespace Opm
 
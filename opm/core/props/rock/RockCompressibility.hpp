@@ -20,6 +20,8 @@
 #ifndef OPM_ROCKCOMPRESSIBILITY_HEADER_INCLUDED
 #define OPM_ROCKCOMPRESSIBILITY_HEADER_INCLUDED
 
+#include <opm/core/utility/UniformTableLinear.hpp>
+
 #include <opm/parser/eclipse/Deck/Deck.hpp>
 #include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
 
@@ -35,8 +37,14 @@ namespace Opm
     public:
         /// Construct from input deck.
         /// Looks for the keywords ROCK and ROCKTAB.
+        /// If resampleTolerance is positive, a ROCKTAB table is
+        /// resampled onto a uniform pressure grid of at most
+        /// maxResampleSize points, aiming for this maximum relative
+        /// error, so that lookups need no searching.
         RockCompressibility(Opm::DeckConstPtr deck,
-                            Opm::EclipseStateConstPtr eclipseState);
+                            Opm::EclipseStateConstPtr eclipseState,
+                            const double resampleTolerance = 0.0,
+                            const int maxResampleSize = 1025);
 
         /// Construct from parameters.
         /// Accepts the following parameters (with defaults).
@@ -62,12 +70,22 @@ namespace Opm
         /// Rock compressibility = (d poro / d p)*(1 / poro).
         double rockComp(double pressure) const;
 
+        /// Maximum relative error introduced by resampling the
+        /// ROCKTAB table, zero if it was not resampled.
+        double resamplingError() const;
+
     private:
         std::vector<double> p_;
         std::vector<double> poromult_;
         std::vector<double> transmult_;
         double pref_;
         double rock_comp_;
+
+        // Optional uniformly resampled tables, used if uniform_ is true.
+        bool uniform_;
+        double resampling_error_;
+        UniformTableLinear<double> uniform_poromult_;
+        UniformTableLinear<double> uniform_transmult_;
     };
 
 } // namespace Opm
@@ -23,6 +23,7 @@
 
 #include <iostream>
 #include <utility>
+#include <vector>
 
 #include <opm/core/utility/parameters/ParameterGroup.hpp>
 #include <opm/core/utility/ErrorMacros.hpp>
@@ -72,6 +73,28 @@ namespace Opm {
                    Solver& solver, State& state, WellState& well_state,
                    OutputWriter& outputWriter );
 
+        /** \brief  state carried from one report step to the next, for
+                    checkpointing: the suggested next time step followed
+                    by the history of the time step control
+        */
+        std::vector<double> history() const
+        {
+            std::vector<double> h( 1, suggested_next_timestep_ );
+            const std::vector<double> control = timeStepControl_->history();
+            h.insert( h.end(), control.begin(), control.end() );
+            return h;
+        }
+
+        /** \brief  restore the state returned by history() */
+        void setHistory( const std::vector<double>& h )
+        {
+            if( h.empty() ) {
+                OPM_THROW(std::runtime_error,"AdaptiveTimeStepping: empty history");
+            }
+            suggested_next_timestep_ = h[ 0 ];
+            timeStepControl_->setHistory( std::vector<double>( h.begin() + 1, h.end() ) );
+        }
+
     protected:
         template <class Solver, class State, class WellState>
         void stepImpl( const SimulatorTimer& timer,
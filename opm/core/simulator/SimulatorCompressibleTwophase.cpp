@@ -31,9 +31,11 @@
 #include <opm/core/wells.h>
 #include <opm/core/pressure/flow_bc.h>
 
+#include <opm/core/io/CheckpointFile.hpp>
 #include <opm/core/simulator/SimulatorReport.hpp>
 #include <opm/core/simulator/SimulatorTimer.hpp>
 #include <opm/core/utility/StopWatch.hpp>
+#include <opm/core/utility/Profiler.hpp>
 #include <opm/core/io/vtk/writeVtkData.hpp>
 #include <opm/core/utility/miscUtilities.hpp>
 #include <opm/core/utility/miscUtilitiesBlackoil.hpp>
@@ -85,6 +87,10 @@ namespace Opm
         bool output_vtk_;
         std::string output_dir_;
         int output_interval_;
+        // Parameters for checkpointing.
+        int checkpoint_interval_;
+        std::string checkpoint_file_;
+        std::string restart_checkpoint_;
         // Parameters for well control
         bool check_well_controls_;
         int max_well_control_iterations_;
@@ -274,6 +280,23 @@ namespace Opm
             output_interval_ = param.getDefault("output_interval", 1);
         }
 
+        // Checkpointing.
+        checkpoint_interval_ = param.getDefault("checkpoint_interval", 0);
+        restart_checkpoint_ = param.getDefault("restart_checkpoint", std::string(""));
+        if (checkpoint_interval_ > 0) {
+            const std::string default_file = param.getDefault("output_dir", std::string("output")) + "/checkpoint.bin";
+            checkpoint_file_ = param.getDefault("checkpoint_file", default_file);
+            boost::filesystem::path fpath = boost::filesystem::path(checkpoint_file_).parent_path();
+            if (!fpath.empty()) {
+                try {
+                    create_directories(fpath);
+                }
+                catch (...) {
+                    OPM_THROW(std::runtime_error, "Creating directories failed: " << fpath);
+                }
+            }
+        }
+
         // Well control related init.
         check_well_controls_ = param.getDefault("check_well_controls", false);
         max_well_control_iterations_ = param.getDefault("max_well_control_iterations", 10);
@@ -303,6 +326,15 @@ namespace Opm
     {
         std::vector<double> transport_src;
 
+        // Resume from a checkpoint, the first time run() is called.
+        if (!restart_checkpoint_.empty()) {
+            readCheckpoint(restart_checkpoint_, timer, state, well_state);
+            std::cout << "\nResuming from checkpoint " << restart_checkpoint_
+                      << " at step " << timer.currentStepNum() << std::endl;
+            restart_checkpoint_.clear();
+        }
+        const int first_step = timer.currentStepNum();
+
         // Initialisation.
         std::vector<double> porevol;
         if (rock_comp_props_ && rock_comp_props_->isActive()) {
@@ -345,14 +377,25 @@ namespace Opm
         for (; !timer.done(); ++timer) {
             // Report timestep and (optionally) write state to disk.
             step_timer.start();
+            OPM_PROFILE_REGION("step");
             timer.report(std::cout);
             if (output_ && (timer.currentStepNum() % output_interval_ == 0)) {
+                OPM_PROFILE_REGION("output");
                 if (output_vtk_) {
                     outputStateVtk(grid_, state, timer.currentStepNum(), output_dir_);
                 }
                 outputStateMatlab(grid_, state, timer.currentStepNum(), output_dir_);
             }
 
+            // Checkpoint the state at the start of the step, after the
+            // output above. A run resumed from the checkpoint starts at
+            // this step, and so writes the output of the step again.
+            if (checkpoint_interval_ > 0 && timer.currentStepNum() != first_step
+                && timer.currentStepNum() % checkpoint_interval_ == 0) {
+                writeCheckpoint(checkpoint_file_, timer, state, well_state);
+                std::cout << "Wrote checkpoint " << checkpoint_file_ << std::endl;
+            }
+
             SimulatorReport sreport;
 
             // Solve pressure equation.
@@ -367,6 +410,7 @@ namespace Opm
             do {
                 // Run solver.
                 pressure_timer.start();
+                OPM_PROFILE_REGION("pressure");
                 std::vector<double> initial_pressure = state.pressure();
                 psolver_.solve(timer.currentStepLength(), state, well_state);
 
@@ -445,6 +489,7 @@ namespace Opm
             double injected[2] = { 0.0 };
             double produced[2] = { 0.0 };
             for (int tr_substep = 0; tr_substep < num_transport_substeps_; ++tr_substep) {
+                OPM_PROFILE_REGION("transport");
                 tsolver_.solve(&state.faceflux()[0], &state.pressure()[0], &state.temperature()[0],
                                &initial_porevol[0], &porevol[0], &transport_src[0], stepsize,
                                state.saturation(), state.surfacevol());
@@ -514,6 +559,7 @@ namespace Opm
         }
 
         if (output_) {
+            OPM_PROFILE_REGION("output");
             if (output_vtk_) {
                 outputStateVtk(grid_, state, timer.currentStepNum(), output_dir_);
             }
@@ -526,6 +572,9 @@ namespace Opm
         }
 
         total_timer.stop();
+        if (output_) {
+            OPM_PROFILE_WRITE(output_dir_ + "/profile");
+        }
 
         SimulatorReport report;
         report.pressure_time = ptime;
@@ -50,6 +50,9 @@ namespace Opm
         ///     output (true)                  write output to files?
         ///     output_dir ("output")          output directoty
         ///     output_interval (1)            output every nth step
+        ///     checkpoint_interval (0)        write a checkpoint every nth step, 0 for never
+        ///     checkpoint_file (output_dir/checkpoint.bin)  checkpoint file, overwritten
+        ///     restart_checkpoint ("")        if set, resume from this checkpoint file
         ///     nl_pressure_residual_tolerance (0.0) pressure solver residual tolerance (in Pascal)
         ///     nl_pressure_change_tolerance (1.0)   pressure solver change tolerance (in Pascal)
         ///     nl_pressure_maxiter (10)       max nonlinear iterations in pressure
@@ -32,10 +32,13 @@
 #include <opm/core/wells.h>
 #include <opm/core/pressure/flow_bc.h>
 
+#include <opm/core/io/CheckpointFile.hpp>
 #include <opm/core/simulator/SimulatorReport.hpp>
 #include <opm/core/simulator/SimulatorTimer.hpp>
 #include <opm/core/utility/StopWatch.hpp>
+#include <opm/core/utility/Profiler.hpp>
 #include <opm/core/io/vtk/writeVtkData.hpp>
+#include <opm/core/io/vtk/VtuWriter.hpp>
 #include <opm/core/utility/miscUtilities.hpp>
 #include <opm/core/utility/Event.hpp>
 
@@ -82,8 +85,13 @@ namespace Opm
         std::ostream* log_;
         bool output_;
         bool output_vtk_;
+        std::unique_ptr<VtuWriter> vtu_writer_;
         std::string output_dir_;
         int output_interval_;
+        // Parameters for checkpointing.
+        int checkpoint_interval_;
+        std::string checkpoint_file_;
+        std::string restart_checkpoint_;
         // Parameters for well control
         bool check_well_controls_;
         int max_well_control_iterations_;
@@ -180,6 +188,7 @@ namespace Opm
     }
 
     static void outputStateVtk(const UnstructuredGrid& grid,
+                               const Opm::VtuWriter* vtu_writer,
                                const Opm::TwophaseState& state,
                                const int step,
                                const std::string& output_dir)
@@ -194,17 +203,22 @@ namespace Opm
         catch (...) {
             OPM_THROW(std::runtime_error, "Creating directories failed: " << fpath);
         }
-        vtkfilename << "/output-" << std::setw(3) << std::setfill('0') << step << ".vtu";
-        std::ofstream vtkfile(vtkfilename.str().c_str());
-        if (!vtkfile) {
-            OPM_THROW(std::runtime_error, "Failed to open " << vtkfilename.str());
-        }
+        vtkfilename << "/output-" << std::setw(3) << std::setfill('0') << step;
         Opm::DataMap dm;
         dm["saturation"] = &state.saturation();
         dm["pressure"] = &state.pressure();
         std::vector<double> cell_velocity;
         Opm::estimateCellVelocity(grid, state.faceflux(), cell_velocity);
         dm["velocity"] = &cell_velocity;
+        if (vtu_writer) {
+            vtu_writer->write(dm, vtkfilename.str());
+            return;
+        }
+        vtkfilename << ".vtu";
+        std::ofstream vtkfile(vtkfilename.str().c_str());
+        if (!vtkfile) {
+            OPM_THROW(std::runtime_error, "Failed to open " << vtkfilename.str());
+        }
         Opm::writeVtkData(grid, dm, vtkfile);
     }
 
@@ -377,6 +391,13 @@ namespace Opm
         output_ = param.getDefault("output", true);
         if (output_) {
             output_vtk_ = param.getDefault("output_vtk", true);
+            if (output_vtk_) {
+                const std::string format = param.getDefault("output_vtk_format", std::string("ascii"));
+                if (format != "ascii") {
+                    vtu_writer_.reset(new VtuWriter(grid, VtuWriter::encodingFromString(format),
+                                                    param.getDefault("output_vtk_pieces", 1)));
+                }
+            }
             output_dir_ = param.getDefault("output_dir", std::string("output"));
             // Ensure that output dir exists
             boost::filesystem::path fpath(output_dir_);
@@ -389,6 +410,23 @@ namespace Opm
             output_interval_ = param.getDefault("output_interval", 1);
         }
 
+        // Checkpointing.
+        checkpoint_interval_ = param.getDefault("checkpoint_interval", 0);
+        restart_checkpoint_ = param.getDefault("restart_checkpoint", std::string(""));
+        if (checkpoint_interval_ > 0) {
+            const std::string default_file = param.getDefault("output_dir", std::string("output")) + "/checkpoint.bin";
+            checkpoint_file_ = param.getDefault("checkpoint_file", default_file);
+            boost::filesystem::path fpath = boost::filesystem::path(checkpoint_file_).parent_path();
+            if (!fpath.empty()) {
+                try {
+                    create_directories(fpath);
+                }
+                catch (...) {
+                    OPM_THROW(std::runtime_error, "Creating directories failed: " << fpath);
+                }
+            }
+        }
+
         // Well control related init.
         check_well_controls_ = param.getDefault("check_well_controls", false);
         max_well_control_iterations_ = param.getDefault("max_well_control_iterations", 10);
@@ -413,6 +451,15 @@ namespace Opm
     {
         std::vector<double> transport_src;
 
+        // Resume from a checkpoint, the first time run() is called.
+        if (!restart_checkpoint_.empty()) {
+            readCheckpoint(restart_checkpoint_, timer, state, well_state);
+            *log_ << "\nResuming from checkpoint " << restart_checkpoint_
+                  << " at step " << timer.currentStepNum() << std::endl;
+            restart_checkpoint_.clear();
+        }
+        const int first_step = timer.currentStepNum();
+
         // Initialisation.
         std::vector<double> porevol;
         if (rock_comp_props_ && rock_comp_props_->isActive()) {
@@ -457,10 +504,12 @@ namespace Opm
         while (!timer.done()) {
             // Report timestep and (optionally) write state to disk.
             step_timer.start();
+            OPM_PROFILE_REGION("step");
             timer.report(*log_);
             if (output_ && (timer.currentStepNum() % output_interval_ == 0)) {
+                OPM_PROFILE_REGION("output");
                 if (output_vtk_) {
-                    outputStateVtk(grid_, state, timer.currentStepNum(), output_dir_);
+                    outputStateVtk(grid_, vtu_writer_.get(), state, timer.currentStepNum(), output_dir_);
                 }
                 outputStateMatlab(grid_, state, timer.currentStepNum(), output_dir_);
                 if (use_reorder_) {
@@ -471,6 +520,15 @@ namespace Opm
                 }
             }
 
+            // Checkpoint the state at the start of the step, after the
+            // output above. A run resumed from the checkpoint starts at
+            // this step, and so writes the output of the step again.
+            if (checkpoint_interval_ > 0 && timer.currentStepNum() != first_step
+                && timer.currentStepNum() % checkpoint_interval_ == 0) {
+                writeCheckpoint(checkpoint_file_, timer, state, well_state);
+                *log_ << "Wrote checkpoint " << checkpoint_file_ << std::endl;
+            }
+
             SimulatorReport sreport;
 
             // Solve pressure equation.
@@ -483,6 +541,7 @@ namespace Opm
             do {
                 // Run solver.
                 pressure_timer.start();
+                OPM_PROFILE_REGION("pressure");
                 std::vector<double> initial_pressure = state.pressure();
                 psolver_.solve(timer.currentStepLength(), state, well_state);
 
@@ -562,6 +621,7 @@ namespace Opm
             double injected[2] = { 0.0 };
             double produced[2] = { 0.0 };
             for (int tr_substep = 0; tr_substep < num_transport_substeps_; ++tr_substep) {
+                OPM_PROFILE_REGION("transport");
                 tsolver_->solve(&initial_porevol[0], &transport_src[0], stepsize, state);
 
                 double substep_injected[2] = { 0.0 };
@@ -619,8 +679,9 @@ namespace Opm
         }
 
         if (output_) {
+            OPM_PROFILE_REGION("output");
             if (output_vtk_) {
-                outputStateVtk(grid_, state, timer.currentStepNum(), output_dir_);
+                outputStateVtk(grid_, vtu_writer_.get(), state, timer.currentStepNum(), output_dir_);
             }
             outputStateMatlab(grid_, state, timer.currentStepNum(), output_dir_);
             if (use_reorder_) {
@@ -637,6 +698,9 @@ namespace Opm
         }
 
         total_timer.stop();
+        if (output_) {
+            OPM_PROFILE_WRITE(output_dir_ + "/profile");
+        }
 
         SimulatorReport report;
         report.pressure_time = ptime;
@@ -20,11 +20,19 @@
 #include "SimulatorOutput.hpp"
 
 // we need complete definitions for these types
+#include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/Schedule.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/TimeMap.hpp>
+#include <opm/core/io/AsyncOutputWriter.hpp>
 #include <opm/core/io/OutputWriter.hpp>
+#include <opm/core/simulator/SimulatorState.hpp>
 #include <opm/core/simulator/SimulatorTimer.hpp>
+#include <opm/core/simulator/WellState.hpp>
+#include <opm/core/utility/ErrorMacros.hpp>
+#include <opm/core/utility/parameters/ParameterGroup.hpp>
 
 #include <numeric> // partial_sum
+#include <stdexcept>
 
 using namespace Opm;
 
@@ -35,27 +43,46 @@ SimulatorOutputBase::SimulatorOutputBase (
         std::shared_ptr <const UnstructuredGrid> grid,
         std::shared_ptr <const SimulatorTimer> timer,
         std::shared_ptr <const SimulatorState> state,
-        std::shared_ptr <const WellState> wellState)
+        std::shared_ptr <const WellState> wellState,
+        std::shared_ptr <const CompressedCartesianIndex> cartesianIndex)
 
     // store all parameters passed into the object, making them curried
     // parameters to the writeOutput function.
     : timer_          (timer    )
+    , timeMap_        (eclipseState->getSchedule ()->getTimeMap ())
     , reservoirState_ (state    )
     , wellState_      (wellState)
 
     // process parameters into a writer. we don't setup a new chain in
     // every timestep!
-    , writer_ (std::move (OutputWriter::create (params, eclipseState, phaseUsage, grid)))
+    , writer_ (std::move (OutputWriter::create (params, eclipseState, phaseUsage, grid, cartesianIndex)))
 
     // always start from the first timestep
     , next_ (0) {
 
     // write the static initialization files, even before simulation starts
     writer_->writeInit (*timer);
+
+    // start the background writer after writeInit, which is done here
+    if (params.getDefault <bool> ("output_async", false)) {
+        const int num_buffers = params.getDefault <int> ("output_async_buffers", 2);
+        if (num_buffers < 1) {
+            OPM_THROW (std::runtime_error, "output_async_buffers must be positive, got " << num_buffers);
+        }
+        async_.reset (new AsyncOutputWriter (*writer_, num_buffers));
+    }
+}
+
+SimulatorOutputBase::~SimulatorOutputBase() {
+    // the asynchronous writer finishes its queue before it goes away
 }
 
-// default destructor is OK, just need to be defined
-SimulatorOutputBase::~SimulatorOutputBase() { }
+void
+SimulatorOutputBase::flush () {
+    if (async_) {
+        async_->flush ();
+    }
+}
 
 SimulatorOutputBase::operator std::function <void ()> () {
     // return (a pointer to) the writeOutput() function as an object
@@ -88,12 +115,23 @@ SimulatorOutputBase::writeOutput () {
 
             // relay the request to the handlers (setup in the constructor
             // from parameters)
-            writer_->writeTimeStep (*timer_, *reservoirState_, *wellState_ , false);
+            if (async_) {
+                async_->writeTimeStep (*timer_, *reservoirState_, *wellState_);
+            }
+            else {
+                writer_->writeTimeStep (*timer_, *reservoirState_, *wellState_ , false);
+            }
 
             // advance to the next reporting time
             ++next_;
         }
     }
+
+    // this was the last step of the simulation; wait for the output
+    // so that writer errors are thrown out of the simulator's run()
+    if (timer_->done ()) {
+        flush ();
+    }
 }
 
 void
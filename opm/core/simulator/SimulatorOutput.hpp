@@ -32,8 +32,10 @@ struct UnstructuredGrid;
 namespace Opm {
 
 // forward definitions
+class CompressedCartesianIndex;
 class Deck;
 class EclipseState;
+class AsyncOutputWriter;
 class OutputWriter;
 namespace parameter { class ParameterGroup; }
 class SimulatorState;
@@ -47,13 +49,35 @@ struct PhaseUsage;
  * a function object holding curried arguments to the writing backend
  * which is used when invoked through the event handler (which passes
  * on no arguments on it own).
+ *
+ * If the parameter output_async is true, the writers are called on a
+ * background thread instead: at each reporting time the timer and
+ * states are copied into one of output_async_buffers (default 2)
+ * pooled buffers and queued, and the simulation continues while they
+ * are written. If all buffers are in use, the simulation waits for
+ * the writers to catch up. An exception thrown by a writer is
+ * rethrown at the next reporting time, or after the last time step
+ * of the simulation, when the output is flushed.
  */
 class SimulatorOutputBase {
+public:
+    /**
+     * Wait until all queued output has been written. In asynchronous
+     * mode, rethrow an exception thrown by a writer since the last
+     * time one was reported. This is done after the last time step;
+     * call it explicitly if the simulation stops earlier, since the
+     * destructor can only report such errors to std::cerr.
+     */
+    void flush ();
+
 protected:
     /**
      * Curry arguments for the output writer. These arguments are passed
      * to the simulator, but is not passed on to the event handler so it
      * need to pick them up from the object members.
+     *
+     * The Cartesian index of the grid is handed to the writers, see
+     * OutputWriter::create.
      */
     SimulatorOutputBase (const parameter::ParameterGroup& p,
                          std::shared_ptr <const EclipseState> eclipseState,
@@ -61,7 +85,8 @@ protected:
                          std::shared_ptr <const UnstructuredGrid> grid,
                          std::shared_ptr <const SimulatorTimer> timer,
                          std::shared_ptr <const SimulatorState> state,
-                         std::shared_ptr <const WellState> wellState);
+                         std::shared_ptr <const WellState> wellState,
+                         std::shared_ptr <const CompressedCartesianIndex> cartesianIndex);
 
     /**
      * We need a destructor in the compilation unit to avoid the
@@ -93,6 +118,9 @@ protected:
     virtual void sync ();
 
 private:
+    /// Background writer thread and its buffers, if asynchronous
+    std::unique_ptr <AsyncOutputWriter> async_;
+
     /// Index of the upcoming reporting time
     std::vector <double>::size_type next_;
 
@@ -151,10 +179,12 @@ struct SimulatorOutput : public SimulatorOutputBase {
                      std::shared_ptr <const SimulatorTimer> timer,
                      std::shared_ptr <const SimulatorState> state,
                      std::shared_ptr <const WellState> wellState,
-                     std::shared_ptr <Simulator> sim)
+                     std::shared_ptr <Simulator> sim,
+                     std::shared_ptr <const CompressedCartesianIndex> cartesianIndex
+                         = std::shared_ptr <const CompressedCartesianIndex> ())
         // send all other parameters to base class
         : SimulatorOutputBase (params, eclipseState, phaseUsage,
-                               grid, timer, state, wellState)
+                               grid, timer, state, wellState, cartesianIndex)
 
         // store reference to simulator in derived class
         , sim_ (sim) {
@@ -175,7 +205,9 @@ struct SimulatorOutput : public SimulatorOutputBase {
                      const SimulatorTimer& timer,
                      const SimulatorState& state,
                      const WellState& wellState,
-                     Simulator& sim)
+                     Simulator& sim,
+                     std::shared_ptr <const CompressedCartesianIndex> cartesianIndex
+                         = std::shared_ptr <const CompressedCartesianIndex> ())
         // send all other parameters to base class
         : SimulatorOutputBase (params,
                                share_obj (eclipseState),
@@ -183,7 +215,8 @@ struct SimulatorOutput : public SimulatorOutputBase {
                                share_obj (grid),
                                share_obj (timer),
                                share_obj (state),
-                               share_obj (wellState))
+                               share_obj (wellState),
+                               cartesianIndex)
 
         // store reference to simulator in derived class
         , sim_ (share_obj (sim)) {
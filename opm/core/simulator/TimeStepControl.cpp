@@ -158,6 +158,20 @@ namespace Opm
         }
     }
 
+    std::vector<double> PIDTimeStepControl::history() const
+    {
+        return errors_;
+    }
+
+    void PIDTimeStepControl::setHistory( const std::vector<double>& history )
+    {
+        if( history.size() != errors_.size() ) {
+            OPM_THROW(std::runtime_error,"PIDTimeStepControl: history has " << history.size()
+                      << " entries, expected " << errors_.size() );
+        }
+        errors_ = history;
+    }
+
 
 
     ////////////////////////////////////////////////////////////
@@ -91,6 +91,12 @@ namespace Opm
         /// \brief \copydoc TimeStepControlInterface::computeTimeStepSize
         double computeTimeStepSize( const double dt, const int /* iterations */, const SimulatorState& state ) const;
 
+        /// \brief \copydoc TimeStepControlInterface::history
+        std::vector<double> history() const;
+
+        /// \brief \copydoc TimeStepControlInterface::setHistory
+        void setHistory( const std::vector<double>& history );
+
     protected:
         template <class Iterator>
         double euclidianNormSquared( Iterator it, const Iterator end, int num_components = 1 ) const
@@ -21,6 +21,8 @@
 
 #include <opm/core/simulator/SimulatorState.hpp> 
 
+#include <vector>
+
 namespace Opm
 {
 
@@ -45,6 +47,13 @@ namespace Opm
         /// \return suggested time step size for the next step
         virtual double computeTimeStepSize( const double dt, const int iterations, const SimulatorState& ) const = 0;
 
+        /// \return the history that the controller carries from one time step
+        ///         to the next, for checkpointing (default is empty)
+        virtual std::vector<double> history() const { return std::vector<double>(); }
+
+        /// restore the history returned by history()
+        virtual void setHistory( const std::vector<double>& /*history*/ ) {}
+
         /// virtual destructor (empty)
         virtual ~TimeStepControlInterface () {}
     };
@@ -22,12 +22,15 @@
 
 #include <opm/core/wells.h>
 #include <opm/core/well_controls.h>
+#include <opm/core/utility/ErrorMacros.hpp>
+#include <algorithm>
 #include <array>
 #include <map>
 #include <string>
 #include <vector>
 #include <cassert>
 #include <cstddef>
+#include <stdexcept>
 
 namespace Opm
 {
@@ -49,6 +52,8 @@ namespace Opm
         {
             // clear old name mapping
             wellMap_.clear();
+            well_ids_.clear();
+            well_connpos_.clear();
 
             if (wells) {
                 const int nw = wells->number_of_wells;
@@ -149,6 +154,48 @@ namespace Opm
             }
         }
 
+        /// Allocate and initialize as init(wells, state), then carry
+        /// over the values of the wells that are also present in
+        /// prev_state, such as when the wells change between report
+        /// steps. Wells are matched by their identities, not names,
+        /// and the transfer takes linear time.
+        ///
+        /// For a matched well that is not stopped, the bhp, thp,
+        /// temperature and well rates are copied. The exception is the
+        /// bhp (thp) if the current control is a BHP (THP) control, in
+        /// which case the target is kept. The perforation rates and
+        /// pressures are copied if the number of perforations is
+        /// unchanged.
+        /// \param[in] wells       The new wells.
+        /// \param[in] well_ids    Identity of each well, as given by
+        ///                        WellsManager::wellIds(). Identities
+        ///                        must be non-negative and unique.
+        /// \param[in] state       Reservoir state, as for init(wells, state).
+        /// \param[in] prev_state  Well state of the previous wells. It
+        ///                        has no identities, and nothing is
+        ///                        carried over, if it was initialised
+        ///                        without them.
+        template <class State>
+        void init(const Wells* wells, const std::vector<int>& well_ids,
+                  const State& state, const WellState& prev_state)
+        {
+            init(wells, state);
+            if (!wells) {
+                return;
+            }
+            if (int(well_ids.size()) != wells->number_of_wells) {
+                OPM_THROW(std::runtime_error, "WellState::init(): " << well_ids.size()
+                          << " well identities given for " << wells->number_of_wells << " wells.");
+            }
+            well_ids_ = well_ids;
+            well_connpos_.assign(wells->well_connpos, wells->well_connpos + wells->number_of_wells + 1);
+            transfer(*wells, prev_state);
+        }
+
+        /// Identity of each well, stable across report steps, if
+        /// initialised with identities. Otherwise empty.
+        const std::vector<int>& wellIds() const { return well_ids_; }
+
         /// One bhp pressure per well.
         std::vector<double>& bhp() { return bhp_; }
         const std::vector<double>& bhp() const { return bhp_; }
@@ -209,6 +256,57 @@ namespace Opm
         }
 
     private:
+        // Copy the values of wells present in prev, see init().
+        void transfer(const Wells& wells, const WellState& prev)
+        {
+            const std::vector<int>& prev_ids = prev.well_ids_;
+            if (prev_ids.empty()) {
+                return;
+            }
+            const int np = wells.number_of_phases;
+            if (prev.numPhases() != np) {
+                OPM_THROW(std::runtime_error, "WellState::init(): number of phases changed from "
+                          << prev.numPhases() << " to " << np << '.');
+            }
+
+            // Previous well index by identity.
+            const int max_id = *std::max_element(prev_ids.begin(), prev_ids.end());
+            std::vector<int> prev_index(max_id + 1, -1);
+            for (std::size_t w = 0; w < prev_ids.size(); ++w) {
+                prev_index[prev_ids[w]] = w;
+            }
+            const std::vector<int>& prev_connpos = prev.well_connpos_;
+
+            for (int w = 0; w < wells.number_of_wells; ++w) {
+                const int id = well_ids_[w];
+                const int pw = id <= max_id ? prev_index[id] : -1;
+                const WellControls* ctrl = wells.ctrls[w];
+                if (pw < 0 || well_controls_well_is_stopped(ctrl)) {
+                    continue;
+                }
+                const WellControlType control = well_controls_get_current_type(ctrl);
+                if (control != BHP) {
+                    bhp_[w] = prev.bhp_[pw];
+                }
+                if (control != THP) {
+                    thp_[w] = prev.thp_[pw];
+                }
+                temperature_[w] = prev.temperature_[pw];
+                std::copy(prev.wellrates_.begin() + np*pw, prev.wellrates_.begin() + np*(pw + 1),
+                          wellrates_.begin() + np*w);
+
+                const int num_perf = wells.well_connpos[w + 1] - wells.well_connpos[w];
+                if (prev_connpos[pw + 1] - prev_connpos[pw] == num_perf) {
+                    const int first = wells.well_connpos[w];
+                    const int prev_first = prev_connpos[pw];
+                    std::copy(prev.perfrates_.begin() + prev_first, prev.perfrates_.begin() + prev_first + num_perf,
+                              perfrates_.begin() + first);
+                    std::copy(prev.perfpress_.begin() + prev_first, prev.perfpress_.begin() + prev_first + num_perf,
+                              perfpress_.begin() + first);
+                }
+            }
+        }
+
         std::vector<double> bhp_;
         std::vector<double> thp_;
         std::vector<double> temperature_;
@@ -217,6 +315,8 @@ namespace Opm
         std::vector<double> perfpress_;
 
         WellMapType wellMap_;
+        std::vector<int> well_ids_;
+        std::vector<int> well_connpos_;   // Only with well_ids_.
     };
 
 } // namespace Opm
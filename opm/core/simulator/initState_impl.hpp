@@ -25,7 +25,7 @@
 #include <opm/core/grid.h>
 #include <opm/core/grid/GridHelpers.hpp>
 #include <opm/core/utility/ErrorMacros.hpp>
-#include <opm/core/utility/MonotCubicInterpolator.hpp>
+#include <opm/core/utility/MonotCubicTable.hpp>
 #include <opm/core/utility/Units.hpp>
 #include <opm/core/props/IncompPropertiesInterface.hpp>
 #include <opm/core/props/BlackoilPropertiesInterface.hpp>
@@ -280,16 +280,17 @@ namespace Opm
                 zv.push_back(it->first);
                 pv.push_back(it->second);
             }
-            MonotCubicInterpolator press(zv, pv);
+            MonotCubicTable press(zv, pv);
 
             // Evaluate pressure at each cell centroid.
-            std::vector<double>& p = state.pressure();
+            std::vector<double> cell_z(number_of_cells);
             for (int c = 0; c < number_of_cells; ++c) {
-                const double z = UgGridHelpers::
+                cell_z[c] = UgGridHelpers::
                     getCoordinate(UgGridHelpers::increment(begin_cell_centroids, c, dimensions),
                                   dimensions-1);
-                p[c] = press(z);
             }
+            std::vector<double>& p = state.pressure();
+            press.evaluate(number_of_cells, cell_z.data(), p.data());
         }
 
         // Initialize face pressures to distance-weighted average of adjacent cell pressures.
@@ -0,0 +1,97 @@
+/*
+  Copyright 2015 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media Project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_CSRMATRIXGENERICSOLVER_HPP_HEADER
+#define OPM_CSRMATRIXGENERICSOLVER_HPP_HEADER
+
+#include <opm/core/linalg/LinearSolverInterface.hpp>
+#include <opm/core/linalg/sparse_sys.h>
+#include <opm/core/utility/ErrorMacros.hpp>
+#include <opm/core/utility/Exceptions.hpp>
+
+#include <algorithm>
+#include <memory>
+
+namespace Opm
+{
+    namespace ImplicitTransportLinAlgSupport
+    {
+
+        /// Adapter making any LinearSolverInterface usable as the
+        /// linear solver of ImplicitTransport.  Typically used with a
+        /// LinearSolverFactory configured for an iterative method,
+        /// e.g. linsolver = "istl" for ILU(0)-preconditioned BiCGStab,
+        /// as an alternative to a direct solver for large models.
+        class CSRMatrixGenericSolver
+        {
+        public:
+            /// Construct adapter.
+            /// \param[in] linsolver  The linear solver to use.
+            explicit CSRMatrixGenericSolver(std::shared_ptr<LinearSolverInterface> linsolver)
+                : linsolver_(linsolver)
+            {
+            }
+
+
+            template <class Vector>
+            void
+            solve(const struct CSRMatrix* A,
+                  const Vector            b,
+                  Vector                  x)
+            {
+                solveImpl(A, b, x);
+            }
+
+
+            template <class Vector>
+            void
+            solve(const struct CSRMatrix& A,
+                  const Vector&           b,
+                  Vector&                 x)
+            {
+                solveImpl(&A, &b[0], &x[0]);
+            }
+
+
+        private:
+            std::shared_ptr<LinearSolverInterface> linsolver_;
+
+            void
+            solveImpl(const struct CSRMatrix* A,
+                      const double*           b,
+                      double*                 x)
+            {
+                // The Newton increment is small near convergence, so
+                // zero is a better initial guess than the previous one.
+                std::fill(x, x + A->m, 0.0);
+
+                const LinearSolverInterface::LinearSolverReport rep =
+                    linsolver_->solve(A, b, x);
+
+                if (!rep.converged) {
+                    OPM_THROW(LinearSolverProblem, "Linear solver failed to converge in "
+                              << rep.iterations << " iterations in implicit transport solver.");
+                }
+            }
+        }; // class CSRMatrixGenericSolver
+
+    } // namespace ImplicitTransportLinAlgSupport
+} // namespace Opm
+
+#endif  /* OPM_CSRMATRIXGENERICSOLVER_HPP_HEADER */
@@ -38,15 +38,48 @@
 
 #include <opm/core/linalg/call_umfpack.h>
 #include <opm/core/utility/ErrorMacros.hpp>
+#include <opm/core/utility/Exceptions.hpp>
+
+#include <memory>
 
 namespace Opm
 {
     namespace ImplicitTransportLinAlgSupport
     {
 
+        /// Direct solver for the Newton systems of the implicit
+        /// transport solver.  By default the symbolic factorisation
+        /// (fill-reducing ordering and elimination tree) is computed
+        /// once and reused for as long as the sparsity pattern of the
+        /// system matrix is unchanged, which is the case throughout a
+        /// simulation.  Optionally, the numeric factorisation can also
+        /// be kept for several consecutive solves, turning the Newton
+        /// iteration into a simplified (chord) Newton iteration.
         class CSRMatrixUmfpackSolver
         {
         public:
+            /// Construct solver.
+            /// \param[in] reuse_symbolic            Keep symbolic factorisation between solves.
+            /// \param[in] numeric_refactor_interval Recompute the numeric factorisation every
+            ///                                      this many solves. Only used if
+            ///                                      reuse_symbolic is true. One (the
+            ///                                      default) gives the ordinary Newton method.
+            explicit CSRMatrixUmfpackSolver(const bool reuse_symbolic = true,
+                                            const int  numeric_refactor_interval = 1)
+                : refactor_interval_(numeric_refactor_interval > 0 ? numeric_refactor_interval : 1),
+                  num_solves_(0)
+            {
+#if HAVE_SUITESPARSE_UMFPACK_H
+                if (reuse_symbolic) {
+                    cache_.reset(call_UMFPACK_create_cache(), call_UMFPACK_destroy_cache);
+                    if (!cache_) {
+                        OPM_THROW(std::runtime_error, "Failed to allocate UMFPACK factorisation cache.");
+                    }
+                }
+#else
+                static_cast<void>(reuse_symbolic);
+#endif
+            }
 
 
             template <class Vector>
@@ -56,7 +89,7 @@ namespace Opm
                   Vector                  x)
             {
 #if HAVE_SUITESPARSE_UMFPACK_H
-                call_UMFPACK(const_cast<CSRMatrix*>(A), b, x);
+                solveImpl(A, b, x);
 #else
     OPM_THROW(std::runtime_error, "Cannot use implicit transport solver without UMFPACK. "
           "Reconfigure opm-core with SuiteSparse/UMFPACK support and recompile.");
@@ -71,7 +104,7 @@ namespace Opm
                   Vector&                 x)
             {
 #if HAVE_SUITESPARSE_UMFPACK_H
-                call_UMFPACK(const_cast<CSRMatrix*>(&A), &b[0], &x[0]);
+                solveImpl(&A, &b[0], &x[0]);
 #else
     OPM_THROW(std::runtime_error, "Cannot use implicit transport solver without UMFPACK. "
           "Reconfigure opm-core with SuiteSparse/UMFPACK support and recompile.");
@@ -79,6 +112,31 @@ namespace Opm
             }
 
 
+        private:
+            std::shared_ptr<UMFPACKCache> cache_;
+            int                           refactor_interval_;
+            int                           num_solves_;
+
+#if HAVE_SUITESPARSE_UMFPACK_H
+            void
+            solveImpl(const struct CSRMatrix* A,
+                      const double*           b,
+                      double*                 x)
+            {
+                if (!cache_) {
+                    call_UMFPACK(const_cast<CSRMatrix*>(A), b, x);
+                    return;
+                }
+
+                const int refactor = (num_solves_ % refactor_interval_) == 0;
+                ++num_solves_;
+
+                if (!call_UMFPACK_cached(const_cast<CSRMatrix*>(A), b, x,
+                                         refactor, cache_.get())) {
+                    OPM_THROW(LinearSolverProblem, "UMFPACK failed to solve linear system.");
+                }
+            }
+#endif
         }; // class CSRMatrixUmfpackSolver
 
     } // namespace ImplicitTransportLinAlgSupport
@@ -35,6 +35,7 @@
 #include <opm/core/utility/miscUtilities.hpp>
 
 #include <iostream>
+#include <string>
 
 namespace Opm
 {
@@ -46,7 +47,9 @@ namespace Opm
             const double* gravity,
             const std::vector<double>& half_trans,
             const parameter::ParameterGroup& param)
-        : fluid_(props),
+        : linsolver_(param.getDefault("reuse_symbolic_factorization", true),
+                     param.getDefault("numeric_refactor_interval", 1)),
+          fluid_(props),
           model_(fluid_, grid, porevol, gravity, param.getDefault("guess_old_solution", false)),
           tsolver_(model_),
           grid_(grid),
@@ -55,6 +58,18 @@ namespace Opm
         ctrl_.max_it = param.getDefault("max_it", 20);
         ctrl_.verbosity = param.getDefault("verbosity", 0);
         ctrl_.max_it_ls = param.getDefault("max_it_ls", 5);
+        const std::string linsolver = param.getDefault<std::string>("transport_linsolver", "umfpack");
+        if (linsolver == "iterative") {
+            std::shared_ptr<LinearSolverInterface> ls;
+            if (param.has("transport_linsolver_params")) {
+                ls.reset(new LinearSolverFactory(param.getGroup("transport_linsolver_params")));
+            } else {
+                ls.reset(new LinearSolverFactory(param));
+            }
+            iterative_linsolver_.reset(new ImplicitTransportLinAlgSupport::CSRMatrixGenericSolver(ls));
+        } else if (linsolver != "umfpack") {
+            OPM_THROW(std::runtime_error, "Unknown transport_linsolver: " << linsolver);
+        }
         model_.initGravityTrans(grid_, half_trans);
         tsrc_ = create_transport_source(2, 2);
         initial_porevolume_cell0_ = porevol[0];
@@ -96,7 +111,11 @@ namespace Opm
             }
         }
         Opm::ImplicitTransportDetails::NRReport  rpt;
-        tsolver_.solve(grid_, tsrc_, dt, ctrl_, state, linsolver_, rpt);
+        if (iterative_linsolver_) {
+            tsolver_.solve(grid_, tsrc_, dt, ctrl_, state, *iterative_linsolver_, rpt);
+        } else {
+            tsolver_.solve(grid_, tsrc_, dt, ctrl_, state, linsolver_, rpt);
+        }
         std::cout << rpt;
     }
 
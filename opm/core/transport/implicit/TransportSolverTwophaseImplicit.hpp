@@ -27,6 +27,7 @@
 #include <opm/core/transport/implicit/ImplicitTransport.hpp>
 #include <opm/core/transport/implicit/transport_source.h>
 #include <opm/core/transport/implicit/CSRMatrixUmfpackSolver.hpp>
+#include <opm/core/transport/implicit/CSRMatrixGenericSolver.hpp>
 #include <opm/core/transport/implicit/NormSupport.hpp>
 #include <opm/core/transport/implicit/ImplicitAssembly.hpp>
 #include <opm/core/transport/implicit/ImplicitTransport.hpp>
@@ -55,7 +56,15 @@ namespace Opm
         /// \param[in] porevol   Pore volumes
         /// \param[in] gravity   Gravity vector (null for no gravity).
         /// \param[in] half_trans Half-transmissibilities (one-sided)
-        /// \param[in] maxit     Maximum number of non-linear iterations used.
+        /// \param[in] param     Parameters for the solver. The linear solver is chosen by
+        ///                      transport_linsolver ("umfpack") ("umfpack", "iterative").
+        ///                      For "umfpack", reuse_symbolic_factorization (true) and
+        ///                      numeric_refactor_interval (1) control reuse of the
+        ///                      factorisation between Newton iterations and time steps.
+        ///                      For "iterative", a LinearSolverFactory is constructed from
+        ///                      the parameter group transport_linsolver_params if present,
+        ///                      otherwise from param itself, e.g. linsolver=istl for
+        ///                      ILU(0)-preconditioned BiCGStab.
         TransportSolverTwophaseImplicit(const UnstructuredGrid& grid,
                                         const Opm::IncompPropertiesInterface& props,
                                         const std::vector<double>& porevol,
@@ -104,6 +113,7 @@ namespace Opm
 
         // Data members.
         Opm::ImplicitTransportLinAlgSupport::CSRMatrixUmfpackSolver linsolver_;
+        std::unique_ptr<Opm::ImplicitTransportLinAlgSupport::CSRMatrixGenericSolver> iterative_linsolver_;
         Opm::SimpleFluid2pWrappingProps fluid_;
         SinglePointUpwindTwoPhase<Opm::SimpleFluid2pWrappingProps> model_;
         TransportSolver tsolver_;
@@ -8,8 +8,8 @@
 #include <assert.h>
 #include <stdio.h>
 #include <stdlib.h>
-#include <limits.h>
 #include <math.h>
+#include <string.h>
 
 #include <opm/core/grid.h>
 #include <opm/core/transport/minimal/spu_implicit.h>
@@ -17,72 +17,44 @@
 
 
 
-/* Assume uniformly spaced table. */
-static double
-interpolate(int n, double h, double x0, double *tab, double x)
+/* Evaluate two uniformly spaced tables (water and oil mobility)
+ * and their (piecewise constant) derivatives at n saturations.
+ * Outside the tables, values are extended as constants and
+ * derivatives as those of the first/last interval.  Both tables
+ * share the interval index and weight, and the loop body is free of
+ * branches other than selects so that compilers can vectorise it.
+ * The arithmetic is that of the former scalar interpolate() and
+ * differentiate(), so results are bitwise identical to theirs. */
+static void
+compute_mobilities(int n, double *s, double *mob, double *dmob, int ntab, double h, double x0, double *tab)
 {
-    int           i;
-    double        a;
-
-    assert(h > 0);
-    assert((x-x0) < h*INT_MAX);
-    assert((x-x0) > h*INT_MIN);
+    const double *tabw = tab;
+    const double *tabo = tab + ntab;
 
-    if ( x < x0  ) {
-        return tab[0];
-    }
-
-    i = ((x-x0)/h);
-
-    assert(i>=0);
-
-    if (i+1 > n-1) {
-        return tab[n-1];
-    }
-
-    a = (x-x0 - i*h) / h;
-
-    return (1-a) * tab[i] + a * tab[i+1];
-}
-
-/* Assume uniformly spaced table. */
-static double
-differentiate(int n, double h, double x0, double *tab, double x)
-{
-    int           i;
+    int    k, i, last;
+    double x, t, a, tmax;
 
     assert(h > 0);
-    assert((x-x0) < h*INT_MAX);
-    assert((x-x0) > h*INT_MIN);
-    assert(n>1);
-
-    if ( x < x0  ) {
-        return (tab[1]-tab[0])/h;
-    }
-
-    i = ((x-x0)/h);
+    assert(ntab > 1);
 
-    assert(i>=0);
+    tmax = ntab - 1;
 
-    if (i+1 > n-1) {
-        return (tab[n-1]-tab[n-2])/h;
-    }
+    for (k = 0; k < n; ++k) {
+        x = s[k] - x0;
+        x = x < 0.0 ? 0.0 : x;
 
-    return (tab[i+1]-tab[i])/h;
-}
+        t = x / h;
+        t = t > tmax ? tmax : t;
 
-static void
-compute_mobilities(int n, double *s, double *mob, double *dmob, int ntab, double h, double x0, double *tab)
-{
-    double *tabw=tab;
-    double *tabo=tab+ntab;
+        i    = (int) t;
+        last = i > ntab - 2;
+        i    = last ? ntab - 2 : i;
+        a    = last ? 1.0 : (x - i*h) / h;
 
-    int i;
-    for (i=0; i<n; ++i) {
-        *mob++  = interpolate  (ntab, h, x0, tabw, *s);
-        *mob++  = interpolate  (ntab, h, x0, tabo, *s);
-        *dmob++ = differentiate(ntab, h, x0, tabw, *s);
-        *dmob++ = differentiate(ntab, h, x0, tabo, *s++);
+        mob [2*k + 0] = (1-a) * tabw[i] + a * tabw[i+1];
+        mob [2*k + 1] = (1-a) * tabo[i] + a * tabo[i+1];
+        dmob[2*k + 0] = (tabw[i+1] - tabw[i]) / h;
+        dmob[2*k + 1] = (tabo[i+1] - tabo[i]) / h;
     }
 }
 
@@ -271,13 +243,14 @@ phase_upwind_mobility(double darcyflux, double gravityflux,  int i, int c,
     }
 }
 
-void
-spu_implicit_assemble(struct UnstructuredGrid *g, double *s0, double *s, double *mob, double *dmob,
-                      double *dflux, double *gflux, double *src, double dt, sparse_t *S,
-                      double *b)
+/* Assemble equation and Jacobian row of cell i.  Row entries are
+ * written to ja and sa, diagonal first.  Returns number of entries. */
+static int
+assemble_row(struct UnstructuredGrid *g, int i, double *s0, double *s, double *mob, double *dmob,
+             double *dflux, double *gflux, double *src, double dt, int *ja, double *sa,
+             double *b)
 {
-    int     i, k, f, c1, c2, c;
-    int     nc   = g->number_of_cells;
+    int     k, f, c1, c2, c;
 
     double  m[6] = { 0, 0, 0, 0, 0, 0 };
     double  dm[2] = { 0, 0 };
@@ -290,83 +263,136 @@ spu_implicit_assemble(struct UnstructuredGrid *g, double *s0, double *s, double
     double  sgn;
     double  df, gf;
 
-    pja = S->ja;
-    psa = S->sa;
-
-    /* Assemble system */
-    S->ia[0] = 0;
-    for (i=0; i<nc; ++i) {
+    pja = ja;
+    psa = sa;
 
-        /* Store position of diagonal element */
-        d      = psa++;
-        *pja++ = i;
-        *d     = 0.0;
+    /* Store position of diagonal element */
+    d      = psa++;
+    *pja++ = i;
+    *d     = 0.0;
 
-        /* Accumulation term */
-        b[i]   = (s[i] - s0[i]);
-        *d    += 1.0;
+    /* Accumulation term */
+    b[i]   = (s[i] - s0[i]);
+    *d    += 1.0;
 
-        /* Flux terms follows*/
-        for (k=g->cell_facepos[i]; k<g->cell_facepos[i+1]; ++k) {
-            f   = g->cell_faces[k];
-            c1  = g->face_cells[2*f+0];
-            c2  = g->face_cells[2*f+1];
+    /* Flux terms follows*/
+    for (k=g->cell_facepos[i]; k<g->cell_facepos[i+1]; ++k) {
+        f   = g->cell_faces[k];
+        c1  = g->face_cells[2*f+0];
+        c2  = g->face_cells[2*f+1];
 
-            /* Skip all boundary terms (for now). */
-            if (c1 == -1 || c2 == -1) { continue; }
+        /* Skip all boundary terms (for now). */
+        if (c1 == -1 || c2 == -1) { continue; }
 
-            /* Set cell index of other cell, set correct sign of fluxes. */
-            c   = (i==c1 ? c2 : c1);
-            sgn = (i==c1)*2.0 - 1.0;
-            df  = sgn * dt*dflux[f];
-            gf  = sgn * dt*gflux[f];
+        /* Set cell index of other cell, set correct sign of fluxes. */
+        c   = (i==c1 ? c2 : c1);
+        sgn = (i==c1)*2.0 - 1.0;
+        df  = sgn * dt*dflux[f];
+        gf  = sgn * dt*gflux[f];
 
-            phase_upwind_mobility(df, gf,  i, c, mob, dmob, m, dm, cix);
+        phase_upwind_mobility(df, gf,  i, c, mob, dmob, m, dm, cix);
 
-            /* Ensure we do not divide by zero. */
-            if (m[0] + m[1] > 0.0) {
+        /* Ensure we do not divide by zero. */
+        if (m[0] + m[1] > 0.0) {
 
-                b[i]  += m[0]/(m[0]+m[1])*(df + m[1]*gf);
+            b[i]  += m[0]/(m[0]+m[1])*(df + m[1]*gf);
 
-                mt2  = (m[0]+m[1])*(m[0]+m[1]);
-                *psa = 0.0;
-                *pja = c;
+            mt2  = (m[0]+m[1])*(m[0]+m[1]);
+            *psa = 0.0;
+            *pja = c;
 
-                /* dFw/dmw·dmw/dsw */
-                if (cix[0] == c ) { *psa +=  m[1]/mt2*(df + m[1]*gf)*dm[0]; }
-                else              { *d   +=  m[1]/mt2*(df + m[1]*gf)*dm[0]; }
+            /* dFw/dmw·dmw/dsw */
+            if (cix[0] == c ) { *psa +=  m[1]/mt2*(df + m[1]*gf)*dm[0]; }
+            else              { *d   +=  m[1]/mt2*(df + m[1]*gf)*dm[0]; }
 
-                /* dFw/dmo·dmo/dsw */
-                if (cix[1] == c) { *psa += -m[0]/mt2*(df - m[0]*gf)*dm[1];  }
-                else             { *d   += -m[0]/mt2*(df - m[0]*gf)*dm[1];  }
+            /* dFw/dmo·dmo/dsw */
+            if (cix[1] == c) { *psa += -m[0]/mt2*(df - m[0]*gf)*dm[1];  }
+            else             { *d   += -m[0]/mt2*(df - m[0]*gf)*dm[1];  }
 
 
-                if (cix[0] == c || cix[1] == c) {
-                    ++psa;
-                    ++pja;
-                }
+            if (cix[0] == c || cix[1] == c) {
+                ++psa;
+                ++pja;
             }
         }
+    }
 
-        /* Injection */
-        if (src[i] > 0.0) {
-            /* Assume sat==1.0 in source, and f(1.0)=1.0; */
-            m1    = 1.0;
-            m2    = 0.0;
-            b[i] -= dt*src[i] * m1/(m1+m2);
-        }
+    /* Injection */
+    if (src[i] > 0.0) {
+        /* Assume sat==1.0 in source, and f(1.0)=1.0; */
+        m1    = 1.0;
+        m2    = 0.0;
+        b[i] -= dt*src[i] * m1/(m1+m2);
+    }
 
-        /* Production */
-        else {
-            m1  = mob [2*i+0];
-            m2  = mob [2*i+1];
-            dm1 = dmob[2*i+0];
-            dm2 = dmob[2*i+1];
+    /* Production */
+    else {
+        m1  = mob [2*i+0];
+        m2  = mob [2*i+1];
+        dm1 = dmob[2*i+0];
+        dm2 = dmob[2*i+1];
+
+        *d   -= dt*src[i] *(m2*dm1-m1*dm2)/(m1+m2)/(m1+m2);
+        b[i] -= dt*src[i] *m1/(m1+m2);
+
+    }
+
+    return (int) (pja - ja);
+}
+
+void
+spu_implicit_assemble(struct UnstructuredGrid *g, double *s0, double *s, double *mob, double *dmob,
+                      double *dflux, double *gflux, double *src, double dt, sparse_t *S,
+                      double *b)
+{
+    int     i;
+    int     nc   = g->number_of_cells;
 
-            *d   -= dt*src[i] *(m2*dm1-m1*dm2)/(m1+m2)/(m1+m2);
-            b[i] -= dt*src[i] *m1/(m1+m2);
+#ifdef _OPENMP
+    /* Rows are independent, but their positions in S depend on the
+     * number of entries in preceding rows.  Assemble rows in parallel
+     * into scratch space with room for the diagonal and one entry per
+     * half-face, then pack. */
+    int     nhf  = g->cell_facepos[nc];
+    int    *ja   = malloc((nhf + nc) * sizeof *ja);
+    double *sa   = malloc((nhf + nc) * sizeof *sa);
+
+    if ((ja != NULL) && (sa != NULL)) {
+#pragma omp parallel for schedule(static)
+        for (i=0; i<nc; ++i) {
+            int p = g->cell_facepos[i] + i;
+            S->ia[i+1] = assemble_row(g, i, s0, s, mob, dmob, dflux, gflux,
+                                      src, dt, ja + p, sa + p, b);
+        }
+
+        S->ia[0] = 0;
+        for (i=0; i<nc; ++i) {
+            S->ia[i+1] += S->ia[i];
+        }
 
+#pragma omp parallel for schedule(static)
+        for (i=0; i<nc; ++i) {
+            int p = g->cell_facepos[i] + i;
+            int n = S->ia[i+1] - S->ia[i];
+            memcpy(S->ja + S->ia[i], ja + p, n * sizeof *ja);
+            memcpy(S->sa + S->ia[i], sa + p, n * sizeof *sa);
         }
-        S->ia[i+1] = pja - S->ja;
+
+        free(sa);
+        free(ja);
+
+        return;
+    }
+
+    free(sa);
+    free(ja);
+#endif
+
+    /* Assemble system */
+    S->ia[0] = 0;
+    for (i=0; i<nc; ++i) {
+        S->ia[i+1] = S->ia[i] +
+            assemble_row(g, i, s0, s, mob, dmob, dflux, gflux, src, dt,
+                         S->ja + S->ia[i], S->sa + S->ia[i], b);
     }
 }
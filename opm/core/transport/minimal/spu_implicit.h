@@ -6,6 +6,12 @@
 #ifndef SPU_IMPLICIT_H_INCLUDED
 #define SPU_IMPLICIT_H_INCLUDED
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct UnstructuredGrid;
+
 typedef struct Sparse {
     int     m;
     int     n;
@@ -26,5 +32,9 @@ spu_implicit(struct UnstructuredGrid *g, double *s0, double *s, double h, double
               double *dflux, double *gflux, double *src, double dt,
              void (*linear_solver)(int, int*, int*, double *, double *, double *));
 
+#ifdef __cplusplus
+}
+#endif
+
 #endif /* SPU_IMPLICIT_H_INCLUDED */
 
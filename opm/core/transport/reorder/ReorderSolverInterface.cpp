@@ -21,11 +21,10 @@
 #include <opm/core/transport/reorder/ReorderSolverInterface.hpp>
 #include <opm/core/transport/reorder/reordersequence.h>
 #include <opm/core/grid.h>
-#include <opm/core/utility/StopWatch.hpp>
+#include <opm/core/utility/Profiler.hpp>
 
 #include <vector>
 #include <cassert>
-#include <iostream>
 
 
 void Opm::ReorderSolverInterface::reorderAndTransport(const UnstructuredGrid& grid, const double* darcyflux)
@@ -34,11 +33,11 @@ void Opm::ReorderSolverInterface::reorderAndTransport(const UnstructuredGrid& gr
     sequence_.resize(grid.number_of_cells);
     components_.resize(grid.number_of_cells + 1);
     int ncomponents;
-    time::StopWatch clock;
-    clock.start();
-    compute_sequence(&grid, darcyflux, &sequence_[0], &components_[0], &ncomponents);
-    clock.stop();
-    std::cout << "Topological sort took: " << clock.secsSinceStart() << " seconds." << std::endl;
+    {
+        OPM_PROFILE_REGION("reorder");
+        compute_sequence(&grid, darcyflux, &sequence_[0], &components_[0], &ncomponents);
+    }
+    OPM_PROFILE_COUNT("reorder_components", ncomponents);
 
     // Make vector's size match actual used data.
     components_.resize(ncomponents + 1);
@@ -25,6 +25,7 @@
 #include <opm/core/grid/ColumnExtract.hpp>
 #include <opm/core/utility/RootFinders.hpp>
 #include <opm/core/utility/miscUtilities.hpp>
+#include <opm/core/utility/Profiler.hpp>
 #include <opm/core/pressure/tpfa/trans_tpfa.h>
 
 #include <iostream>
@@ -414,8 +415,7 @@ namespace Opm
             OPM_THROW(std::runtime_error, "In solveMultiCell(), we did not converge after "
                   << num_iters << " iterations. Remaining update count = " << update_count);
         }
-        std::cout << "Solved " << num_cells << " cell multicell problem in "
-                  << num_iters << " iterations." << std::endl;
+        OPM_PROFILE_COUNT("multicell_iterations", num_iters);
 
 #else
         double max_s_change = 0.0;
@@ -450,8 +450,7 @@ namespace Opm
             OPM_THROW(std::runtime_error, "In solveMultiCell(), we did not converge after "
                   << num_iters << " iterations. Delta s = " << max_s_change);
         }
-        std::cout << "Solved " << num_cells << " cell multicell problem in "
-                  << num_iters << " iterations." << std::endl;
+        OPM_PROFILE_COUNT("multicell_iterations", num_iters);
 #endif // EXPERIMENT_GAUSS_SEIDEL
     }
 
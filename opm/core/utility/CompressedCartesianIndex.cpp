@@ -0,0 +1,110 @@
+/*
+  Copyright 2015 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "config.h"
+#include <opm/core/utility/CompressedCartesianIndex.hpp>
+#include <opm/core/utility/compressedToCartesian.hpp>
+#include <opm/core/utility/ErrorMacros.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace Opm
+{
+
+    namespace
+    {
+        // A hash table entry costs roughly ten times as much memory as
+        // an entry of the dense array, so the hash table is only used
+        // when fewer than one in sparse_ratio Cartesian cells are active.
+        const int sparse_ratio = 8;
+    }
+
+
+
+    CompressedCartesianIndex::CompressedCartesianIndex()
+        : cartesian_size_(0),
+          sparse_(false)
+    {
+    }
+
+
+
+    CompressedCartesianIndex::CompressedCartesianIndex(const int num_cells,
+                                                       const int* global_cell,
+                                                       const int cartesian_size)
+        : cartesian_(compressedToCartesian(num_cells, global_cell)),
+          cartesian_size_(cartesian_size),
+          sparse_(false)
+    {
+        if (cartesian_size_ < 0) {
+            cartesian_size_ = cartesian_.empty() ? 0
+                : *std::max_element(cartesian_.begin(), cartesian_.end()) + 1;
+        }
+        for (int cell = 0; cell < num_cells; ++cell) {
+            if (cartesian_[cell] < 0 || cartesian_[cell] >= cartesian_size_) {
+                OPM_THROW(std::runtime_error, "CompressedCartesianIndex: Cartesian index " << cartesian_[cell]
+                          << " of cell " << cell << " outside Cartesian grid of size " << cartesian_size_);
+            }
+        }
+
+        sparse_ = double(num_cells)*sparse_ratio < double(cartesian_size_);
+        if (sparse_) {
+            hash_.reserve(num_cells);
+            for (int cell = 0; cell < num_cells; ++cell) {
+                hash_.insert(std::make_pair(cartesian_[cell], cell));
+            }
+        } else {
+            dense_.assign(cartesian_size_, -1);
+            // Assign in reverse, so that the first cell wins should
+            // a Cartesian index be repeated.
+            for (int cell = num_cells - 1; cell >= 0; --cell) {
+                dense_[cartesian_[cell]] = cell;
+            }
+        }
+    }
+
+
+
+    std::vector<int> CompressedCartesianIndex::cellsInCartesianOrder() const
+    {
+        std::vector<int> cells;
+        cells.reserve(cartesian_.size());
+        if (!sparse_) {
+            for (int ci = 0; ci < cartesian_size_; ++ci) {
+                if (dense_[ci] >= 0) {
+                    cells.push_back(dense_[ci]);
+                }
+            }
+        } else {
+            std::vector<std::pair<int, int> > order;
+            order.reserve(hash_.size());
+            for (std::unordered_map<int, int>::const_iterator it = hash_.begin(); it != hash_.end(); ++it) {
+                order.push_back(*it);
+            }
+            std::sort(order.begin(), order.end());
+            for (std::size_t i = 0; i < order.size(); ++i) {
+                cells.push_back(order[i].second);
+            }
+        }
+        return cells;
+    }
+
+} // namespace Opm
@@ -0,0 +1,107 @@
+/*
+  Copyright 2015 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_COMPRESSEDCARTESIANINDEX_HEADER_INCLUDED
+#define OPM_COMPRESSEDCARTESIANINDEX_HEADER_INCLUDED
+
+#include <unordered_map>
+#include <vector>
+
+namespace Opm
+{
+
+    /// Mapping in both directions between the compressed (active) cell
+    /// indices of a grid and the indices of the logical Cartesian grid,
+    /// as given by the global_cell field of an UnstructuredGrid.
+    ///
+    /// Both lookups take constant time. The Cartesian to compressed
+    /// direction is stored as a dense array over the Cartesian grid,
+    /// unless only a small fraction of the Cartesian cells is active,
+    /// in which case a hash table of the active cells is used instead.
+    /// Build one object per grid and share it between its users.
+    class CompressedCartesianIndex
+    {
+    public:
+        /// Empty mapping.
+        CompressedCartesianIndex();
+
+        /// Construct from global_cell.
+        /// \param[in] num_cells       The number of active cells.
+        /// \param[in] global_cell     Either null, for the identity mapping,
+        ///                            or the Cartesian index of each of the
+        ///                            num_cells active cells.
+        /// \param[in] cartesian_size  The number of cells in the Cartesian
+        ///                            grid. If negative, one more than the
+        ///                            largest Cartesian index is used.
+        CompressedCartesianIndex(const int num_cells,
+                                 const int* global_cell,
+                                 const int cartesian_size = -1);
+
+        /// The number of active cells.
+        int numCells() const
+        {
+            return int(cartesian_.size());
+        }
+
+        /// The number of cells in the Cartesian grid.
+        int cartesianSize() const
+        {
+            return cartesian_size_;
+        }
+
+        /// Cartesian index of an active cell.
+        int cartesianIndex(const int cell) const
+        {
+            return cartesian_[cell];
+        }
+
+        /// Cartesian indices of all active cells.
+        const std::vector<int>& cartesianIndices() const
+        {
+            return cartesian_;
+        }
+
+        /// Compressed index of a Cartesian cell, or -1 if the cell is not
+        /// active or outside the Cartesian grid.
+        int compressedIndex(const int cartesian_index) const
+        {
+            if (cartesian_index < 0 || cartesian_index >= cartesian_size_) {
+                return -1;
+            }
+            if (!sparse_) {
+                return dense_[cartesian_index];
+            }
+            std::unordered_map<int, int>::const_iterator it = hash_.find(cartesian_index);
+            return it == hash_.end() ? -1 : it->second;
+        }
+
+        /// The active cells, ordered by increasing Cartesian index.
+        std::vector<int> cellsInCartesianOrder() const;
+
+    private:
+        std::vector<int> cartesian_;
+        int cartesian_size_;
+        bool sparse_;
+        std::vector<int> dense_;
+        std::unordered_map<int, int> hash_;
+    };
+
+} // namespace Opm
+
+#endif // OPM_COMPRESSEDCARTESIANINDEX_HEADER_INCLUDED
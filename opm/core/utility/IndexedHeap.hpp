@@ -0,0 +1,196 @@
+/*
+  Copyright 2015 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_INDEXEDHEAP_HEADER_INCLUDED
+#define OPM_INDEXEDHEAP_HEADER_INCLUDED
+
+#include <cassert>
+#include <utility>
+#include <vector>
+
+namespace Opm
+{
+
+    /// A d-ary min-heap of (value, index) pairs, where the indices
+    /// are integers in [0, n). The position of each index in the heap
+    /// is kept in a flat array, so that membership queries and
+    /// decrease-key operations need no handles or associative
+    /// containers. Elements are ordered by value, ties are broken
+    /// by smallest index.
+    ///
+    /// \tparam Arity Number of children per node. Larger values give
+    ///               shallower heaps and cheaper push/decrease
+    ///               operations at the cost of more comparisons in pop.
+    template <int Arity = 4>
+    class IndexedHeap
+    {
+    public:
+        typedef std::pair<double, int> Entry;
+        typedef typename std::vector<Entry>::const_iterator const_iterator;
+
+        /// Construct an empty heap for indices in [0, num_indices).
+        explicit IndexedHeap(const int num_indices = 0)
+            : position_(num_indices, NotInHeap)
+        {
+        }
+
+        /// Empty the heap and set the range of valid indices to [0, num_indices).
+        void reset(const int num_indices)
+        {
+            heap_.clear();
+            position_.assign(num_indices, NotInHeap);
+        }
+
+        /// Empty the heap, keeping the range of valid indices.
+        void clear()
+        {
+            for (const_iterator it = heap_.begin(); it != heap_.end(); ++it) {
+                position_[it->second] = NotInHeap;
+            }
+            heap_.clear();
+        }
+
+        bool empty() const
+        {
+            return heap_.empty();
+        }
+
+        int size() const
+        {
+            return heap_.size();
+        }
+
+        /// True if the index is currently in the heap.
+        bool contains(const int index) const
+        {
+            return position_[index] != NotInHeap;
+        }
+
+        /// Value associated with an index. It must be in the heap.
+        double value(const int index) const
+        {
+            assert(contains(index));
+            return heap_[position_[index]].first;
+        }
+
+        /// The entry with the smallest value.
+        const Entry& top() const
+        {
+            assert(!empty());
+            return heap_[0];
+        }
+
+        /// Insert an index that is not already in the heap.
+        void push(const double value, const int index)
+        {
+            assert(!contains(index));
+            heap_.push_back(Entry(value, index));
+            position_[index] = heap_.size() - 1;
+            siftUp(heap_.size() - 1);
+        }
+
+        /// Remove the entry with the smallest value.
+        void pop()
+        {
+            assert(!empty());
+            position_[heap_[0].second] = NotInHeap;
+            const Entry last = heap_.back();
+            heap_.pop_back();
+            if (!heap_.empty()) {
+                heap_[0] = last;
+                position_[last.second] = 0;
+                siftDown(0);
+            }
+        }
+
+        /// Lower the value associated with an index in the heap.
+        /// The new value must not exceed the current one.
+        void decrease(const int index, const double value)
+        {
+            const int pos = position_[index];
+            assert(pos != NotInHeap);
+            assert(value <= heap_[pos].first);
+            heap_[pos].first = value;
+            siftUp(pos);
+        }
+
+        /// Iteration over all entries, in no particular order.
+        /// The iterators are invalidated by any modifying operation.
+        const_iterator begin() const
+        {
+            return heap_.begin();
+        }
+
+        const_iterator end() const
+        {
+            return heap_.end();
+        }
+
+    private:
+        enum { NotInHeap = -1 };
+        std::vector<Entry> heap_;
+        std::vector<int> position_;
+
+        void siftUp(int pos)
+        {
+            const Entry e = heap_[pos];
+            while (pos > 0) {
+                const int parent = (pos - 1) / Arity;
+                if (!(e < heap_[parent])) {
+                    break;
+                }
+                heap_[pos] = heap_[parent];
+                position_[heap_[pos].second] = pos;
+                pos = parent;
+            }
+            heap_[pos] = e;
+            position_[e.second] = pos;
+        }
+
+        void siftDown(int pos)
+        {
+            const int n = heap_.size();
+            const Entry e = heap_[pos];
+            for (;;) {
+                const int first_child = Arity*pos + 1;
+                if (first_child >= n) {
+                    break;
+                }
+                const int last_child = (first_child + Arity < n) ? first_child + Arity : n;
+                int best = first_child;
+                for (int child = first_child + 1; child < last_child; ++child) {
+                    if (heap_[child] < heap_[best]) {
+                        best = child;
+                    }
+                }
+                if (!(heap_[best] < e)) {
+                    break;
+                }
+                heap_[pos] = heap_[best];
+                position_[heap_[pos].second] = pos;
+                pos = best;
+            }
+            heap_[pos] = e;
+            position_[e.second] = pos;
+        }
+    };
+
+} // namespace Opm
+
+#endif // OPM_INDEXEDHEAP_HEADER_INCLUDED
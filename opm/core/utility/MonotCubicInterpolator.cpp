@@ -273,6 +273,23 @@ get_fVector() const
 
 
 
+vector<double>
+MonotCubicInterpolator::
+get_dVector() const
+{
+  vector<double> outputvector;
+  if (ddata.size() != data.size()) {
+    return outputvector;
+  }
+  outputvector.reserve(ddata.size());
+  for (map<double,double>::const_iterator it = ddata.begin(); it != ddata.end(); ++it) {
+    outputvector.push_back(it->second);
+  }
+  return outputvector;
+}
+
+
+
 string
 MonotCubicInterpolator::
 toString() const
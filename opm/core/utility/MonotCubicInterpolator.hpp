@@ -285,6 +285,18 @@ class MonotCubicInterpolator {
    */
    std::vector<double> get_fVector() const ;
 
+   /**
+      Provide a copy of the derivative data used for the cubic
+      Hermite interpolation as a vector
+
+      Corresponds to get_xVector. Empty if the derivatives have
+      not been computed, in which case evaluate() interpolates
+      linearly.
+
+      @return derivative values as a vector
+   */
+   std::vector<double> get_dVector() const ;
+
    /**
       @param factor Scaling constant
 
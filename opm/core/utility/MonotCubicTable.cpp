@@ -0,0 +1,51 @@
+/*
+  Copyright 2015 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "config.h"
+#include <opm/core/utility/MonotCubicTable.hpp>
+#include <opm/core/utility/MonotCubicInterpolator.hpp>
+#include <opm/core/utility/ErrorMacros.hpp>
+
+#include <stdexcept>
+
+namespace Opm
+{
+
+    MonotCubicTable::MonotCubicTable(const MonotCubicInterpolator& interp)
+    {
+        init(interp);
+    }
+
+    MonotCubicTable::MonotCubicTable(const std::vector<double>& x,
+                                     const std::vector<double>& f)
+    {
+        init(MonotCubicInterpolator(x, f));
+    }
+
+    void MonotCubicTable::init(const MonotCubicInterpolator& interp)
+    {
+        x_ = interp.get_xVector();
+        f_ = interp.get_fVector();
+        d_ = interp.get_dVector();
+        if (x_.empty()) {
+            OPM_THROW(std::runtime_error, "MonotCubicTable: the interpolator contains no data.");
+        }
+    }
+
+} // namespace Opm
@@ -0,0 +1,132 @@
+/*
+  Copyright 2015 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_MONOTCUBICTABLE_HEADER_INCLUDED
+#define OPM_MONOTCUBICTABLE_HEADER_INCLUDED
+
+#include <algorithm>
+#include <vector>
+
+namespace Opm
+{
+
+    class MonotCubicInterpolator;
+
+    /// Immutable, contiguous counterpart of MonotCubicInterpolator.
+    ///
+    /// The x values, function values and Hermite derivatives of an
+    /// interpolator are copied into flat arrays once, so evaluation
+    /// needs a binary search in an array instead of map traversals.
+    /// Evaluation performs exactly the same floating point operations
+    /// as MonotCubicInterpolator::evaluate(), and so gives identical
+    /// results, including the constant extrapolation outside the data
+    /// range and the linear interpolation used when the interpolator
+    /// has no derivative data.
+    ///
+    /// Use MonotCubicInterpolator to build the data incrementally with
+    /// addPair(), and this class for repeated evaluation.
+    class MonotCubicTable
+    {
+    public:
+        /// Construct from an interpolator, which must contain data.
+        explicit MonotCubicTable(const MonotCubicInterpolator& interp);
+
+        /// Construct from x and f values, with derivatives computed
+        /// as in MonotCubicInterpolator(x, f). x needs not be sorted.
+        MonotCubicTable(const std::vector<double>& x,
+                        const std::vector<double>& f);
+
+        /// Number of data points.
+        int size() const
+        {
+            return int(x_.size());
+        }
+
+        /// Returns f(x), see MonotCubicInterpolator::evaluate().
+        /// Unlike that method, x is not checked to be finite.
+        double operator()(const double x) const
+        {
+            const int k = std::lower_bound(x_.begin(), x_.end(), x) - x_.begin();
+            return evaluateInterval(x, k);
+        }
+
+        /// Evaluate f at n points.
+        /// Each lookup first tries the interval of the previous point
+        /// and the one following it, so sorted or clustered input
+        /// costs constant time per point.
+        /// \param[in]  n  Number of points.
+        /// \param[in]  x  Array of n x values.
+        /// \param[out] f  Array of n function values.
+        void evaluate(const int n, const double* x, double* f) const
+        {
+            int k = 0;
+            for (int i = 0; i < n; ++i) {
+                const double xi = x[i];
+                if (!isInterval(xi, k)) {
+                    if (isInterval(xi, k + 1)) {
+                        ++k;
+                    } else {
+                        k = std::lower_bound(x_.begin(), x_.end(), xi) - x_.begin();
+                    }
+                }
+                f[i] = evaluateInterval(xi, k);
+            }
+        }
+
+    private:
+        // True if k is the index of the first x value that is not
+        // less than x, as found by lower_bound().
+        bool isInterval(const double x, const int k) const
+        {
+            return k > 0 && k < int(x_.size()) && x_[k - 1] < x && x <= x_[k];
+        }
+
+        void init(const MonotCubicInterpolator& interp);
+
+        // Evaluate at x, where k is the index of the first x value
+        // that is not less than x.
+        double evaluateInterval(const double x, const int k) const
+        {
+            if (k == 0) {
+                return f_.front();
+            }
+            if (k == int(x_.size())) {
+                return f_.back();
+            }
+            const double x1 = x_[k - 1];
+            const double x2 = x_[k];
+            if (d_.empty()) {
+                return f_[k - 1] + (f_[k] - f_[k - 1]) / (x2 - x1) * (x - x1);
+            }
+            const double t = (x - x1)/(x2 - x1);
+            const double h = x2 - x1;
+            return f_[k - 1] * (2*t*t*t - 3*t*t + 1)
+                +  d_[k - 1] * (t*t*t - 2*t*t + t) * h
+                +  f_[k]     * (-2*t*t*t + 3*t*t)
+                +  d_[k]     * (t*t*t - t*t) * h;
+        }
+
+        std::vector<double> x_;
+        std::vector<double> f_;
+        std::vector<double> d_;
+    };
+
+} // namespace Opm
+
+#endif // OPM_MONOTCUBICTABLE_HEADER_INCLUDED
@@ -0,0 +1,463 @@
+/*
+  Copyright 2015 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "config.h"
+#include <opm/core/utility/Profiler.hpp>
+#include <opm/core/utility/ErrorMacros.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <ostream>
+#include <stdexcept>
+
+namespace Opm
+{
+
+    namespace time
+    {
+
+        namespace
+        {
+            long long now()
+            {
+                return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch()).count();
+            }
+
+            bool sameName(const char* a, const char* b)
+            {
+                return a == b || std::strcmp(a, b) == 0;
+            }
+
+            std::string jsonEscaped(const std::string& s)
+            {
+                std::string r;
+                for (std::size_t i = 0; i < s.size(); ++i) {
+                    const char c = s[i];
+                    if (c == '"' || c == '\\') {
+                        r += '\\';
+                        r += c;
+                    } else if (static_cast<unsigned char>(c) < 0x20) {
+                        r += ' ';
+                    } else {
+                        r += c;
+                    }
+                }
+                return r;
+            }
+
+            // Microseconds, printed with nanosecond resolution.
+            void writeMicroseconds(std::ostream& os, const long long ns)
+            {
+                os << ns / 1000 << '.' << std::setw(3) << std::setfill('0') << ns % 1000
+                   << std::setfill(' ');
+            }
+        } // anonymous namespace
+
+
+
+        struct Profiler::ThreadData
+        {
+            // A region path as a tree node, nodes[0] is the root.
+            struct Node
+            {
+                const char* name;
+                int parent;
+                int first_child;
+                int next_sibling;
+                long long calls;
+                long long total;
+            };
+            struct Open
+            {
+                int node;
+                long long start;
+                bool trace;
+            };
+            struct Event
+            {
+                int node;
+                long long start;
+                long long duration;
+            };
+
+            explicit ThreadData(const int thread_id)
+                : id(thread_id)
+            {
+                clear();
+            }
+
+            void clear()
+            {
+                const Node root = { "", -1, -1, -1, 0, 0 };
+                nodes.assign(1, root);
+                stack.clear();
+                events.clear();
+                dropped = 0;
+                counters.clear();
+                current = 0;
+            }
+
+            int child(const char* name)
+            {
+                int c = nodes[current].first_child;
+                for (; c >= 0; c = nodes[c].next_sibling) {
+                    if (sameName(nodes[c].name, name)) {
+                        return c;
+                    }
+                }
+                const Node node = { name, current, -1, nodes[current].first_child, 0, 0 };
+                nodes.push_back(node);
+                c = int(nodes.size()) - 1;
+                nodes[current].first_child = c;
+                return c;
+            }
+
+            // Full path of every node, parents precede their children.
+            std::vector<std::string> paths() const
+            {
+                std::vector<std::string> p(nodes.size());
+                for (std::size_t i = 1; i < nodes.size(); ++i) {
+                    const int parent = nodes[i].parent;
+                    p[i] = parent == 0 ? nodes[i].name : p[parent] + "/" + nodes[i].name;
+                }
+                return p;
+            }
+
+            int id;
+            int current;
+            std::vector<Node> nodes;
+            std::vector<Open> stack;
+            std::vector<Event> events;
+            long long dropped;  // Instances not kept in events.
+            std::vector<std::pair<const char*, long long> > counters;
+        };
+
+
+
+        Profiler& Profiler::instance()
+        {
+            static Profiler profiler;
+            return profiler;
+        }
+
+
+
+        Profiler::Profiler()
+            : enabled_(true),
+              max_events_(1000000),
+              epoch_(now())
+        {
+        }
+
+
+
+        Profiler::~Profiler()
+        {
+        }
+
+
+
+        Profiler::ThreadData& Profiler::threadData()
+        {
+            static thread_local ThreadData* data = 0;
+            if (!data) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                threads_.emplace_back(new ThreadData(int(threads_.size())));
+                data = threads_.back().get();
+            }
+            return *data;
+        }
+
+
+
+        bool Profiler::begin(const char* name, const bool trace)
+        {
+            if (!enabled_) {
+                return false;
+            }
+            ThreadData& d = threadData();
+            const ThreadData::Open open = { d.child(name), now(), trace };
+            d.stack.push_back(open);
+            d.current = open.node;
+            return true;
+        }
+
+
+
+        void Profiler::end()
+        {
+            const long long stop = now();
+            ThreadData& d = threadData();
+            if (d.stack.empty()) {
+                OPM_THROW(std::logic_error, "Profiler::end() called without an open region");
+            }
+            const ThreadData::Open open = d.stack.back();
+            d.stack.pop_back();
+            ThreadData::Node& node = d.nodes[open.node];
+            ++node.calls;
+            node.total += stop - open.start;
+            if (open.trace) {
+                if (d.events.size() < max_events_) {
+                    const ThreadData::Event event = { open.node, open.start - epoch_, stop - open.start };
+                    d.events.push_back(event);
+                } else {
+                    ++d.dropped;
+                }
+            }
+            d.current = node.parent;
+        }
+
+
+
+        void Profiler::count(const char* name, const long long n)
+        {
+            if (!enabled_) {
+                return;
+            }
+            ThreadData& d = threadData();
+            for (std::size_t i = 0; i < d.counters.size(); ++i) {
+                if (sameName(d.counters[i].first, name)) {
+                    d.counters[i].second += n;
+                    return;
+                }
+            }
+            d.counters.push_back(std::make_pair(name, n));
+        }
+
+
+
+        void Profiler::setEnabled(const bool enabled)
+        {
+            enabled_ = enabled;
+        }
+
+
+
+        bool Profiler::enabled() const
+        {
+            return enabled_;
+        }
+
+
+
+        void Profiler::setMaxTraceEvents(const std::size_t max_events)
+        {
+            max_events_ = max_events;
+        }
+
+
+
+        std::size_t Profiler::maxTraceEvents() const
+        {
+            return max_events_;
+        }
+
+
+
+        long long Profiler::droppedTraceEvents() const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            long long dropped = 0;
+            for (std::size_t t = 0; t < threads_.size(); ++t) {
+                dropped += threads_[t]->dropped;
+            }
+            return dropped;
+        }
+
+
+
+        void Profiler::reset()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (std::size_t t = 0; t < threads_.size(); ++t) {
+                if (!threads_[t]->stack.empty()) {
+                    OPM_THROW(std::logic_error, "Profiler::reset() called with open regions");
+                }
+                threads_[t]->clear();
+            }
+        }
+
+
+
+        std::vector<Profiler::RegionStats> Profiler::regions() const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            std::map<std::string, RegionStats> stats;
+            for (std::size_t t = 0; t < threads_.size(); ++t) {
+                const ThreadData& d = *threads_[t];
+                const std::vector<std::string> paths = d.paths();
+                std::vector<long long> child_total(d.nodes.size(), 0);
+                for (std::size_t i = 1; i < d.nodes.size(); ++i) {
+                    child_total[d.nodes[i].parent] += d.nodes[i].total;
+                }
+                for (std::size_t i = 1; i < d.nodes.size(); ++i) {
+                    const ThreadData::Node& node = d.nodes[i];
+                    if (node.calls == 0) {
+                        continue;
+                    }
+                    RegionStats& s = stats[paths[i]];
+                    s.path = paths[i];
+                    s.calls += node.calls;
+                    s.total += 1e-9*node.total;
+                    s.self += 1e-9*(node.total - child_total[i]);
+                }
+            }
+            std::vector<RegionStats> result;
+            for (std::map<std::string, RegionStats>::const_iterator it = stats.begin(); it != stats.end(); ++it) {
+                result.push_back(it->second);
+            }
+            return result;
+        }
+
+
+
+        std::vector<std::pair<std::string, long long> > Profiler::counters() const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            std::map<std::string, long long> totals;
+            for (std::size_t t = 0; t < threads_.size(); ++t) {
+                const ThreadData& d = *threads_[t];
+                for (std::size_t i = 0; i < d.counters.size(); ++i) {
+                    totals[d.counters[i].first] += d.counters[i].second;
+                }
+            }
+            return std::vector<std::pair<std::string, long long> >(totals.begin(), totals.end());
+        }
+
+
+
+        void Profiler::writeChromeTrace(std::ostream& os) const
+        {
+            const std::vector<std::pair<std::string, long long> > counter_totals = counters();
+            const long long dropped = droppedTraceEvents();
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            os << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+            const char* separator = "\n";
+            long long last = 0;
+            for (std::size_t t = 0; t < threads_.size(); ++t) {
+                const ThreadData& d = *threads_[t];
+                os << separator << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << d.id
+                   << ",\"args\":{\"name\":\"thread " << d.id << "\"}}";
+                separator = ",\n";
+                const std::vector<std::string> paths = d.paths();
+                for (std::size_t e = 0; e < d.events.size(); ++e) {
+                    const ThreadData::Event& event = d.events[e];
+                    os << separator << "{\"name\":\"" << jsonEscaped(d.nodes[event.node].name)
+                       << "\",\"cat\":\"opm\",\"ph\":\"X\",\"pid\":0,\"tid\":" << d.id << ",\"ts\":";
+                    writeMicroseconds(os, event.start);
+                    os << ",\"dur\":";
+                    writeMicroseconds(os, event.duration);
+                    os << ",\"args\":{\"path\":\"" << jsonEscaped(paths[event.node]) << "\"}}";
+                    last = std::max(last, event.start + event.duration);
+                }
+            }
+            if (!counter_totals.empty()) {
+                os << separator << "{\"name\":\"counters\",\"ph\":\"C\",\"pid\":0,\"tid\":0,\"ts\":";
+                writeMicroseconds(os, last);
+                os << ",\"args\":{";
+                for (std::size_t i = 0; i < counter_totals.size(); ++i) {
+                    os << (i == 0 ? "" : ",") << '"' << jsonEscaped(counter_totals[i].first)
+                       << "\":" << counter_totals[i].second;
+                }
+                os << "}}";
+            }
+            os << "\n]";
+            if (dropped > 0) {
+                os << ",\"otherData\":{\"dropped_events\":" << dropped << '}';
+            }
+            os << "}\n";
+        }
+
+
+
+        void Profiler::writeSummary(std::ostream& os) const
+        {
+            const std::vector<RegionStats> stats = regions();
+            const std::vector<std::pair<std::string, long long> > counter_totals = counters();
+
+            std::size_t width = 6;
+            for (std::size_t i = 0; i < stats.size(); ++i) {
+                width = std::max(width, stats[i].path.size());
+            }
+            for (std::size_t i = 0; i < counter_totals.size(); ++i) {
+                width = std::max(width, counter_totals[i].first.size());
+            }
+            width += 2;
+
+            const std::ios_base::fmtflags flags = os.flags();
+            const std::streamsize precision = os.precision();
+            os << std::left << std::setw(width) << "Region" << std::right
+               << std::setw(10) << "Calls"
+               << std::setw(14) << "Total (s)"
+               << std::setw(14) << "Self (s)"
+               << std::setw(14) << "Average (s)" << '\n';
+            os << std::fixed << std::setprecision(6);
+            for (std::size_t i = 0; i < stats.size(); ++i) {
+                const RegionStats& s = stats[i];
+                os << std::left << std::setw(width) << s.path << std::right
+                   << std::setw(10) << s.calls
+                   << std::setw(14) << s.total
+                   << std::setw(14) << s.self
+                   << std::setw(14) << s.total/s.calls << '\n';
+            }
+            if (!counter_totals.empty()) {
+                os << '\n' << std::left << std::setw(width) << "Counter" << std::right
+                   << std::setw(10) << "Value" << '\n';
+                for (std::size_t i = 0; i < counter_totals.size(); ++i) {
+                    os << std::left << std::setw(width) << counter_totals[i].first << std::right
+                       << std::setw(10) << counter_totals[i].second << '\n';
+                }
+            }
+            const long long dropped = droppedTraceEvents();
+            if (dropped > 0) {
+                os << '\n' << dropped << " region instances were not written to the trace, the limit is "
+                   << maxTraceEvents() << " per thread.\n";
+            }
+            os.flags(flags);
+            os.precision(precision);
+        }
+
+
+
+        void Profiler::writeFiles(const std::string& basename) const
+        {
+            const std::string tracename = basename + ".json";
+            std::ofstream trace(tracename.c_str());
+            if (!trace) {
+                OPM_THROW(std::runtime_error, "Failed to open " << tracename);
+            }
+            writeChromeTrace(trace);
+
+            const std::string summaryname = basename + ".txt";
+            std::ofstream summary(summaryname.c_str());
+            if (!summary) {
+                OPM_THROW(std::runtime_error, "Failed to open " << summaryname);
+            }
+            writeSummary(summary);
+        }
+
+    } // namespace time
+
+} // namespace Opm
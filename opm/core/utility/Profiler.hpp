@@ -0,0 +1,188 @@
+/*
+  Copyright 2015 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_PROFILER_HEADER_INCLUDED
+#define OPM_PROFILER_HEADER_INCLUDED
+
+#include <atomic>
+#include <cstddef>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Opm
+{
+
+    namespace time
+    {
+
+        /// Registry of hierarchical timing regions and counters.
+        ///
+        /// Regions are opened and closed on a thread, and nest: a
+        /// region is identified by the path of names of the regions
+        /// enclosing it on the same thread, such as "step/pressure".
+        /// Every thread records into its own buffers, so recording
+        /// takes no locks once a thread has registered, and times are
+        /// taken from a nanosecond steady clock.
+        ///
+        /// Library code is instrumented with the OPM_PROFILE_REGION,
+        /// OPM_PROFILE_REGION_STATS and OPM_PROFILE_COUNT macros, which
+        /// compile to nothing unless OPM_PROFILING is defined (in
+        /// config.h, by the CMake option of the same name). Recording
+        /// can in addition be switched off at run time with
+        /// setEnabled().
+        ///
+        /// Every region instance is kept for the trace, up to
+        /// maxTraceEvents() per thread; later instances only add to
+        /// the statistics. Regions entered very often, such as once
+        /// per cell, should use OPM_PROFILE_REGION_STATS, which never
+        /// records instances.
+        ///
+        /// The summary and trace writers must not run concurrently
+        /// with recording threads.
+        class Profiler
+        {
+        public:
+            /// Statistics of a region path, summed over all threads.
+            struct RegionStats
+            {
+                std::string path;
+                long long calls;
+                double total;   // Seconds.
+                double self;    // Seconds, excluding child regions.
+            };
+
+            /// The process wide profiler.
+            static Profiler& instance();
+
+            /// Open a region, named by a string that outlives the
+            /// profiler (normally a literal), on the calling thread.
+            /// \param[in] name   region name
+            /// \param[in] trace  if false, only the statistics of the
+            ///                   region are recorded, not the instance
+            /// \return false if nothing was recorded since recording
+            ///         is disabled, in which case end() must not be
+            ///         called.
+            bool begin(const char* name, bool trace = true);
+
+            /// Close the innermost open region of the calling thread.
+            void end();
+
+            /// Add to a named counter.
+            void count(const char* name, long long n = 1);
+
+            /// Switch recording on (the default) or off.
+            void setEnabled(bool enabled);
+            bool enabled() const;
+
+            /// Number of region instances kept for the trace on each
+            /// thread, default 1000000.
+            void setMaxTraceEvents(std::size_t max_events);
+            std::size_t maxTraceEvents() const;
+
+            /// Number of region instances that were not kept for the
+            /// trace since the limit was reached, summed over all
+            /// threads.
+            long long droppedTraceEvents() const;
+
+            /// Forget all recorded regions and counters. No regions
+            /// may be open.
+            void reset();
+
+            /// Statistics of each region path, sorted by path.
+            std::vector<RegionStats> regions() const;
+
+            /// Counter totals, sorted by name.
+            std::vector<std::pair<std::string, long long> > counters() const;
+
+            /// Write every recorded region instance and the counter
+            /// totals as JSON in the Chrome trace event format, for
+            /// viewing in chrome://tracing or similar tools. The
+            /// number of dropped instances, if any, is written as
+            /// "dropped_events" in "otherData".
+            void writeChromeTrace(std::ostream& os) const;
+
+            /// Write a table of the region statistics and counters.
+            void writeSummary(std::ostream& os) const;
+
+            /// Write the trace to basename.json and the summary to
+            /// basename.txt.
+            void writeFiles(const std::string& basename) const;
+
+        private:
+            struct ThreadData;
+
+            Profiler();
+            ~Profiler();
+            Profiler(const Profiler&);
+            Profiler& operator=(const Profiler&);
+
+            ThreadData& threadData();
+
+            std::atomic<bool> enabled_;
+            std::atomic<std::size_t> max_events_;
+            long long epoch_;   // Nanoseconds.
+            mutable std::mutex mutex_;
+            std::vector<std::unique_ptr<ThreadData> > threads_;
+        };
+
+
+
+        /// Region that is open for the lifetime of the object.
+        class ScopedRegion
+        {
+        public:
+            explicit ScopedRegion(const char* name, const bool trace = true)
+                : active_(Profiler::instance().begin(name, trace))
+            {
+            }
+            ~ScopedRegion()
+            {
+                if (active_) {
+                    Profiler::instance().end();
+                }
+            }
+        private:
+            ScopedRegion(const ScopedRegion&);
+            ScopedRegion& operator=(const ScopedRegion&);
+            bool active_;
+        };
+
+    } // namespace time
+
+} // namespace Opm
+
+#ifdef OPM_PROFILING
+# define OPM_PROFILE_CONCAT_(a, b) a ## b
+# define OPM_PROFILE_CONCAT(a, b) OPM_PROFILE_CONCAT_(a, b)
+# define OPM_PROFILE_REGION(name) ::Opm::time::ScopedRegion OPM_PROFILE_CONCAT(opm_profile_region_, __LINE__)(name)
+# define OPM_PROFILE_REGION_STATS(name) ::Opm::time::ScopedRegion OPM_PROFILE_CONCAT(opm_profile_region_, __LINE__)(name, false)
+# define OPM_PROFILE_COUNT(name, n) ::Opm::time::Profiler::instance().count(name, n)
+# define OPM_PROFILE_WRITE(basename) ::Opm::time::Profiler::instance().writeFiles(basename)
+#else
+# define OPM_PROFILE_REGION(name) do {} while (false)
+# define OPM_PROFILE_REGION_STATS(name) do {} while (false)
+# define OPM_PROFILE_COUNT(name, n) do {} while (false)
+# define OPM_PROFILE_WRITE(basename) do {} while (false)
+#endif
+
+#endif // OPM_PROFILER_HEADER_INCLUDED
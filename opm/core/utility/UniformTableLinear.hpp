@@ -167,6 +167,17 @@ namespace Opm {
 	UniformTableLinear<T>
 	::operator()(const double xparam) const
 	{
+            // Extrapolate linearly using the first or last interval.
+            const int n = y_values_.size();
+            if (xparam < xmin_ && left_ == Extrapolate) {
+                const double w = (xparam - xmin_)/xdelta_;
+                return y_values_[0] + w*(y_values_[1] - y_values_[0]);
+            }
+            if (xparam > xmax_ && right_ == Extrapolate) {
+                const double w = (xparam - xmax_)/xdelta_;
+                return y_values_[n - 1] + w*(y_values_[n - 1] - y_values_[n - 2]);
+            }
+
             // Implements ClosestValue policy.
             double x = std::min(xparam, xmax_);
             x = std::max(x, xmin_);
@@ -175,7 +186,7 @@ namespace Opm {
             double pos = (x - xmin_)/xdelta_;
             double posi = std::floor(pos);
             int left = int(posi);
-            if (left == int(y_values_.size()) - 1) {
+            if (left >= n - 1) {
                 // We are at xmax_
                 return y_values_.back();
             }
@@ -191,7 +202,12 @@ namespace Opm {
             // Implements derivative consistent
             // with ClosestValue policy for function
             double value;
-            if (xparam > xmax_ || xparam < xmin_) {
+            if (xparam < xmin_ && left_ == Extrapolate) {
+                value = (y_values_[1] - y_values_[0])/xdelta_;
+            } else if (xparam > xmax_ && right_ == Extrapolate) {
+                const int n = y_values_.size();
+                value = (y_values_[n - 1] - y_values_[n - 2])/xdelta_;
+            } else if (xparam > xmax_ || xparam < xmin_) {
                 value = 0.0;
             } else {
                 double x = std::min(xparam, xmax_);
@@ -200,9 +216,9 @@ namespace Opm {
                 double pos = (x - xmin_)/xdelta_;
                 double posi = std::floor(pos);
                 int left = int(posi);
-                if (left == int(y_values_.size()) - 1) {
+                if (left >= int(y_values_.size()) - 1) {
                     // We are at xmax_
-                    --left;
+                    left = int(y_values_.size()) - 2;
                 }
                 value = (y_values_[left + 1] - y_values_[left])/xdelta_;
             }
@@ -227,8 +243,8 @@ namespace Opm {
 	UniformTableLinear<T>
 	::setLeftPolicy(RangePolicy rp)
 	{
-	    if (rp != ClosestValue) {
-		OPM_THROW(std::runtime_error, "Only ClosestValue RangePolicy implemented.");
+	    if (rp == Throw) {
+		OPM_THROW(std::runtime_error, "Only ClosestValue and Extrapolate RangePolicy implemented.");
 	    }
 	    left_ = rp;
 	}
@@ -238,8 +254,8 @@ namespace Opm {
 	UniformTableLinear<T>
 	::setRightPolicy(RangePolicy rp)
 	{
-	    if (rp != ClosestValue) {
-		OPM_THROW(std::runtime_error, "Only ClosestValue RangePolicy implemented.");
+	    if (rp == Throw) {
+		OPM_THROW(std::runtime_error, "Only ClosestValue and Extrapolate RangePolicy implemented.");
 	    }
 	    right_ = rp;
 	}
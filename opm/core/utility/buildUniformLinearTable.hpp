@@ -0,0 +1,89 @@
+/*
+  Copyright 2015 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_BUILDUNIFORMLINEARTABLE_HEADER_INCLUDED
+#define OPM_BUILDUNIFORMLINEARTABLE_HEADER_INCLUDED
+
+#include <opm/core/utility/UniformTableLinear.hpp>
+#include <opm/core/utility/linearInterpolation.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace Opm {
+
+    /// Resample a piecewise linear table onto a uniformly spaced table
+    /// over the same domain, so that lookups need no searching.
+    ///
+    /// The number of samples is doubled, starting from the number of
+    /// input points, until the maximum deviation from the input table
+    /// relative to the largest table value is at most tolerance, or
+    /// until max_samples is reached. Since both tables are piecewise
+    /// linear and agree at the uniform nodes, the deviation is largest
+    /// at one of the input nodes, where it is measured. Outside the
+    /// domain the result extrapolates linearly, like linearInterpolation().
+    ///
+    /// \return the achieved maximum relative deviation.
+    inline double buildUniformLinearTable(const std::vector<double>& xv,
+                                          const std::vector<double>& yv,
+                                          const double tolerance,
+                                          const int max_samples,
+                                          UniformTableLinear<double>& table)
+    {
+        const int num_points = xv.size();
+        const double xmin = xv[0];
+        const double xmax = xv.back();
+        double scale = 0.0;
+        for (int i = 0; i < num_points; ++i) {
+            scale = std::max(scale, std::fabs(yv[i]));
+        }
+        if (scale == 0.0) {
+            scale = 1.0;
+        }
+
+        std::vector<double> uniform_yv;
+        double error = 0.0;
+        int samples = std::max(num_points, 2);
+        for (;;) {
+            uniform_yv.resize(samples);
+            for (int i = 0; i < samples; ++i) {
+                const double w = double(i)/double(samples - 1);
+                const double x = (i == samples - 1) ? xmax : (1.0 - w)*xmin + w*xmax;
+                uniform_yv[i] = linearInterpolation(xv, yv, x);
+            }
+            table = UniformTableLinear<double>(xmin, xmax, uniform_yv);
+            table.setLeftPolicy(UniformTableLinear<double>::Extrapolate);
+            table.setRightPolicy(UniformTableLinear<double>::Extrapolate);
+
+            error = 0.0;
+            for (int i = 0; i < num_points; ++i) {
+                error = std::max(error, std::fabs(table(xv[i]) - yv[i])/scale);
+            }
+            if (error <= tolerance || samples >= max_samples) {
+                break;
+            }
+            samples = std::min(2*samples - 1, max_samples);
+        }
+        return error;
+    }
+
+} // namespace Opm
+
+#endif // OPM_BUILDUNIFORMLINEARTABLE_HEADER_INCLUDED
@@ -20,7 +20,7 @@
 #ifndef OPM_BUILDUNIFORMMONOTONETABLE_HEADER_INCLUDED
 #define OPM_BUILDUNIFORMMONOTONETABLE_HEADER_INCLUDED
 
-#include <opm/core/utility/MonotCubicInterpolator.hpp>
+#include <opm/core/utility/MonotCubicTable.hpp>
 #include <opm/core/utility/UniformTableLinear.hpp>
 
 namespace Opm {
@@ -31,15 +31,16 @@ namespace Opm {
                                    const int samples,
                                    UniformTableLinear<T>& table)
     {
-        MonotCubicInterpolator interp(xv, yv);
+        MonotCubicTable interp(xv, yv);
+        std::vector<double> uniform_xv(samples);
         std::vector<T> uniform_yv(samples);
         double xmin = xv[0];
         double xmax = xv.back();
         for (int i = 0; i < samples; ++i) {
             double w = double(i)/double(samples - 1);
-            double x = (1.0 - w)*xmin + w*xmax;
-            uniform_yv[i] = interp(x);
+            uniform_xv[i] = (1.0 - w)*xmin + w*xmax;
         }
+        interp.evaluate(samples, &uniform_xv[0], &uniform_yv[0]);
         table = UniformTableLinear<T>(xmin, xmax, uniform_yv);
     }
 
@@ -52,6 +52,27 @@ namespace Opm
     }
 
 
+    inline double linearInterpolationInInterval(const std::vector<double>& xv,
+                                                const std::vector<double>& yv,
+                                                int ix1, double x)
+    {
+        // As linearInterpolation(), with the interval given by a
+        // previous call to tableIndex() so that several columns can
+        // share one search.
+        int ix2 = ix1 + 1;
+        return (yv[ix2] - yv[ix1])/(xv[ix2] - xv[ix1])*(x - xv[ix1]) + yv[ix1];
+    }
+
+
+    inline double linearInterpolationDerivativeInInterval(const std::vector<double>& xv,
+                                                          const std::vector<double>& yv,
+                                                          int ix1)
+    {
+        int ix2 = ix1 + 1;
+        return (yv[ix2] - yv[ix1])/(xv[ix2] - xv[ix1]);
+    }
+
+
     inline double linearInterpolationDerivative(const std::vector<double>& xv,
                                                 const std::vector<double>& yv, double x)
     {
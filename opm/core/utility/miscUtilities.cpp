@@ -23,6 +23,7 @@
 #include <opm/core/grid.h>
 #include <opm/core/wells.h>
 #include <opm/core/well_controls.h>
+#include <opm/core/wells/WellPerforationTable.hpp>
 #include <opm/core/props/IncompPropertiesInterface.hpp>
 #include <opm/core/props/BlackoilPropertiesInterface.hpp>
 #include <opm/core/props/rock/RockCompressibility.hpp>
@@ -525,6 +526,70 @@ namespace Opm
     }
 
 
+    void computeWDP(const WellPerforationTable& perforations, const std::vector<double>& saturations,
+                    const double* densities, const double gravity, const bool per_grid_cell,
+                    std::vector<double>& wdp)
+    {
+        const int nperf = perforations.numPerforations();
+        wdp.resize(nperf);
+        if (nperf == 0) {
+            return;
+        }
+        const int np = per_grid_cell ?
+            saturations.size()/perforations.numCells()
+            : saturations.size()/nperf;
+        for (int k = 0; k < nperf; ++k) {
+            const int perf = perforations.perforation(k);
+            const double* s = &saturations[0] + np*(per_grid_cell ? perforations.cell(k) : perf);
+            double saturation_sum = 0.0;
+            for (int p = 0; p < np; ++p) {
+                saturation_sum += s[p];
+            }
+            if (saturation_sum == 0) {
+                saturation_sum = 1.0;
+            }
+            double density = 0.0;
+            for (int p = 0; p < np; ++p) {
+                density += s[p] * densities[p] / saturation_sum;
+            }
+            wdp[perf] = density * perforations.depthBelowReference(k) * gravity;
+        }
+    }
+
+
+    void computeFlowRatePerWell(const WellPerforationTable& perforations,
+                                const std::vector<double>& flow_rates_per_cell,
+                                std::vector<double>& flow_rates_per_well)
+    {
+        const int nperf = perforations.numPerforations();
+        assert(int(flow_rates_per_cell.size()) == nperf);
+        flow_rates_per_well.assign(perforations.numWells(), 0.0);
+        for (int k = 0; k < nperf; ++k) {
+            flow_rates_per_well[perforations.well(k)] += flow_rates_per_cell[perforations.perforation(k)];
+        }
+    }
+
+
+    void computePhaseFlowRatesPerWell(const WellPerforationTable& perforations,
+                                      const std::vector<double>& flow_rates_per_well_cell,
+                                      const std::vector<double>& fractional_flows,
+                                      std::vector<double>& phase_flow_per_well)
+    {
+        const int np = perforations.numPhases();
+        const int nperf = perforations.numPerforations();
+        assert(int(flow_rates_per_well_cell.size()) == nperf);
+        phase_flow_per_well.assign(perforations.numWells() * np, 0.0);
+        for (int k = 0; k < nperf; ++k) {
+            const double rate = flow_rates_per_well_cell[perforations.perforation(k)];
+            const double* frac = &fractional_flows[perforations.cell(k) * np];
+            double* well_rates = &phase_flow_per_well[perforations.well(k) * np];
+            for (int phase = 0; phase < np; ++phase) {
+                well_rates[phase] += rate * frac[phase];
+            }
+        }
+    }
+
+
     void Watercut::push(double time, double fraction, double produced)
     {
         data_.push_back(time);
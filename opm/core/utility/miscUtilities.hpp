@@ -32,6 +32,7 @@ namespace Opm
     class IncompPropertiesInterface;
     class BlackoilPropertiesInterface;
     class RockCompressibility;
+    class WellPerforationTable;
 
     /// @brief Computes pore volume of all cells in a grid.
     /// @param[in]  grid      a grid
@@ -300,6 +301,46 @@ namespace Opm
                                       const std::vector<double>& fractional_flows,
                                       std::vector<double>& phase_flow_per_well);
 
+    /// Computes the WDP for each perforation, as computeWDP() above for the
+    /// wells and grid the table was built from, visiting the perforations
+    /// in the order of the table.
+    /// \param[in] perforations  Perforation table of the wells.
+    /// \param[in] saturations   As for computeWDP() above.
+    /// \param[in] densities     Density for each phase.
+    /// \param[out] wdp          Will contain the wdp of each perforation, in the
+    ///                          order of the wells struct. Resized, not appended to.
+    /// \param[in] per_grid_cell Whether or not the saturations are per grid cell or per
+    ///                          well cell.
+    void computeWDP(const WellPerforationTable& perforations, const std::vector<double>& saturations,
+                    const double* densities, const double gravity, const bool per_grid_cell,
+                    std::vector<double>& wdp);
+
+    /// Computes (sums) the flow rate for each well, visiting the perforations
+    /// in the order of the table. The sum of a well is accumulated in a
+    /// different order than by computeFlowRatePerWell() above, so the results
+    /// may differ by rounding.
+    /// \param[in] perforations         Perforation table of the wells.
+    /// \param[in] flow_rates_per_cell  Flow rates per well cells, ordered as the wells struct.
+    /// \param[out] flow_rates_per_well Will contain the summed up flow rates for each well.
+    ///                                 Resized, not appended to.
+    void computeFlowRatePerWell(const WellPerforationTable& perforations,
+                                const std::vector<double>& flow_rates_per_cell,
+                                std::vector<double>& flow_rates_per_well);
+
+    /// Computes the phase flow rate per well, visiting the perforations in the
+    /// order of the table. The sum of a well is accumulated in a different
+    /// order than by computePhaseFlowRatesPerWell() above, so the results may
+    /// differ by rounding.
+    /// \param[in] perforations              Perforation table of the wells.
+    /// \param[in] flow_rates_per_well_cell  The total flow rate for each perforation,
+    ///                                      ordered as the wells struct.
+    /// \param[in] fractional_flows          The fractional flow of each phase in each grid cell.
+    /// \param[out] phase_flow_per_well      Will contain the phase flow per well.
+    void computePhaseFlowRatesPerWell(const WellPerforationTable& perforations,
+                                      const std::vector<double>& flow_rates_per_well_cell,
+                                      const std::vector<double>& fractional_flows,
+                                      std::vector<double>& phase_flow_per_well);
+
 
 
 
@@ -134,21 +134,11 @@ namespace Opm
                               const std::vector<double>& s,
                               std::vector<double>& totmob)
     {
-        std::vector<double> pmobc;
-
-        computePhaseMobilities(props, cells, press, temp, z, s, pmobc);
-
-        const std::size_t                 np = props.numPhases();
-        const std::vector<int>::size_type nc = cells.size();
-
-        totmob.clear();
-        totmob.resize(nc, 0.0);
-
-        for (std::vector<int>::size_type c = 0; c < nc; ++c) {
-            for (std::size_t p = 0; p < np; ++p) {
-                totmob[ c ] += pmobc[c*np + p];
-            }
-        }
+        const int nc = cells.size();
+        BlackoilCellProperties cellprops;
+        props.computeCellProperties(nc, &press[0], &temp[0], &z[0], &s[0], &cells[0],
+                                    BlackoilCellProperties::Mobilities, cellprops);
+        totmob.swap(cellprops.totmob);
     }
 
     /*
@@ -213,19 +203,16 @@ namespace Opm
 
         assert(int(s.size()) == nc * np);
 
-        std::vector<double> mu(nc*np);
-        props.viscosity(nc, &p[0], &T[0], &z[0], &cells[0], &mu[0], 0);
+        BlackoilCellProperties cellprops;
+        props.computeCellProperties(nc, &p[0], &T[0], &z[0], &s[0], &cells[0],
+                                    BlackoilCellProperties::Mobilities, cellprops);
 
-        pmobc.clear();
-        pmobc.resize(nc*np, 0.0);
-        double* dpmobc = 0;
-        props.relperm(nc, &s[0], &cells[0],
-                      &pmobc[0], dpmobc);
-
-        std::transform(pmobc.begin(), pmobc.end(),
-                       mu.begin(),
-                       pmobc.begin(),
-                       std::divides<double>());
+        pmobc.resize(nc*np);
+        for (int c = 0; c < nc; ++c) {
+            for (int phase = 0; phase < np; ++phase) {
+                pmobc[np*c + phase] = cellprops.mob[cellprops.index(phase, c)];
+            }
+        }
     }
 
     /// Computes the fractional flow for each cell in the cells argument
@@ -245,20 +232,46 @@ namespace Opm
                                std::vector<double>& fractional_flows)
     {
         const int num_phases = props.numPhases();
+        const int nc = cells.size();
 
-        computePhaseMobilities(props, cells, p, T, z, s, fractional_flows);
+        BlackoilCellProperties cellprops;
+        props.computeCellProperties(nc, &p[0], &T[0], &z[0], &s[0], &cells[0],
+                                    BlackoilCellProperties::Mobilities, cellprops);
 
-        for (std::vector<int>::size_type i = 0; i < cells.size(); ++i) {
-            double phase_sum = 0.0;
+        fractional_flows.resize(nc * num_phases);
+        for (int i = 0; i < nc; ++i) {
+            const double phase_sum = cellprops.totmob[i];
             for (int phase = 0; phase < num_phases; ++phase) {
-                phase_sum += fractional_flows[i * num_phases + phase];
-            }
-            for (int phase = 0; phase < num_phases; ++phase) {
-                fractional_flows[i * num_phases + phase] /= phase_sum;
+                fractional_flows[i * num_phases + phase]
+                    = cellprops.mob[cellprops.index(phase, i)] / phase_sum;
             }
         }
     }
 
+    namespace
+    {
+        // Kernel of computeSurfacevol() for NP phases. The terms of each
+        // row are summed in the same order as in the generic loop.
+        template <int NP>
+        void computeSurfacevolKernel(const int n,
+                                     const double* A,
+                                     const double* saturation,
+                                     double* surfacevol)
+        {
+            for (int i = 0; i < n; ++i) {
+                const double* Ai = A + i*NP*NP;
+                const double* si = saturation + i*NP;
+                for (int row = 0; row < NP; ++row) {
+                    double z = 0.0;
+                    for (int col = 0; col < NP; ++col) {
+                        z += Ai[row + col*NP] * si[col];
+                    }
+                    surfacevol[i*NP + row] = z;
+                }
+            }
+        }
+    } // anonymous namespace
+
     /// Computes the surface volume densities from saturations by the formula
     ///     z = A s
     /// for a number of data points, where z is the surface volume density,
@@ -280,11 +293,20 @@ namespace Opm
         // Note: since this is a simple matrix-vector product, it can
         // be done by a BLAS call, but then we have to reorder the A
         // matrix data.
-        std::fill(surfacevol, surfacevol + n*np, 0.0);
-        for (int i = 0; i < n; ++i) {
-            for (int col = 0; col < np; ++col) {
-                for (int row = 0; row < np; ++row) {
-                    surfacevol[i*np + row] += A[i*np*np + row + col*np] * saturation[i*np + col];
+        switch (np) {
+        case 2:
+            computeSurfacevolKernel<2>(n, A, saturation, surfacevol);
+            break;
+        case 3:
+            computeSurfacevolKernel<3>(n, A, saturation, surfacevol);
+            break;
+        default:
+            std::fill(surfacevol, surfacevol + n*np, 0.0);
+            for (int i = 0; i < n; ++i) {
+                for (int col = 0; col < np; ++col) {
+                    for (int row = 0; row < np; ++row) {
+                        surfacevol[i*np + row] += A[i*np*np + row + col*np] * saturation[i*np + col];
+                    }
                 }
             }
         }
@@ -25,10 +25,16 @@
 
 #include <boost/lexical_cast.hpp>
 
+#include <algorithm>
 #include <memory>
 
 namespace Opm
 {
+    WellCollection::WellCollection()
+        : flat_tree_valid_(false)
+    {
+    }
+
     void WellCollection::addField(GroupConstPtr fieldGroup, size_t timeStep, const PhaseUsage& phaseUsage) {
         WellsGroupInterface* fieldNode = findNode(fieldGroup->name());
         if (fieldNode) {
@@ -36,6 +42,7 @@ namespace Opm
         }
 
         roots_.push_back(createGroupWellsGroup(fieldGroup, timeStep, phaseUsage));
+        registerNode(roots_.back().get());
     }
 
     void WellCollection::addGroup(GroupConstPtr groupChild, std::string parent_name,
@@ -58,6 +65,7 @@ namespace Opm
         }
         parent_as_group->addChild(child);
         child->setParent(parent);
+        registerNode(child.get());
     }
 
     void WellCollection::addWell(WellConstPtr wellChild, size_t timeStep, const PhaseUsage& phaseUsage) {
@@ -77,6 +85,7 @@ namespace Opm
         leaf_nodes_.push_back(static_cast<WellNode*>(child.get()));
 
         child->setParent(parent);
+        registerNode(child.get());
     }
 
     const std::vector<WellNode*>& WellCollection::getLeafNodes() const {
@@ -85,26 +94,29 @@ namespace Opm
 
     WellsGroupInterface* WellCollection::findNode(const std::string& name)
     {
-
-        for (size_t i = 0; i < roots_.size(); i++) {
-            WellsGroupInterface* result = roots_[i]->findGroup(name);
-            if (result) {
-                return result;
-            }
-        }
-        return NULL;
+        auto it = node_by_name_.find(name);
+        return it == node_by_name_.end() ? NULL : it->second;
     }
 
     const WellsGroupInterface* WellCollection::findNode(const std::string& name) const
     {
+        auto it = node_by_name_.find(name);
+        return it == node_by_name_.end() ? NULL : it->second;
+    }
 
-        for (size_t i = 0; i < roots_.size(); i++) {
-            WellsGroupInterface* result = roots_[i]->findGroup(name);
-            if (result) {
-                return result;
+    // Adds the node and its subtree to the name index, and marks the
+    // flattened tree as out of date. Should a name be repeated, the
+    // node added first is kept.
+    void WellCollection::registerNode(WellsGroupInterface* node)
+    {
+        node_by_name_.insert(std::make_pair(node->name(), node));
+        if (!node->isLeafNode()) {
+            const auto& children = static_cast<WellsGroup*>(node)->children();
+            for (size_t i = 0; i < children.size(); ++i) {
+                registerNode(children[i].get());
             }
         }
-        return NULL;
+        flat_tree_valid_ = false;
     }
 
     /// Adds the child to the collection
@@ -124,7 +136,7 @@ namespace Opm
         if (child_node->isLeafNode()) {
             leaf_nodes_.push_back(static_cast<WellNode*>(child_node.get()));
         }
-
+        registerNode(child_node.get());
     }
 
     /// Adds the node to the collection (as a root node)
@@ -135,20 +147,69 @@ namespace Opm
         if (child_node->isLeafNode()) {
             leaf_nodes_.push_back(static_cast<WellNode*> (child_node.get()));
         }
+        registerNode(child_node.get());
+    }
+
+    void WellCollection::buildFlatTree()
+    {
+        flat_nodes_.clear();
+        flat_parent_.clear();
+        flat_is_leaf_.clear();
+        for (size_t i = 0; i < roots_.size(); ++i) {
+            appendPostOrder(roots_[i].get());
+        }
+        flat_summed_.resize(flat_nodes_.size());
+        flat_tree_valid_ = true;
+    }
+
+    // Appends the subtree of node in post-order, and returns the index of node.
+    int WellCollection::appendPostOrder(WellsGroupInterface* node)
+    {
+        std::vector<int> child_index;
+        if (!node->isLeafNode()) {
+            const auto& children = static_cast<WellsGroup*>(node)->children();
+            child_index.reserve(children.size());
+            for (size_t i = 0; i < children.size(); ++i) {
+                child_index.push_back(appendPostOrder(children[i].get()));
+            }
+        }
+        const int index = flat_nodes_.size();
+        flat_nodes_.push_back(node);
+        flat_parent_.push_back(-1);
+        flat_is_leaf_.push_back(node->isLeafNode());
+        for (size_t i = 0; i < child_index.size(); ++i) {
+            flat_parent_[child_index[i]] = index;
+        }
+        return index;
     }
 
     bool WellCollection::conditionsMet(const std::vector<double>& well_bhp,
                                        const std::vector<double>& well_reservoirrates_phase,
                                        const std::vector<double>& well_surfacerates_phase)
     {
-        for (size_t i = 0; i < roots_.size(); i++) {
-            WellPhasesSummed phases;
-            if (!roots_[i]->conditionsMet(well_bhp,
-                                          well_reservoirrates_phase,
-                                          well_surfacerates_phase,
-                                          phases)) {
+        if (!flat_tree_valid_) {
+            buildFlatTree();
+        }
+        std::fill(flat_summed_.begin(), flat_summed_.end(), WellPhasesSummed());
+
+        // Children come before their parent, so the rates of a group
+        // are complete when it is reached.
+        for (size_t i = 0; i < flat_nodes_.size(); ++i) {
+            if (flat_is_leaf_[i]) {
+                if (!flat_nodes_[i]->conditionsMet(well_bhp,
+                                                   well_reservoirrates_phase,
+                                                   well_surfacerates_phase,
+                                                   flat_summed_[i])) {
+                    return false;
+                }
+            } else if (!static_cast<WellsGroup*>(flat_nodes_[i])->groupConditionsMet(well_reservoirrates_phase,
+                                                                                      well_surfacerates_phase,
+                                                                                      flat_summed_[i])) {
                 return false;
             }
+            if (flat_parent_[i] >= 0) {
+                flat_summed_[flat_parent_[i]] += flat_summed_[i];
+            }
         }
         return true;
     }
@@ -21,6 +21,8 @@
 
 #include <vector>
 #include <memory>
+#include <string>
+#include <unordered_map>
 
 #include <opm/core/wells/WellsGroup.hpp>
 #include <opm/core/grid.h>
@@ -35,6 +37,7 @@ namespace Opm
     class WellCollection
     {
     public:
+        WellCollection();
 
         void addField(GroupConstPtr fieldGroup, size_t timeStep, const PhaseUsage& phaseUsage);
 
@@ -75,6 +78,10 @@ namespace Opm
         ///                         Is assumed to be ordered the same way as the related Wells-struct,
         ///                         with all phase rates of a single well adjacent in the array.
         /// \return true if no violations were found, false otherwise (false also implies a change).
+        ///
+        /// The tree is traversed bottom-up in a single loop over a flattened copy
+        /// of it, in the same order, and with the same summation order, as a
+        /// recursive traversal from the roots.
         bool conditionsMet(const std::vector<double>& well_bhp,
                            const std::vector<double>& well_reservoirrates_phase,
                            const std::vector<double>& well_surfacerates_phase);
@@ -86,6 +93,8 @@ namespace Opm
         const std::vector<WellNode*>& getLeafNodes() const;
 
         /// Finds the group with the given name.
+        /// Only nodes added through the collection (including the subtrees of
+        /// nodes passed to addChild()) are found, in constant time.
         /// \param[in] the name of the group
         /// \return the pointer to the group if found, NULL otherwise
         WellsGroupInterface* findNode(const std::string& name);
@@ -117,6 +126,21 @@ namespace Opm
         // This will be used to traverse the bottom nodes.
         std::vector<WellNode*> leaf_nodes_;
 
+        // Every node of the forest by name.
+        std::unordered_map<std::string, WellsGroupInterface*> node_by_name_;
+
+        // The forest flattened to arrays, with the nodes in post-order
+        // (children before their parent, roots in order). Rebuilt by
+        // conditionsMet() after nodes have been added.
+        std::vector<WellsGroupInterface*> flat_nodes_;
+        std::vector<int> flat_parent_;     // -1 for roots
+        std::vector<char> flat_is_leaf_;
+        std::vector<WellPhasesSummed> flat_summed_;
+        bool flat_tree_valid_;
+
+        void registerNode(WellsGroupInterface* node);
+        void buildFlatTree();
+        int appendPostOrder(WellsGroupInterface* node);
 
     };
 
@@ -0,0 +1,94 @@
+/*
+  Copyright 2015 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "config.h"
+#include <opm/core/wells/WellPerforationTable.hpp>
+#include <opm/core/grid.h>
+
+#include <algorithm>
+
+namespace Opm
+{
+
+    namespace
+    {
+        struct ByCell
+        {
+            explicit ByCell(const int* cells) : cells_(cells) {}
+            bool operator()(const int a, const int b) const
+            {
+                return cells_[a] < cells_[b];
+            }
+            const int* cells_;
+        };
+    } // anonymous namespace
+
+
+
+    WellPerforationTable::WellPerforationTable()
+        : num_wells_(0),
+          num_phases_(0),
+          num_cells_(0)
+    {
+    }
+
+
+
+    WellPerforationTable::WellPerforationTable(const Wells& wells, const UnstructuredGrid& grid)
+        : WellPerforationTable(wells, grid.number_of_cells, grid.cell_centroids)
+    {
+    }
+
+
+
+    void WellPerforationTable::init(const Wells& wells, const int number_of_cells,
+                                    const std::vector<double>& cell_depth)
+    {
+        num_wells_ = wells.number_of_wells;
+        num_phases_ = wells.number_of_phases;
+        num_cells_ = number_of_cells;
+
+        const int nperf = wells.well_connpos[num_wells_];
+        std::vector<int> well_of_perf(nperf);
+        for (int w = 0; w < num_wells_; ++w) {
+            std::fill(well_of_perf.begin() + wells.well_connpos[w],
+                      well_of_perf.begin() + wells.well_connpos[w + 1], w);
+        }
+
+        // Stable, so that the perforations of a cell keep their order.
+        perf_.resize(nperf);
+        for (int perf = 0; perf < nperf; ++perf) {
+            perf_[perf] = perf;
+        }
+        std::stable_sort(perf_.begin(), perf_.end(), ByCell(wells.well_cells));
+
+        cell_.resize(nperf);
+        well_.resize(nperf);
+        depth_diff_.resize(nperf);
+        WI_.resize(nperf);
+        for (int k = 0; k < nperf; ++k) {
+            const int perf = perf_[k];
+            cell_[k] = wells.well_cells[perf];
+            well_[k] = well_of_perf[perf];
+            depth_diff_[k] = cell_depth[perf] - wells.depth_ref[well_[k]];
+            WI_[k] = wells.WI[perf];
+        }
+    }
+
+} // namespace Opm
@@ -0,0 +1,115 @@
+/*
+  Copyright 2015 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_WELLPERFORATIONTABLE_HEADER_INCLUDED
+#define OPM_WELLPERFORATIONTABLE_HEADER_INCLUDED
+
+#include <opm/core/grid/GridHelpers.hpp>
+#include <opm/core/wells.h>
+
+#include <vector>
+
+struct UnstructuredGrid;
+
+namespace Opm
+{
+
+    /// The perforations of a Wells struct, stored as separate arrays
+    /// (structure of arrays) and sorted by cell index.
+    ///
+    /// Kernels that visit all perforations, such as the overloads of
+    /// computeWDP() and computePhaseFlowRatesPerWell() taking a table,
+    /// then access per-cell data in increasing cell order instead of in
+    /// the order of the well connections. Entry k of the table belongs
+    /// to perforation perforation(k) of the Wells struct, so per-
+    /// perforation results are scattered back to the usual ordering.
+    ///
+    /// The table must be rebuilt when the perforations of the wells
+    /// change. Changes to well controls do not affect it.
+    class WellPerforationTable
+    {
+    public:
+        /// Empty table.
+        WellPerforationTable();
+
+        /// Construct from wells and grid.
+        WellPerforationTable(const Wells& wells, const UnstructuredGrid& grid);
+
+        /// Construct from wells and cell centroids.
+        /// \param[in] wells                 The wells.
+        /// \param[in] number_of_cells       The number of cells in the grid.
+        /// \param[in] begin_cell_centroids  Pointer/Iterator to the first cell centroid.
+        template<class T>
+        WellPerforationTable(const Wells& wells, int number_of_cells, T begin_cell_centroids)
+        {
+            const int nperf = wells.well_connpos[wells.number_of_wells];
+            std::vector<double> cell_depth(nperf);
+            for (int perf = 0; perf < nperf; ++perf) {
+                const int cell = wells.well_cells[perf];
+                cell_depth[perf] = UgGridHelpers
+                    ::getCoordinate(UgGridHelpers::increment(begin_cell_centroids, cell, 3), 2);
+            }
+            init(wells, number_of_cells, cell_depth);
+        }
+
+        /// Number of wells.
+        int numWells() const { return num_wells_; }
+
+        /// Number of phases of the wells.
+        int numPhases() const { return num_phases_; }
+
+        /// Number of perforations.
+        int numPerforations() const { return int(perf_.size()); }
+
+        /// Number of cells in the grid.
+        int numCells() const { return num_cells_; }
+
+        /// Index of entry k in the perforation arrays of the Wells struct.
+        int perforation(const int k) const { return perf_[k]; }
+
+        /// Cell of entry k.
+        int cell(const int k) const { return cell_[k]; }
+
+        /// Well of entry k.
+        int well(const int k) const { return well_[k]; }
+
+        /// Depth of the cell of entry k relative to the reference depth
+        /// of its well.
+        double depthBelowReference(const int k) const { return depth_diff_[k]; }
+
+        /// Well index of entry k.
+        double wellIndex(const int k) const { return WI_[k]; }
+
+    private:
+        void init(const Wells& wells, const int number_of_cells,
+                  const std::vector<double>& cell_depth);
+
+        int num_wells_;
+        int num_phases_;
+        int num_cells_;
+        std::vector<int> perf_;
+        std::vector<int> cell_;
+        std::vector<int> well_;
+        std::vector<double> depth_diff_;
+        std::vector<double> WI_;
+    };
+
+} // namespace Opm
+
+#endif // OPM_WELLPERFORATIONTABLE_HEADER_INCLUDED
@@ -328,7 +328,20 @@ namespace Opm
             child_phases_summed += current_child_phases_summed;
         }
 
+        if (!groupConditionsMet(well_reservoirrates_phase,
+                                well_surfacerates_phase,
+                                child_phases_summed)) {
+            return false;
+        }
+
+        summed_phases += child_phases_summed;
+        return true;
+    }
 
+    bool WellsGroup::groupConditionsMet(const std::vector<double>& well_reservoirrates_phase,
+                                        const std::vector<double>& well_surfacerates_phase,
+                                        const WellPhasesSummed& child_phases_summed)
+    {
         // Injection constraints.
         InjectionSpecification::ControlMode injection_modes[] = {InjectionSpecification::RATE,
                                                                  InjectionSpecification::RESV};
@@ -406,7 +419,6 @@ namespace Opm
             }
         }
 
-        summed_phases += child_phases_summed;
         return true;
     }
 
@@ -415,6 +427,11 @@ namespace Opm
         children_.push_back(child);
     }
 
+    const std::vector<std::shared_ptr<WellsGroupInterface> >& WellsGroup::children() const
+    {
+        return children_;
+    }
+
 
     int WellsGroup::numberOfLeafNodes() {
         // This could probably use some caching, but seeing as how the number of
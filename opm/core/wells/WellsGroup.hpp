@@ -30,6 +30,7 @@
 
 #include <string>
 #include <memory>
+#include <vector>
 
 namespace Opm
 {
@@ -237,11 +238,28 @@ namespace Opm
 
         void addChild(std::shared_ptr<WellsGroupInterface> child);
 
+        /// The children of the group, in the order they were added.
+        const std::vector<std::shared_ptr<WellsGroupInterface> >& children() const;
+
         virtual bool conditionsMet(const std::vector<double>& well_bhp,
                                    const std::vector<double>& well_reservoirrates_phase,
                                    const std::vector<double>& well_surfacerates_phase,
                                    WellPhasesSummed& summed_phases);
 
+        /// Checks the constraints of the group itself, as conditionsMet()
+        /// does after checking those of the children, but with the summed
+        /// phase rates of the children given instead of computed.
+        /// \param[in]    well_reservoirrates_phase
+        ///                         A vector containing reservoir rates by phase for each well.
+        /// \param[in]    well_surfacerates_phase
+        ///                         A vector containing surface rates by phase for each well.
+        /// \param[in]    child_phases_summed
+        ///                         The summed phase rates of all children.
+        /// \return true if no violations were found, false otherwise (false also implies a change).
+        bool groupConditionsMet(const std::vector<double>& well_reservoirrates_phase,
+                                const std::vector<double>& well_surfacerates_phase,
+                                const WellPhasesSummed& child_phases_summed);
+
         virtual int numberOfLeafNodes();
         virtual std::pair<WellNode*, double> getWorstOffending(const std::vector<double>& well_reservoirrates_phase,
                                                                const std::vector<double>& well_surfacerates_phase,
@@ -313,13 +313,13 @@ namespace Opm
 
     /// Default constructor.
     WellsManager::WellsManager()
-        : w_(0), is_parallel_run_(false)
+        : w_(0), is_parallel_run_(false), cached_permeability_(0)
     {
     }
 
     /// Construct from existing wells object.
     WellsManager::WellsManager(struct Wells* W)
-        : w_(clone_wells(W)), is_parallel_run_(false)
+        : w_(clone_wells(W)), is_parallel_run_(false), cached_permeability_(0)
     {
     }
 
@@ -327,14 +327,15 @@ namespace Opm
     WellsManager::WellsManager(const Opm::EclipseStateConstPtr eclipseState,
                                const size_t timeStep,
                                const UnstructuredGrid& grid,
-                               const double* permeability)
-        : w_(0), is_parallel_run_(false)
+                               const double* permeability,
+                               std::shared_ptr<const CompressedCartesianIndex> cartesian_index)
+        : w_(0), is_parallel_run_(false), cached_permeability_(0)
     {
         init(eclipseState, timeStep, UgGridHelpers::numCells(grid),
              UgGridHelpers::globalCell(grid), UgGridHelpers::cartDims(grid), 
              UgGridHelpers::dimensions(grid),
              UgGridHelpers::cell2Faces(grid), UgGridHelpers::beginFaceCentroids(grid),
-             permeability);
+             permeability, cartesian_index);
 
     }
 
@@ -344,6 +345,20 @@ namespace Opm
         destroy_wells(w_);
     }
 
+    /// Replace the wells by those of another report step.
+    void WellsManager::update(const Opm::EclipseStateConstPtr eclipseState,
+                              const size_t timeStep,
+                              const UnstructuredGrid& grid,
+                              const double* permeability,
+                              std::shared_ptr<const CompressedCartesianIndex> cartesian_index)
+    {
+        update(eclipseState, timeStep, UgGridHelpers::numCells(grid),
+               UgGridHelpers::globalCell(grid), UgGridHelpers::cartDims(grid),
+               UgGridHelpers::dimensions(grid),
+               UgGridHelpers::cell2Faces(grid), UgGridHelpers::beginFaceCentroids(grid),
+               permeability, cartesian_index);
+    }
+
 
     /// Does the "deck" define any wells?
     bool WellsManager::empty() const
@@ -366,6 +381,11 @@ namespace Opm
         return well_collection_;
     }
 
+    const std::vector<int>& WellsManager::wellIds() const
+    {
+        return well_ids_;
+    }
+
     bool WellsManager::conditionsMet(const std::vector<double>& well_bhp,
                                      const std::vector<double>& well_reservoirrates_phase,
                                      const std::vector<double>& well_surfacerates_phase)
@@ -391,26 +411,6 @@ namespace Opm
         well_collection_.applyExplicitReinjectionControls(well_reservoirrates_phase, well_surfacerates_phase);
     }
 
-    void WellsManager::setupCompressedToCartesian(const int* global_cell, int number_of_cells,
-                                                  std::map<int,int>& cartesian_to_compressed ) {
-        // global_cell is a map from compressed cells to Cartesian grid cells.
-        // We must make the inverse lookup.
-
-        if (global_cell) {
-            for (int i = 0; i < number_of_cells; ++i) {
-                cartesian_to_compressed.insert(std::make_pair(global_cell[i], i));
-            }
-        }
-        else {
-            for (int i = 0; i < number_of_cells; ++i) {
-                cartesian_to_compressed.insert(std::make_pair(i, i));
-            }
-        }
-
-    }
-
-
-
     void WellsManager::setupWellControls(std::vector<WellConstPtr>& wells, size_t timeStep,
                                          std::vector<std::string>& well_names, const PhaseUsage& phaseUsage,
                                          const std::vector<int>& wells_on_proc) {
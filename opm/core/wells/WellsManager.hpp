@@ -27,8 +27,14 @@
 #include <opm/core/wells/WellsGroup.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/GroupTree.hpp>
 
+#include <opm/core/utility/CompressedCartesianIndex.hpp>
 #include <opm/core/utility/CompressedPropertyAccess.hpp>
 
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
 struct Wells;
 struct UnstructuredGrid;
 
@@ -72,6 +78,9 @@ namespace Opm
         /// The permeability argument may be zero if the input contain
         /// well productivity indices, otherwise it must be given in
         /// order to approximate these by the Peaceman formula.
+        /// The cartesian_index argument may be null, in which case the
+        /// index is built from global_cell. Pass the one of the grid if
+        /// it is already built, so that it is shared with the output.
         template<class F2C, class FC>
         WellsManager(const Opm::EclipseStateConstPtr eclipseState,
                      const size_t timeStep,
@@ -82,15 +91,48 @@ namespace Opm
                      const F2C& f2c,
                      FC begin_face_centroids,
                      const double* permeability,
-                     bool is_parallel_run=false);
+                     bool is_parallel_run=false,
+                     std::shared_ptr<const CompressedCartesianIndex> cartesian_index
+                         = std::shared_ptr<const CompressedCartesianIndex>());
 
         WellsManager(const Opm::EclipseStateConstPtr eclipseState,
                      const size_t timeStep,
                      const UnstructuredGrid& grid,
-                     const double* permeability);
+                     const double* permeability,
+                     std::shared_ptr<const CompressedCartesianIndex> cartesian_index
+                         = std::shared_ptr<const CompressedCartesianIndex>());
         /// Destructor.
         ~WellsManager();
 
+        /// Replace the wells by those of another report step.
+        /// The result is the same as that of constructing a new
+        /// WellsManager for the report step, but the lookups derived
+        /// from the grid are only computed once, and the connection
+        /// transmissibility factors of wells whose completions have
+        /// not changed since they were last computed are reused.
+        /// The grid and permeability must be those given to earlier
+        /// calls or to the constructor, if any. A cartesian_index
+        /// given here replaces the one in use.
+        template<class F2C, class FC>
+        void update(const Opm::EclipseStateConstPtr eclipseState,
+                    const size_t timeStep,
+                    int num_cells,
+                    const int* global_cell,
+                    const int* cart_dims,
+                    int dimensions,
+                    const F2C& f2c,
+                    FC begin_face_centroids,
+                    const double* permeability,
+                    std::shared_ptr<const CompressedCartesianIndex> cartesian_index
+                        = std::shared_ptr<const CompressedCartesianIndex>());
+
+        void update(const Opm::EclipseStateConstPtr eclipseState,
+                    const size_t timeStep,
+                    const UnstructuredGrid& grid,
+                    const double* permeability,
+                    std::shared_ptr<const CompressedCartesianIndex> cartesian_index
+                        = std::shared_ptr<const CompressedCartesianIndex>());
+
         /// Does the "deck" define any wells?
         bool empty() const;
 
@@ -102,6 +144,12 @@ namespace Opm
         /// Access the well group hierarchy.
         const WellCollection& wellCollection() const;
 
+        /// Identity of each well of c_wells(), stable across report
+        /// steps: the position of the well among all wells of the
+        /// schedule. Empty if the wells were not set up from a
+        /// schedule. For use with WellState::init().
+        const std::vector<int>& wellIds() const;
+
         /// Checks if each condition is met, applies well controls where needed
         /// (that is, it either changes the active control of violating wells, or shuts
         /// down wells). Only one change is applied per invocation. Typical use will be
@@ -149,11 +197,11 @@ namespace Opm
                   int dimensions,
                   const C2F& cell_to_faces,
                   FC begin_face_centroids,
-                  const double* permeability);
+                  const double* permeability,
+                  std::shared_ptr<const CompressedCartesianIndex> cartesian_index);
         // Disable copying and assignment.
         WellsManager(const WellsManager& other);
         WellsManager& operator=(const WellsManager& other);
-        static void setupCompressedToCartesian(const int* global_cell, int number_of_cells, std::map<int,int>& cartesian_to_compressed );
         void setupWellControls(std::vector<WellConstPtr>& wells, size_t timeStep,
                                std::vector<std::string>& well_names, const PhaseUsage& phaseUsage,
                                const std::vector<int>& wells_on_proc);
@@ -169,7 +217,7 @@ namespace Opm
                                    std::vector<WellData>& well_data,
                                    std::map<std::string, int> & well_names_to_index,
                                    const PhaseUsage& phaseUsage,
-                                   const std::map<int,int>& cartesian_to_compressed,
+                                   const CompressedCartesianIndex& cartesian_index,
                                    const double* permeability,
                                    const NTG& ntg,
                                    std::vector<int>& wells_on_proc);
@@ -178,11 +226,27 @@ namespace Opm
         void setupGuideRates(std::vector<WellConstPtr>& wells, const size_t timeStep, std::vector<WellData>& well_data, std::map<std::string, int>& well_names_to_index);
 
 
+        // Perforations of a well, as computed from a completion set.
+        struct PerforationCache
+        {
+            CompletionSetConstPtr completions;
+            std::vector<PerfData> perf_data;
+            // Whether the well is handled by this process.
+            bool on_proc;
+        };
+
         // Data
         Wells* w_;
         WellCollection well_collection_;
         // Whether this is a parallel simulation
         bool is_parallel_run_;
+        // Lookups derived from the grid, and perforations by well
+        // name, reused by update().
+        std::shared_ptr<const CompressedCartesianIndex> cartesian_index_;
+        std::vector<double> dz_;
+        const double* cached_permeability_;
+        std::map<std::string, PerforationCache> perforation_cache_;
+        std::vector<int> well_ids_;
     };
 
 } // namespace Opm
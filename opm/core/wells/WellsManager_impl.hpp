@@ -2,7 +2,6 @@
 #include <opm/core/grid/GridHelpers.hpp>
 
 #include <opm/core/utility/ErrorMacros.hpp>
-#include <opm/core/utility/compressedToCartesian.hpp>
 
 #include <algorithm>
 #include <array>
@@ -113,7 +112,7 @@ void WellsManager::createWellsFromSpecs(std::vector<WellConstPtr>& wells, size_t
                                         std::vector<WellData>& well_data,
                                         std::map<std::string, int>& well_names_to_index,
                                         const PhaseUsage& phaseUsage,
-                                        const std::map<int,int>& cartesian_to_compressed,
+                                        const CompressedCartesianIndex& cartesian_index,
                                         const double* permeability,
                                         const NTG& ntg,
                                         std::vector<int>& wells_on_proc)
@@ -136,8 +135,14 @@ void WellsManager::createWellsFromSpecs(std::vector<WellConstPtr>& wells, size_t
             continue;
         }
 
-        {   // COMPDAT handling
-            CompletionSetConstPtr completionSet = well->getCompletions(timeStep);
+        // The perforations only depend on the completion set, which
+        // is shared between report steps until it is modified.
+        CompletionSetConstPtr completionSet = well->getCompletions(timeStep);
+        PerforationCache& cached = perforation_cache_[well->name()];
+        if (cached.completions != completionSet) {   // COMPDAT handling
+            cached.completions.reset();
+            cached.perf_data.clear();
+            cached.on_proc = true;
             // shut completions and open ones stored in this process will have 1 others 0.
             std::vector<std::size_t> completion_on_proc(completionSet->size(), 1);
             std::size_t shut_completions_number = 0;
@@ -150,8 +155,8 @@ void WellsManager::createWellsFromSpecs(std::vector<WellConstPtr>& wells, size_t
 
                     const int* cpgdim = cart_dims;
                     int cart_grid_indx = i + cpgdim[0]*(j + cpgdim[1]*k);
-                    std::map<int, int>::const_iterator cgit = cartesian_to_compressed.find(cart_grid_indx);
-                    if (cgit == cartesian_to_compressed.end()) {
+                    const int cell = cartesian_index.compressedIndex(cart_grid_indx);
+                    if (cell < 0) {
                         if ( is_parallel_run_ )
                         {
                             completion_on_proc[c]=0;
@@ -165,7 +170,6 @@ void WellsManager::createWellsFromSpecs(std::vector<WellConstPtr>& wells, size_t
                     }
                     else
                     {
-                        int cell = cgit->second;
                         PerfData pd;
                         pd.cell = cell;
                         {
@@ -197,7 +201,7 @@ void WellsManager::createWellsFromSpecs(std::vector<WellConstPtr>& wells, size_t
                             }
                             pd.well_index *= wellPi;
                         }
-                        wellperf_data[well_index].push_back(pd);
+                        cached.perf_data.push_back(pd);
                     }
                 } else {
                     ++shut_completions_number;
@@ -217,8 +221,7 @@ void WellsManager::createWellsFromSpecs(std::vector<WellConstPtr>& wells, size_t
                 if ( sum_completions_on_proc == shut_completions_number )
                 {
                     // Mark well as not existent on this process
-                    wells_on_proc[wellIter-wells.begin()] = 0;
-                    continue;
+                    cached.on_proc = false;
                 }
                 else
                 {
@@ -229,12 +232,18 @@ void WellsManager::createWellsFromSpecs(std::vector<WellConstPtr>& wells, size_t
                                  << "completely in the disjoint partition of "
                                  << "process deactivating here." << std::endl;
                         // Mark well as not existent on this process
-                        wells_on_proc[wellIter-wells.begin()] = 0;
-                        continue;
+                        cached.on_proc = false;
                     }
                 }
             }
+            cached.completions = completionSet;
         }
+        if (!cached.on_proc) {
+            wells_on_proc[wellIter-wells.begin()] = 0;
+            continue;
+        }
+        wellperf_data[well_index] = cached.perf_data;
+
         {   // WELSPECS handling
             well_names_to_index[well->name()] = well_index;
             well_names.push_back(well->name());
@@ -314,12 +323,38 @@ WellsManager(const Opm::EclipseStateConstPtr eclipseState,
              const C2F&                      cell_to_faces,
              FC                              begin_face_centroids,
              const double*                   permeability,
-             bool                            is_parallel_run)
-    : w_(0), is_parallel_run_(is_parallel_run)
+             bool                            is_parallel_run,
+             std::shared_ptr<const CompressedCartesianIndex> cartesian_index)
+    : w_(0), is_parallel_run_(is_parallel_run), cached_permeability_(0)
+{
+    init(eclipseState, timeStep, number_of_cells, global_cell,
+         cart_dims, dimensions,
+         cell_to_faces, begin_face_centroids, permeability,
+         cartesian_index);
+}
+
+/// Replace the wells by those of another report step.
+template <class C2F, class FC>
+void
+WellsManager::update(const Opm::EclipseStateConstPtr eclipseState,
+                     const size_t                    timeStep,
+                     int                             number_of_cells,
+                     const int*                      global_cell,
+                     const int*                      cart_dims,
+                     int                             dimensions,
+                     const C2F&                      cell_to_faces,
+                     FC                              begin_face_centroids,
+                     const double*                   permeability,
+                     std::shared_ptr<const CompressedCartesianIndex> cartesian_index)
 {
+    destroy_wells(w_);
+    w_ = 0;
+    well_collection_ = WellCollection();
+    well_ids_.clear();
     init(eclipseState, timeStep, number_of_cells, global_cell,
          cart_dims, dimensions,
-         cell_to_faces, begin_face_centroids, permeability);
+         cell_to_faces, begin_face_centroids, permeability,
+         cartesian_index);
 }
 
 /// Construct wells from deck.
@@ -333,7 +368,8 @@ WellsManager::init(const Opm::EclipseStateConstPtr eclipseState,
                    int                             dimensions,
                    const C2F&                      cell_to_faces,
                    FC                              begin_face_centroids,
-                   const double*                   permeability)
+                   const double*                   permeability,
+                   std::shared_ptr<const CompressedCartesianIndex> cartesian_index)
 {
     if (dimensions != 3) {
         OPM_THROW(std::runtime_error,
@@ -347,9 +383,36 @@ WellsManager::init(const Opm::EclipseStateConstPtr eclipseState,
         return;
     }
 
-    std::map<int,int> cartesian_to_compressed;
-    setupCompressedToCartesian(global_cell, number_of_cells,
-                               cartesian_to_compressed);
+    // The grid lookups and perforations are kept for update().
+    if (cartesian_index) {
+        if (cartesian_index->numCells() != number_of_cells) {
+            OPM_THROW(std::runtime_error, "The Cartesian index has " << cartesian_index->numCells()
+                      << " cells, the grid " << number_of_cells << ".");
+        }
+        if (cartesian_index != cartesian_index_) {
+            cartesian_index_ = cartesian_index;
+            dz_.clear();
+        }
+    }
+    else if (!cartesian_index_ || cartesian_index_->numCells() != number_of_cells) {
+        cartesian_index_ = std::make_shared<CompressedCartesianIndex>(number_of_cells, global_cell,
+                                                                      cart_dims[0]*cart_dims[1]*cart_dims[2]);
+        dz_.clear();
+    }
+    if (dz_.empty()) {
+        // use cell thickness (dz) from eclGrid
+        // dz overwrites values calculated by WellDetails::getCubeDim
+        EclipseGridConstPtr eclGrid = eclipseState->getEclipseGrid();
+        dz_.resize(number_of_cells);
+        for (int cell = 0; cell < number_of_cells; ++cell) {
+            dz_[cell] = eclGrid->getCellThicknes(cartesian_index_->cartesianIndex(cell));
+        }
+        perforation_cache_.clear();
+    }
+    if (permeability != cached_permeability_) {
+        perforation_cache_.clear();
+        cached_permeability_ = permeability;
+    }
 
     // Obtain phase usage data.
     PhaseUsage pu = phaseUsageFromDeck(eclipseState);
@@ -376,29 +439,41 @@ WellsManager::init(const Opm::EclipseStateConstPtr eclipseState,
     DoubleArray ntg_glob(eclipseState, "NTG", 1.0);
     NTGArray    ntg(ntg_glob, global_cell);
 
-    EclipseGridConstPtr eclGrid = eclipseState->getEclipseGrid();
-
-    // use cell thickness (dz) from eclGrid
-    // dz overwrites values calculated by WellDetails::getCubeDim
-    std::vector<double> dz(number_of_cells);
-    {
-        std::vector<int> gc = compressedToCartesian(number_of_cells, global_cell);
-        for (int cell = 0; cell < number_of_cells; ++cell) {
-            dz[cell] = eclGrid->getCellThicknes(gc[cell]);
-        }
-    }
-
     createWellsFromSpecs(wells, timeStep, cell_to_faces,
                          cart_dims,
                          begin_face_centroids,
                          dimensions,
-                         dz,
+                         dz_,
                          well_names, well_data, well_names_to_index,
-                         pu, cartesian_to_compressed, permeability, ntg,
+                         pu, *cartesian_index_, permeability, ntg,
                          wells_on_proc);
 
     setupWellControls(wells, timeStep, well_names, pu, wells_on_proc);
 
+    // The wells of a report step are listed in the order of all
+    // wells of the schedule, so their identities are found in a
+    // single pass over the latter.
+    {
+        const auto all_wells = schedule->getWells();
+        well_ids_.clear();
+        well_ids_.reserve(well_names.size());
+        std::size_t id = 0;
+        for (std::size_t i = 0; i < wells.size(); ++i, ++id) {
+            while (id < all_wells.size() && all_wells[id] != wells[i]) {
+                ++id;
+            }
+            if (id == all_wells.size()) {
+                OPM_THROW(std::runtime_error, "Well " << wells[i]->name()
+                          << " not found in the schedule in the expected order.");
+            }
+            // SHUT wells and wells of other processes are not in
+            // c_wells(), see createWellsFromSpecs().
+            if (wells_on_proc[i] && wells[i]->getStatus(timeStep) != WellCommon::SHUT) {
+                well_ids_.push_back(id);
+            }
+        }
+    }
+
     {
         GroupTreeNodeConstPtr fieldNode =
             schedule->getGroupTree(timeStep)->getNode("FIELD");
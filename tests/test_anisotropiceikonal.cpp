@@ -37,8 +37,6 @@
 
 using namespace Opm;
 
-#if BOOST_HEAP_AVAILABLE
-
 BOOST_AUTO_TEST_CASE(cartesian_2d_a)
 {
     const GridManager gm(2, 2);
@@ -90,11 +88,28 @@ BOOST_AUTO_TEST_CASE(cartesian_2d_b)
     }
 }
 
-#else // BOOST_HEAP_AVAILABLE is false
 
-BOOST_AUTO_TEST_CASE(dummy)
+BOOST_AUTO_TEST_CASE(cartesian_3d)
 {
-    BOOST_CHECK(true);
-}
+    const GridManager gm(2, 2, 2);
+    const UnstructuredGrid& grid = *gm.c_grid();
+    AnisotropicEikonal ae(grid);
 
-#endif // BOOST_HEAP_AVAILABLE
+    std::vector<double> metric;
+    for (int cell = 0; cell < grid.number_of_cells; ++cell) {
+        const double m[9] = { 1, 0, 0, 0, 1, 0, 0, 0, 1 };
+        metric.insert(metric.end(), m, m + 9);
+    }
+    BOOST_REQUIRE_EQUAL(metric.size(), grid.number_of_cells*grid.dimensions*grid.dimensions);
+    const std::vector<int> start = { 0 };
+    std::vector<double> sol;
+    ae.solve(metric.data(), start, sol);
+    BOOST_REQUIRE(!sol.empty());
+    BOOST_CHECK_EQUAL(sol.size(), grid.number_of_cells);
+    const double s2 = std::sqrt(2.0);
+    const double s3 = std::sqrt(3.0);
+    std::vector<double> truth = { 0, 1, 1, s2, 1, s2, s2, s3 };
+    for (int cell = 0; cell < grid.number_of_cells; ++cell) {
+        BOOST_CHECK_CLOSE(sol[cell], truth[cell], 1e-10);
+    }
+}
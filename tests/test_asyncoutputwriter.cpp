@@ -0,0 +1,183 @@
+/*
+  Copyright 2015 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "config.h"
+
+#if HAVE_DYNAMIC_BOOST_TEST
+#define BOOST_TEST_DYN_LINK
+#endif
+
+#define NVERBOSE  // Suppress own messages when throw()ing
+
+#define BOOST_TEST_MODULE AsyncOutputWriterTest
+#include <boost/test/unit_test.hpp>
+
+#include <opm/core/io/AsyncOutputWriter.hpp>
+#include <opm/core/io/OutputWriter.hpp>
+#include <opm/core/simulator/SimulatorState.hpp>
+#include <opm/core/simulator/SimulatorTimer.hpp>
+#include <opm/core/simulator/WellState.hpp>
+#include <opm/core/utility/parameters/ParameterGroup.hpp>
+
+#include <chrono>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    // Writes the raw bytes of everything it is given, slowly, so that
+    // the simulation runs ahead of it in asynchronous mode.
+    class RecordingWriter : public Opm::OutputWriter
+    {
+    public:
+        explicit RecordingWriter(const int fail_at = -1)
+            : fail_at_(fail_at)
+        {
+        }
+
+        void writeInit(const Opm::SimulatorTimerInterface&)
+        {
+        }
+
+        void writeTimeStep(const Opm::SimulatorTimerInterface& timer,
+                           const Opm::SimulatorState& reservoirState,
+                           const Opm::WellState& wellState,
+                           bool isSubstep)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            if (timer.currentStepNum() == fail_at_) {
+                throw std::runtime_error("disk full");
+            }
+            const int step = timer.currentStepNum();
+            const double elapsed = timer.simulationTimeElapsed();
+            os_.write(reinterpret_cast<const char*>(&step), sizeof step);
+            os_.write(reinterpret_cast<const char*>(&elapsed), sizeof elapsed);
+            os_ << isSubstep;
+            append(reservoirState.cellData());
+            append(reservoirState.faceData());
+            append(std::vector<std::vector<double> >(1, wellState.bhp()));
+            append(std::vector<std::vector<double> >(1, wellState.perfRates()));
+        }
+
+        std::string bytes() const
+        {
+            return os_.str();
+        }
+
+    private:
+        void append(const std::vector<std::vector<double> >& data)
+        {
+            for (std::size_t i = 0; i < data.size(); ++i) {
+                os_.write(reinterpret_cast<const char*>(data[i].data()),
+                          data[i].size()*sizeof(double));
+            }
+        }
+
+        int fail_at_;
+        std::ostringstream os_;
+    };
+
+    // Advance through five steps, changing the state before each
+    // write, and pass every step to write().
+    template <class Write>
+    void simulate(Write write)
+    {
+        Opm::parameter::ParameterGroup param;
+        param.disableOutput();
+        param.insertParameter("num_psteps", "5");
+        param.insertParameter("stepsize_days", "10");
+        Opm::SimulatorTimer timer;
+        timer.init(param);
+        Opm::SimulatorState state;
+        state.init(10, 12, 2);
+        Opm::WellState well_state;
+        well_state.init(0, state);
+        while (!timer.done()) {
+            ++timer;
+            for (std::size_t i = 0; i < state.cellData().size(); ++i) {
+                std::vector<double>& d = state.cellData()[i];
+                for (std::size_t j = 0; j < d.size(); ++j) {
+                    d[j] = 100.0*timer.currentStepNum() + i + 0.25*j;
+                }
+            }
+            for (std::size_t j = 0; j < state.faceflux().size(); ++j) {
+                state.faceflux()[j] = -1.0*timer.currentStepNum()*j;
+            }
+            write(timer, state, well_state);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(SameAsSynchronous)
+{
+    RecordingWriter sync_writer;
+    simulate([&](const Opm::SimulatorTimer& timer,
+                 const Opm::SimulatorState& state,
+                 const Opm::WellState& well_state) {
+                 sync_writer.writeTimeStep(timer, state, well_state, false);
+             });
+
+    for (int num_buffers = 1; num_buffers <= 3; ++num_buffers) {
+        RecordingWriter async_writer;
+        Opm::AsyncOutputWriter async(async_writer, num_buffers);
+        simulate([&](const Opm::SimulatorTimer& timer,
+                     const Opm::SimulatorState& state,
+                     const Opm::WellState& well_state) {
+                     async.writeTimeStep(timer, state, well_state);
+                 });
+        async.flush();
+        BOOST_CHECK(async_writer.bytes() == sync_writer.bytes());
+        async.finish();
+        BOOST_CHECK(async_writer.bytes() == sync_writer.bytes());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(ErrorIsRethrown)
+{
+    // From the next write after the failure.
+    {
+        RecordingWriter writer(2);
+        Opm::AsyncOutputWriter async(writer, 1);
+        BOOST_CHECK_THROW(simulate([&](const Opm::SimulatorTimer& timer,
+                                       const Opm::SimulatorState& state,
+                                       const Opm::WellState& well_state) {
+                                       async.writeTimeStep(timer, state, well_state);
+                                   }),
+                          std::runtime_error);
+        // Reported once only.
+        async.finish();
+    }
+    // From finish(), when the last step fails.
+    {
+        RecordingWriter writer(5);
+        Opm::AsyncOutputWriter async(writer, 2);
+        simulate([&](const Opm::SimulatorTimer& timer,
+                     const Opm::SimulatorState& state,
+                     const Opm::WellState& well_state) {
+                     async.writeTimeStep(timer, state, well_state);
+                 });
+        BOOST_CHECK_THROW(async.finish(), std::runtime_error);
+        BOOST_CHECK_THROW(async.writeTimeStep(Opm::SimulatorTimer(), Opm::SimulatorState(),
+                                              Opm::WellState()),
+                          std::logic_error);
+    }
+}
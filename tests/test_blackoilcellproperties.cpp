@@ -0,0 +1,185 @@
+/*
+  Copyright 2015 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "config.h"
+
+#if HAVE_DYNAMIC_BOOST_TEST
+#define BOOST_TEST_DYN_LINK
+#endif
+
+#define NVERBOSE  // Suppress own messages when throw()ing
+
+#define BOOST_TEST_MODULE BlackoilCellPropertiesTest
+#include <boost/test/unit_test.hpp>
+
+#include <opm/core/grid.h>
+#include <opm/core/grid/cart_grid.h>
+#include <opm/core/props/BlackoilPropertiesFromDeck.hpp>
+#include <opm/core/utility/Units.hpp>
+
+#include <opm/parser/eclipse/Parser/Parser.hpp>
+#include <opm/parser/eclipse/Parser/ParseMode.hpp>
+#include <opm/parser/eclipse/Deck/Deck.hpp>
+#include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
+
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+    struct Points
+    {
+        // Points spanning saturated and undersaturated oil, in the
+        // given cells.
+        explicit Points(const std::vector<int>& c)
+            : n(c.size()), p(n), T(n, 300.0), z(3*n), s(3*n), cells(c)
+        {
+            for (int i = 0; i < n; ++i) {
+                const double w = double(i % 97)/96.0;
+                p[i] = (20.0 + 430.0*w)*Opm::unit::barsa;
+                z[3*i + 0] = 1.0;
+                z[3*i + 1] = 1.0;
+                z[3*i + 2] = 150.0*double(i % 13)/12.0;
+                s[3*i + 0] = 0.2 + 0.5*w;
+                s[3*i + 1] = 0.7 - 0.6*w;
+                s[3*i + 2] = 1.0 - s[3*i + 0] - s[3*i + 1];
+            }
+        }
+
+        int n;
+        std::vector<double> p, T, z, s;
+        std::vector<int> cells;
+    };
+
+    // Number of values in cp differing from those of separate calls
+    // to viscosity(), relperm(), matrix() and density().
+    int mismatches(const Opm::BlackoilPropertiesInterface& props,
+                   const Points& pts,
+                   const Opm::BlackoilCellProperties& cp)
+    {
+        const int n = pts.n;
+        const int np = props.numPhases();
+        std::vector<double> mu(n*np), kr(n*np), dkrds(n*np*np);
+        std::vector<double> A(n*np*np), dAdp(n*np*np), rho(n*np);
+        props.viscosity(n, &pts.p[0], &pts.T[0], &pts.z[0], &pts.cells[0], &mu[0], 0);
+        props.relperm(n, &pts.s[0], &pts.cells[0], &kr[0], &dkrds[0]);
+        props.matrix(n, &pts.p[0], &pts.T[0], &pts.z[0], &pts.cells[0], &A[0], &dAdp[0]);
+        props.density(n, &A[0], &pts.cells[0], &rho[0]);
+
+        int count = 0;
+        for (int i = 0; i < n; ++i) {
+            double totmob = 0.0;
+            for (int row = 0; row < np; ++row) {
+                const double mob = kr[np*i + row] / mu[np*i + row];
+                totmob += mob;
+                count += cp.mob[cp.index(row, i)] != mob;
+                count += cp.B[cp.index(row, i)] != 1.0 / A[np*np*i + np*row + row];
+                count += cp.rho[cp.index(row, i)] != rho[np*i + row];
+                for (int col = 0; col < np; ++col) {
+                    const int k = np*np*i + row + np*col;
+                    count += cp.A[cp.index(row, col, i)] != A[k];
+                    count += cp.dAdp[cp.index(row, col, i)] != dAdp[k];
+                    count += cp.dmobds[cp.index(row, col, i)] != dkrds[k] / mu[np*i + row];
+                }
+            }
+            count += cp.totmob[i] != totmob;
+        }
+        return count;
+    }
+
+    std::shared_ptr<Opm::BlackoilPropertiesFromDeck>
+    createProperties(const UnstructuredGrid& grid)
+    {
+        Opm::ParseMode parseMode;
+        Opm::ParserPtr parser(new Opm::Parser());
+        Opm::DeckConstPtr deck = parser->parseFile("equil_liveoil.DATA", parseMode);
+        Opm::EclipseStateConstPtr eclipseState(new Opm::EclipseState(deck, parseMode));
+        return std::make_shared<Opm::BlackoilPropertiesFromDeck>(deck, eclipseState, grid, false);
+    }
+}
+
+BOOST_AUTO_TEST_CASE (SameAsSeparateCalls)
+{
+    std::shared_ptr<UnstructuredGrid>
+        grid(create_grid_cart3d(1, 1, 20), destroy_grid);
+    const auto props = createProperties(*grid);
+    BOOST_REQUIRE(props->numPhases() == 3);
+
+    // All cells in order, and many points in a subset of the cells.
+    const int nc = grid->number_of_cells;
+    std::vector<int> all_cells(nc), subset(1500);
+    for (int c = 0; c < nc; ++c) {
+        all_cells[c] = c;
+    }
+    for (int i = 0; i < int(subset.size()); ++i) {
+        subset[i] = (nc - 1) - (7*i) % (nc - 3);
+    }
+
+    typedef Opm::BlackoilCellProperties CP;
+    for (const auto& cells : { all_cells, subset }) {
+        const Points pts(cells);
+        CP fused, blocked;
+        props->computeCellProperties(pts.n, &pts.p[0], &pts.T[0], &pts.z[0], &pts.s[0],
+                                     &pts.cells[0], CP::Mobilities | CP::Densities | CP::Derivatives,
+                                     fused);
+        props->BlackoilPropertiesInterface::computeCellProperties(pts.n, &pts.p[0], &pts.T[0],
+                                                                  &pts.z[0], &pts.s[0], &pts.cells[0],
+                                                                  CP::Mobilities | CP::Densities | CP::Derivatives,
+                                                                  blocked);
+        BOOST_CHECK_EQUAL(mismatches(*props, pts, fused), 0);
+        BOOST_CHECK_EQUAL(mismatches(*props, pts, blocked), 0);
+    }
+}
+
+BOOST_AUTO_TEST_CASE (OnlyRequestedQuantities)
+{
+    std::shared_ptr<UnstructuredGrid>
+        grid(create_grid_cart3d(1, 1, 20), destroy_grid);
+    const auto props = createProperties(*grid);
+    const int nc = grid->number_of_cells;
+    const int np = props->numPhases();
+    std::vector<int> cells(nc);
+    for (int c = 0; c < nc; ++c) {
+        cells[c] = c;
+    }
+    const Points pts(cells);
+
+    typedef Opm::BlackoilCellProperties CP;
+    CP cp;
+    props->computeCellProperties(nc, &pts.p[0], &pts.T[0], &pts.z[0], 0, &pts.cells[0],
+                                 CP::Densities | CP::MatrixDerivatives, cp);
+    BOOST_CHECK(cp.mob.empty());
+    BOOST_CHECK(cp.totmob.empty());
+    BOOST_CHECK(cp.dmobds.empty());
+    BOOST_CHECK_EQUAL(cp.A.size(), std::size_t(nc*np*np));
+    BOOST_CHECK_EQUAL(cp.dAdp.size(), std::size_t(nc*np*np));
+    BOOST_CHECK_EQUAL(cp.rho.size(), std::size_t(nc*np));
+
+    props->computeCellProperties(nc, &pts.p[0], &pts.T[0], &pts.z[0], &pts.s[0], &pts.cells[0],
+                                 CP::Mobilities, cp);
+    BOOST_CHECK_EQUAL(cp.mob.size(), std::size_t(nc*np));
+    BOOST_CHECK(cp.dmobds.empty());
+    BOOST_CHECK(cp.A.empty());
+    BOOST_CHECK(cp.rho.empty());
+
+    BOOST_CHECK_THROW(props->computeCellProperties(nc, &pts.p[0], &pts.T[0], &pts.z[0], 0,
+                                                   &pts.cells[0], CP::Mobilities, cp),
+                      std::runtime_error);
+}
@@ -0,0 +1,139 @@
+/*
+  Copyright 2015 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "config.h"
+
+#if HAVE_DYNAMIC_BOOST_TEST
+#define BOOST_TEST_DYN_LINK
+#endif
+
+#define NVERBOSE  // Suppress own messages when throw()ing
+
+#define BOOST_TEST_MODULE BlackoilPropertiesThreadsTest
+#include <boost/test/unit_test.hpp>
+
+#include <opm/core/grid.h>
+#include <opm/core/grid/cart_grid.h>
+#include <opm/core/props/BlackoilPropertiesFromDeck.hpp>
+#include <opm/core/utility/Units.hpp>
+
+#include <opm/parser/eclipse/Parser/Parser.hpp>
+#include <opm/parser/eclipse/Parser/ParseMode.hpp>
+#include <opm/parser/eclipse/Deck/Deck.hpp>
+#include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
+
+#include <memory>
+#include <vector>
+
+namespace
+{
+    struct Results
+    {
+        explicit Results(const int n, const int np)
+            : A(n*np*np), dAdp(n*np*np), mu(n*np), rho(n*np), kr(n*np)
+        {
+        }
+
+        std::vector<double> A;
+        std::vector<double> dAdp;
+        std::vector<double> mu;
+        std::vector<double> rho;
+        std::vector<double> kr;
+    };
+
+    // Evaluate the properties of the points [begin, end).
+    void evaluate(const Opm::BlackoilPropertiesFromDeck& props,
+                  const int begin, const int end,
+                  const std::vector<double>& p,
+                  const std::vector<double>& T,
+                  const std::vector<double>& z,
+                  const std::vector<double>& s,
+                  const std::vector<int>& cells,
+                  Results& res)
+    {
+        const int np = props.numPhases();
+        const int n = end - begin;
+        props.matrix(n, &p[begin], &T[begin], &z[np*begin], &cells[begin],
+                     &res.A[np*np*begin], &res.dAdp[np*np*begin]);
+        props.viscosity(n, &p[begin], &T[begin], &z[np*begin], &cells[begin],
+                        &res.mu[np*begin], 0);
+        props.density(n, &res.A[np*np*begin], &cells[begin], &res.rho[np*begin]);
+        props.relperm(n, &s[np*begin], &cells[begin], &res.kr[np*begin], 0);
+    }
+}
+
+BOOST_AUTO_TEST_CASE (ConcurrentEvaluation)
+{
+    std::shared_ptr<UnstructuredGrid>
+        grid(create_grid_cart3d(1, 1, 20), destroy_grid);
+    Opm::ParseMode parseMode;
+    Opm::ParserPtr parser(new Opm::Parser());
+    Opm::DeckConstPtr deck = parser->parseFile("equil_liveoil.DATA", parseMode);
+    Opm::EclipseStateConstPtr eclipseState(new Opm::EclipseState(deck, parseMode));
+    Opm::BlackoilPropertiesFromDeck props(deck, eclipseState, *grid, false);
+
+    const int np = props.numPhases();
+    BOOST_REQUIRE(np == 3);
+
+    // Points spanning saturated and undersaturated oil.
+    const int n = 2000;
+    std::vector<double> p(n), T(n, 300.0), z(n*np), s(n*np);
+    std::vector<int> cells(n);
+    for (int i = 0; i < n; ++i) {
+        const double w = double(i % 97)/96.0;
+        p[i] = (20.0 + 430.0*w)*Opm::unit::barsa;
+        z[np*i + 0] = 1.0;
+        z[np*i + 1] = 1.0;
+        z[np*i + 2] = 150.0*double(i % 13)/12.0;
+        s[np*i + 0] = 0.2 + 0.6*w;
+        s[np*i + 1] = 0.8 - 0.6*w;
+        s[np*i + 2] = 0.0;
+        cells[i] = i % grid->number_of_cells;
+    }
+
+    Results reference(n, np);
+    evaluate(props, 0, n, p, T, z, s, cells, reference);
+
+    // Evaluate overlapping chunks of varying size from several
+    // threads, each into its own output arrays, and require results
+    // identical to the serial evaluation.
+    const int num_tasks = 400;
+    int mismatches = 0;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(4) reduction(+:mismatches)
+#endif
+    for (int task = 0; task < num_tasks; ++task) {
+        const int begin = (37*task) % (n/2);
+        const int end = begin + 1 + (53*task) % (n/2);
+        Results res(n, np);
+        evaluate(props, begin, end, p, T, z, s, cells, res);
+        for (int i = begin; i < end; ++i) {
+            for (int k = 0; k < np*np; ++k) {
+                mismatches += res.A[np*np*i + k] != reference.A[np*np*i + k];
+                mismatches += res.dAdp[np*np*i + k] != reference.dAdp[np*np*i + k];
+            }
+            for (int k = 0; k < np; ++k) {
+                mismatches += res.mu[np*i + k] != reference.mu[np*i + k];
+                mismatches += res.rho[np*i + k] != reference.rho[np*i + k];
+                mismatches += res.kr[np*i + k] != reference.kr[np*i + k];
+            }
+        }
+    }
+    BOOST_CHECK_EQUAL(mismatches, 0);
+}
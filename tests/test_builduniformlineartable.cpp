@@ -0,0 +1,170 @@
+/*
+  Copyright 2015 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <config.h>
+
+#if defined(HAVE_DYNAMIC_BOOST_TEST)
+#define BOOST_TEST_DYN_LINK
+#endif
+#define NVERBOSE // to suppress our messages when throwing
+
+
+#define BOOST_TEST_MODULE BuildUniformLinearTableTests
+#include <boost/test/unit_test.hpp>
+#include <opm/core/utility/buildUniformLinearTable.hpp>
+#include <opm/core/utility/linearInterpolation.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+    // A table with short and long intervals, like typical PVDO input.
+    void nonuniformTable(std::vector<double>& xv, std::vector<double>& yv)
+    {
+        const double x[] = { 10.0, 10.5, 11.0, 13.0, 20.0, 35.0, 60.0, 100.0 };
+        const double y[] = { 1.30, 1.29, 1.285, 1.27, 1.24, 1.19, 1.15, 1.12 };
+        xv.assign(x, x + sizeof(x)/sizeof(x[0]));
+        yv.assign(y, y + sizeof(y)/sizeof(y[0]));
+    }
+
+    // Maximum deviation between the table and the input, relative to
+    // the largest input value, sampled densely over the domain.
+    double maxDeviation(const std::vector<double>& xv,
+                        const std::vector<double>& yv,
+                        const Opm::UniformTableLinear<double>& table)
+    {
+        double scale = 0.0;
+        for (std::size_t i = 0; i < yv.size(); ++i) {
+            scale = std::max(scale, std::fabs(yv[i]));
+        }
+        double dev = 0.0;
+        const int num = 20000;
+        for (int i = 0; i <= num; ++i) {
+            const double x = xv[0] + (xv.back() - xv[0])*double(i)/double(num);
+            dev = std::max(dev, std::fabs(table(x) - Opm::linearInterpolation(xv, yv, x))/scale);
+        }
+        return dev;
+    }
+}
+
+
+
+BOOST_AUTO_TEST_CASE(exact_on_uniform_input)
+{
+    // Uniformly spaced input is reproduced exactly, with no refinement.
+    const double x[] = { 0.0, 0.5, 1.0, 1.5, 2.0 };
+    const double y[] = { 3.0, -1.0, 2.0, 2.5, 0.0 };
+    const std::vector<double> xv(x, x + 5), yv(y, y + 5);
+    Opm::UniformTableLinear<double> table;
+    const double error = Opm::buildUniformLinearTable(xv, yv, 0.0, 1025, table);
+    BOOST_CHECK_EQUAL(error, 0.0);
+    BOOST_CHECK(table.domain() == std::make_pair(0.0, 2.0));
+    for (int i = 0; i < 5; ++i) {
+        BOOST_CHECK_EQUAL(table(xv[i]), yv[i]);
+    }
+    BOOST_CHECK_EQUAL(table(0.25), 1.0);
+    BOOST_CHECK_EQUAL(table(1.75), 1.25);
+    BOOST_CHECK_EQUAL(table.derivative(0.25), -8.0);
+}
+
+
+
+BOOST_AUTO_TEST_CASE(error_bound)
+{
+    std::vector<double> xv, yv;
+    nonuniformTable(xv, yv);
+    const double tolerances[] = { 1e-2, 1e-3, 1e-4, 1e-6 };
+    double previous = 1.0;
+    for (const double tol : tolerances) {
+        Opm::UniformTableLinear<double> table;
+        const double error = Opm::buildUniformLinearTable(xv, yv, tol, 1 << 20, table);
+        // The tolerance is met, and the reported error is the
+        // largest deviation anywhere in the domain.
+        BOOST_CHECK(error <= tol);
+        BOOST_CHECK(error <= previous);
+        BOOST_CHECK(maxDeviation(xv, yv, table) <= error*(1.0 + 1e-8) + 1e-15);
+        previous = error;
+    }
+
+    // If the size limit is reached first, the error achieved is
+    // reported, and it still bounds the deviation.
+    Opm::UniformTableLinear<double> table;
+    const double error = Opm::buildUniformLinearTable(xv, yv, 1e-12, 17, table);
+    BOOST_CHECK(error > 1e-12);
+    BOOST_CHECK(maxDeviation(xv, yv, table) <= error*(1.0 + 1e-8) + 1e-15);
+}
+
+
+
+BOOST_AUTO_TEST_CASE(out_of_range)
+{
+    std::vector<double> xv, yv;
+    nonuniformTable(xv, yv);
+    Opm::UniformTableLinear<double> table;
+    Opm::buildUniformLinearTable(xv, yv, 1e-6, 1 << 20, table);
+
+    // Extrapolation uses the first and last intervals, which lie on
+    // the first and last input segments since those are longer than
+    // the uniform spacing. So it agrees with linearInterpolation().
+    const double outside[] = { 0.0, 5.0, 9.99, 100.01, 150.0, 1000.0 };
+    for (const double x : outside) {
+        const double expected = Opm::linearInterpolation(xv, yv, x);
+        BOOST_CHECK_CLOSE(table(x), expected, 1e-6);
+        BOOST_CHECK_CLOSE(table.derivative(x),
+                          Opm::linearInterpolationDerivative(xv, yv, x), 1e-6);
+    }
+
+    // With the ClosestValue policy the end values are used instead.
+    table.setLeftPolicy(Opm::UniformTableLinear<double>::ClosestValue);
+    table.setRightPolicy(Opm::UniformTableLinear<double>::ClosestValue);
+    BOOST_CHECK_EQUAL(table(0.0), table(xv[0]));
+    BOOST_CHECK_EQUAL(table(1000.0), table(xv.back()));
+    BOOST_CHECK_EQUAL(table.derivative(0.0), 0.0);
+    BOOST_CHECK_EQUAL(table.derivative(1000.0), 0.0);
+
+    BOOST_CHECK_THROW(table.setLeftPolicy(Opm::UniformTableLinear<double>::Throw),
+                      std::runtime_error);
+}
+
+
+
+BOOST_AUTO_TEST_CASE(extrapolate_policy)
+{
+    // The Extrapolate policy on a plain table continues the first
+    // and last intervals linearly.
+    const double y[] = { 1.0, -1.0, 3.0, 4.0, 2.0 };
+    const std::vector<double> yv(y, y + 5);
+    Opm::UniformTableLinear<double> table(1.0, 11.0, yv);
+    table.setLeftPolicy(Opm::UniformTableLinear<double>::Extrapolate);
+    table.setRightPolicy(Opm::UniformTableLinear<double>::Extrapolate);
+    BOOST_CHECK_EQUAL(table(-1.5), 3.0);
+    BOOST_CHECK_EQUAL(table(13.5), 0.0);
+    BOOST_CHECK_EQUAL(table.derivative(-1.5), -0.8);
+    BOOST_CHECK_EQUAL(table.derivative(13.5), -0.8);
+    // Inside the domain nothing changes.
+    BOOST_CHECK_EQUAL(table(2.25), 0.0);
+    BOOST_CHECK_EQUAL(table(11.0), 2.0);
+
+    // The policies are independent.
+    table.setLeftPolicy(Opm::UniformTableLinear<double>::ClosestValue);
+    BOOST_CHECK_EQUAL(table(-1.5), 1.0);
+    BOOST_CHECK_EQUAL(table(13.5), 0.0);
+}
@@ -0,0 +1,142 @@
+/*
+  Copyright 2015 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "config.h"
+
+#if HAVE_DYNAMIC_BOOST_TEST
+#define BOOST_TEST_DYN_LINK
+#endif
+
+#define NVERBOSE  // Suppress own messages when throw()ing
+
+#define BOOST_TEST_MODULE CachedBlackoilPropertiesTest
+#include <boost/test/unit_test.hpp>
+
+#include <opm/core/props/BlackoilPropertiesBasic.hpp>
+#include <opm/core/props/CachedBlackoilProperties.hpp>
+#include <opm/core/utility/parameters/ParameterGroup.hpp>
+
+#include <memory>
+#include <vector>
+
+namespace
+{
+    const int num_cells = 4;
+    const int np = 2;
+
+    std::shared_ptr<const Opm::BlackoilPropertiesInterface> basicProps()
+    {
+        Opm::parameter::ParameterGroup param;
+        param.disableOutput();
+        param.insertParameter("num_phases", "2");
+        param.insertParameter("relperm_func", "Quadratic");
+        return std::make_shared<Opm::BlackoilPropertiesBasic>(param, 3, num_cells);
+    }
+
+    std::vector<double> saturations(const double sw0)
+    {
+        std::vector<double> s(np*num_cells);
+        for (int c = 0; c < num_cells; ++c) {
+            s[np*c] = sw0 + 0.1*c;
+            s[np*c + 1] = 1.0 - s[np*c];
+        }
+        return s;
+    }
+}
+
+BOOST_AUTO_TEST_CASE(IdenticalToWrapped)
+{
+    std::shared_ptr<const Opm::BlackoilPropertiesInterface> props = basicProps();
+    Opm::CachedBlackoilProperties cached(props);
+    const int cells[num_cells] = { 0, 1, 2, 3 };
+    const std::vector<double> s = saturations(0.2);
+
+    std::vector<double> kr(np*num_cells), dkr(np*np*num_cells);
+    props->relperm(num_cells, &s[0], cells, &kr[0], &dkr[0]);
+    for (int repeat = 0; repeat < 2; ++repeat) {
+        std::vector<double> ckr(np*num_cells), cdkr(np*np*num_cells);
+        cached.relperm(num_cells, &s[0], cells, &ckr[0], &cdkr[0]);
+        BOOST_CHECK(ckr == kr);
+        BOOST_CHECK(cdkr == dkr);
+    }
+    const Opm::CachedBlackoilProperties::Statistics& stats
+        = cached.statistics(Opm::CachedBlackoilProperties::Relperm);
+    BOOST_CHECK_EQUAL(stats.hits, std::size_t(num_cells));
+    BOOST_CHECK_EQUAL(stats.misses, std::size_t(num_cells));
+    BOOST_CHECK_CLOSE(stats.hitRate(), 0.5, 1e-12);
+}
+
+BOOST_AUTO_TEST_CASE(OnlyChangedCellsRecomputed)
+{
+    std::shared_ptr<const Opm::BlackoilPropertiesInterface> props = basicProps();
+    Opm::CachedBlackoilProperties cached(props);
+    const int cells[num_cells] = { 0, 1, 2, 3 };
+    std::vector<double> s = saturations(0.2);
+    std::vector<double> kr(np*num_cells);
+    cached.relperm(num_cells, &s[0], cells, &kr[0], 0);
+
+    // Change cell 2, and ask for derivatives, which were not computed.
+    s[np*2] += 0.05;
+    s[np*2 + 1] -= 0.05;
+    cached.resetStatistics();
+    cached.relperm(num_cells, &s[0], cells, &kr[0], 0);
+    BOOST_CHECK_EQUAL(cached.statistics(Opm::CachedBlackoilProperties::Relperm).misses, std::size_t(1));
+    std::vector<double> dkr(np*np*num_cells);
+    cached.relperm(num_cells, &s[0], cells, &kr[0], &dkr[0]);
+    BOOST_CHECK_EQUAL(cached.statistics(Opm::CachedBlackoilProperties::Relperm).misses,
+                      std::size_t(1 + num_cells));
+
+    std::vector<double> expected(np*num_cells);
+    props->relperm(num_cells, &s[0], cells, &expected[0], 0);
+    BOOST_CHECK(kr == expected);
+
+    // Cells out of range are passed through, but not remembered.
+    const int other[2] = { 3, num_cells };
+    cached.resetStatistics();
+    cached.relperm(2, &s[np*2], other, &kr[0], 0);
+    cached.relperm(2, &s[np*2], other, &kr[0], 0);
+    BOOST_CHECK_EQUAL(cached.statistics(Opm::CachedBlackoilProperties::Relperm).misses, std::size_t(3));
+
+    cached.invalidate();
+    cached.resetStatistics();
+    cached.relperm(num_cells, &s[0], cells, &kr[0], 0);
+    BOOST_CHECK_EQUAL(cached.statistics(Opm::CachedBlackoilProperties::Relperm).hits, std::size_t(0));
+}
+
+BOOST_AUTO_TEST_CASE(Tolerance)
+{
+    Opm::CachedBlackoilProperties cached(basicProps(), 1e-8);
+    const int cells[num_cells] = { 0, 1, 2, 3 };
+    std::vector<double> p(num_cells, 1e7), T(num_cells, 300.0), z(np*num_cells, 1.0);
+    std::vector<double> mu(np*num_cells), A(np*np*num_cells);
+    cached.viscosity(num_cells, &p[0], &T[0], &z[0], cells, &mu[0], 0);
+    cached.matrix(num_cells, &p[0], &T[0], &z[0], cells, &A[0], 0);
+
+    p[0] *= 1.0 + 1e-10;
+    p[1] *= 1.0 + 1e-6;
+    cached.viscosity(num_cells, &p[0], &T[0], &z[0], cells, &mu[0], 0);
+    cached.matrix(num_cells, &p[0], &T[0], &z[0], cells, &A[0], 0);
+    BOOST_CHECK_EQUAL(cached.statistics(Opm::CachedBlackoilProperties::Viscosity).hits, std::size_t(3));
+    BOOST_CHECK_EQUAL(cached.statistics(Opm::CachedBlackoilProperties::Matrix).hits, std::size_t(3));
+
+    // Calls without cell indices are not cached.
+    cached.viscosity(num_cells, &p[0], &T[0], &z[0], 0, &mu[0], 0);
+    BOOST_CHECK_EQUAL(cached.statistics(Opm::CachedBlackoilProperties::Viscosity).misses,
+                      std::size_t(num_cells + 1));
+}
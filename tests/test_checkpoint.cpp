@@ -0,0 +1,257 @@
+/*
+  Copyright 2015 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "config.h"
+
+#if HAVE_DYNAMIC_BOOST_TEST
+#define BOOST_TEST_DYN_LINK
+#endif
+
+#define NVERBOSE  // Suppress own messages when throw()ing
+
+#define BOOST_TEST_MODULE CheckpointTest
+#include <boost/test/unit_test.hpp>
+
+#include <opm/core/io/CheckpointFile.hpp>
+#include <opm/core/simulator/BlackoilState.hpp>
+#include <opm/core/simulator/SimulatorTimer.hpp>
+#include <opm/core/simulator/WellState.hpp>
+#include <opm/core/utility/parameters/ParameterGroup.hpp>
+#include <opm/core/wells.h>
+#include <opm/core/well_controls.h>
+
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+    struct TempFile
+    {
+        TempFile()
+            : path(boost::filesystem::temp_directory_path()
+                   / boost::filesystem::unique_path("test_checkpoint-%%%%-%%%%.bin"))
+        {
+        }
+        ~TempFile()
+        {
+            boost::filesystem::remove(path);
+        }
+        std::string name() const
+        {
+            return path.string();
+        }
+        boost::filesystem::path path;
+    };
+
+    // Two wells with 2 and 1 perforations, bhp controlled.
+    std::shared_ptr<Wells> createWells()
+    {
+        std::shared_ptr<Wells> wells(create_wells(3, 2, 3), destroy_wells);
+        const double comp[3] = { 1.0, 0.0, 0.0 };
+        const int cells0[2] = { 0, 1 };
+        const int cells1[1] = { 5 };
+        const double wi[2] = { 1.0, 1.0 };
+        add_well(INJECTOR, 0.0, 2, comp, cells0, wi, "INJ", wells.get());
+        add_well(PRODUCER, 0.0, 1, comp, cells1, wi, "PROD", wells.get());
+        for (int w = 0; w < 2; ++w) {
+            well_controls_add_new(BHP, 1e7*(w + 1), 0.0, -1, NULL, wells->ctrls[w]);
+            well_controls_set_current(wells->ctrls[w], 0);
+        }
+        return wells;
+    }
+
+    void initTimer(Opm::SimulatorTimer& timer, const int num_steps)
+    {
+        Opm::parameter::ParameterGroup param;
+        param.insertParameter("num_psteps", std::to_string(num_steps));
+        param.insertParameter("stepsize_days", "10");
+        timer.init(param);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(RoundTrip)
+{
+    TempFile file;
+    std::shared_ptr<Wells> wells = createWells();
+
+    Opm::BlackoilState state;
+    state.init(6, 7, 3);
+    for (std::size_t i = 0; i < state.cellData().size(); ++i) {
+        std::vector<double>& d = state.cellData()[i];
+        for (std::size_t j = 0; j < d.size(); ++j) {
+            d[j] = 100.0*i + 0.5*j;
+        }
+    }
+    for (std::size_t j = 0; j < state.faceflux().size(); ++j) {
+        state.faceflux()[j] = -1.0*j;
+    }
+    Opm::WellState well_state;
+    well_state.init(wells.get(), state);
+    well_state.wellRates()[4] = 42.0;
+    well_state.perfRates()[2] = -3.0;
+    well_state.perfPress()[1] = 2e7;
+    Opm::SimulatorTimer timer;
+    initTimer(timer, 5);
+    ++timer;
+    ++timer;
+    std::vector<double> history(4);
+    history[0] = 86400.0;
+    history[1] = 0.1;
+    history[2] = 0.2;
+    history[3] = 0.3;
+
+    Opm::writeCheckpoint(file.name(), timer, state, well_state, history);
+    BOOST_CHECK(!boost::filesystem::exists(file.name() + ".tmp"));
+
+    Opm::BlackoilState restored;
+    restored.init(6, 7, 3);
+    Opm::WellState restored_well_state;
+    restored_well_state.init(wells.get(), restored);
+    Opm::SimulatorTimer restored_timer;
+    initTimer(restored_timer, 5);
+    std::vector<double> restored_history;
+    Opm::readCheckpoint(file.name(), restored_timer, restored, restored_well_state, &restored_history);
+
+    BOOST_CHECK(restored.cellData() == state.cellData());
+    BOOST_CHECK(restored.faceData() == state.faceData());
+    BOOST_CHECK(restored_well_state.bhp() == well_state.bhp());
+    BOOST_CHECK(restored_well_state.thp() == well_state.thp());
+    BOOST_CHECK(restored_well_state.temperature() == well_state.temperature());
+    BOOST_CHECK(restored_well_state.wellRates() == well_state.wellRates());
+    BOOST_CHECK(restored_well_state.perfRates() == well_state.perfRates());
+    BOOST_CHECK(restored_well_state.perfPress() == well_state.perfPress());
+    BOOST_CHECK_EQUAL(restored_timer.currentStepNum(), 2);
+    BOOST_CHECK_CLOSE(restored_timer.simulationTimeElapsed(), timer.simulationTimeElapsed(), 1e-12);
+    BOOST_CHECK(restored_history == history);
+}
+
+BOOST_AUTO_TEST_CASE(Mismatch)
+{
+    TempFile file;
+    std::shared_ptr<Wells> wells = createWells();
+    Opm::BlackoilState state;
+    state.init(6, 7, 3);
+    // Nothing is carried over from a well state without identities.
+    const Opm::WellState none;
+    Opm::WellState well_state;
+    well_state.init(wells.get(), std::vector<int>{ 0, 1 }, state, none);
+    Opm::SimulatorTimer timer;
+    initTimer(timer, 5);
+    Opm::writeCheckpoint(file.name(), timer, state, well_state);
+
+    // Other grid.
+    {
+        Opm::BlackoilState other;
+        other.init(5, 7, 3);
+        BOOST_CHECK_THROW(Opm::readCheckpoint(file.name(), timer, other, well_state), std::runtime_error);
+    }
+    // No wells.
+    {
+        Opm::WellState other;
+        other.init(0, state);
+        BOOST_CHECK_THROW(Opm::readCheckpoint(file.name(), timer, state, other), std::runtime_error);
+    }
+
+    // A failed read leaves the states and the timer unchanged, also
+    // when the mismatch is found after the arrays have been read.
+    Opm::BlackoilState changed;
+    changed.init(6, 7, 3);
+    changed.pressure()[2] = 1e5;
+    changed.faceflux()[3] = 0.5;
+    // Other wells, with the same numbers of wells and perforations.
+    {
+        Opm::WellState other;
+        other.init(wells.get(), std::vector<int>{ 0, 2 }, changed, none);
+        other.bhp()[1] = 3e7;
+        Opm::SimulatorTimer other_timer;
+        initTimer(other_timer, 5);
+        ++other_timer;
+        Opm::BlackoilState before = changed;
+        Opm::WellState other_before = other;
+        BOOST_CHECK_THROW(Opm::readCheckpoint(file.name(), other_timer, changed, other), std::runtime_error);
+        BOOST_CHECK(changed.cellData() == before.cellData());
+        BOOST_CHECK(changed.faceData() == before.faceData());
+        BOOST_CHECK(other.bhp() == other_before.bhp());
+        BOOST_CHECK_EQUAL(other_timer.currentStepNum(), 1);
+    }
+    // Other schedule.
+    {
+        Opm::SimulatorTimer other;
+        initTimer(other, 4);
+        ++other;
+        Opm::BlackoilState before = changed;
+        Opm::WellState other_state;
+        other_state.init(wells.get(), std::vector<int>{ 0, 1 }, changed, none);
+        other_state.perfPress()[2] = 2e7;
+        Opm::WellState other_before = other_state;
+        BOOST_CHECK_THROW(Opm::readCheckpoint(file.name(), other, changed, other_state), std::runtime_error);
+        BOOST_CHECK(changed.cellData() == before.cellData());
+        BOOST_CHECK(changed.faceData() == before.faceData());
+        BOOST_CHECK(other_state.perfPress() == other_before.perfPress());
+        BOOST_CHECK_EQUAL(other.currentStepNum(), 1);
+    }
+    // No history was written.
+    std::vector<double> history(1, 1.0);
+    Opm::readCheckpoint(file.name(), timer, state, well_state, &history);
+    BOOST_CHECK(history.empty());
+}
+
+BOOST_AUTO_TEST_CASE(Arrays)
+{
+    TempFile file;
+    std::vector<int> ints(3, 7);
+    std::vector<double> doubles(1001, 0.25);
+    {
+        Opm::CheckpointWriter writer;
+        writer.add("ints", ints);
+        writer.add("doubles", doubles);
+        BOOST_CHECK_THROW(writer.add("ints", ints), std::runtime_error);
+        BOOST_CHECK_THROW(writer.add(std::string(40, 'x'), ints), std::runtime_error);
+        writer.write(file.name());
+    }
+
+    Opm::CheckpointReader reader(file.name());
+    BOOST_CHECK(reader.has("ints"));
+    BOOST_CHECK(!reader.has("other"));
+    BOOST_CHECK_EQUAL(reader.size("doubles"), doubles.size());
+    std::vector<double> d;
+    reader.read("doubles", d);
+    BOOST_CHECK(d == doubles);
+    std::vector<int> i;
+    reader.read("ints", i);
+    BOOST_CHECK(i == ints);
+    BOOST_CHECK_THROW(reader.read("ints", d), std::runtime_error);
+    BOOST_CHECK_THROW(reader.read("other", i), std::runtime_error);
+
+    // Truncated file.
+    boost::filesystem::resize_file(file.path, boost::filesystem::file_size(file.path) - 8);
+    BOOST_CHECK_THROW(Opm::CheckpointReader truncated(file.name()), std::runtime_error);
+
+    // Not a checkpoint file.
+    {
+        std::ofstream os(file.name().c_str());
+        os << "PRESSURE 1.0 2.0 3.0 4.0 5.0 6.0 7.0 8.0 9.0\n";
+    }
+    BOOST_CHECK_THROW(Opm::CheckpointReader other(file.name()), std::runtime_error);
+}
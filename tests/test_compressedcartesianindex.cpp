@@ -0,0 +1,88 @@
+/*
+  Copyright 2015 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "config.h"
+
+#if HAVE_DYNAMIC_BOOST_TEST
+#define BOOST_TEST_DYN_LINK
+#endif
+
+#define NVERBOSE  // Suppress own messages when throw()ing
+
+#define BOOST_TEST_MODULE CompressedCartesianIndexTest
+#include <boost/test/unit_test.hpp>
+
+#include <opm/core/utility/CompressedCartesianIndex.hpp>
+
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+    void checkInverse(const Opm::CompressedCartesianIndex& index)
+    {
+        int active = 0;
+        for (int ci = -1; ci <= index.cartesianSize(); ++ci) {
+            const int cell = index.compressedIndex(ci);
+            if (cell >= 0) {
+                BOOST_CHECK_EQUAL(index.cartesianIndex(cell), ci);
+                ++active;
+            }
+        }
+        BOOST_CHECK_EQUAL(active, index.numCells());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(Identity)
+{
+    Opm::CompressedCartesianIndex index(5, 0);
+    BOOST_CHECK_EQUAL(index.numCells(), 5);
+    BOOST_CHECK_EQUAL(index.cartesianSize(), 5);
+    for (int c = 0; c < 5; ++c) {
+        BOOST_CHECK_EQUAL(index.cartesianIndex(c), c);
+        BOOST_CHECK_EQUAL(index.compressedIndex(c), c);
+    }
+    checkInverse(index);
+}
+
+BOOST_AUTO_TEST_CASE(DenseAndSparse)
+{
+    // Unordered global_cell, as in grids that are not in Eclipse order.
+    const int global_cell[] = { 7, 2, 9, 4 };
+    const std::vector<int> expected_order = { 1, 3, 0, 2 };
+
+    Opm::CompressedCartesianIndex dense(4, global_cell, 12);
+    BOOST_CHECK_EQUAL(dense.cartesianSize(), 12);
+    BOOST_CHECK_EQUAL(dense.compressedIndex(9), 2);
+    BOOST_CHECK_EQUAL(dense.compressedIndex(3), -1);
+    BOOST_CHECK(dense.cellsInCartesianOrder() == expected_order);
+    checkInverse(dense);
+
+    Opm::CompressedCartesianIndex sparse(4, global_cell, 1000);
+    BOOST_CHECK_EQUAL(sparse.compressedIndex(9), 2);
+    BOOST_CHECK_EQUAL(sparse.compressedIndex(3), -1);
+    BOOST_CHECK_EQUAL(sparse.compressedIndex(1000), -1);
+    BOOST_CHECK(sparse.cellsInCartesianOrder() == expected_order);
+    checkInverse(sparse);
+
+    Opm::CompressedCartesianIndex deduced(4, global_cell);
+    BOOST_CHECK_EQUAL(deduced.cartesianSize(), 10);
+
+    BOOST_CHECK_THROW(Opm::CompressedCartesianIndex(4, global_cell, 8), std::runtime_error);
+}
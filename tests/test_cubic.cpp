@@ -49,6 +49,7 @@
 
 /* --- our own headers --- */
 #include <opm/core/utility/MonotCubicInterpolator.hpp>
+#include <opm/core/utility/MonotCubicTable.hpp>
 using namespace Opm;
 
 BOOST_AUTO_TEST_SUITE ()
@@ -70,4 +71,33 @@ BOOST_AUTO_TEST_CASE (cubic)
     BOOST_REQUIRE_CLOSE (interp.evaluate(4.0), 2., 0.00001);
 }
 
+BOOST_AUTO_TEST_CASE (table)
+{
+    const int num_v = 6;
+    double xv[num_v] = {3.0, 0.0, 1.0, 2.0, 5.0, 4.5};
+    double fv[num_v] = {1.0, 10.0, 21.0, 2.0, -4.0, 0.5};
+    std::vector<double> x(xv, xv + num_v);
+    std::vector<double> f(fv, fv + num_v);
+    MonotCubicInterpolator interp(x, f);
+    MonotCubicTable table(interp);
+    BOOST_CHECK_EQUAL (table.size(), num_v);
+
+    // Both single and batched evaluation must be identical to the
+    // interpolator, for sorted and unsorted points.
+    std::vector<double> xs;
+    for (int i = 0; i <= 140; ++i) {
+        xs.push_back(-1.0 + 0.05*i);
+    }
+    for (int i = 0; i <= 140; ++i) {
+        xs.push_back(-1.0 + 0.05*((37*i) % 141));
+    }
+    xs.insert(xs.end(), x.begin(), x.end());
+    std::vector<double> fs(xs.size());
+    table.evaluate(xs.size(), &xs[0], &fs[0]);
+    for (std::size_t i = 0; i < xs.size(); ++i) {
+        BOOST_CHECK_EQUAL (table(xs[i]), interp.evaluate(xs[i]));
+        BOOST_CHECK_EQUAL (fs[i], interp.evaluate(xs[i]));
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,187 @@
+/*
+  Copyright 2015 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "config.h"
+
+#if HAVE_DYNAMIC_BOOST_TEST
+#define BOOST_TEST_DYN_LINK
+#endif
+
+#define NVERBOSE  // Suppress own messages when throw()ing
+
+#define BOOST_TEST_MODULE EclipseBinaryFileTest
+#include <boost/test/unit_test.hpp>
+
+#include <opm/core/io/eclipse/EclipseBinaryFile.hpp>
+
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+    struct TempFile
+    {
+        TempFile()
+            : path(boost::filesystem::temp_directory_path()
+                   / boost::filesystem::unique_path("test_eclipsebinaryfile-%%%%-%%%%.UNRST"))
+        {
+        }
+        ~TempFile()
+        {
+            boost::filesystem::remove(path);
+        }
+        std::string name() const
+        {
+            return path.string();
+        }
+        boost::filesystem::path path;
+    };
+}
+
+BOOST_AUTO_TEST_CASE(RoundTrip)
+{
+    TempFile file;
+
+    // Sizes chosen to span several data records.
+    std::vector<int> ints(2500);
+    std::vector<float> floats(1000);
+    std::vector<double> doubles(1001);
+    std::vector<std::string> strings(211);
+    std::vector<bool> logicals(7);
+    for (std::size_t i = 0; i < ints.size(); ++i) {
+        ints[i] = int(i) - 1000;
+    }
+    for (std::size_t i = 0; i < floats.size(); ++i) {
+        floats[i] = 0.5f*i;
+    }
+    for (std::size_t i = 0; i < doubles.size(); ++i) {
+        doubles[i] = 1.0/(i + 1);
+    }
+    for (std::size_t i = 0; i < strings.size(); ++i) {
+        strings[i] = std::string(i % 9, 'A' + i % 26);
+    }
+    for (std::size_t i = 0; i < logicals.size(); ++i) {
+        logicals[i] = i % 3 == 0;
+    }
+    {
+        Opm::EclipseBinaryWriter writer(file.name());
+        writer.write("INTS", ints);
+        writer.writeMessage("STARTSOL");
+        writer.write("FLOATS", floats);
+        writer.write("DOUBLES", doubles);
+        writer.write("STRINGS", strings);
+        writer.writeLogical("LOGICALS", logicals);
+        writer.write("EMPTY", std::vector<int>());
+    }
+
+    // The first record is the 16 byte header of INTS.
+    {
+        std::ifstream is(file.name().c_str(), std::ios::binary);
+        char head[24];
+        is.read(head, 24);
+        BOOST_CHECK_EQUAL(std::string(head, 4), std::string("\0\0\0\x10", 4));
+        BOOST_CHECK_EQUAL(std::string(head + 4, 8), "INTS    ");
+        BOOST_CHECK_EQUAL(std::string(head + 12, 4), std::string("\0\0\x09\xc4", 4));
+        BOOST_CHECK_EQUAL(std::string(head + 16, 4), "INTE");
+    }
+
+    Opm::EclipseBinaryReader reader(file.name());
+    BOOST_REQUIRE(reader.next());
+    BOOST_CHECK_EQUAL(reader.name(), "INTS");
+    BOOST_CHECK(reader.getInt() == ints);
+    BOOST_REQUIRE(reader.next());
+    BOOST_CHECK_EQUAL(reader.name(), "STARTSOL");
+    BOOST_CHECK_EQUAL(reader.type(), "MESS");
+    BOOST_CHECK_EQUAL(reader.size(), 0);
+    BOOST_REQUIRE(reader.next());
+    BOOST_CHECK_EQUAL(reader.type(), "REAL");
+    BOOST_CHECK(reader.getDouble() == std::vector<double>(floats.begin(), floats.end()));
+    BOOST_REQUIRE(reader.next());
+    BOOST_CHECK_EQUAL(reader.type(), "DOUB");
+    BOOST_CHECK(reader.getDouble() == doubles);
+    BOOST_CHECK_THROW(reader.getInt(), std::runtime_error);
+    BOOST_REQUIRE(reader.next());
+    BOOST_CHECK(reader.getChar() == strings);
+    BOOST_REQUIRE(reader.next());
+    BOOST_CHECK(reader.getLogical() == logicals);
+    BOOST_REQUIRE(reader.next());
+    BOOST_CHECK_EQUAL(reader.name(), "EMPTY");
+    BOOST_CHECK(reader.getInt().empty());
+    BOOST_CHECK(!reader.next());
+}
+
+BOOST_AUTO_TEST_CASE(GatheredCellData)
+{
+    TempFile file;
+
+    // Two components per cell, write the second one of cells 3, 0, 4
+    // in bars.
+    std::vector<double> field(10);
+    for (std::size_t i = 0; i < field.size(); ++i) {
+        field[i] = 1e5*i + 1.0;
+    }
+    const int cell_data[3] = { 3, 0, 4 };
+    const std::vector<int> cells(cell_data, cell_data + 3);
+    {
+        Opm::EclipseBinaryWriter writer(file.name());
+        writer.writeCellData("PRESSURE", field, cells, 2, 1, 1e5);
+        writer.writeCellData("TEMP", field, cells, 2, 0, 1.0, 273.15);
+    }
+    // Appending keeps the keywords already written.
+    {
+        Opm::EclipseBinaryWriter writer(file.name(), true);
+        writer.writeMessage("ENDSOL");
+    }
+
+    Opm::EclipseBinaryReader reader(file.name());
+    BOOST_REQUIRE(reader.next());
+    BOOST_CHECK_EQUAL(reader.type(), "REAL");
+    const std::vector<double> pressure = reader.getDouble();
+    BOOST_REQUIRE_EQUAL(pressure.size(), 3u);
+    for (int i = 0; i < 3; ++i) {
+        BOOST_CHECK_EQUAL(pressure[i], double(float(field[2*cells[i] + 1]/1e5)));
+    }
+    BOOST_REQUIRE(reader.next());
+    const std::vector<double> temperature = reader.getDouble();
+    for (int i = 0; i < 3; ++i) {
+        BOOST_CHECK_EQUAL(temperature[i], double(float(field[2*cells[i]] - 273.15)));
+    }
+    BOOST_REQUIRE(reader.next());
+    BOOST_CHECK_EQUAL(reader.name(), "ENDSOL");
+    BOOST_CHECK(!reader.next());
+}
+
+BOOST_AUTO_TEST_CASE(InvalidInput)
+{
+    TempFile file;
+    {
+        Opm::EclipseBinaryWriter writer(file.name());
+        BOOST_CHECK_THROW(writer.write("TOOLONGNAME", std::vector<int>(1)), std::runtime_error);
+        BOOST_CHECK_THROW(writer.write("ZWEL", std::vector<std::string>(1, "TOOLONGNAME")), std::runtime_error);
+        writer.write("INTS", std::vector<int>(10, 1));
+    }
+    // Truncate the last record.
+    boost::filesystem::resize_file(file.path, boost::filesystem::file_size(file.path) - 2);
+    Opm::EclipseBinaryReader reader(file.name());
+    BOOST_CHECK_THROW(reader.next(), std::runtime_error);
+}
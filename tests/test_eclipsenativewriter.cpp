@@ -0,0 +1,281 @@
+/*
+  Copyright 2015 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "config.h"
+
+#if HAVE_DYNAMIC_BOOST_TEST
+#define BOOST_TEST_DYN_LINK
+#endif
+
+#define BOOST_TEST_MODULE EclipseNativeWriterTest
+#include <boost/test/unit_test.hpp>
+
+#include <opm/core/io/eclipse/EclipseNativeWriter.hpp>
+#include <opm/core/io/eclipse/EclipseBinaryFile.hpp>
+#include <opm/core/grid/GridManager.hpp>
+#include <opm/core/grid.h>
+#include <opm/core/props/phaseUsageFromDeck.hpp>
+#include <opm/core/simulator/BlackoilState.hpp>
+#include <opm/core/simulator/WellState.hpp>
+#include <opm/core/simulator/SimulatorTimer.hpp>
+#include <opm/core/utility/parameters/ParameterGroup.hpp>
+#include <opm/core/utility/Units.hpp>
+#include <opm/core/wells.h>
+#include <opm/core/wells/WellsManager.hpp>
+
+#include <opm/parser/eclipse/Parser/Parser.hpp>
+#include <opm/parser/eclipse/Deck/Deck.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/EclipseGrid.hpp>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace
+{
+    const char* deckString =
+        "RUNSPEC\n"
+        "UNIFOUT\n"
+        "OIL\n"
+        "GAS\n"
+        "WATER\n"
+        "METRIC\n"
+        "DIMENS\n"
+        "3 3 3/\n"
+        "GRID\n"
+        "DXV\n"
+        "1.0 2.0 3.0 /\n"
+        "DYV\n"
+        "4.0 5.0 6.0 /\n"
+        "DZV\n"
+        "7.0 8.0 9.0 /\n"
+        "TOPS\n"
+        "9*100 /\n"
+        "PROPS\n"
+        "PORO\n"
+        "27*0.3 /\n"
+        "PERMX\n"
+        "27*1 /\n"
+        "SOLUTION\n"
+        "RPTRST\n"
+        "BASIC=2\n"
+        "/\n"
+        "SCHEDULE\n"
+        "WELSPECS\n"
+        "'INJ' 'G' 1 1 2000 'GAS' /\n"
+        "'PROD' 'G' 3 3 1000 'OIL' /\n"
+        "/\n"
+        "COMPDAT\n"
+        "'INJ' 1 1 1 1 'OPEN' 1 10.0 0.5 /\n"
+        "'PROD' 3 3 3 3 'OPEN' 0 10.0 0.5 /\n"
+        "/\n"
+        "WCONINJE\n"
+        "'INJ' 'GAS' 'OPEN' 'RATE' 1000 /\n"
+        "/\n"
+        "WCONPROD\n"
+        "'PROD' 'OPEN' 'ORAT' 50 4* 100 /\n"
+        "/\n"
+        "TSTEP\n"
+        "1.0 2.0 3.0 4.0 /\n";
+
+    void fillState(const int step, Opm::BlackoilState& state)
+    {
+        const int numCells = state.pressure().size();
+        for (int cell = 0; cell < numCells; ++cell) {
+            state.pressure()[cell] = step*1e5 + 1e4 + cell;
+            for (int phase = 0; phase < 3; ++phase) {
+                state.saturation()[3*cell + phase] = 0.1*phase + 0.001*cell + 0.01*step;
+            }
+        }
+    }
+
+    // Bottom hole pressures in bars and surface rates in m^3/day,
+    // the latter positive for injection.
+    double bhp(const std::string& well, const int step)
+    {
+        return (well == "INJ" ? 200.0 : 100.0) + step;
+    }
+
+    double rate(const std::string& well, const char phase, const int step)
+    {
+        if (well == "INJ") {
+            return phase == 'G' ? 1000.0 + 10.0*step : 0.0;
+        }
+        return phase == 'O' ? -(50.0 + step) : (phase == 'W' ? -(20.0 + 2.0*step) : -(500.0 + step));
+    }
+
+    void fillWellState(const int step, const Wells& wells,
+                       const Opm::PhaseUsage& phaseUsage, Opm::WellState& wellState)
+    {
+        using namespace Opm::unit;
+        const char phaseLetter[] = { 'W', 'O', 'G' };
+        const int np = phaseUsage.num_phases;
+        for (int w = 0; w < wells.number_of_wells; ++w) {
+            wellState.bhp()[w] = bhp(wells.name[w], step)*barsa;
+            for (int phase = 0; phase < Opm::BlackoilPhases::MaxNumPhases; ++phase) {
+                const double q = rate(wells.name[w], phaseLetter[phase], step);
+                wellState.wellRates()[np*w + phaseUsage.phase_pos[phase]] = q*cubic(meter)/day;
+            }
+        }
+    }
+
+    // The value of a summary variable in the deck units.
+    double expectedSummary(const std::string& keyword, const std::string& well, const int step)
+    {
+        if (keyword == "WBHP") {
+            return bhp(well, step);
+        }
+        const double q = rate(well, keyword[1], step);
+        return keyword[2] == 'I' ? std::max(q, 0.0) : std::max(-q, 0.0);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(WriteAndReadBack)
+{
+    Opm::ParseMode parseMode;
+    Opm::ParserConstPtr parser(new Opm::Parser());
+    Opm::DeckConstPtr deck = parser->parseString(deckString, parseMode);
+    Opm::EclipseStatePtr eclipseState(new Opm::EclipseState(deck, parseMode));
+    Opm::EclipseGridConstPtr eclGrid = eclipseState->getEclipseGrid();
+    Opm::GridManager gridManager(eclGrid);
+    const UnstructuredGrid& grid = *gridManager.c_grid();
+    const int numCells = grid.number_of_cells;
+
+    Opm::parameter::ParameterGroup params;
+    params.insertParameter("deck_filename", "native.data");
+    const Opm::PhaseUsage phaseUsage = Opm::phaseUsageFromDeck(deck);
+    const int waterPos = phaseUsage.phase_pos[Opm::BlackoilPhases::Aqua];
+    Opm::EclipseNativeWriter writer(params, eclipseState, phaseUsage, numCells, grid.global_cell);
+
+    Opm::SimulatorTimer timer;
+    timer.init(eclipseState->getSchedule()->getTimeMap());
+    writer.writeInit(timer);
+
+    // Grid.
+    {
+        std::vector<double> coord;
+        eclGrid->exportCOORD(coord);
+        Opm::EclipseBinaryReader reader("NATIVE.EGRID");
+        bool foundCoord = false;
+        while (reader.next()) {
+            if (reader.name() == "GRIDHEAD") {
+                const std::vector<int> gridhead = reader.getInt();
+                BOOST_CHECK_EQUAL(gridhead[1], 3);
+                BOOST_CHECK_EQUAL(gridhead[2], 3);
+                BOOST_CHECK_EQUAL(gridhead[3], 3);
+            } else if (reader.name() == "COORD") {
+                const std::vector<double> result = reader.getDouble();
+                BOOST_REQUIRE_EQUAL(result.size(), coord.size());
+                for (std::size_t i = 0; i < coord.size(); ++i) {
+                    BOOST_CHECK_CLOSE(result[i], coord[i], 1e-5);
+                }
+                foundCoord = true;
+            } else if (reader.name() == "ACTNUM") {
+                BOOST_CHECK(reader.getInt() == std::vector<int>(27, 1));
+            }
+        }
+        BOOST_CHECK(foundCoord);
+    }
+
+    Opm::BlackoilState state;
+    state.init(grid, 3);
+    Opm::WellsManager wellsManager(eclipseState, 0, grid, 0);
+    BOOST_REQUIRE_EQUAL(wellsManager.c_wells()->number_of_wells, 2);
+    Opm::WellState wellState;
+    int numSteps = 0;
+    for (; timer.currentStepNum() < timer.numSteps(); ++timer, ++numSteps) {
+        const int step = timer.currentStepNum();
+        fillState(step, state);
+        wellState.init(wellsManager.c_wells(), state);
+        fillWellState(step, *wellsManager.c_wells(), phaseUsage, wellState);
+        writer.writeTimeStep(timer, state, wellState, false);
+    }
+
+    // Restart: the solution of every step, in bars.
+    {
+        Opm::EclipseBinaryReader reader("NATIVE.UNRST");
+        Opm::BlackoilState expected;
+        expected.init(grid, 3);
+        int seqnum = -1;
+        int numRestartSteps = 0;
+        while (reader.next()) {
+            if (reader.name() == "SEQNUM") {
+                seqnum = reader.getInt()[0];
+                fillState(seqnum, expected);
+                ++numRestartSteps;
+            } else if (reader.name() == "PRESSURE") {
+                const std::vector<double> result = reader.getDouble();
+                BOOST_REQUIRE_EQUAL(int(result.size()), numCells);
+                for (int cell = 0; cell < numCells; ++cell) {
+                    BOOST_CHECK_CLOSE(result[cell]*1e5, expected.pressure()[cell], 1e-4);
+                }
+            } else if (reader.name() == "SWAT") {
+                const std::vector<double> result = reader.getDouble();
+                BOOST_REQUIRE_EQUAL(int(result.size()), numCells);
+                for (int cell = 0; cell < numCells; ++cell) {
+                    BOOST_CHECK_CLOSE(result[cell], expected.saturation()[3*cell + waterPos], 1e-4);
+                }
+            }
+        }
+        BOOST_CHECK_EQUAL(numRestartSteps, numSteps);
+    }
+
+    // Summary: TIME and the well variables, one PARAMS per step.
+    {
+        Opm::EclipseBinaryReader smspec("NATIVE.SMSPEC");
+        std::vector<std::string> keywords;
+        std::vector<std::string> wells;
+        while (smspec.next()) {
+            if (smspec.name() == "KEYWORDS") {
+                keywords = smspec.getChar();
+            } else if (smspec.name() == "WGNAMES") {
+                wells = smspec.getChar();
+            }
+        }
+        BOOST_REQUIRE_EQUAL(keywords.size(), 15u);
+        BOOST_CHECK_EQUAL(keywords[0], "TIME");
+        BOOST_CHECK_EQUAL(keywords[1], "WBHP");
+        BOOST_CHECK_EQUAL(wells[1], "INJ");
+        BOOST_CHECK_EQUAL(wells[8], "PROD");
+
+        // The well values of each step, converted to bars and
+        // m^3/day. PARAMS is single precision.
+        Opm::EclipseBinaryReader unsmry("NATIVE.UNSMRY");
+        std::vector<double> times;
+        while (unsmry.next()) {
+            if (unsmry.name() == "PARAMS") {
+                const std::vector<double> params = unsmry.getDouble();
+                BOOST_REQUIRE_EQUAL(params.size(), keywords.size());
+                const int step = times.size();
+                for (std::size_t v = 1; v < params.size(); ++v) {
+                    const double expected = expectedSummary(keywords[v], wells[v], step);
+                    BOOST_TEST_MESSAGE(keywords[v] << " " << wells[v] << " step " << step);
+                    if (expected == 0.0) {
+                        BOOST_CHECK_EQUAL(params[v], 0.0);
+                    } else {
+                        BOOST_CHECK_CLOSE(params[v], expected, 1e-4);
+                    }
+                }
+                times.push_back(params[0]);
+            }
+        }
+        BOOST_REQUIRE_EQUAL(int(times.size()), numSteps);
+        BOOST_CHECK_CLOSE(times.back(), 6.0, 1e-6);
+    }
+}
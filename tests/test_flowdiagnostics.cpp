@@ -28,6 +28,10 @@
 #define BOOST_TEST_MODULE FlowDiagnosticsTests
 #include <boost/test/unit_test.hpp>
 #include <opm/core/flowdiagnostics/FlowDiagnostics.hpp>
+#include <opm/core/wells.h>
+
+#include <cmath>
+#include <limits>
 
 const std::vector<double> pv(16, 18750.0);
 
@@ -196,3 +200,117 @@ BOOST_AUTO_TEST_CASE(Sweep)
     compareCollections(et.first, Ev);
     compareCollections(et.second, tD);
 }
+
+
+
+
+BOOST_AUTO_TEST_CASE(FandPhiBinned)
+{
+    BOOST_CHECK_THROW(computeFandPhiBinned(pv, ftof, wrong_length, 10), std::runtime_error);
+    const int num_bins = 10000;
+    auto FPhi = computeFandPhiBinned(pv, ftof, rtof, num_bins);
+    BOOST_REQUIRE_EQUAL(FPhi.first.size(), num_bins + 1);
+    BOOST_REQUIRE_EQUAL(FPhi.second.size(), num_bins + 1);
+    BOOST_CHECK_EQUAL(FPhi.first.front(), 0.0);
+    BOOST_CHECK_CLOSE(FPhi.first.back(), 1.0, 1e-11);
+    BOOST_CHECK_CLOSE(FPhi.second.back(), 1.0, 1e-11);
+    // With bins finer than the differences between travel times,
+    // the curve contains the exact points, only repeated.
+    BOOST_CHECK_CLOSE(computeLorenz(FPhi.first, FPhi.second), 1.645920738950826e-01, 1e-8);
+    // With coarse bins the curve is still close.
+    auto coarse = computeFandPhiBinned(pv, ftof, rtof, 20);
+    BOOST_CHECK_CLOSE(computeLorenz(coarse.first, coarse.second), 1.645920738950826e-01, 5.0);
+}
+
+
+
+
+BOOST_AUTO_TEST_CASE(FandPhiBinnedSpecialCases)
+{
+    // No cells.
+    const std::vector<double> empty;
+    BOOST_CHECK_THROW(computeFandPhiBinned(empty, empty, empty, 0), std::runtime_error);
+    auto FPhi = computeFandPhiBinned(empty, empty, empty, 10);
+    compareCollections(FPhi.first, std::vector<double>(11, 0.0));
+    compareCollections(FPhi.second, std::vector<double>(11, 0.0));
+
+    // A cell with non-finite travel time is left out, and does not
+    // change the binning of the other cells, so the curves are those
+    // of the other cells.
+    const int num_bins = 1000;
+    const int cell = 6; // Neither the shortest nor the longest time.
+    std::vector<double> pv_other = pv, ftof_other = ftof, rtof_other = rtof;
+    pv_other.erase(pv_other.begin() + cell);
+    ftof_other.erase(ftof_other.begin() + cell);
+    rtof_other.erase(rtof_other.begin() + cell);
+    const auto other = computeFandPhiBinned(pv_other, ftof_other, rtof_other, num_bins);
+    const double lorenz_other = computeLorenz(other.first, other.second);
+
+    std::vector<double> ftof_inf = ftof;
+    ftof_inf[cell] = std::numeric_limits<double>::infinity();
+    std::vector<double> ftof_nan = ftof;
+    ftof_nan[cell] = std::numeric_limits<double>::quiet_NaN();
+    for (const auto& ftof_nonfinite : { ftof_inf, ftof_nan }) {
+        FPhi = computeFandPhiBinned(pv, ftof_nonfinite, rtof, num_bins);
+        BOOST_REQUIRE_EQUAL(FPhi.first.size(), num_bins + 1);
+        BOOST_REQUIRE_EQUAL(FPhi.second.size(), num_bins + 1);
+        for (int b = 0; b <= num_bins; ++b) {
+            BOOST_CHECK(std::isfinite(FPhi.first[b]));
+        }
+        compareCollections(FPhi.first, other.first);
+        compareCollections(FPhi.second, other.second);
+        const double lorenz = computeLorenz(FPhi.first, FPhi.second);
+        BOOST_CHECK(std::isfinite(lorenz));
+        BOOST_CHECK_CLOSE(lorenz, lorenz_other, 1e-10);
+    }
+
+    // The same for well pairs.
+    Wells* wells = create_wells(2, 2, 2);
+    BOOST_REQUIRE(wells != 0);
+    const double comp_frac[2] = { 1.0, 0.0 };
+    const int inj_cell = 0;
+    const int prod_cell = 15;
+    const double wi = 1.0;
+    add_well(INJECTOR, 0.0, 1, comp_frac, &inj_cell, &wi, "INJ", wells);
+    add_well(PRODUCER, 0.0, 1, comp_frac, &prod_cell, &wi, "PROD", wells);
+    const std::vector<double> tracer(pv.size(), 1.0);
+    const auto pairs = computeWellPairFandPhi(*wells, pv, ftof_nan, rtof, tracer, tracer, num_bins);
+    BOOST_REQUIRE_EQUAL(pairs.size(), 1);
+    compareCollections(pairs[0].first, other.first);
+    compareCollections(pairs[0].second, other.second);
+    destroy_wells(wells);
+
+    // No cell with finite travel time.
+    const std::vector<double> all_inf(pv.size(), std::numeric_limits<double>::infinity());
+    FPhi = computeFandPhiBinned(pv, all_inf, rtof, 10);
+    compareCollections(FPhi.first, std::vector<double>(11, 0.0));
+    compareCollections(FPhi.second, std::vector<double>(11, 0.0));
+}
+
+
+
+BOOST_AUTO_TEST_CASE(WellPairFandPhi)
+{
+    // One injector and one producer, each perforated in one cell.
+    Wells* wells = create_wells(2, 2, 2);
+    BOOST_REQUIRE(wells != 0);
+    const double comp_frac[2] = { 1.0, 0.0 };
+    const int inj_cell = 0;
+    const int prod_cell = 15;
+    const double wi = 1.0;
+    add_well(INJECTOR, 0.0, 1, comp_frac, &inj_cell, &wi, "INJ", wells);
+    add_well(PRODUCER, 0.0, 1, comp_frac, &prod_cell, &wi, "PROD", wells);
+
+    // All cells are fully associated with the only well pair.
+    const std::vector<double> tracer(pv.size(), 1.0);
+    const int num_bins = 100;
+    auto pairs = computeWellPairFandPhi(*wells, pv, ftof, rtof, tracer, tracer, num_bins);
+    BOOST_REQUIRE_EQUAL(pairs.size(), 1);
+    auto FPhi = computeFandPhiBinned(pv, ftof, rtof, num_bins);
+    compareCollections(pairs[0].first, FPhi.first);
+    compareCollections(pairs[0].second, FPhi.second);
+    BOOST_CHECK_THROW(computeWellPairFandPhi(*wells, pv, ftof, rtof, wrong_length, tracer, num_bins),
+                      std::runtime_error);
+
+    destroy_wells(wells);
+}
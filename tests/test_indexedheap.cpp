@@ -0,0 +1,99 @@
+/*
+  Copyright 2015 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#if HAVE_DYNAMIC_BOOST_TEST
+#define BOOST_TEST_DYN_LINK
+#endif
+#define NVERBOSE // to suppress our messages when throwing
+
+#define BOOST_TEST_MODULE IndexedHeapTest
+
+#include <opm/core/utility/platform_dependent/disable_warnings.h>
+#include <boost/test/unit_test.hpp>
+#include <opm/core/utility/platform_dependent/reenable_warnings.h>
+
+#include <opm/core/utility/IndexedHeap.hpp>
+
+#include <algorithm>
+#include <vector>
+
+using namespace Opm;
+
+
+BOOST_AUTO_TEST_CASE(push_pop_in_order)
+{
+    const std::vector<double> values = { 5.0, 3.0, 8.0, 1.0, 9.0, 3.0, 0.5, 7.0, 2.0, 6.0 };
+    const int n = values.size();
+    IndexedHeap<3> heap(n);
+    BOOST_CHECK(heap.empty());
+    for (int i = 0; i < n; ++i) {
+        heap.push(values[i], i);
+        BOOST_CHECK(heap.contains(i));
+    }
+    BOOST_CHECK_EQUAL(heap.size(), n);
+
+    std::vector<double> sorted = values;
+    std::sort(sorted.begin(), sorted.end());
+    std::vector<int> popped;
+    for (int i = 0; i < n; ++i) {
+        BOOST_CHECK_EQUAL(heap.top().first, sorted[i]);
+        popped.push_back(heap.top().second);
+        heap.pop();
+        BOOST_CHECK(!heap.contains(popped.back()));
+    }
+    BOOST_CHECK(heap.empty());
+    // Equal values are popped in order of increasing index.
+    BOOST_CHECK_EQUAL(popped[3], 1);
+    BOOST_CHECK_EQUAL(popped[4], 5);
+}
+
+
+BOOST_AUTO_TEST_CASE(decrease_and_reset)
+{
+    IndexedHeap<> heap(6);
+    for (int i = 0; i < 6; ++i) {
+        heap.push(10.0 + i, i);
+    }
+    heap.decrease(4, 1.0);
+    BOOST_CHECK_EQUAL(heap.top().second, 4);
+    BOOST_CHECK_EQUAL(heap.value(4), 1.0);
+    heap.decrease(5, 0.5);
+    BOOST_CHECK_EQUAL(heap.top().second, 5);
+    heap.pop();
+    BOOST_CHECK_EQUAL(heap.top().second, 4);
+    BOOST_CHECK_EQUAL(heap.size(), 5);
+    int count = 0;
+    for (auto it = heap.begin(); it != heap.end(); ++it) {
+        BOOST_CHECK(heap.contains(it->second));
+        ++count;
+    }
+    BOOST_CHECK_EQUAL(count, 5);
+
+    heap.clear();
+    BOOST_CHECK(heap.empty());
+    for (int i = 0; i < 6; ++i) {
+        BOOST_CHECK(!heap.contains(i));
+    }
+    heap.reset(10);
+    heap.push(2.0, 9);
+    BOOST_CHECK(heap.contains(9));
+    BOOST_CHECK_EQUAL(heap.top().second, 9);
+}
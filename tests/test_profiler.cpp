@@ -0,0 +1,216 @@
+/*
+  Copyright 2015 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "config.h"
+
+#if HAVE_DYNAMIC_BOOST_TEST
+#define BOOST_TEST_DYN_LINK
+#endif
+
+#define NVERBOSE  // Suppress own messages when throw()ing
+
+#define BOOST_TEST_MODULE ProfilerTest
+#include <boost/test/unit_test.hpp>
+
+// Test the macros as instrumented code sees them with profiling on.
+#ifndef OPM_PROFILING
+#define OPM_PROFILING 1
+#endif
+#include <opm/core/utility/Profiler.hpp>
+
+#include <chrono>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    void sleepMs(const int ms)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+    }
+
+    void work()
+    {
+        OPM_PROFILE_REGION("work");
+        for (int i = 0; i < 3; ++i) {
+            OPM_PROFILE_REGION("inner");
+            OPM_PROFILE_COUNT("items", 2);
+            sleepMs(2);
+        }
+    }
+
+    const Opm::time::Profiler::RegionStats*
+    findRegion(const std::vector<Opm::time::Profiler::RegionStats>& stats, const std::string& path)
+    {
+        for (std::size_t i = 0; i < stats.size(); ++i) {
+            if (stats[i].path == path) {
+                return &stats[i];
+            }
+        }
+        return 0;
+    }
+}
+
+BOOST_AUTO_TEST_CASE(NestedRegions)
+{
+    Opm::time::Profiler& profiler = Opm::time::Profiler::instance();
+    profiler.reset();
+    {
+        OPM_PROFILE_REGION("step");
+        work();
+        sleepMs(2);
+    }
+    work();
+
+    const std::vector<Opm::time::Profiler::RegionStats> stats = profiler.regions();
+    BOOST_REQUIRE_EQUAL(stats.size(), 5u);
+    const Opm::time::Profiler::RegionStats* step = findRegion(stats, "step");
+    const Opm::time::Profiler::RegionStats* nested = findRegion(stats, "step/work/inner");
+    const Opm::time::Profiler::RegionStats* top = findRegion(stats, "work");
+    BOOST_REQUIRE(step && nested && top && findRegion(stats, "step/work") && findRegion(stats, "work/inner"));
+    BOOST_CHECK_EQUAL(step->calls, 1);
+    BOOST_CHECK_EQUAL(nested->calls, 3);
+    BOOST_CHECK_EQUAL(top->calls, 1);
+    BOOST_CHECK_GE(nested->total, 0.006);
+    BOOST_CHECK_GE(step->total, 0.008);
+    BOOST_CHECK_GE(step->self, 0.002);
+    BOOST_CHECK_LT(step->self, step->total - nested->total + 1e-9);
+
+    const std::vector<std::pair<std::string, long long> > counters = profiler.counters();
+    BOOST_REQUIRE_EQUAL(counters.size(), 1u);
+    BOOST_CHECK_EQUAL(counters[0].first, "items");
+    BOOST_CHECK_EQUAL(counters[0].second, 12);
+
+    std::ostringstream summary;
+    profiler.writeSummary(summary);
+    BOOST_CHECK(summary.str().find("step/work/inner") != std::string::npos);
+    BOOST_CHECK(summary.str().find("items") != std::string::npos);
+
+    // One complete event per region instance.
+    std::ostringstream trace;
+    profiler.writeChromeTrace(trace);
+    const std::string json = trace.str();
+    int num_events = 0;
+    for (std::size_t pos = json.find("\"ph\":\"X\""); pos != std::string::npos;
+         pos = json.find("\"ph\":\"X\"", pos + 1)) {
+        ++num_events;
+    }
+    BOOST_CHECK_EQUAL(num_events, 9);
+    BOOST_CHECK(json.find("\"path\":\"step/work/inner\"") != std::string::npos);
+    BOOST_CHECK(json.find("\"items\":12") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(Threads)
+{
+    Opm::time::Profiler& profiler = Opm::time::Profiler::instance();
+    profiler.reset();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.push_back(std::thread(work));
+    }
+    for (int t = 0; t < 4; ++t) {
+        threads[t].join();
+    }
+    const std::vector<Opm::time::Profiler::RegionStats> stats = profiler.regions();
+    BOOST_REQUIRE_EQUAL(stats.size(), 2u);
+    BOOST_CHECK_EQUAL(stats[0].path, "work");
+    BOOST_CHECK_EQUAL(stats[0].calls, 4);
+    BOOST_CHECK_EQUAL(stats[1].calls, 12);
+    BOOST_CHECK_EQUAL(profiler.counters()[0].second, 24);
+}
+
+BOOST_AUTO_TEST_CASE(Disabled)
+{
+    Opm::time::Profiler& profiler = Opm::time::Profiler::instance();
+    profiler.reset();
+    profiler.setEnabled(false);
+    work();
+    profiler.setEnabled(true);
+    BOOST_CHECK(profiler.regions().empty());
+    BOOST_CHECK(profiler.counters().empty());
+
+    // Disabling while a region is open does not unbalance it.
+    {
+        OPM_PROFILE_REGION("outer");
+        profiler.setEnabled(false);
+    }
+    profiler.setEnabled(true);
+    BOOST_CHECK_EQUAL(profiler.regions().size(), 1u);
+    BOOST_CHECK_THROW(profiler.end(), std::logic_error);
+}
+
+BOOST_AUTO_TEST_CASE(StatisticsOnly)
+{
+    Opm::time::Profiler& profiler = Opm::time::Profiler::instance();
+    profiler.reset();
+    {
+        OPM_PROFILE_REGION("step");
+        for (int i = 0; i < 100; ++i) {
+            OPM_PROFILE_REGION_STATS("cell");
+        }
+    }
+    const std::vector<Opm::time::Profiler::RegionStats> stats = profiler.regions();
+    BOOST_REQUIRE_EQUAL(stats.size(), 2u);
+    BOOST_CHECK_EQUAL(stats[1].path, "step/cell");
+    BOOST_CHECK_EQUAL(stats[1].calls, 100);
+
+    // Only the enclosing region is in the trace, and nothing is
+    // counted as dropped.
+    std::ostringstream trace;
+    profiler.writeChromeTrace(trace);
+    BOOST_CHECK(trace.str().find("\"path\":\"step\"") != std::string::npos);
+    BOOST_CHECK(trace.str().find("step/cell") == std::string::npos);
+    BOOST_CHECK_EQUAL(profiler.droppedTraceEvents(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(TraceLimit)
+{
+    Opm::time::Profiler& profiler = Opm::time::Profiler::instance();
+    profiler.reset();
+    const std::size_t max_events = profiler.maxTraceEvents();
+    profiler.setMaxTraceEvents(10);
+    for (int i = 0; i < 25; ++i) {
+        OPM_PROFILE_REGION("often");
+    }
+    profiler.setMaxTraceEvents(max_events);
+
+    // The statistics include every instance, the trace the first ten.
+    BOOST_REQUIRE_EQUAL(profiler.regions().size(), 1u);
+    BOOST_CHECK_EQUAL(profiler.regions()[0].calls, 25);
+    BOOST_CHECK_EQUAL(profiler.droppedTraceEvents(), 15);
+    std::ostringstream trace;
+    profiler.writeChromeTrace(trace);
+    const std::string json = trace.str();
+    int num_events = 0;
+    for (std::size_t pos = json.find("\"ph\":\"X\""); pos != std::string::npos;
+         pos = json.find("\"ph\":\"X\"", pos + 1)) {
+        ++num_events;
+    }
+    BOOST_CHECK_EQUAL(num_events, 10);
+    BOOST_CHECK(json.find("\"dropped_events\":15") != std::string::npos);
+    std::ostringstream summary;
+    profiler.writeSummary(summary);
+    BOOST_CHECK(summary.str().find("15 region instances") != std::string::npos);
+
+    profiler.reset();
+    BOOST_CHECK_EQUAL(profiler.droppedTraceEvents(), 0);
+}
@@ -0,0 +1,184 @@
+/*
+  Copyright 2015 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "config.h"
+
+#if HAVE_DYNAMIC_BOOST_TEST
+#define BOOST_TEST_DYN_LINK
+#endif
+
+#define NVERBOSE  // Suppress own messages when throw()ing
+
+#define BOOST_TEST_MODULE PropertyKernelsTest
+#include <boost/test/unit_test.hpp>
+
+#include <opm/core/props/BlackoilPropertiesBasic.hpp>
+#include <opm/core/props/pvt/PvtPropertiesBasic.hpp>
+#include <opm/core/utility/miscUtilitiesBlackoil.hpp>
+#include <opm/core/utility/parameters/ParameterGroup.hpp>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+// The kernels specialised for two and three phases are compared with
+// the generic loops they replaced. Other numbers of phases use the
+// generic kernels, and are compared as well.
+
+namespace
+{
+    // Different values for every point, phase and matrix entry, so
+    // that mixing up indices changes the results.
+    void fillData(const int n, const int np, std::vector<double>& A, std::vector<double>& s)
+    {
+        A.resize(n*np*np);
+        s.resize(n*np);
+        for (int i = 0; i < n; ++i) {
+            for (int k = 0; k < np*np; ++k) {
+                A[i*np*np + k] = 1.0 + 0.1*k + 0.003*((i + 7*k) % 13);
+            }
+            for (int p = 0; p < np; ++p) {
+                s[i*np + p] = 0.1 + 0.2*p + 0.01*((i + p) % 5);
+            }
+        }
+    }
+
+    void surfacevolGeneric(const int n, const int np, const double* A,
+                           const double* s, double* z)
+    {
+        std::fill(z, z + n*np, 0.0);
+        for (int i = 0; i < n; ++i) {
+            for (int col = 0; col < np; ++col) {
+                for (int row = 0; row < np; ++row) {
+                    z[i*np + row] += A[i*np*np + row + col*np] * s[i*np + col];
+                }
+            }
+        }
+    }
+
+    void fillGeneric(const int n, const int np, const double* value, double* out)
+    {
+        for (int phase = 0; phase < np; ++phase) {
+            for (int i = 0; i < n; ++i) {
+                out[np*i + phase] = value[phase];
+            }
+        }
+    }
+
+    void diagonalMatrixGeneric(const int n, const int np, const double* B, double* A)
+    {
+        for (int i = 0; i < n; ++i) {
+            double* m = A + i*np*np;
+            std::fill(m, m + np*np, 0.0);
+            for (int phase = 0; phase < np; ++phase) {
+                m[phase + phase*np] = 1.0/B[phase];
+            }
+        }
+    }
+
+    void densityGeneric(const int n, const int np, const double* A,
+                        const double* sdens, double* rho)
+    {
+        for (int i = 0; i < n; ++i) {
+            for (int phase = 0; phase < np; ++phase) {
+                rho[np*i + phase] = 0.0;
+                for (int comp = 0; comp < np; ++comp) {
+                    rho[np*i + phase] += A[i*np*np + np*phase + comp]*sdens[comp];
+                }
+            }
+        }
+    }
+
+    const int num_points = 17;
+}
+
+BOOST_AUTO_TEST_CASE (Surfacevol)
+{
+    const int n = num_points;
+    for (int np = 1; np <= 4; ++np) {
+        std::vector<double> A, s;
+        fillData(n, np, A, s);
+        // Garbage in the output, which must be overwritten.
+        std::vector<double> z(n*np, -1.0), expected(n*np);
+        Opm::computeSurfacevol(n, np, &A[0], &s[0], &z[0]);
+        surfacevolGeneric(n, np, &A[0], &s[0], &expected[0]);
+        BOOST_CHECK_MESSAGE(z == expected, "np = " << np);
+    }
+}
+
+BOOST_AUTO_TEST_CASE (PvtBasic)
+{
+    const int n = num_points;
+    for (int np = 1; np <= 3; ++np) {
+        std::vector<double> rho(np), visc(np);
+        for (int p = 0; p < np; ++p) {
+            rho[p] = 700.0 + 100.0*p;
+            visc[p] = 1e-3*(1.0 + p);
+        }
+        Opm::PvtPropertiesBasic pvt;
+        pvt.init(np, rho, visc);
+        const std::vector<double> B(np, 1.0), dBdp(n*np, 0.0);
+        std::vector<double> expected_mu(n*np), expected_B(n*np);
+        fillGeneric(n, np, &visc[0], &expected_mu[0]);
+        fillGeneric(n, np, &B[0], &expected_B[0]);
+
+        std::vector<double> mu_out(n*np, -1.0), B_out(n*np, -1.0), dBdp_out(n*np, -1.0);
+        pvt.mu(n, 0, 0, 0, &mu_out[0]);
+        BOOST_CHECK_MESSAGE(mu_out == expected_mu, "np = " << np);
+        pvt.B(n, 0, 0, 0, &B_out[0]);
+        BOOST_CHECK_MESSAGE(B_out == expected_B, "np = " << np);
+        std::fill(B_out.begin(), B_out.end(), -1.0);
+        pvt.dBdp(n, 0, 0, 0, &B_out[0], &dBdp_out[0]);
+        BOOST_CHECK_MESSAGE(B_out == expected_B, "np = " << np);
+        BOOST_CHECK_MESSAGE(dBdp_out == dBdp, "np = " << np);
+    }
+}
+
+BOOST_AUTO_TEST_CASE (BlackoilBasic)
+{
+    const int n = num_points;
+    // BlackoilPropertiesBasic supports one and two phases.
+    for (int np = 1; np <= 2; ++np) {
+        Opm::parameter::ParameterGroup param;
+        param.disableOutput();
+        param.insertParameter("num_phases", std::to_string(np));
+        param.insertParameter("relperm_func", np == 1 ? "Constant" : "Linear");
+        param.insertParameter("rho1", "1010.0");
+        param.insertParameter("rho2", "780.0");
+        Opm::BlackoilPropertiesBasic props(param, 3, 1);
+        BOOST_REQUIRE_EQUAL(props.numPhases(), np);
+
+        const std::vector<double> p(n, 1e7), T(n, 300.0);
+        const std::vector<int> cells(n, 0);
+        const std::vector<double> B(np, 1.0);
+        std::vector<double> A(n*np*np, -1.0), dAdp(n*np*np, -1.0), expected(n*np*np);
+        props.matrix(n, &p[0], &T[0], 0, &cells[0], &A[0], &dAdp[0]);
+        diagonalMatrixGeneric(n, np, &B[0], &expected[0]);
+        BOOST_CHECK_MESSAGE(A == expected, "np = " << np);
+        BOOST_CHECK_MESSAGE(dAdp == std::vector<double>(n*np*np, 0.0), "np = " << np);
+
+        // The density for general matrices, not only those of matrix().
+        std::vector<double> s;
+        fillData(n, np, A, s);
+        std::vector<double> rho(n*np, -1.0), expected_rho(n*np);
+        props.density(n, &A[0], &cells[0], &rho[0]);
+        densityGeneric(n, np, &A[0], props.surfaceDensity(0), &expected_rho[0]);
+        BOOST_CHECK_MESSAGE(rho == expected_rho, "np = " << np);
+    }
+}
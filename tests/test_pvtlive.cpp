@@ -0,0 +1,262 @@
+/*
+  Copyright 2015 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "config.h"
+
+#if HAVE_DYNAMIC_BOOST_TEST
+#define BOOST_TEST_DYN_LINK
+#endif
+
+#define NVERBOSE  // Suppress own messages when throw()ing
+
+#define BOOST_TEST_MODULE PvtLiveTest
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <opm/core/props/BlackoilPhases.hpp>
+#include <opm/core/props/pvt/PvtLiveGas.hpp>
+#include <opm/core/props/pvt/PvtLiveOil.hpp>
+#include <opm/core/utility/Units.hpp>
+
+#include <opm/parser/eclipse/Parser/Parser.hpp>
+#include <opm/parser/eclipse/Parser/ParseMode.hpp>
+#include <opm/parser/eclipse/Deck/Deck.hpp>
+#include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
+
+#include <string>
+#include <vector>
+
+namespace
+{
+    // The second PVTO record has no undersaturated data, so that its
+    // undersaturated curve is extrapolated from the next record.
+    const std::string deckString =
+        "RUNSPEC\n"
+        "METRIC\n"
+        "OIL\n"
+        "GAS\n"
+        "DISGAS\n"
+        "VAPOIL\n"
+        "DIMENS\n"
+        "  1 1 1 /\n"
+        "TABDIMS\n"
+        "  1 1 20 20 1 20 /\n"
+        "GRID\n"
+        "DXV\n"
+        "  1.0 /\n"
+        "DYV\n"
+        "  1.0 /\n"
+        "DZV\n"
+        "  1.0 /\n"
+        "TOPS\n"
+        "  0.0 /\n"
+        "PROPS\n"
+        "PVTO\n"
+        "   20   40.  1.10  1.50\n"
+        "       100.  1.09  1.55\n"
+        "       200.  1.075 1.62 /\n"
+        "   50  100.  1.20  1.30 /\n"
+        "   80  150.  1.30  1.10\n"
+        "       250.  1.28  1.16\n"
+        "       350.  1.265 1.21 /\n"
+        "  110  200.  1.40  0.95\n"
+        "       400.  1.37  1.02 /\n"
+        "/\n"
+        "PVTG\n"
+        "   50.  0.0002  0.025  0.015\n"
+        "        0.0     0.0252 0.0148 /\n"
+        "  100.  0.0004  0.012  0.018\n"
+        "        0.0     0.0122 0.0175 /\n"
+        "  200.  0.0007  0.006  0.024\n"
+        "        0.0003  0.0061 0.0235\n"
+        "        0.0     0.0062 0.023 /\n"
+        "  300.  0.0010  0.004  0.030\n"
+        "        0.0     0.0042 0.028 /\n"
+        "/\n";
+
+    // Pressure (bar), dissolved gas-oil or vaporised oil-gas ratio,
+    // and whether the other hydrocarbon phase is present.
+    struct Point
+    {
+        double p;
+        double r;
+        bool saturated;
+    };
+
+    // For each point: mu, dmudp, dmudr, b, dbdp and dbdr as functions
+    // of r with the phase presence given, then B, dBdp and mu as
+    // functions of the surface volumes. For oil, also the first six
+    // with saturation determined from r (not implemented for gas).
+    std::vector<double> evaluate(const Opm::PvtInterface& pvt, const Point& pt, const bool gas)
+    {
+        const int idx = 0;
+        const double p = pt.p*Opm::unit::barsa;
+        const double T = 300.0;
+        const double r = pt.r;
+        Opm::PhasePresence cond;
+        if (pt.saturated) {
+            if (gas) {
+                cond.setFreeOil();
+            } else {
+                cond.setFreeGas();
+            }
+        }
+        // Water, oil, gas.
+        const double z[] = { 0.0, gas ? r : 1.0, gas ? 1.0 : r };
+
+        std::vector<double> v(gas ? 9 : 15);
+        pvt.mu(1, &idx, &p, &T, &r, &cond, &v[0], &v[1], &v[2]);
+        pvt.b(1, &idx, &p, &T, &r, &cond, &v[3], &v[4], &v[5]);
+        pvt.dBdp(1, &idx, &p, &T, z, &v[6], &v[7]);
+        pvt.mu(1, &idx, &p, &T, z, &v[8]);
+        if (!gas) {
+            pvt.mu(1, &idx, &p, &T, &r, &v[9], &v[10], &v[11]);
+            pvt.b(1, &idx, &p, &T, &r, &v[12], &v[13], &v[14]);
+        }
+        return v;
+    }
+
+    void checkValues(const Opm::PvtInterface& pvt, const bool gas,
+                     const std::vector<Point>& points,
+                     const std::vector<std::vector<double> >& expected)
+    {
+        BOOST_REQUIRE_EQUAL(points.size(), expected.size());
+        for (std::size_t i = 0; i < points.size(); ++i) {
+            BOOST_TEST_MESSAGE("Point " << i);
+            const std::vector<double> v = evaluate(pvt, points[i], gas);
+            BOOST_REQUIRE_EQUAL(v.size(), expected[i].size());
+            for (std::size_t k = 0; k < v.size(); ++k) {
+                if (expected[i][k] == 0.0) {
+                    BOOST_CHECK_EQUAL(v[k], 0.0);
+                } else {
+                    BOOST_CHECK_CLOSE(v[k], expected[i][k], 1e-10);
+                }
+            }
+        }
+    }
+
+    struct Tables
+    {
+        Tables()
+        {
+            Opm::ParseMode parseMode;
+            Opm::ParserPtr parser(new Opm::Parser());
+            Opm::DeckConstPtr deck = parser->parseString(deckString, parseMode);
+            Opm::EclipseStateConstPtr eclipseState(new Opm::EclipseState(deck, parseMode));
+            tables = eclipseState->getTableManager();
+        }
+
+        std::shared_ptr<const Opm::TableManager> tables;
+    };
+
+    void setPhases(Opm::PvtInterface& pvt)
+    {
+        const int phase_pos[] = { 0, 1, 2 };
+        pvt.setPhaseConfiguration(3, phase_pos);
+    }
+}
+
+// Reference values are those of the former miscible_oil() and
+// miscible_gas(), which searched the tables once per quantity.
+
+BOOST_AUTO_TEST_CASE (LiveOilSameAsBefore)
+{
+    const std::vector<Point> points = {
+        { 120.0,  90.0, true  },  // saturated
+        { 180.0,  30.0, false },  // undersaturated, first records
+        { 300.0,  65.0, false },  // undersaturated, extrapolated record
+        { 380.0,  95.0, false },  // undersaturated, last records
+        {  60.0,  40.0, false },  // saturated by r, undersaturated by phase presence
+        { 250.0,   0.0, true  }   // undersaturated by r, saturated by phase presence
+    };
+    const std::vector<std::vector<double> > expected = {
+        { 0.0012157894736842107, -4.0627885503231811e-11, 0,
+          0.80769230769230771, -1.2820512820512841e-08, 0,
+          1.2380952380952381, 1.9652305366591112e-08, 0.0012157894736842107,
+          0.0012157894736842107, -4.0627885503231811e-11, 0,
+          0.80769230769230771, -1.2820512820512841e-08, 0 },
+        { 0.0015183895890745808, 7.2129054652906804e-12, -8.5090702624999903e-06,
+          0.89969819002915874, 1.2874521430434104e-09, -0.0027974095014579297,
+          1.1114838410062717, -1.5905136510447668e-09, 0.0015183895890745808,
+          0.0015183895890745808, 7.2129054652906804e-12, -8.5090702624999903e-06,
+          0.89969819002915874, 1.2874521430434104e-09, -0.0027974095014579297 },
+        { 0.0013010377772290889, 5.5143988844807679e-12, -8.1579611705382531e-06,
+          0.82113595191040856, 9.6498270750989269e-10, -0.0023502689942907383,
+          1.2178251331870884, -1.4311639766379296e-09, 0.0013010377772290889,
+          0.0013010377772290889, 5.5143988844807679e-12, -8.1579611705382531e-06,
+          0.82113595191040856, 9.6498270750989269e-10, -0.0023502689942907383 },
+        { 0.0011135374891050678, 4.3717603978804823e-12, -7.0778238085421784e-06,
+          0.76082793109381908, 8.5422402494364223e-10, -0.0021643368730602983,
+          1.3143576347970434, -1.4757027484487647e-09, 0.0011135374891050678,
+          0.0011135374891050678, 4.3717603978804823e-12, -7.0778238085421784e-06,
+          0.76082793109381908, 8.5422402494364223e-10, -0.0021643368730602983 },
+        { 0.0013499973764511993, 7.1334866925318744e-12, -7.8904136833264394e-06,
+          0.85604033453804096, 1.3314046427578547e-09, -0.002791533453804096,
+          1.1314285714285715, 1.6163265306122438e-08, 0.0014308176100628932,
+          0.0014308176100628932, -3.3938530912543008e-11, 0,
+          0.88383838383838387, -1.2626262626262615e-08, 0 },
+        { 0.00081960784313725497, -2.437395873382031e-11, 0,
+          0.65934065934065944, -1.0989010989010972e-08, 0,
+          1.0065688512438582, -1.48380967633757e-09, 0.0018504315011029888,
+          0.0018504315011029888, 8.6307839083175728e-12, -1.0203751081864474e-05,
+          0.99347401696789972, 1.464506235957219e-09, -0.0028420388044436288 }
+    };
+
+    Tables t;
+    Opm::PvtLiveOil pvt(t.tables->getPvtoTables());
+    setPhases(pvt);
+    checkValues(pvt, false, points, expected);
+}
+
+BOOST_AUTO_TEST_CASE (LiveGasSameAsBefore)
+{
+    const std::vector<Point> points = {
+        {  75.0, 5.0e-4, true  },  // saturated
+        {  75.0, 1.0e-4, false },  // undersaturated, first records
+        { 150.0, 2.0e-4, false },  // undersaturated, middle records
+        { 260.0, 6.0e-4, false },  // undersaturated, last records
+        { 350.0, 1.5e-3, false },  // saturated by r, undersaturated by phase presence
+        {  30.0,    0.0, true  }   // undersaturated by r, saturated by phase presence
+    };
+    const std::vector<std::vector<double> > expected = {
+        { 1.6903553299492385e-05, 5.5657192919168204e-13, 0,
+          61.666666666666664, 8.6666666666666661e-06, 0,
+          0.016216216216216217, -2.2790357925493062e-09, 1.6903553299492385e-05 },
+        { 1.6632066202175949e-05, 5.0458042297867451e-13, 0.001153240968844815,
+          61.075006505334372, 8.4934946656258113e-06, 2501.3010668748411,
+          0.016373309758266806, -2.276980831403299e-09, 1.6632066202175949e-05 },
+        { 2.1099654895909965e-05, 5.360367109948304e-13, 0.0015173198576936418,
+          122.85166578529876, 8.040278512251013e-06, 6114.489687995756,
+          0.0081398977670164123, -5.3273225633293683e-10, 2.1099654895909965e-05 },
+        { 2.7300347349278541e-05, 5.0749667464152677e-13, 0.0017285784926993773,
+          213.53629976580797, 7.9254488680718193e-06, 9875.0975800156193,
+          0.0046830445273086203, -1.7381227448819466e-10, 2.7300347349278541e-05 },
+        { 3.3348912967679599e-05, 4.2812459771251792e-13, 0.0024224440174231403,
+          297.86299765807962, 8.3821233411397346e-06, 14441.842310694745,
+          0.0034285714285714288, -9.7959183673469404e-11, 3.2307692307692308e-05 },
+        { 1.204724409448819e-05, 2.0925041850083694e-12, 0,
+          22.666666666666668, 8.6666666666666661e-06, 0,
+          0.0252, -5.3704918032786874e-09, 1.4800000000000001e-05 }
+    };
+
+    Tables t;
+    Opm::PvtLiveGas pvt(t.tables->getPvtgTables());
+    setPhases(pvt);
+    checkValues(pvt, true, points, expected);
+}
@@ -0,0 +1,218 @@
+/*
+  Copyright 2015 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "config.h"
+
+#if HAVE_DYNAMIC_BOOST_TEST
+#define BOOST_TEST_DYN_LINK
+#endif
+
+#define NVERBOSE  // Suppress own messages when throw()ing
+
+#define BOOST_TEST_MODULE PvtRegionGroupingTest
+#include <boost/test/unit_test.hpp>
+
+#include <opm/core/grid.h>
+#include <opm/core/grid/cart_grid.h>
+#include <opm/core/props/BlackoilPropertiesFromDeck.hpp>
+#include <opm/core/utility/Units.hpp>
+#include <opm/core/utility/parameters/ParameterGroup.hpp>
+
+#include <opm/parser/eclipse/Parser/Parser.hpp>
+#include <opm/parser/eclipse/Parser/ParseMode.hpp>
+#include <opm/parser/eclipse/Deck/Deck.hpp>
+#include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // Three PVT regions, assigned to the cells out of order.
+    const std::string deckString =
+        "RUNSPEC\n"
+        "WATER\n"
+        "OIL\n"
+        "GAS\n"
+        "DISGAS\n"
+        "TABDIMS\n"
+        "  1 3 20 20 1 20 /\n"
+        "DIMENS\n"
+        "  1 1 12 /\n"
+        "GRID\n"
+        "DXV\n"
+        "  1.0 /\n"
+        "DYV\n"
+        "  1.0 /\n"
+        "DZV\n"
+        "  12*5.0 /\n"
+        "TOPS\n"
+        "  0.0 /\n"
+        "PORO\n"
+        "  12*0.2 /\n"
+        "PERMX\n"
+        "  12*100.0 /\n"
+        "PERMY\n"
+        "  12*100.0 /\n"
+        "PERMZ\n"
+        "  12*10.0 /\n"
+        "PROPS\n"
+        "PVTO\n"
+        "    0    1.  1.000 1.20 /\n"
+        "   50  100.  1.030 1.12 /\n"
+        "  100  200.  1.060 1.05\n"
+        "       400.  1.055 1.08 /\n"
+        "/\n"
+        "    0    1.  1.000 1.50 /\n"
+        "   40  100.  1.020 1.40 /\n"
+        "   80  200.  1.045 1.30\n"
+        "       400.  1.040 1.34 /\n"
+        "/\n"
+        "    0    1.  1.000 0.90 /\n"
+        "   60  100.  1.040 0.85 /\n"
+        "  120  200.  1.080 0.80\n"
+        "       400.  1.074 0.83 /\n"
+        "/\n"
+        "PVDG\n"
+        "  100 0.010 0.010\n"
+        "  400 0.003 0.020 /\n"
+        "  100 0.011 0.012\n"
+        "  400 0.004 0.025 /\n"
+        "  100 0.009 0.011\n"
+        "  400 0.0025 0.018 /\n"
+        "SWOF\n"
+        "  0.2 0 1 0.9\n"
+        "  1   1 0 0.1 /\n"
+        "SGOF\n"
+        "  0   0 1 0.2\n"
+        "  0.8 1 0 0.5 /\n"
+        "PVTW\n"
+        "  1. 1.00 4.0E-5 0.96 0.0 /\n"
+        "  1. 1.01 4.5E-5 0.90 0.0 /\n"
+        "  1. 0.99 3.5E-5 1.00 0.0 /\n"
+        "ROCK\n"
+        "  1. 5.0E-5 /\n"
+        "DENSITY\n"
+        "  700 1000 1.0 /\n"
+        "  750 1010 1.1 /\n"
+        "  680  990 0.9 /\n"
+        "REGIONS\n"
+        "PVTNUM\n"
+        "  1 3 2 2 1 3 3 1 2 1 2 3 /\n";
+
+    struct Points
+    {
+        // Saturated and undersaturated oil in the given cells.
+        explicit Points(const std::vector<int>& c)
+            : n(c.size()), p(n), T(n, 300.0), z(3*n), s(3*n), cells(c)
+        {
+            for (int i = 0; i < n; ++i) {
+                const double w = double(i % 7)/6.0;
+                p[i] = (20.0 + 350.0*w)*Opm::unit::barsa;
+                z[3*i + 0] = 1.0;
+                z[3*i + 1] = 1.0;
+                z[3*i + 2] = 110.0*double(i % 5)/4.0;
+                s[3*i + 0] = 0.2 + 0.5*w;
+                s[3*i + 1] = 0.7 - 0.6*w;
+                s[3*i + 2] = 1.0 - s[3*i + 0] - s[3*i + 1];
+            }
+        }
+
+        int n;
+        std::vector<double> p, T, z, s;
+        std::vector<int> cells;
+    };
+
+    std::shared_ptr<Opm::BlackoilPropertiesFromDeck>
+    createProperties(const UnstructuredGrid& grid, const bool grouped)
+    {
+        Opm::ParseMode parseMode;
+        Opm::ParserPtr parser(new Opm::Parser());
+        Opm::DeckConstPtr deck = parser->parseString(deckString, parseMode);
+        Opm::EclipseStateConstPtr eclipseState(new Opm::EclipseState(deck, parseMode));
+        Opm::parameter::ParameterGroup param;
+        param.disableOutput();
+        param.insertParameter("pvt_region_grouping", grouped ? "true" : "false");
+        return std::make_shared<Opm::BlackoilPropertiesFromDeck>(deck, eclipseState, grid,
+                                                                 param, false);
+    }
+}
+
+BOOST_AUTO_TEST_CASE (GroupedSameAsUngrouped)
+{
+    std::shared_ptr<UnstructuredGrid>
+        grid(create_grid_cart3d(1, 1, 12), destroy_grid);
+    const auto grouped = createProperties(*grid, true);
+    const auto ungrouped = createProperties(*grid, false);
+    const int np = grouped->numPhases();
+    BOOST_REQUIRE(np == 3);
+
+    // All cells in order, which is evaluated by region if grouping
+    // is enabled, and a subset of cells in another order.
+    const int nc = grid->number_of_cells;
+    std::vector<int> all_cells(nc), subset;
+    for (int c = 0; c < nc; ++c) {
+        all_cells[c] = c;
+    }
+    for (int i = 0; i < 50; ++i) {
+        subset.push_back((5*i + 3) % nc);
+    }
+
+    // The regions have different properties.
+    const Points all_pts(all_cells);
+    std::vector<double> mu(nc*np);
+    ungrouped->viscosity(nc, &all_pts.p[0], &all_pts.T[0], &all_pts.z[0], &all_pts.cells[0],
+                         &mu[0], 0);
+    BOOST_CHECK(mu[np*0 + 1] != mu[np*1 + 1]);
+
+    typedef Opm::BlackoilCellProperties CP;
+    for (const auto& cells : { all_cells, subset }) {
+        const Points pts(cells);
+        const int n = pts.n;
+        std::vector<double> mu[2], A[2], dAdp[2], rho[2];
+        CP cp[2];
+        int k = 0;
+        for (const auto& props : { grouped, ungrouped }) {
+            mu[k].resize(n*np);
+            A[k].resize(n*np*np);
+            dAdp[k].resize(n*np*np);
+            rho[k].resize(n*np);
+            props->viscosity(n, &pts.p[0], &pts.T[0], &pts.z[0], &pts.cells[0], &mu[k][0], 0);
+            props->matrix(n, &pts.p[0], &pts.T[0], &pts.z[0], &pts.cells[0], &A[k][0], &dAdp[k][0]);
+            props->density(n, &A[k][0], &pts.cells[0], &rho[k][0]);
+            props->computeCellProperties(n, &pts.p[0], &pts.T[0], &pts.z[0], &pts.s[0],
+                                         &pts.cells[0],
+                                         CP::Mobilities | CP::Densities | CP::Derivatives,
+                                         cp[k]);
+            ++k;
+        }
+        BOOST_CHECK(mu[0] == mu[1]);
+        BOOST_CHECK(A[0] == A[1]);
+        BOOST_CHECK(dAdp[0] == dAdp[1]);
+        BOOST_CHECK(rho[0] == rho[1]);
+        BOOST_CHECK(cp[0].mob == cp[1].mob);
+        BOOST_CHECK(cp[0].totmob == cp[1].totmob);
+        BOOST_CHECK(cp[0].dmobds == cp[1].dmobds);
+        BOOST_CHECK(cp[0].A == cp[1].A);
+        BOOST_CHECK(cp[0].dAdp == cp[1].dAdp);
+        BOOST_CHECK(cp[0].B == cp[1].B);
+        BOOST_CHECK(cp[0].rho == cp[1].rho);
+    }
+}
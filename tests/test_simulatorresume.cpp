@@ -0,0 +1,214 @@
+/*
+  Copyright 2015 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "config.h"
+
+#if HAVE_DYNAMIC_BOOST_TEST
+#define BOOST_TEST_DYN_LINK
+#endif
+
+#define NVERBOSE  // Suppress own messages when throw()ing
+
+#define BOOST_TEST_MODULE SimulatorResumeTest
+#include <boost/test/unit_test.hpp>
+
+#include <opm/core/grid.h>
+#include <opm/core/grid/cart_grid.h>
+#include <opm/core/linalg/LinearSolverInterface.hpp>
+#include <opm/core/props/IncompPropertiesBasic.hpp>
+#include <opm/core/simulator/SimulatorIncompTwophase.hpp>
+#include <opm/core/simulator/SimulatorReport.hpp>
+#include <opm/core/simulator/SimulatorTimer.hpp>
+#include <opm/core/simulator/TwophaseState.hpp>
+#include <opm/core/simulator/WellState.hpp>
+#include <opm/core/utility/Event.hpp>
+#include <opm/core/utility/Units.hpp>
+#include <opm/core/utility/parameters/ParameterGroup.hpp>
+#include <opm/core/wells/WellsManager.hpp>
+
+#include <boost/filesystem.hpp>
+
+#include <cmath>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    // Gaussian elimination with partial pivoting, so that the test
+    // does not depend on the linear solvers that are available.
+    class DenseSolver : public Opm::LinearSolverInterface
+    {
+    public:
+        using LinearSolverInterface::solve;
+
+        virtual LinearSolverReport solve(const int size, const int, const int* ia,
+                                         const int* ja, const double* sa,
+                                         const double* rhs, double* solution,
+                                         const boost::any& = boost::any()) const
+        {
+            const int n = size;
+            std::vector<double> A(n*n, 0.0);
+            for (int row = 0; row < n; ++row) {
+                for (int k = ia[row]; k < ia[row + 1]; ++k) {
+                    A[row*n + ja[k]] += sa[k];
+                }
+            }
+            std::vector<double> b(rhs, rhs + n);
+            for (int col = 0; col < n; ++col) {
+                int pivot = col;
+                for (int row = col + 1; row < n; ++row) {
+                    if (std::fabs(A[row*n + col]) > std::fabs(A[pivot*n + col])) {
+                        pivot = row;
+                    }
+                }
+                for (int k = 0; k < n; ++k) {
+                    std::swap(A[col*n + k], A[pivot*n + k]);
+                }
+                std::swap(b[col], b[pivot]);
+                for (int row = col + 1; row < n; ++row) {
+                    const double f = A[row*n + col]/A[col*n + col];
+                    for (int k = col; k < n; ++k) {
+                        A[row*n + k] -= f*A[col*n + k];
+                    }
+                    b[row] -= f*b[col];
+                }
+            }
+            for (int row = n - 1; row >= 0; --row) {
+                double x = b[row];
+                for (int k = row + 1; k < n; ++k) {
+                    x -= A[row*n + k]*solution[k];
+                }
+                solution[row] = x/A[row*n + row];
+            }
+            LinearSolverReport rep;
+            rep.converged = true;
+            rep.iterations = 1;
+            rep.residual_reduction = 0.0;
+            return rep;
+        }
+
+        virtual void setTolerance(const double) {}
+        virtual double getTolerance() const { return 0.0; }
+    };
+
+    struct StepCounter
+    {
+        StepCounter() : count(0) {}
+        void increment() { ++count; }
+        int count;
+    };
+
+    // Water injected in the first cell and produced from the last, in
+    // a 5x4 grid initially filled with oil.
+    struct Case
+    {
+        Case()
+            : grid(create_grid_cart2d(5, 4, 10.0, 10.0), destroy_grid),
+              props(2, Opm::SaturationPropsBasic::Linear,
+                    std::vector<double>{ 1000.0, 800.0 },
+                    std::vector<double>{ 1.0*Opm::prefix::centi*Opm::unit::Poise,
+                                         3.0*Opm::prefix::centi*Opm::unit::Poise },
+                    0.2, 100.0*Opm::prefix::milli*Opm::unit::darcy,
+                    2, grid->number_of_cells),
+              src(grid->number_of_cells, 0.0)
+        {
+            src[0] = 1e-4;
+            src[grid->number_of_cells - 1] = -1e-4;
+        }
+
+        // Run the simulation from fresh states, and return the number
+        // of steps taken.
+        int run(const Opm::parameter::ParameterGroup& param,
+                Opm::TwophaseState& state, Opm::WellState& well_state) const
+        {
+            std::vector<int> allcells(grid->number_of_cells);
+            for (int c = 0; c < grid->number_of_cells; ++c) {
+                allcells[c] = c;
+            }
+            state.init(*grid, 2);
+            state.setFirstSat(allcells, props, Opm::SimulatorState::MinSat);
+            Opm::WellsManager wells;
+            well_state.init(wells.c_wells(), state);
+
+            Opm::SimulatorTimer timer;
+            Opm::parameter::ParameterGroup timer_param;
+            timer_param.disableOutput();
+            timer_param.insertParameter("num_psteps", "6");
+            timer_param.insertParameter("stepsize_days", "2");
+            timer.init(timer_param);
+
+            DenseSolver linsolver;
+            Opm::SimulatorIncompTwophase simulator(param, *grid, props, 0, wells, src,
+                                                   0, linsolver, 0);
+            StepCounter steps;
+            simulator.timestep_completed().add<StepCounter, &StepCounter::increment>(steps);
+            simulator.run(timer, state, well_state);
+            BOOST_CHECK(timer.done());
+            return steps.count;
+        }
+
+        std::shared_ptr<UnstructuredGrid> grid;
+        Opm::IncompPropertiesBasic props;
+        std::vector<double> src;
+    };
+
+    Opm::parameter::ParameterGroup simulatorParam()
+    {
+        Opm::parameter::ParameterGroup param;
+        param.disableOutput();
+        param.insertParameter("output", "false");
+        param.insertParameter("quiet", "true");
+        return param;
+    }
+}
+
+BOOST_AUTO_TEST_CASE (ResumedRunSameAsFullRun)
+{
+    const boost::filesystem::path file = boost::filesystem::temp_directory_path()
+        / boost::filesystem::unique_path("test_simulatorresume-%%%%-%%%%.bin");
+    Case c;
+
+    // Checkpoints at steps 2 and 4, the last one is kept.
+    Opm::parameter::ParameterGroup param = simulatorParam();
+    param.insertParameter("checkpoint_interval", "2");
+    param.insertParameter("checkpoint_file", file.string());
+    Opm::TwophaseState state;
+    Opm::WellState well_state;
+    BOOST_CHECK_EQUAL(c.run(param, state, well_state), 6);
+    BOOST_REQUIRE(boost::filesystem::exists(file));
+
+    // The water front is still moving, so that resuming from another
+    // step would give another final state.
+    const std::vector<double>& s = state.saturation();
+    BOOST_CHECK(s[0] > s[2*(c.grid->number_of_cells - 1)] + 0.1);
+
+    // The resumed run takes the last two steps only, and ends in the
+    // same state.
+    Opm::parameter::ParameterGroup resume_param = simulatorParam();
+    resume_param.insertParameter("restart_checkpoint", file.string());
+    Opm::TwophaseState resumed;
+    Opm::WellState resumed_well_state;
+    BOOST_CHECK_EQUAL(c.run(resume_param, resumed, resumed_well_state), 2);
+    BOOST_CHECK(resumed.cellData() == state.cellData());
+    BOOST_CHECK(resumed.faceData() == state.faceData());
+
+    boost::filesystem::remove(file);
+}
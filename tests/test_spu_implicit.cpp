@@ -0,0 +1,218 @@
+/*
+  Copyright 2015 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "config.h"
+
+#if HAVE_DYNAMIC_BOOST_TEST
+#define BOOST_TEST_DYN_LINK
+#endif
+
+#define NVERBOSE  // Suppress own messages when throw()ing
+
+#define BOOST_TEST_MODULE SpuImplicitTest
+#include <boost/test/unit_test.hpp>
+
+#include <opm/core/grid.h>
+#include <opm/core/grid/cart_grid.h>
+#include <opm/core/transport/minimal/spu_implicit.h>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    // The mobility evaluation of the original scalar solver, kept
+    // here as the baseline.
+    double interpolate(int n, double h, double x0, const double *tab, double x)
+    {
+        if (x < x0) {
+            return tab[0];
+        }
+        const int i = (x - x0)/h;
+        if (i + 1 > n - 1) {
+            return tab[n - 1];
+        }
+        const double a = (x - x0 - i*h) / h;
+        return (1 - a) * tab[i] + a * tab[i + 1];
+    }
+
+    double differentiate(int n, double h, double x0, const double *tab, double x)
+    {
+        if (x < x0) {
+            return (tab[1] - tab[0])/h;
+        }
+        const int i = (x - x0)/h;
+        if (i + 1 > n - 1) {
+            return (tab[n - 1] - tab[n - 2])/h;
+        }
+        return (tab[i + 1] - tab[i])/h;
+    }
+
+    // Every linear system passed to the solver, in order.
+    struct System
+    {
+        std::vector<int> ia, ja;
+        std::vector<double> sa, b;
+    };
+    std::vector<System> systems;
+
+    // Dense Gaussian elimination with partial pivoting.
+    void recordAndSolve(int n, int *ia, int *ja, double *sa, double *b, double *x)
+    {
+        System sys;
+        sys.ia.assign(ia, ia + n + 1);
+        sys.ja.assign(ja, ja + ia[n]);
+        sys.sa.assign(sa, sa + ia[n]);
+        sys.b.assign(b, b + n);
+        systems.push_back(sys);
+
+        std::vector<double> A(n*n, 0.0), r(b, b + n);
+        for (int i = 0; i < n; ++i) {
+            for (int k = ia[i]; k < ia[i + 1]; ++k) {
+                A[n*i + ja[k]] += sa[k];
+            }
+        }
+        for (int c = 0; c < n; ++c) {
+            int p = c;
+            for (int i = c + 1; i < n; ++i) {
+                if (std::fabs(A[n*i + c]) > std::fabs(A[n*p + c])) {
+                    p = i;
+                }
+            }
+            for (int j = 0; j < n; ++j) {
+                std::swap(A[n*c + j], A[n*p + j]);
+            }
+            std::swap(r[c], r[p]);
+            for (int i = c + 1; i < n; ++i) {
+                const double f = A[n*i + c]/A[n*c + c];
+                for (int j = c; j < n; ++j) {
+                    A[n*i + j] -= f*A[n*c + j];
+                }
+                r[i] -= f*r[c];
+            }
+        }
+        for (int i = n - 1; i >= 0; --i) {
+            double v = r[i];
+            for (int j = i + 1; j < n; ++j) {
+                v -= A[n*i + j]*x[j];
+            }
+            x[i] = v/A[n*i + i];
+        }
+    }
+
+    // The Newton loop of the original solver, on the baseline
+    // mobilities.
+    void baselineSolve(UnstructuredGrid *g, std::vector<double>& s0, std::vector<double>& s,
+                       double h, double x0, int ntab, std::vector<double>& tab,
+                       std::vector<double>& dflux, std::vector<double>& gflux,
+                       std::vector<double>& src, double dt)
+    {
+        const int nc = g->number_of_cells;
+        const int nhf = g->cell_facepos[nc];
+        std::vector<int> ia(nc + 1), ja(nc + nhf);
+        std::vector<double> sa(nc + nhf), b(nc), x(nc), mob(2*nc), dmob(2*nc);
+        sparse_t S;
+        S.m = nc;
+        S.n = nc;
+        S.ia = &ia[0];
+        S.ja = &ja[0];
+        S.sa = &sa[0];
+
+        double infnorm = 1.0;
+        int it = 0;
+        while (infnorm > 1e-9 && it++ < 20) {
+            for (int c = 0; c < nc; ++c) {
+                mob [2*c + 0] = interpolate  (ntab, h, x0, &tab[0], s[c]);
+                mob [2*c + 1] = interpolate  (ntab, h, x0, &tab[ntab], s[c]);
+                dmob[2*c + 0] = differentiate(ntab, h, x0, &tab[0], s[c]);
+                dmob[2*c + 1] = differentiate(ntab, h, x0, &tab[ntab], s[c]);
+            }
+            spu_implicit_assemble(g, &s0[0], &s[0], &mob[0], &dmob[0], &dflux[0],
+                                  &gflux[0], &src[0], dt, &S, &b[0]);
+            infnorm = 0.0;
+            for (int c = 0; c < nc; ++c) {
+                infnorm = std::max(infnorm, std::fabs(b[c]));
+            }
+            recordAndSolve(nc, S.ia, S.ja, S.sa, &b[0], &x[0]);
+            for (int c = 0; c < nc; ++c) {
+                s[c] = std::min(1.0, std::max(0.0, s[c] - x[c]));
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE (SameAsBaseline)
+{
+    std::shared_ptr<UnstructuredGrid>
+        grid(create_grid_cart2d(7, 5, 1.0, 1.0), destroy_grid);
+    UnstructuredGrid* g = grid.get();
+    const int nc = g->number_of_cells;
+    const int nf = g->number_of_faces;
+
+    // Tables not starting at zero or ending at one, so that the
+    // saturations are also outside them.
+    const int ntab = 12;
+    const double x0 = 0.07;
+    const double h = 0.077;
+    std::vector<double> tab(2*ntab);
+    for (int i = 0; i < ntab; ++i) {
+        const double sw = x0 + i*h;
+        tab[i] = sw*sw;
+        tab[ntab + i] = (1.0 - sw)*(1.0 - sw)/3.0;
+    }
+
+    // A diagonal Darcy flux, gravity along y and a pair of wells.
+    std::vector<double> dflux(nf), gflux(nf), src(nc, 0.0), s0(nc);
+    for (int f = 0; f < nf; ++f) {
+        const bool yface = g->face_normals[2*f + 1] != 0.0;
+        dflux[f] = yface ? 0.3 : 0.5 + 0.01*(f % 3);
+        gflux[f] = yface ? -0.2 : 0.0;
+    }
+    src[0] = 1.0;
+    src[nc - 1] = -1.0;
+    for (int c = 0; c < nc; ++c) {
+        s0[c] = double(c % 11)/10.0;
+    }
+    s0[3] = x0 + 5*h;
+    s0[4] = x0;
+    s0[5] = x0 + (ntab - 1)*h;
+
+    const double dt = 0.7;
+    std::vector<double> s_base(s0), s(s0);
+    systems.clear();
+    baselineSolve(g, s0, s_base, h, x0, ntab, tab, dflux, gflux, src, dt);
+    const std::vector<System> base_systems = systems;
+
+    systems.clear();
+    spu_implicit(g, &s0[0], &s[0], h, x0, ntab, &tab[0], &dflux[0], &gflux[0],
+                 &src[0], dt, recordAndSolve);
+
+    BOOST_REQUIRE_EQUAL(systems.size(), base_systems.size());
+    BOOST_CHECK(systems.size() > 1);
+    for (std::size_t k = 0; k < systems.size(); ++k) {
+        BOOST_CHECK(systems[k].ia == base_systems[k].ia);
+        BOOST_CHECK(systems[k].ja == base_systems[k].ja);
+        BOOST_CHECK(systems[k].sa == base_systems[k].sa);
+        BOOST_CHECK(systems[k].b == base_systems[k].b);
+    }
+    BOOST_CHECK(s == s_base);
+}
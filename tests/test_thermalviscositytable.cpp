@@ -0,0 +1,68 @@
+/*
+  Copyright 2015 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <config.h>
+
+#if defined(HAVE_DYNAMIC_BOOST_TEST)
+#define BOOST_TEST_DYN_LINK
+#endif
+#define NVERBOSE // to suppress our messages when throwing
+
+
+#define BOOST_TEST_MODULE ThermalViscosityTableTests
+#include <boost/test/unit_test.hpp>
+#include <opm/core/props/pvt/ThermalViscosityTable.hpp>
+
+#include <vector>
+
+
+BOOST_AUTO_TEST_CASE(evaluation)
+{
+    const double Ta[] = { 280.0, 300.0, 330.0, 400.0 };
+    const double mua[] = { 4.0e-3, 2.0e-3, 1.5e-3, 0.5e-3 };
+    const std::vector<double> T(Ta, Ta + 4);
+    const std::vector<double> mu(mua, mua + 4);
+    const Opm::ThermalViscosityTable table(T, mu);
+
+    // Table values and constant extrapolation.
+    for (int i = 0; i < 4; ++i) {
+        BOOST_CHECK_EQUAL(table(T[i]), mu[i]);
+    }
+    BOOST_CHECK_EQUAL(table(200.0), mu[0]);
+    BOOST_CHECK_EQUAL(table(500.0), mu[3]);
+    BOOST_CHECK_CLOSE(table(315.0), 1.75e-3, 1e-12);
+
+    // Evaluation with a search hint gives the same values for any
+    // order of the temperatures.
+    const double Tq[] = { 390.0, 281.0, 300.0, 329.0, 331.0, 250.0, 399.0, 310.0 };
+    const int n = sizeof(Tq)/sizeof(Tq[0]);
+    std::vector<double> batch(n);
+    table.evaluate(n, Tq, &batch[0]);
+    for (int i = 0; i < n; ++i) {
+        BOOST_CHECK_EQUAL(batch[i], table(Tq[i]));
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(single_row)
+{
+    const Opm::ThermalViscosityTable table(std::vector<double>(1, 300.0),
+                                           std::vector<double>(1, 1.0e-3));
+    BOOST_CHECK_EQUAL(table(250.0), 1.0e-3);
+    BOOST_CHECK_EQUAL(table(350.0), 1.0e-3);
+}
@@ -0,0 +1,244 @@
+/*
+  Copyright 2015 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "config.h"
+
+#if HAVE_DYNAMIC_BOOST_TEST
+#define BOOST_TEST_DYN_LINK
+#endif
+
+#define NVERBOSE  // Suppress own messages when throw()ing
+
+#define BOOST_TEST_MODULE TofDiscGalReorderTest
+#include <boost/test/unit_test.hpp>
+
+#include <opm/core/flowdiagnostics/TofDiscGalReorder.hpp>
+#include <opm/core/grid.h>
+#include <opm/core/grid/cart_grid.h>
+#include <opm/core/grid/cornerpoint_grid.h>
+#include <opm/core/grid/CellQuadrature.hpp>
+#include <opm/core/grid/FaceQuadrature.hpp>
+#include <opm/core/utility/SparseTable.hpp>
+#include <opm/core/utility/parameters/ParameterGroup.hpp>
+
+#include <cmath>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace
+{
+    typedef std::shared_ptr<UnstructuredGrid> GridPtr;
+
+    // A 4x3x3 corner-point grid with a fault through the middle, so
+    // that cells along the fault have more faces than the others. The
+    // throw changes sign along the fault, so that layer boundaries
+    // cross on the fault and some fault faces are not quadrilaterals.
+    GridPtr createFaultedGrid()
+    {
+        const int nx = 4, ny = 3, nz = 3;
+        const double dx = 10.0, dy = 8.0, dz = 2.0;
+        std::vector<double> coord;
+        for (int j = 0; j <= ny; ++j) {
+            for (int i = 0; i <= nx; ++i) {
+                const double x = i*dx + 0.5*j;
+                const double y = j*dy;
+                const double top[] = { x, y, 0.0 };
+                const double bot[] = { x, y, 10.0*dz };
+                coord.insert(coord.end(), top, top + 3);
+                coord.insert(coord.end(), bot, bot + 3);
+            }
+        }
+        std::vector<double> zcorn;
+        for (int k = 0; k < 2*nz; ++k) {
+            for (int j = 0; j < 2*ny; ++j) {
+                for (int i = 0; i < 2*nx; ++i) {
+                    const double z = ((k + 1)/2)*dz + 0.05*dz*(i % 2);
+                    const double throw_ = 0.4*dz*(((j + 1)/2) - 0.5*ny);
+                    zcorn.push_back(z + ((i/2 >= nx/2) ? throw_ : 0.0));
+                }
+            }
+        }
+        struct grdecl g;
+        g.dims[0] = nx;
+        g.dims[1] = ny;
+        g.dims[2] = nz;
+        g.coord = &coord[0];
+        g.zcorn = &zcorn[0];
+        g.actnum = 0;
+        g.mapaxes = 0;
+        GridPtr grid(create_grid_cornerpoint(&g, 0.0), destroy_grid);
+        BOOST_REQUIRE(grid);
+        return grid;
+    }
+
+    // Face fluxes with a constant part along 'dir' and a part varying
+    // from face to face, which gives cycles in the flow graph. The
+    // sources balance the fluxes in each cell, and there is no flow
+    // across the outer boundary.
+    struct Flow
+    {
+        Flow(const UnstructuredGrid& g, const double* dir, const double perturbation)
+            : flux(g.number_of_faces, 0.0), source(g.number_of_cells, 0.0),
+              porevol(g.number_of_cells)
+        {
+            const int dim = g.dimensions;
+            for (int f = 0; f < g.number_of_faces; ++f) {
+                if (g.face_cells[2*f] < 0 || g.face_cells[2*f + 1] < 0) {
+                    continue;
+                }
+                const double* n = g.face_normals + dim*f;
+                double v = 0.0;
+                for (int d = 0; d < dim; ++d) {
+                    v += dir[d]*n[d];
+                }
+                v += perturbation*g.face_areas[f]*std::sin(1.7*f);
+                flux[f] = v;
+                source[g.face_cells[2*f]] += v;
+                source[g.face_cells[2*f + 1]] -= v;
+            }
+            for (int c = 0; c < g.number_of_cells; ++c) {
+                porevol[c] = (0.15 + 0.01*(c % 5))*g.cell_volumes[c];
+            }
+        }
+
+        std::vector<double> flux, source, porevol;
+    };
+
+    // Two tracers, started in the first half and the second half of
+    // the inflow cells.
+    Opm::SparseTable<int> tracerHeads(const std::vector<double>& source)
+    {
+        std::vector<int> inflow;
+        for (int c = 0; c < int(source.size()); ++c) {
+            if (source[c] > 0.0) {
+                inflow.push_back(c);
+            }
+        }
+        BOOST_REQUIRE(inflow.size() >= 2);
+        const int sizes[] = { int(inflow.size())/2, int(inflow.size() - inflow.size()/2) };
+        return Opm::SparseTable<int>(inflow.begin(), inflow.end(), sizes, sizes + 2);
+    }
+
+    struct Config
+    {
+        int degree;
+        bool tensorial;
+        bool cvi;
+        std::string limiter_usage;
+    };
+
+    std::shared_ptr<Opm::TofDiscGalReorder>
+    createSolver(const UnstructuredGrid& g, const Config& cfg, const bool cached)
+    {
+        Opm::parameter::ParameterGroup param;
+        param.disableOutput();
+        param.insertParameter("dg_degree", std::to_string(cfg.degree));
+        param.insertParameter("use_tensorial_basis", cfg.tensorial ? "true" : "false");
+        param.insertParameter("use_cvi", cfg.cvi ? "true" : "false");
+        if (!cfg.limiter_usage.empty()) {
+            param.insertParameter("use_limiter", "true");
+            param.insertParameter("limiter_usage", cfg.limiter_usage);
+        }
+        param.insertParameter("use_quadrature_cache", cached ? "true" : "false");
+        return std::make_shared<Opm::TofDiscGalReorder>(g, param);
+    }
+
+    // Solves for each flow with each solver, first for time-of-flight
+    // only and then with tracers, and compares the results. The cached
+    // solver fills its cache in the first solve and reuses it in the
+    // others, also when the flow changes. ECVI velocity interpolation
+    // requires every corner to have exactly 'dim' faces, so it is only
+    // used if 'cvi' is true.
+    void checkCacheMakesNoDifference(const UnstructuredGrid& g,
+                                     const std::vector<Flow>& flows,
+                                     const bool cvi)
+    {
+        const Config configs[] = { { 0, false, false, "" },
+                                   { 1, false, false, "" },
+                                   { 1, true, false, "" },
+                                   { 1, false, true, "" },
+                                   { 1, true, true, "DuringComputations" },
+                                   { 1, false, false, "AsPostProcess" } };
+        for (const Config& cfg : configs) {
+            if (cfg.cvi && !cvi) {
+                continue;
+            }
+            BOOST_TEST_MESSAGE("Degree " << cfg.degree << ", tensorial " << cfg.tensorial
+                               << ", cvi " << cfg.cvi << ", limiter " << cfg.limiter_usage);
+            const auto uncached = createSolver(g, cfg, false);
+            const auto cached = createSolver(g, cfg, true);
+            std::size_t usage = 0;
+            for (const Flow& flow : flows) {
+                std::vector<double> tof, tof_cached, tracer, tracer_cached;
+                uncached->solveTof(&flow.flux[0], &flow.porevol[0], &flow.source[0], tof);
+                cached->solveTof(&flow.flux[0], &flow.porevol[0], &flow.source[0], tof_cached);
+                BOOST_CHECK(tof_cached == tof);
+                if (usage == 0) {
+                    usage = cached->quadratureCacheMemoryUsage();
+                    BOOST_CHECK(usage > 0);
+                }
+
+                const Opm::SparseTable<int> heads = tracerHeads(flow.source);
+                uncached->solveTofTracer(&flow.flux[0], &flow.porevol[0], &flow.source[0],
+                                         heads, tof, tracer);
+                cached->solveTofTracer(&flow.flux[0], &flow.porevol[0], &flow.source[0],
+                                       heads, tof_cached, tracer_cached);
+                BOOST_CHECK(tof_cached == tof);
+                BOOST_CHECK(tracer_cached == tracer);
+                BOOST_CHECK_EQUAL(cached->quadratureCacheMemoryUsage(), usage);
+                BOOST_CHECK_EQUAL(uncached->quadratureCacheMemoryUsage(), 0);
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE (CachedSameAsUncached2D)
+{
+    GridPtr grid(create_grid_cart2d(9, 7, 5.0, 4.0), destroy_grid);
+    const double dir[] = { 1.0, 0.3 };
+    const double reversed[] = { -1.0, -0.4 };
+    const std::vector<Flow> flows = { Flow(*grid, dir, 1.2), Flow(*grid, reversed, 0.8) };
+    checkCacheMakesNoDifference(*grid, flows, true);
+}
+
+BOOST_AUTO_TEST_CASE (CachedSameAsUncachedFaulted)
+{
+    GridPtr grid = createFaultedGrid();
+    const UnstructuredGrid& g = *grid;
+
+    // The quadrature point counts of degree 2 differ between cells,
+    // and between faces, and from those of degree 1.
+    std::set<int> cell_pts, face_pts;
+    for (int c = 0; c < g.number_of_cells; ++c) {
+        cell_pts.insert(Opm::CellQuadrature(g, c, 2).numQuadPts());
+        BOOST_CHECK_EQUAL(Opm::CellQuadrature(g, c, 1).numQuadPts(), 1);
+    }
+    for (int f = 0; f < g.number_of_faces; ++f) {
+        face_pts.insert(Opm::FaceQuadrature(g, f, 2).numQuadPts());
+    }
+    BOOST_REQUIRE(cell_pts.size() > 1);
+    BOOST_REQUIRE(face_pts.size() > 1);
+
+    const double dir[] = { 1.0, 0.2, 0.1 };
+    const double reversed[] = { -0.3, -1.0, 0.1 };
+    const std::vector<Flow> flows = { Flow(g, dir, 1.2), Flow(g, reversed, 0.8) };
+    checkCacheMakesNoDifference(g, flows, false);
+}
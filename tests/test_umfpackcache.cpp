@@ -0,0 +1,247 @@
+/*
+  Copyright 2015 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "config.h"
+
+#if HAVE_DYNAMIC_BOOST_TEST
+#define BOOST_TEST_DYN_LINK
+#endif
+
+#define NVERBOSE  // Suppress own messages when throw()ing
+
+#define BOOST_TEST_MODULE UmfpackCacheTest
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <opm/core/linalg/call_umfpack.h>
+#include <opm/core/linalg/sparse_sys.h>
+#include <opm/core/linalg/LinearSolverUmfpack.hpp>
+#include <opm/core/transport/implicit/CSRMatrixGenericSolver.hpp>
+#include <opm/core/transport/implicit/CSRMatrixUmfpackSolver.hpp>
+#include <opm/core/utility/Exceptions.hpp>
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    typedef std::shared_ptr<CSRMatrix> MatrixPtr;
+
+    // Nonsymmetric convection-diffusion type matrix on an n-by-n grid,
+    // with values depending on 'shift'. If 'extra' is set, each row
+    // also couples to the cell two to the right.
+    MatrixPtr createMatrix(const int n, const double shift, const bool extra = false)
+    {
+        const int m = n*n;
+        MatrixPtr A(csrmatrix_new_known_nnz(m, (extra ? 6 : 5)*m), csrmatrix_delete);
+        int nz = 0;
+        A->ia[0] = 0;
+        for (int row = 0; row < m; ++row) {
+            const int x = row % n;
+            const int y = row / n;
+            const int cols[] = { row - n, row - 1, row, row + 1, row + 2, row + n };
+            const bool use[] = { y > 0, x > 0, true, x < n - 1, extra && x < n - 2, y < n - 1 };
+            const double vals[] = { -1.0, -1.5 - 0.1*shift, 0.0, -0.5, -0.25, -1.0 };
+            double diag = 0.0;
+            for (int k = 0; k < 6; ++k) {
+                if (use[k] && k != 2) {
+                    diag -= vals[k];
+                }
+            }
+            for (int k = 0; k < 6; ++k) {
+                if (use[k]) {
+                    A->ja[nz] = cols[k];
+                    A->sa[nz] = (k == 2) ? diag + 1.0 + shift + 0.01*(row % 7) : vals[k];
+                    ++nz;
+                }
+            }
+            A->ia[row + 1] = nz;
+        }
+        A->nnz = nz;
+        return A;
+    }
+
+    std::vector<double> rhs(const int m, const double shift)
+    {
+        std::vector<double> b(m);
+        for (int i = 0; i < m; ++i) {
+            b[i] = 1.0 + shift*double(i % 5) - 0.5*double(i % 3);
+        }
+        return b;
+    }
+
+    std::vector<double> solveUncached(const MatrixPtr& A, const std::vector<double>& b)
+    {
+        std::vector<double> x(A->m);
+        call_UMFPACK(A.get(), &b[0], &x[0]);
+        return x;
+    }
+
+    void checkSame(const std::vector<double>& x, const std::vector<double>& expected)
+    {
+        BOOST_REQUIRE_EQUAL(x.size(), expected.size());
+        for (std::size_t i = 0; i < x.size(); ++i) {
+            BOOST_CHECK_CLOSE(x[i], expected[i], 1e-10);
+        }
+    }
+
+    // Reports failure to converge.
+    class FailingSolver : public Opm::LinearSolverInterface
+    {
+    public:
+        using LinearSolverInterface::solve;
+
+        virtual LinearSolverReport solve(const int, const int, const int*, const int*,
+                                         const double*, const double*, double*,
+                                         const boost::any& = boost::any()) const
+        {
+            LinearSolverReport rep;
+            rep.converged = false;
+            rep.iterations = 100;
+            rep.residual_reduction = 0.5;
+            return rep;
+        }
+
+        virtual void setTolerance(const double) {}
+        virtual double getTolerance() const { return 0.0; }
+    };
+}
+
+BOOST_AUTO_TEST_CASE (SamePatternReusesSymbolic)
+{
+    std::shared_ptr<UMFPACKCache> cache(call_UMFPACK_create_cache(), call_UMFPACK_destroy_cache);
+    BOOST_REQUIRE(cache);
+
+    // New values in the same pattern are gathered into the cached
+    // structure and give the same solutions as uncached solves.
+    for (int it = 0; it < 4; ++it) {
+        const MatrixPtr A = createMatrix(6, 0.5*it);
+        const std::vector<double> b = rhs(A->m, it);
+        std::vector<double> x(A->m);
+        BOOST_REQUIRE(call_UMFPACK_cached(A.get(), &b[0], &x[0], 1, cache.get()));
+        checkSame(x, solveUncached(A, b));
+    }
+}
+
+BOOST_AUTO_TEST_CASE (ChangedPatternIsAnalysed)
+{
+    std::shared_ptr<UMFPACKCache> cache(call_UMFPACK_create_cache(), call_UMFPACK_destroy_cache);
+    BOOST_REQUIRE(cache);
+
+    // Alternate between patterns with the same number of rows, with
+    // more nonzeros, and with a different size.
+    const MatrixPtr matrices[] = { createMatrix(6, 0.0), createMatrix(6, 1.0, true),
+                                   createMatrix(6, 2.0), createMatrix(4, 3.0),
+                                   createMatrix(4, 4.0, true), createMatrix(6, 5.0, true) };
+    for (const MatrixPtr& A : matrices) {
+        const std::vector<double> b = rhs(A->m, 1.0);
+        std::vector<double> x(A->m);
+        // Not refactoring has no effect when the pattern changes.
+        BOOST_REQUIRE(call_UMFPACK_cached(A.get(), &b[0], &x[0], 0, cache.get()));
+        checkSame(x, solveUncached(A, b));
+    }
+
+    // The same pattern with a permuted column order in one row is a
+    // different pattern.
+    const MatrixPtr A = createMatrix(6, 1.0);
+    const MatrixPtr B = createMatrix(6, 1.0);
+    std::swap(B->ja[B->ia[7]], B->ja[B->ia[7] + 1]);
+    std::swap(B->sa[B->ia[7]], B->sa[B->ia[7] + 1]);
+    const std::vector<double> b = rhs(A->m, 2.0);
+    std::vector<double> x(A->m);
+    BOOST_REQUIRE(call_UMFPACK_cached(A.get(), &b[0], &x[0], 1, cache.get()));
+    BOOST_REQUIRE(call_UMFPACK_cached(B.get(), &b[0], &x[0], 0, cache.get()));
+    checkSame(x, solveUncached(A, b));
+}
+
+BOOST_AUTO_TEST_CASE (KeepNumericFactorisation)
+{
+    std::shared_ptr<UMFPACKCache> cache(call_UMFPACK_create_cache(), call_UMFPACK_destroy_cache);
+    BOOST_REQUIRE(cache);
+
+    const MatrixPtr A0 = createMatrix(5, 0.0);
+    const MatrixPtr A1 = createMatrix(5, 1.0);
+    const std::vector<double> b0 = rhs(A0->m, 0.0);
+    const std::vector<double> b1 = rhs(A0->m, 1.0);
+    std::vector<double> x(A0->m);
+
+    BOOST_REQUIRE(call_UMFPACK_cached(A0.get(), &b0[0], &x[0], 0, cache.get()));
+    checkSame(x, solveUncached(A0, b0));
+
+    // Without refactoring, the matrix of the previous factorisation
+    // is used with the new right-hand side.
+    BOOST_REQUIRE(call_UMFPACK_cached(A1.get(), &b1[0], &x[0], 0, cache.get()));
+    checkSame(x, solveUncached(A0, b1));
+
+    BOOST_REQUIRE(call_UMFPACK_cached(A1.get(), &b1[0], &x[0], 1, cache.get()));
+    checkSame(x, solveUncached(A1, b1));
+}
+
+BOOST_AUTO_TEST_CASE (UmfpackSolverRefactorInterval)
+{
+    using Opm::ImplicitTransportLinAlgSupport::CSRMatrixUmfpackSolver;
+
+    std::vector<MatrixPtr> A;
+    for (int it = 0; it < 7; ++it) {
+        A.push_back(createMatrix(5, 0.3*it));
+    }
+    const int m = A[0]->m;
+
+    // Uncached, and refactored on every solve.
+    for (const bool reuse_symbolic : { false, true }) {
+        CSRMatrixUmfpackSolver solver(reuse_symbolic, 1);
+        for (int it = 0; it < 7; ++it) {
+            const std::vector<double> b = rhs(m, it);
+            std::vector<double> x(m);
+            solver.solve(*A[it], b, x);
+            checkSame(x, solveUncached(A[it], b));
+        }
+    }
+
+    // Refactored on solves 0, 3 and 6.
+    CSRMatrixUmfpackSolver solver(true, 3);
+    for (int it = 0; it < 7; ++it) {
+        std::vector<double> b = rhs(m, it);
+        std::vector<double> x(m);
+        solver.solve(A[it].get(), &b[0], &x[0]);
+        checkSame(x, solveUncached(A[3*(it/3)], b));
+    }
+}
+
+BOOST_AUTO_TEST_CASE (GenericSolver)
+{
+    using Opm::ImplicitTransportLinAlgSupport::CSRMatrixGenericSolver;
+
+    CSRMatrixGenericSolver solver(std::make_shared<Opm::LinearSolverUmfpack>());
+    for (int it = 0; it < 3; ++it) {
+        const MatrixPtr A = createMatrix(5, it, it == 1);
+        const std::vector<double> b = rhs(A->m, it);
+        // The initial value of x is ignored.
+        std::vector<double> x(A->m, 1e10);
+        solver.solve(*A, b, x);
+        checkSame(x, solveUncached(A, b));
+    }
+
+    CSRMatrixGenericSolver failing(std::make_shared<FailingSolver>());
+    const MatrixPtr A = createMatrix(3, 0.0);
+    const std::vector<double> b = rhs(A->m, 0.0);
+    std::vector<double> x(A->m);
+    BOOST_CHECK_THROW(failing.solve(*A, b, x), Opm::LinearSolverProblem);
+}
@@ -54,7 +54,8 @@ BOOST_AUTO_TEST_CASE(table_operations)
     BOOST_CHECK_EQUAL(t1(2.25), 0.0);
     BOOST_CHECK_EQUAL(t1(9.75), 3.0);
     BOOST_CHECK_EQUAL(t1.derivative(9.75), -2.0/xdelta);
-    // Until we implement anything but the ClosestValue end policy, we only test that.
+    // The default end policy is ClosestValue (Extrapolate is tested in
+    // test_builduniformlineartable.cpp).
     BOOST_CHECK_EQUAL(t1(xmin - 1.0), yv[0]);
     BOOST_CHECK_EQUAL(t1(xmax + 1.0), yv.back());
 
@@ -0,0 +1,250 @@
+/*
+  Copyright 2015 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "config.h"
+
+#if HAVE_DYNAMIC_BOOST_TEST
+#define BOOST_TEST_DYN_LINK
+#endif
+
+#define NVERBOSE  // Suppress own messages when throw()ing
+
+#define BOOST_TEST_MODULE VtuWriterTest
+#include <boost/test/unit_test.hpp>
+
+#include <opm/core/io/vtk/VtuWriter.hpp>
+#include <opm/core/grid/GridManager.hpp>
+#include <opm/core/grid.h>
+
+#include <boost/filesystem.hpp>
+
+#if HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    struct TempDir
+    {
+        TempDir()
+            : path(boost::filesystem::temp_directory_path()
+                   / boost::filesystem::unique_path("test_vtuwriter-%%%%-%%%%"))
+        {
+            boost::filesystem::create_directories(path);
+        }
+        ~TempDir()
+        {
+            boost::filesystem::remove_all(path);
+        }
+        std::string file(const std::string& name) const
+        {
+            return (path / name).string();
+        }
+        boost::filesystem::path path;
+    };
+
+    std::string readFile(const std::string& filename)
+    {
+        std::ifstream is(filename.c_str(), std::ios::binary);
+        BOOST_REQUIRE(is);
+        std::ostringstream os;
+        os << is.rdbuf();
+        return os.str();
+    }
+
+    std::string attribute(const std::string& contents, const std::string& tag_start,
+                          const std::string& attr)
+    {
+        const std::string::size_type tag = contents.find(tag_start);
+        BOOST_REQUIRE(tag != std::string::npos);
+        const std::string key = attr + "=\"";
+        const std::string::size_type begin = contents.find(key, tag) + key.size();
+        return contents.substr(begin, contents.find('"', begin) - begin);
+    }
+
+    // Decode the appended array with the given name.
+    template <typename T>
+    std::vector<T> readArray(const std::string& contents, const std::string& name)
+    {
+        const std::uint64_t offset = std::strtoull(attribute(contents, "Name=\"" + name + "\"", "offset").c_str(), 0, 10);
+        const std::string marker = "<AppendedData encoding=\"raw\">\n_";
+        const std::string::size_type data = contents.find(marker);
+        BOOST_REQUIRE(data != std::string::npos);
+        const char* p = contents.data() + data + marker.size() + offset;
+
+        std::string bytes;
+        if (contents.find("vtkZLibDataCompressor") == std::string::npos) {
+            std::uint64_t num_bytes;
+            std::memcpy(&num_bytes, p, sizeof(num_bytes));
+            bytes.assign(p + sizeof(num_bytes), num_bytes);
+        } else {
+#if HAVE_ZLIB
+            std::uint64_t header[3];
+            std::memcpy(header, p, sizeof(header));
+            std::vector<std::uint64_t> sizes(header[0]);
+            std::memcpy(sizes.data(), p + sizeof(header), sizes.size()*sizeof(std::uint64_t));
+            const char* block = p + sizeof(header) + sizes.size()*sizeof(std::uint64_t);
+            for (std::size_t b = 0; b < sizes.size(); ++b) {
+                uLongf size = (b + 1 == sizes.size() && header[2] != 0) ? header[2] : header[1];
+                std::vector<Bytef> buffer(size);
+                BOOST_REQUIRE_EQUAL(uncompress(buffer.data(), &size, reinterpret_cast<const Bytef*>(block), sizes[b]), Z_OK);
+                bytes.append(reinterpret_cast<const char*>(buffer.data()), size);
+                block += sizes[b];
+            }
+#else
+            BOOST_FAIL("zlib not available");
+#endif
+        }
+        BOOST_REQUIRE_EQUAL(bytes.size() % sizeof(T), 0u);
+        std::vector<T> v(bytes.size()/sizeof(T));
+        std::memcpy(v.data(), bytes.data(), bytes.size());
+        return v;
+    }
+
+    struct Fixture
+    {
+        Fixture()
+            : gm(2, 3, 4),
+              grid(*gm.c_grid()),
+              pressure(grid.number_of_cells),
+              velocity(3*grid.number_of_cells)
+        {
+            for (int c = 0; c < grid.number_of_cells; ++c) {
+                pressure[c] = 1e5 + c;
+                for (int d = 0; d < 3; ++d) {
+                    velocity[3*c + d] = c + 0.25*d;
+                }
+            }
+            data["pressure"] = &pressure;
+            data["velocity"] = &velocity;
+        }
+        Opm::GridManager gm;
+        const UnstructuredGrid& grid;
+        std::vector<double> pressure;
+        std::vector<double> velocity;
+        Opm::DataMap data;
+        TempDir dir;
+    };
+}
+
+BOOST_FIXTURE_TEST_CASE(RawSinglePiece, Fixture)
+{
+    Opm::VtuWriter writer(grid);
+    BOOST_CHECK_EQUAL(writer.numPieces(), 1);
+    writer.write(data, dir.file("out"));
+    // Written twice from the same writer, to check the reuse of the
+    // encoded geometry.
+    writer.write(data, dir.file("out2"));
+
+    const std::string contents = readFile(dir.file("out2.vtu"));
+    BOOST_CHECK(contents == readFile(dir.file("out.vtu")));
+    BOOST_CHECK_EQUAL(attribute(contents, "<Piece", "NumberOfCells"), "24");
+    BOOST_CHECK_EQUAL(attribute(contents, "<Piece", "NumberOfPoints"), "60");
+    BOOST_CHECK_EQUAL(attribute(contents, "<CellData", "Scalars"), "pressure");
+
+    BOOST_CHECK(readArray<double>(contents, "pressure") == pressure);
+    BOOST_CHECK(readArray<double>(contents, "velocity") == velocity);
+    const std::vector<double> points = readArray<double>(contents, "Coordinates");
+    BOOST_CHECK(points == std::vector<double>(grid.node_coordinates, grid.node_coordinates + 3*60));
+    BOOST_CHECK_EQUAL(readArray<int>(contents, "connectivity").size(), 8u*24);
+    const std::vector<int> offsets = readArray<int>(contents, "offsets");
+    BOOST_REQUIRE_EQUAL(offsets.size(), 24u);
+    BOOST_CHECK_EQUAL(offsets.back(), 8*24);
+    const std::vector<unsigned char> types = readArray<unsigned char>(contents, "types");
+    BOOST_CHECK(types == std::vector<unsigned char>(24, 42));
+}
+
+BOOST_FIXTURE_TEST_CASE(ParallelPieces, Fixture)
+{
+    Opm::VtuWriter writer(grid, Opm::VtuWriter::Raw, 5);
+    BOOST_REQUIRE_EQUAL(writer.numPieces(), 5);
+    writer.write(data, dir.file("out"));
+
+    const std::string index = readFile(dir.file("out.pvtu"));
+    BOOST_CHECK(index.find("PUnstructuredGrid") != std::string::npos);
+    std::vector<double> all_pressure;
+    int num_cells = 0;
+    for (int p = 0; p < writer.numPieces(); ++p) {
+        std::ostringstream name;
+        name << "out-" << p << ".vtu";
+        BOOST_CHECK(index.find("Source=\"" + name.str() + "\"") != std::string::npos);
+        const std::string contents = readFile(dir.file(name.str()));
+        const int piece_cells = std::atoi(attribute(contents, "<Piece", "NumberOfCells").c_str());
+        const int piece_points = std::atoi(attribute(contents, "<Piece", "NumberOfPoints").c_str());
+        num_cells += piece_cells;
+        const std::vector<double> piece_pressure = readArray<double>(contents, "pressure");
+        BOOST_CHECK_EQUAL(int(piece_pressure.size()), piece_cells);
+        all_pressure.insert(all_pressure.end(), piece_pressure.begin(), piece_pressure.end());
+        BOOST_CHECK_EQUAL(int(readArray<double>(contents, "Coordinates").size()), 3*piece_points);
+        const std::vector<int> connectivity = readArray<int>(contents, "connectivity");
+        for (std::size_t i = 0; i < connectivity.size(); ++i) {
+            BOOST_CHECK(connectivity[i] >= 0 && connectivity[i] < piece_points);
+        }
+    }
+    BOOST_CHECK_EQUAL(num_cells, grid.number_of_cells);
+    BOOST_CHECK(all_pressure == pressure);
+}
+
+#if HAVE_ZLIB
+BOOST_FIXTURE_TEST_CASE(ZlibMatchesRaw, Fixture)
+{
+    // Large enough for several compression blocks.
+    Opm::GridManager big_gm(40, 40, 10);
+    const UnstructuredGrid& big = *big_gm.c_grid();
+    std::vector<double> field(big.number_of_cells);
+    for (int c = 0; c < big.number_of_cells; ++c) {
+        field[c] = 0.5*c;
+    }
+    Opm::DataMap big_data;
+    big_data["saturation"] = &field;
+    Opm::VtuWriter raw(big, Opm::VtuWriter::encodingFromString("binary"));
+    Opm::VtuWriter zlib(big, Opm::VtuWriter::encodingFromString("zlib"));
+    raw.write(big_data, dir.file("raw"));
+    zlib.write(big_data, dir.file("zlib"));
+
+    const std::string raw_contents = readFile(dir.file("raw.vtu"));
+    const std::string zlib_contents = readFile(dir.file("zlib.vtu"));
+    BOOST_CHECK(zlib_contents.size() < raw_contents.size());
+    BOOST_CHECK(readArray<double>(zlib_contents, "saturation") == field);
+    BOOST_CHECK(readArray<int>(zlib_contents, "faces") == readArray<int>(raw_contents, "faces"));
+    BOOST_CHECK(readArray<double>(zlib_contents, "Coordinates") == readArray<double>(raw_contents, "Coordinates"));
+}
+#else
+BOOST_FIXTURE_TEST_CASE(ZlibUnavailable, Fixture)
+{
+    BOOST_CHECK_THROW(Opm::VtuWriter(grid, Opm::VtuWriter::Zlib), std::runtime_error);
+}
+#endif
+
+BOOST_AUTO_TEST_CASE(InvalidArguments)
+{
+    Opm::GridManager gm(2, 2, 2);
+    BOOST_CHECK_THROW(Opm::VtuWriter::encodingFromString("ascii"), std::runtime_error);
+    BOOST_CHECK_THROW(Opm::VtuWriter(*gm.c_grid(), Opm::VtuWriter::Raw, 0), std::runtime_error);
+    // More pieces than cells gives one cell per piece.
+    BOOST_CHECK_EQUAL(Opm::VtuWriter(*gm.c_grid(), Opm::VtuWriter::Raw, 20).numPieces(), 8);
+}
@@ -28,6 +28,8 @@
 #define BOOST_TEST_MODULE WellCollectionTest
 #include <boost/test/unit_test.hpp>
 #include <opm/core/wells/WellCollection.hpp>
+#include <opm/core/wells.h>
+#include <opm/core/well_controls.h>
 #include <opm/parser/eclipse/Parser/Parser.hpp>
 #include <opm/parser/eclipse/Parser/ParseMode.hpp>
 #include <opm/parser/eclipse/Deck/Deck.hpp>
@@ -91,3 +93,63 @@ BOOST_AUTO_TEST_CASE(AddWellsAndGroupToCollection) {
     BOOST_CHECK_EQUAL("G2", collection.findNode("PROD2")->getParent()->name());
 }
 
+BOOST_AUTO_TEST_CASE(FlattenedConditionsMetEqualsRecursive) {
+    PhaseUsage pu;
+    pu.num_phases = 3;
+    for (int phase = 0; phase < 3; ++phase) {
+        pu.phase_used[phase] = 1;
+        pu.phase_pos[phase] = phase;
+    }
+    const int num_groups = 3;
+    const int num_wells = 12;
+
+    for (int violated = 0; violated < 2; ++violated) {
+        WellCollection collection;
+        std::shared_ptr<WellsGroupInterface> field(new WellsGroup("FIELD", ProductionSpecification(),
+                                                                  InjectionSpecification(), pu));
+        collection.addChild(field);
+        for (int g = 0; g < num_groups; ++g) {
+            ProductionSpecification prod_spec;
+            if (violated && g == 1) {
+                prod_spec.control_mode_ = ProductionSpecification::RESV;
+                prod_spec.oil_max_rate_ = 1e-9;
+                prod_spec.procedure_ = ProductionSpecification::NONE_P;
+            }
+            std::shared_ptr<WellsGroupInterface> group(new WellsGroup("G" + std::to_string(g), prod_spec,
+                                                                      InjectionSpecification(), pu));
+            collection.addChild(group, "FIELD");
+            group->setParent(field.get());
+        }
+
+        Wells* wells = create_wells(pu.num_phases, num_wells, 0);
+        const double comp_frac[3] = { 1.0, 1.0, 1.0 };
+        for (int w = 0; w < num_wells; ++w) {
+            const std::string name = "W" + std::to_string(w);
+            add_well(PRODUCER, 0.0, 0, comp_frac, 0, 0, name.c_str(), wells);
+            well_controls_add_new(BHP, 1e5, 0.0, 0, 0, wells->ctrls[w]);
+            well_controls_set_current(wells->ctrls[w], 0);
+            std::shared_ptr<WellsGroupInterface> well(new WellNode(name, ProductionSpecification(),
+                                                                   InjectionSpecification(), pu));
+            const std::string parent = "G" + std::to_string(w % num_groups);
+            collection.addChild(well, parent);
+            well->setParent(collection.findNode(parent));
+        }
+        collection.setWellsPointer(wells);
+
+        BOOST_CHECK_EQUAL("G2", collection.findNode("W11")->getParent()->name());
+        BOOST_CHECK(collection.findNode("NONE") == 0);
+
+        std::vector<double> bhp(num_wells, 2e5);
+        std::vector<double> res_rates(pu.num_phases*num_wells);
+        std::vector<double> surf_rates(pu.num_phases*num_wells);
+        for (size_t i = 0; i < res_rates.size(); ++i) {
+            res_rates[i] = -0.001*(i % 7 + 1);
+            surf_rates[i] = -0.002*(i % 5 + 1);
+        }
+        WellPhasesSummed summed;
+        const bool recursive = field->conditionsMet(bhp, res_rates, surf_rates, summed);
+        BOOST_CHECK_EQUAL(recursive, !violated);
+        BOOST_CHECK_EQUAL(collection.conditionsMet(bhp, res_rates, surf_rates), recursive);
+        destroy_wells(wells);
+    }
+}
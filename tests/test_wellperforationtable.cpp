@@ -0,0 +1,130 @@
+/*
+  Copyright 2015 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "config.h"
+
+#if HAVE_DYNAMIC_BOOST_TEST
+#define BOOST_TEST_DYN_LINK
+#endif
+
+#define NVERBOSE  // Suppress own messages when throw()ing
+
+#define BOOST_TEST_MODULE WellPerforationTableTest
+#include <boost/test/unit_test.hpp>
+
+#include <opm/core/wells/WellPerforationTable.hpp>
+#include <opm/core/utility/miscUtilities.hpp>
+#include <opm/core/grid/GridManager.hpp>
+#include <opm/core/grid.h>
+#include <opm/core/wells.h>
+
+#include <vector>
+
+namespace
+{
+    const int np = 2;
+
+    // Two wells on a 4x4x4 grid, perforating the cells in an order
+    // unrelated to the cell numbering. Well 1 perforates cell 21 twice.
+    Wells* createWells()
+    {
+        Wells* wells = create_wells(np, 2, 9);
+        const double comp_frac[np] = { 1.0, 0.0 };
+        const int cells0[4] = { 63, 42, 21, 0 };
+        const double WI0[4] = { 1.0, 2.0, 3.0, 4.0 };
+        add_well(INJECTOR, 0.5, 4, comp_frac, cells0, WI0, "INJ", wells);
+        const int cells1[5] = { 21, 5, 60, 21, 17 };
+        const double WI1[5] = { 5.0, 6.0, 7.0, 8.0, 9.0 };
+        add_well(PRODUCER, 1.5, 5, 0, cells1, WI1, "PROD", wells);
+        return wells;
+    }
+}
+
+BOOST_AUTO_TEST_CASE(SortedByCell)
+{
+    Opm::GridManager gm(4, 4, 4);
+    const UnstructuredGrid& grid = *gm.c_grid();
+    Wells* wells = createWells();
+    Opm::WellPerforationTable table(*wells, grid);
+
+    BOOST_CHECK_EQUAL(table.numWells(), 2);
+    BOOST_CHECK_EQUAL(table.numPerforations(), 9);
+    const int expected_perf[9] = { 3, 5, 8, 2, 4, 7, 1, 6, 0 };
+    for (int k = 0; k < table.numPerforations(); ++k) {
+        const int perf = table.perforation(k);
+        BOOST_CHECK_EQUAL(perf, expected_perf[k]);
+        BOOST_CHECK_EQUAL(table.cell(k), wells->well_cells[perf]);
+        BOOST_CHECK_EQUAL(table.well(k), perf < 4 ? 0 : 1);
+        BOOST_CHECK_EQUAL(table.wellIndex(k), wells->WI[perf]);
+        BOOST_CHECK_EQUAL(table.depthBelowReference(k),
+                          grid.cell_centroids[3*table.cell(k) + 2] - wells->depth_ref[table.well(k)]);
+    }
+    destroy_wells(wells);
+}
+
+BOOST_AUTO_TEST_CASE(KernelsMatchWellOrdered)
+{
+    Opm::GridManager gm(4, 4, 4);
+    const UnstructuredGrid& grid = *gm.c_grid();
+    Wells* wells = createWells();
+    Opm::WellPerforationTable table(*wells, grid);
+    const int nperf = table.numPerforations();
+
+    std::vector<double> s(np*grid.number_of_cells);
+    for (int c = 0; c < grid.number_of_cells; ++c) {
+        s[np*c] = 0.1 + 0.8*c/grid.number_of_cells;
+        s[np*c + 1] = 1.0 - s[np*c];
+    }
+    const double densities[np] = { 1000.0, 800.0 };
+
+    std::vector<double> wdp, table_wdp;
+    Opm::computeWDP(*wells, grid, s, densities, 9.81, true, wdp);
+    Opm::computeWDP(table, s, densities, 9.81, true, table_wdp);
+    BOOST_CHECK(table_wdp == wdp);
+
+    std::vector<double> perf_s(np*nperf, 0.0);
+    for (int perf = 0; perf < nperf; ++perf) {
+        perf_s[np*perf] = 0.05*perf;
+    }
+    wdp.clear();
+    Opm::computeWDP(*wells, grid, perf_s, densities, 9.81, false, wdp);
+    Opm::computeWDP(table, perf_s, densities, 9.81, false, table_wdp);
+    BOOST_CHECK(table_wdp == wdp);
+
+    std::vector<double> rates(nperf);
+    for (int perf = 0; perf < nperf; ++perf) {
+        rates[perf] = 1.0 + perf;
+    }
+    std::vector<double> well_rates, table_well_rates;
+    Opm::computeFlowRatePerWell(*wells, rates, well_rates);
+    Opm::computeFlowRatePerWell(table, rates, table_well_rates);
+    BOOST_REQUIRE_EQUAL(table_well_rates.size(), well_rates.size());
+    for (std::size_t w = 0; w < well_rates.size(); ++w) {
+        BOOST_CHECK_CLOSE(table_well_rates[w], well_rates[w], 1e-12);
+    }
+
+    std::vector<double> phase_rates, table_phase_rates;
+    Opm::computePhaseFlowRatesPerWell(*wells, rates, s, phase_rates);
+    Opm::computePhaseFlowRatesPerWell(table, rates, s, table_phase_rates);
+    BOOST_REQUIRE_EQUAL(table_phase_rates.size(), phase_rates.size());
+    for (std::size_t i = 0; i < phase_rates.size(); ++i) {
+        BOOST_CHECK_CLOSE(table_phase_rates[i], phase_rates[i], 1e-12);
+    }
+    destroy_wells(wells);
+}
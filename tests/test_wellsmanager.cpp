@@ -36,7 +36,11 @@
 #include <opm/core/wells.h>
 #include <opm/core/well_controls.h>
 
+#include <opm/core/grid.h>
 #include <opm/core/grid/GridManager.hpp>
+#include <opm/core/utility/CompressedCartesianIndex.hpp>
+
+#include <memory>
 
 
 void wells_static_check(const Wells* wells) {
@@ -242,6 +246,66 @@ BOOST_AUTO_TEST_CASE(WellsEqual) {
 }
 
 
+BOOST_AUTO_TEST_CASE(UpdateEqualsConstruction) {
+    const std::string filename = "wells_manager_data.data";
+    Opm::ParserPtr parser(new Opm::Parser());
+    Opm::ParseMode parseMode;
+    Opm::DeckConstPtr deck(parser->parseFile(filename , parseMode));
+
+    Opm::EclipseStateConstPtr eclipseState(new Opm::EclipseState(deck , parseMode));
+    Opm::GridManager gridManager(deck);
+
+    Opm::WellsManager updated;
+    for (size_t step = 0; step < 4; ++step) {
+        updated.update(eclipseState , step , *gridManager.c_grid(), NULL);
+        Opm::WellsManager constructed(eclipseState , step , *gridManager.c_grid(), NULL);
+
+        BOOST_CHECK( wells_equal( updated.c_wells() , constructed.c_wells() , true) );
+        BOOST_CHECK_EQUAL( updated.wellCollection().getLeafNodes().size() ,
+                           constructed.wellCollection().getLeafNodes().size() );
+        BOOST_CHECK( updated.wellIds() == constructed.wellIds() );
+
+        // Identities are positions among all wells of the schedule.
+        const std::vector<int>& ids = updated.wellIds();
+        BOOST_CHECK_EQUAL( int(ids.size()) , updated.c_wells()->number_of_wells );
+        for (size_t w = 0; w < ids.size(); ++w) {
+            BOOST_CHECK_EQUAL( eclipseState->getSchedule()->getWells()[ids[w]]->name() ,
+                               std::string(updated.c_wells()->name[w]) );
+        }
+    }
+    check_controls_epoch3( updated.c_wells()->ctrls );
+}
+
+
+BOOST_AUTO_TEST_CASE(SharedCartesianIndex) {
+    const std::string filename = "wells_manager_data.data";
+    Opm::ParserPtr parser(new Opm::Parser());
+    Opm::ParseMode parseMode;
+    Opm::DeckConstPtr deck(parser->parseFile(filename , parseMode));
+
+    Opm::EclipseStateConstPtr eclipseState(new Opm::EclipseState(deck , parseMode));
+    Opm::GridManager gridManager(deck);
+    const UnstructuredGrid& grid = *gridManager.c_grid();
+    auto index = std::make_shared<Opm::CompressedCartesianIndex>(grid.number_of_cells,
+                                                                 grid.global_cell);
+
+    Opm::WellsManager updated;
+    for (size_t step = 0; step < 4; ++step) {
+        updated.update(eclipseState , step , grid, NULL, index);
+        Opm::WellsManager constructed(eclipseState , step , grid, NULL);
+        Opm::WellsManager shared(eclipseState , step , grid, NULL, index);
+
+        BOOST_CHECK( wells_equal( updated.c_wells() , constructed.c_wells() , true) );
+        BOOST_CHECK( wells_equal( shared.c_wells() , constructed.c_wells() , true) );
+    }
+
+    // An index of another grid is rejected.
+    auto other = std::make_shared<Opm::CompressedCartesianIndex>(grid.number_of_cells - 1,
+                                                                 grid.global_cell);
+    BOOST_CHECK_THROW( Opm::WellsManager(eclipseState , 0 , grid, NULL, other) , std::runtime_error );
+}
+
+
 BOOST_AUTO_TEST_CASE(ControlsEqual) {
     const std::string filename = "wells_manager_data.data";
     Opm::ParseMode parseMode;
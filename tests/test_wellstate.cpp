@@ -0,0 +1,132 @@
+/*
+  Copyright 2015 SINTEF ICT, Applied Mathematics.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "config.h"
+
+#if HAVE_DYNAMIC_BOOST_TEST
+#define BOOST_TEST_DYN_LINK
+#endif
+
+#define NVERBOSE  // Suppress own messages when throw()ing
+
+#define BOOST_TEST_MODULE WellStateTest
+#include <boost/test/unit_test.hpp>
+
+#include <opm/core/simulator/WellState.hpp>
+#include <opm/core/simulator/TwophaseState.hpp>
+#include <opm/core/wells.h>
+#include <opm/core/well_controls.h>
+
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+    const int np = 2;
+
+    void addWell(const char* name, const int first_cell, const int num_perf,
+                 const WellControlType control, const double target, Wells* wells)
+    {
+        std::vector<int> cells(num_perf);
+        std::vector<double> WI(num_perf, 1.0);
+        for (int perf = 0; perf < num_perf; ++perf) {
+            cells[perf] = first_cell + perf;
+        }
+        const double comp_frac[np] = { 1.0, 0.0 };
+        add_well(INJECTOR, 0.0, num_perf, comp_frac, &cells[0], &WI[0], name, wells);
+        const double distr[np] = { 1.0, 0.0 };
+        const int w = wells->number_of_wells - 1;
+        well_controls_add_new(control, target, 0.0, 0, distr, wells->ctrls[w]);
+        well_controls_set_current(wells->ctrls[w], 0);
+    }
+
+    void fill(std::vector<double>& v, const double offset)
+    {
+        for (std::size_t i = 0; i < v.size(); ++i) {
+            v[i] = offset + i;
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TransferByIdentity)
+{
+    Opm::TwophaseState state;
+    state.init(10, 0, np);
+
+    // Previous report step: A (id 0, two perforations), B (id 2).
+    Wells* prev_wells = create_wells(np, 2, 3);
+    addWell("A", 0, 2, SURFACE_RATE, 1.0, prev_wells);
+    addWell("B", 5, 1, SURFACE_RATE, 2.0, prev_wells);
+    const int prev_id_data[2] = { 0, 2 };
+    const std::vector<int> prev_ids(prev_id_data, prev_id_data + 2);
+    Opm::WellState prev_state;
+    prev_state.init(prev_wells, prev_ids, state, Opm::WellState());
+    BOOST_CHECK(prev_state.wellIds() == prev_ids);
+    fill(prev_state.bhp(), 100.0);
+    fill(prev_state.thp(), 200.0);
+    fill(prev_state.wellRates(), 300.0);
+    fill(prev_state.perfRates(), 400.0);
+    fill(prev_state.perfPress(), 500.0);
+
+    // New report step: B (id 2, now BHP controlled), C (id 3), A
+    // (id 0, three perforations).
+    Wells* wells = create_wells(np, 3, 5);
+    addWell("B", 5, 1, BHP, 1e5, wells);
+    addWell("C", 8, 1, SURFACE_RATE, 3.0, wells);
+    addWell("A", 0, 3, SURFACE_RATE, 1.0, wells);
+    const int id_data[3] = { 2, 3, 0 };
+    const std::vector<int> ids(id_data, id_data + 3);
+    Opm::WellState fresh;
+    fresh.init(wells, state);
+    Opm::WellState well_state;
+    well_state.init(wells, ids, state, prev_state);
+
+    // B: target bhp kept, other values carried over, including the
+    // perforation values.
+    BOOST_CHECK_EQUAL(well_state.bhp()[0], 1e5);
+    BOOST_CHECK_EQUAL(well_state.thp()[0], prev_state.thp()[1]);
+    BOOST_CHECK_EQUAL(well_state.wellRates()[0], prev_state.wellRates()[np]);
+    BOOST_CHECK_EQUAL(well_state.wellRates()[1], prev_state.wellRates()[np + 1]);
+    BOOST_CHECK_EQUAL(well_state.perfRates()[0], prev_state.perfRates()[2]);
+    BOOST_CHECK_EQUAL(well_state.perfPress()[0], prev_state.perfPress()[2]);
+
+    // C: new well, initialised as without a previous state.
+    BOOST_CHECK_EQUAL(well_state.bhp()[1], fresh.bhp()[1]);
+    BOOST_CHECK_EQUAL(well_state.wellRates()[np], fresh.wellRates()[np]);
+    BOOST_CHECK_EQUAL(well_state.perfRates()[1], fresh.perfRates()[1]);
+
+    // A: well values carried over, but not the perforation values,
+    // since the number of perforations changed.
+    BOOST_CHECK_EQUAL(well_state.bhp()[2], prev_state.bhp()[0]);
+    BOOST_CHECK_EQUAL(well_state.wellRates()[2*np], prev_state.wellRates()[0]);
+    for (int perf = 2; perf < 5; ++perf) {
+        BOOST_CHECK_EQUAL(well_state.perfRates()[perf], fresh.perfRates()[perf]);
+        BOOST_CHECK_EQUAL(well_state.perfPress()[perf], fresh.perfPress()[perf]);
+    }
+
+    // A previous state without identities carries nothing over.
+    Opm::WellState unidentified;
+    unidentified.init(wells, ids, state, fresh);
+    BOOST_CHECK(unidentified.bhp() == fresh.bhp());
+
+    BOOST_CHECK_THROW(unidentified.init(wells, prev_ids, state, prev_state), std::runtime_error);
+
+    destroy_wells(wells);
+    destroy_wells(prev_wells);
+}